@@ -5,11 +5,23 @@
 
 namespace HdrMetadata {
 
-HdrMetadataProvider::HdrMetadataProvider(const std::vector<uint32_t>& profile0Exposures,
-                                         const std::vector<uint32_t>& profile1Exposures) {
-    _profile0.Exposures = profile0Exposures;
-    _profile1.Exposures = profile1Exposures;
-    BuildExposureMap();
+HdrMetadataProvider::HdrMetadataProvider(const std::vector<std::vector<uint32_t>>& profileExposures,
+                                         bool bySequencerSet) {
+    if (profileExposures.size() > UINT8_MAX) {
+        throw std::invalid_argument("Too many profiles");
+    }
+
+    for (const auto& exposures : profileExposures) {
+        ProfileInfo profile;
+        profile.Exposures = exposures;
+        _profiles.push_back(profile);
+    }
+
+    if (bySequencerSet) {
+        BuildSetTable();
+    } else {
+        BuildExposureMap();
+    }
 }
 
 std::unique_ptr<HdrMetadataProvider> HdrMetadataProvider::Create(
@@ -18,24 +30,58 @@ std::unique_ptr<HdrMetadataProvider> HdrMetadataProvider::Create(
     std::vector<uint32_t>& adjustedProfile0,
     std::vector<uint32_t>& adjustedProfile1) {
 
+    std::vector<std::vector<uint32_t>> adjusted;
+    auto provider = Create({profile0Exposures, profile1Exposures}, adjusted);
+
+    adjustedProfile0 = adjusted[0];
+    adjustedProfile1 = adjusted[1];
+
+    return provider;
+}
+
+std::unique_ptr<HdrMetadataProvider> HdrMetadataProvider::Create(
+    const std::vector<std::vector<uint32_t>>& profileExposures,
+    std::vector<std::vector<uint32_t>>& adjustedProfiles) {
+
     auto provider = std::unique_ptr<HdrMetadataProvider>(
-        new HdrMetadataProvider(profile0Exposures, profile1Exposures));
+        new HdrMetadataProvider(profileExposures));
 
     // Build adjusted exposure arrays from the exposure map
-    adjustedProfile0.resize(provider->_profile0.WindowSize());
-    adjustedProfile1.resize(provider->_profile1.WindowSize());
+    adjustedProfiles.clear();
+    for (const auto& profile : provider->_profiles) {
+        adjustedProfiles.emplace_back(profile.WindowSize());
+    }
 
     for (const auto& [exposure, profileIndex] : provider->_exposureMap) {
-        if (profileIndex.first == 0) {
-            adjustedProfile0[profileIndex.second] = exposure;
-        } else {
-            adjustedProfile1[profileIndex.second] = exposure;
-        }
+        adjustedProfiles[profileIndex.first][profileIndex.second] = exposure;
     }
 
     return provider;
 }
 
+std::unique_ptr<HdrMetadataProvider> HdrMetadataProvider::CreateForSequencerSets(
+    const std::vector<uint32_t>& profile0Exposures,
+    const std::vector<uint32_t>& profile1Exposures) {
+
+    return CreateForSequencerSets({profile0Exposures, profile1Exposures});
+}
+
+std::unique_ptr<HdrMetadataProvider> HdrMetadataProvider::CreateForSequencerSets(
+    const std::vector<std::vector<uint32_t>>& profileExposures) {
+
+    size_t setCount = 0;
+    for (const auto& exposures : profileExposures) {
+        setCount += exposures.size();
+    }
+
+    if (setCount > UINT8_MAX) {
+        throw std::invalid_argument("Too many sequencer sets");
+    }
+
+    return std::unique_ptr<HdrMetadataProvider>(
+        new HdrMetadataProvider(profileExposures, true));
+}
+
 HdrMetadata HdrMetadataProvider::ProcessFrame(uint64_t frameNumber, uint32_t actualExposureTime) {
     if (frameNumber == 0) {
         throw std::invalid_argument("Frame number must be greater than zero");
@@ -44,6 +90,27 @@ HdrMetadata HdrMetadataProvider::ProcessFrame(uint64_t frameNumber, uint32_t act
     // Look up the exposure to find profile and index
     auto [profile, index] = LookupExposure(actualExposureTime);
 
+    return ProcessLookup(frameNumber, profile, index, actualExposureTime);
+}
+
+HdrMetadata HdrMetadataProvider::ProcessFrameBySet(uint64_t frameNumber, uint32_t sequencerSet,
+                                                   uint32_t actualExposureTime) {
+    if (frameNumber == 0) {
+        throw std::invalid_argument("Frame number must be greater than zero");
+    }
+
+    if (sequencerSet >= _setTable.size()) {
+        throw std::invalid_argument("Unexpected sequencer set " + std::to_string(sequencerSet) +
+                                   " not found in configured sequences");
+    }
+
+    auto [profile, index] = _setTable[sequencerSet];
+
+    return ProcessLookup(frameNumber, profile, index, actualExposureTime);
+}
+
+HdrMetadata HdrMetadataProvider::ProcessLookup(uint64_t frameNumber, uint8_t profile,
+                                               uint8_t index, uint32_t actualExposureTime) {
     // Get exposure count for current profile
     uint8_t exposureCount = GetProfile(profile).WindowSize();
 
@@ -107,79 +174,78 @@ void HdrMetadataProvider::CalculateFrameOffset(uint64_t n, const ProfileInfo& pr
 }
 
 void HdrMetadataProvider::BuildExposureMap() {
-    // Check if at least one profile is configured
-    if (_profile0.WindowSize() == 0 && _profile1.WindowSize() == 0) {
-        return;
-    }
-
-    // Helper to add profile exposures to map
-    auto addProfileToMap = [this](const ProfileInfo& profile, uint8_t profileNum) {
-        for (uint8_t i = 0; i < profile.WindowSize(); i++) {
-            _exposureMap[profile.Exposures[i]] = {profileNum, i};
+    // Add every profile, the duplicates are resolved afterwards
+    for (uint8_t p = 0; p < _profiles.size(); p++) {
+        for (uint8_t i = 0; i < _profiles[p].WindowSize(); i++) {
+            _exposureMap[_profiles[p].Exposures[i]] = {p, i};
         }
-    };
-
-    // Add both profiles
-    addProfileToMap(_profile0, 0);
-    addProfileToMap(_profile1, 1);
+    }
 
     // Handle duplicates
     HandleDuplicateExposures();
 }
 
-void HdrMetadataProvider::HandleDuplicateExposures() {
-    std::set<uint32_t> seen;
-    std::vector<uint32_t> duplicates;
-
-    // Find duplicates across both profiles
-    for (const auto& exp : _profile0.Exposures) {
-        if (!seen.insert(exp).second) {
-            duplicates.push_back(exp);
+void HdrMetadataProvider::BuildSetTable() {
+    // Same set layout as the sequencer programming: profiles in order
+    for (uint8_t p = 0; p < _profiles.size(); p++) {
+        for (uint8_t i = 0; i < _profiles[p].WindowSize(); i++) {
+            _setTable.emplace_back(p, i);
         }
     }
+}
 
-    for (const auto& exp : _profile1.Exposures) {
-        if (!seen.insert(exp).second) {
-            duplicates.push_back(exp);
-        }
+void HdrMetadataProvider::HandleDuplicateExposures() {
+    // Every configured value stays reserved, adjusted values must not collide
+    // with an exposure of any profile
+    std::set<uint32_t> occupied;
+    for (const auto& profile : _profiles) {
+        occupied.insert(profile.Exposures.begin(), profile.Exposures.end());
     }
 
-    // Adjust duplicates
-    for (uint32_t dupExposure : duplicates) {
-        // Find which profiles have this exposure
-        auto findExposureIndex = [](const ProfileInfo& profile, uint32_t exposure) -> uint8_t {
-            for (uint8_t i = 0; i < profile.WindowSize(); i++) {
-                if (profile.Exposures[i] == exposure) {
-                    return i;
-                }
-            }
-            return UINT8_MAX;
-        };
+    // The first profile using an exposure keeps it, later profiles get adjusted
+    std::unordered_map<uint32_t, uint8_t> owner;
+    for (uint8_t p = 0; p < _profiles.size(); p++) {
+        for (uint8_t i = 0; i < _profiles[p].WindowSize(); i++) {
+            uint32_t exposure = _profiles[p].Exposures[i];
+            auto it = owner.find(exposure);
 
-        uint8_t profile0Index = findExposureIndex(_profile0, dupExposure);
-        uint8_t profile1Index = findExposureIndex(_profile1, dupExposure);
+            if (it == owner.end()) {
+                owner[exposure] = p;
+                continue;
+            }
+            if (it->second == p) {
+                continue;
+            }
 
-        // If found in both, adjust profile 1's value
-        if (profile0Index != UINT8_MAX && profile1Index != UINT8_MAX) {
-            uint32_t adjustedExposure = dupExposure;
+            uint32_t adjustedExposure = exposure;
 
             // Find a unique value by incrementing
-            while (_exposureMap.find(adjustedExposure) != _exposureMap.end()) {
+            while (occupied.count(adjustedExposure) > 0) {
                 adjustedExposure++;
             }
+            occupied.insert(adjustedExposure);
 
-            // Update mapping - Profile 0 keeps original, Profile 1 gets adjusted
-            _exposureMap.erase(dupExposure);
-            _exposureMap[dupExposure] = {0, profile0Index};
-            _exposureMap[adjustedExposure] = {1, profile1Index};
+            // Update mapping - the owner keeps the original, this one is adjusted
+            _exposureMap[exposure] = {it->second, FindExposureIndex(it->second, exposure)};
+            _exposureMap[adjustedExposure] = {p, i};
 
-            std::cerr << "Warning: Duplicate exposure " << dupExposure << "μs. "
-                      << "Profile 1 index " << (int)profile1Index
+            std::cerr << "Warning: Duplicate exposure " << exposure << "μs. "
+                      << "Profile " << (int)p << " index " << (int)i
                       << " adjusted to " << adjustedExposure << "μs" << std::endl;
         }
     }
 }
 
+uint8_t HdrMetadataProvider::FindExposureIndex(uint8_t profile, uint32_t exposure) const {
+    const ProfileInfo& info = GetProfile(profile);
+    for (uint8_t i = 0; i < info.WindowSize(); i++) {
+        if (info.Exposures[i] == exposure) {
+            return i;
+        }
+    }
+    return UINT8_MAX;
+}
+
 std::pair<uint8_t, uint8_t> HdrMetadataProvider::LookupExposure(uint32_t exposureTime) const {
     auto it = _exposureMap.find(exposureTime);
     if (it != _exposureMap.end()) {
@@ -192,11 +258,11 @@ std::pair<uint8_t, uint8_t> HdrMetadataProvider::LookupExposure(uint32_t exposur
 }
 
 HdrMetadataProvider::ProfileInfo& HdrMetadataProvider::GetProfile(uint8_t profile) {
-    return profile == 0 ? _profile0 : _profile1;
+    return _profiles.at(profile);
 }
 
 const HdrMetadataProvider::ProfileInfo& HdrMetadataProvider::GetProfile(uint8_t profile) const {
-    return profile == 0 ? _profile0 : _profile1;
+    return _profiles.at(profile);
 }
 
 } // namespace HdrMetadata
\ No newline at end of file
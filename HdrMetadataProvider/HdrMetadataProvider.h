@@ -27,12 +27,37 @@ public:
         std::vector<uint32_t>& adjustedProfile0,
         std::vector<uint32_t>& adjustedProfile1);
 
+    // Factory method for any number of profiles. Exposures repeated in a later
+    // profile are adjusted until every exposure identifies a single profile.
+    static std::unique_ptr<HdrMetadataProvider> Create(
+        const std::vector<std::vector<uint32_t>>& profileExposures,
+        std::vector<std::vector<uint32_t>>& adjustedProfiles);
+
+    // Factory method for frames identified by the sequencer set that captured
+    // them (ChunkSequencerSetActive). Profile 0 occupies sets 0..n0-1 and
+    // profile 1 the following n1 sets, exposures are used unmodified.
+    static std::unique_ptr<HdrMetadataProvider> CreateForSequencerSets(
+        const std::vector<uint32_t>& profile0Exposures,
+        const std::vector<uint32_t>& profile1Exposures);
+
+    // Same for any number of profiles, each occupying the sets following the
+    // previous one
+    static std::unique_ptr<HdrMetadataProvider> CreateForSequencerSets(
+        const std::vector<std::vector<uint32_t>>& profileExposures);
+
     // Process a frame and return its HDR metadata
     HdrMetadata ProcessFrame(uint64_t frameNumber, uint32_t actualExposureTime);
 
+    // Process a frame identified by its active sequencer set
+    HdrMetadata ProcessFrameBySet(uint64_t frameNumber, uint32_t sequencerSet,
+                                  uint32_t actualExposureTime);
+
     // Get the current/last profile being processed
     int GetCurrentProfile() const { return _lastProfile; }
-    uint8_t GetProfileWindowSize(const int profile) const { return profile == 0 ? _profile0.WindowSize() : _profile1.WindowSize(); }
+    int GetProfileCount() const { return static_cast<int>(_profiles.size()); }
+    uint8_t GetProfileWindowSize(const int profile) const {
+        return profile >= 0 && profile < GetProfileCount() ? _profiles[profile].WindowSize() : 0;
+    }
 private:
     struct ProfileInfo {
         std::vector<uint32_t> Exposures;
@@ -46,8 +71,8 @@ private:
     };
 
     // Constructor is private - use Create factory method
-    HdrMetadataProvider(const std::vector<uint32_t>& profile0Exposures,
-                        const std::vector<uint32_t>& profile1Exposures);
+    HdrMetadataProvider(const std::vector<std::vector<uint32_t>>& profileExposures,
+                        bool bySequencerSet = false);
 
     // Deleted copy operations for clear ownership semantics
     HdrMetadataProvider(const HdrMetadataProvider&) = delete;
@@ -58,16 +83,21 @@ private:
     HdrMetadataProvider& operator=(HdrMetadataProvider&&) = default;
 
     void BuildExposureMap();
+    void BuildSetTable();
     void HandleDuplicateExposures();
+    uint8_t FindExposureIndex(uint8_t profile, uint32_t exposure) const;
+    HdrMetadata ProcessLookup(uint64_t frameNumber, uint8_t profile, uint8_t index,
+                              uint32_t actualExposureTime);
     void CalculateFrameOffset(uint64_t frameNumber, const ProfileInfo& previousProfile,
                              const ProfileInfo& newProfile, uint8_t sequenceIndex);
     std::pair<uint8_t, uint8_t> LookupExposure(uint32_t exposureTime) const;
     ProfileInfo& GetProfile(uint8_t profile);
     const ProfileInfo& GetProfile(uint8_t profile) const;
 
-    ProfileInfo _profile0;
-    ProfileInfo _profile1;
+    std::vector<ProfileInfo> _profiles;
     std::unordered_map<uint32_t, std::pair<uint8_t, uint8_t>> _exposureMap;
+    // sequencer set -> (profile, index)
+    std::vector<std::pair<uint8_t, uint8_t>> _setTable;
 
     uint8_t _lastProfile = 0;
     uint8_t _lastSequenceIndex = 0;
@@ -255,6 +255,124 @@ void test_mid_cycle_switches() {
     std::cout << "✓ Mid-cycle switches test passed" << std::endl;
 }
 
+void test_sequencer_set_lookup() {
+    std::cout << "Testing Sequencer Set Lookup..." << std::endl;
+
+    // Identical exposures in both profiles, told apart by the set index only
+    std::vector<uint32_t> profile0 = {100, 200};
+    std::vector<uint32_t> profile1 = {100, 200, 300};
+
+    auto provider = HdrMetadataProvider::CreateForSequencerSets(profile0, profile1);
+
+    auto meta = provider->ProcessFrameBySet(1, 0, 100);
+    assert(meta.MasterSequence == 1);
+    assert(meta.HdrProfile == 0);
+    assert(meta.ExposureSequenceIndex == 0);
+    assert(meta.ExposureCount == 2);
+    assert(meta.ExposureValue == 100);
+
+    meta = provider->ProcessFrameBySet(2, 1, 200);
+    assert(meta.MasterSequence == 1);
+    assert(meta.ExposureSequenceIndex == 1);
+
+    // Switch to profile 1, sets 2..4
+    meta = provider->ProcessFrameBySet(3, 2, 100);
+    assert(meta.MasterSequence == 2);
+    assert(meta.HdrProfile == 1);
+    assert(meta.ExposureSequenceIndex == 0);
+    assert(meta.ExposureCount == 3);
+    assert(meta.ExposureValue == 100);
+
+    meta = provider->ProcessFrameBySet(4, 3, 200);
+    assert(meta.MasterSequence == 2);
+    assert(meta.ExposureSequenceIndex == 1);
+
+    meta = provider->ProcessFrameBySet(5, 4, 300);
+    assert(meta.MasterSequence == 2);
+    assert(meta.ExposureSequenceIndex == 2);
+
+    // Switch back to profile 0
+    meta = provider->ProcessFrameBySet(6, 0, 100);
+    assert(meta.MasterSequence == 3);
+    assert(meta.HdrProfile == 0);
+
+    bool thrown = false;
+    try {
+        provider->ProcessFrameBySet(7, 5, 100);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "✓ Sequencer set lookup test passed" << std::endl;
+}
+
+void test_three_profiles() {
+    std::cout << "Testing Three Profiles..." << std::endl;
+
+    // Day, dusk and night programs sharing exposures
+    std::vector<std::vector<uint32_t>> profiles = {{19, 150}, {150, 350, 450}, {1000, 150}};
+    std::vector<std::vector<uint32_t>> adjusted;
+
+    auto provider = HdrMetadataProvider::Create(profiles, adjusted);
+    assert(provider->GetProfileCount() == 3);
+    assert(provider->GetProfileWindowSize(2) == 2);
+    assert(provider->GetProfileWindowSize(3) == 0);
+
+    assert(adjusted.size() == 3);
+    assert(adjusted[0][1] == 150);
+    assert(adjusted[1][0] == 151);  // 150 -> 151 (adjusted)
+    assert(adjusted[2][0] == 1000);
+    assert(adjusted[2][1] == 152);  // 150 -> 152, 151 taken by profile 1
+
+    auto meta = provider->ProcessFrame(1, 19);
+    assert(meta.MasterSequence == 1);
+    assert(meta.HdrProfile == 0);
+
+    meta = provider->ProcessFrame(2, 150);
+    assert(meta.MasterSequence == 1);
+    assert(meta.ExposureSequenceIndex == 1);
+
+    // Jump straight from profile 0 to profile 2
+    meta = provider->ProcessFrame(3, 1000);
+    assert(meta.MasterSequence == 2);
+    assert(meta.HdrProfile == 2);
+    assert(meta.ExposureCount == 2);
+
+    meta = provider->ProcessFrame(4, 152);
+    assert(meta.MasterSequence == 2);
+    assert(meta.ExposureSequenceIndex == 1);
+
+    // Then to profile 1
+    meta = provider->ProcessFrame(5, 151);
+    assert(meta.MasterSequence == 3);
+    assert(meta.HdrProfile == 1);
+    assert(meta.ExposureCount == 3);
+
+    meta = provider->ProcessFrame(6, 350);
+    meta = provider->ProcessFrame(7, 450);
+    assert(meta.MasterSequence == 3);
+    assert(meta.ExposureSequenceIndex == 2);
+
+    // Sequencer sets: profile 2 occupies sets 5 and 6
+    auto bySet = HdrMetadataProvider::CreateForSequencerSets(profiles);
+
+    meta = bySet->ProcessFrameBySet(1, 5, 1000);
+    assert(meta.HdrProfile == 2);
+    assert(meta.ExposureSequenceIndex == 0);
+
+    meta = bySet->ProcessFrameBySet(2, 6, 150);
+    assert(meta.HdrProfile == 2);
+    assert(meta.ExposureSequenceIndex == 1);
+    assert(meta.ExposureValue == 150);
+
+    meta = bySet->ProcessFrameBySet(3, 2, 150);
+    assert(meta.HdrProfile == 1);
+    assert(meta.ExposureSequenceIndex == 0);
+
+    std::cout << "✓ Three profiles test passed" << std::endl;
+}
+
 int main() {
     std::cout << "Running HDR Metadata Provider C++ Tests" << std::endl;
     std::cout << "========================================" << std::endl;
@@ -266,6 +384,8 @@ int main() {
         test_extensive_switching();
         test_extreme_gaps();
         test_mid_cycle_switches();
+        test_sequencer_set_lookup();
+        test_three_profiles();
 
         std::cout << "========================================" << std::endl;
         std::cout << "All tests passed successfully! ✓" << std::endl;
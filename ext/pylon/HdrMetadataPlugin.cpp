@@ -8,34 +8,60 @@
 #include <gst/gst.h>
 
 HdrMetadataPlugin::HdrMetadataPlugin()
-    : provider_(nullptr), is_configured_(FALSE) {
+    : provider_(nullptr), is_configured_(FALSE), by_sequencer_set_(FALSE) {
 }
 
 HdrMetadataPlugin::~HdrMetadataPlugin() = default;
 
 gboolean
-HdrMetadataPlugin::Configure(const std::vector<guint32>& profile0_exposures,
-                             const std::vector<guint32>& profile1_exposures,
-                             std::vector<guint32>& adjusted_profile0,
-                             std::vector<guint32>& adjusted_profile1) {
+HdrMetadataPlugin::Configure(const std::vector<std::vector<guint32>>& profile_exposures,
+                             std::vector<std::vector<guint32>>& adjusted_profiles) {
     try {
         // Convert guint32 vectors to uint32_t for the provider
-        std::vector<uint32_t> p0(profile0_exposures.begin(), profile0_exposures.end());
-        std::vector<uint32_t> p1(profile1_exposures.begin(), profile1_exposures.end());
-        std::vector<uint32_t> adj0, adj1;
+        std::vector<std::vector<uint32_t>> profiles;
+        std::vector<std::vector<uint32_t>> adjusted;
+        for (const auto& exposures : profile_exposures) {
+            profiles.emplace_back(exposures.begin(), exposures.end());
+        }
 
         // Create the provider
-        provider_ = HdrMetadata::HdrMetadataProvider::Create(p0, p1, adj0, adj1);
+        provider_ = HdrMetadata::HdrMetadataProvider::Create(profiles, adjusted);
 
         // Convert back to guint32
-        adjusted_profile0.assign(adj0.begin(), adj0.end());
-        adjusted_profile1.assign(adj1.begin(), adj1.end());
+        adjusted_profiles.clear();
+        for (const auto& exposures : adjusted) {
+            adjusted_profiles.emplace_back(exposures.begin(), exposures.end());
+        }
 
         is_configured_ = TRUE;
+        by_sequencer_set_ = FALSE;
 
-        GST_INFO("HDR metadata plugin configured with profiles: "
-                 "P0=%zu exposures, P1=%zu exposures",
-                 profile0_exposures.size(), profile1_exposures.size());
+        GST_INFO("HDR metadata plugin configured with %zu profiles",
+                 profile_exposures.size());
+
+        return TRUE;
+    } catch (const std::exception& e) {
+        GST_ERROR("Failed to configure HDR metadata: %s", e.what());
+        is_configured_ = FALSE;
+        return FALSE;
+    }
+}
+
+gboolean
+HdrMetadataPlugin::ConfigureSequencerSets(const std::vector<std::vector<guint32>>& profile_exposures) {
+    try {
+        std::vector<std::vector<uint32_t>> profiles;
+        for (const auto& exposures : profile_exposures) {
+            profiles.emplace_back(exposures.begin(), exposures.end());
+        }
+
+        provider_ = HdrMetadata::HdrMetadataProvider::CreateForSequencerSets(profiles);
+
+        is_configured_ = TRUE;
+        by_sequencer_set_ = TRUE;
+
+        GST_INFO("HDR metadata plugin configured for sequencer set lookup "
+                 "with %zu profiles", profile_exposures.size());
 
         return TRUE;
     } catch (const std::exception& e) {
@@ -61,36 +87,71 @@ HdrMetadataPlugin::ProcessAndAttachMetadata(GstBuffer* buffer,
 
     try {
         // Process the frame through the provider
-        auto hdr_meta = provider_->ProcessFrame(frame_number, exposure_time);
-
-        // Attach metadata to the buffer
-        GstHdrMeta* meta = gst_buffer_add_hdr_meta(
-            buffer,
-            hdr_meta.MasterSequence,
-            hdr_meta.ExposureSequenceIndex,
-            hdr_meta.ExposureCount,
-            hdr_meta.ExposureValue,
-            hdr_meta.HdrProfile
-        );
-
-        if (!meta) {
-            GST_ERROR("Failed to attach HDR metadata to buffer");
-            return FALSE;
-        }
+        return AttachMetadata(buffer, frame_number,
+                              provider_->ProcessFrame(frame_number, exposure_time));
+    } catch (const std::exception& e) {
+        GST_ERROR("Failed to process HDR metadata: %s", e.what());
+        return FALSE;
+    }
+}
+
+gboolean
+HdrMetadataPlugin::ProcessAndAttachMetadataBySet(GstBuffer* buffer,
+                                                  guint64 frame_number,
+                                                  guint32 sequencer_set,
+                                                  guint32 exposure_time) {
+    if (!is_configured_ || !provider_ || !by_sequencer_set_) {
+        GST_WARNING("HDR metadata plugin not configured for sequencer sets");
+        return FALSE;
+    }
 
-        GST_LOG("Attached HDR metadata: frame=%lu, master=%lu, profile=%d, "
-                "exp_idx=%d/%d, exp_value=%u",
-                frame_number, hdr_meta.MasterSequence, hdr_meta.HdrProfile,
-                hdr_meta.ExposureSequenceIndex, hdr_meta.ExposureCount,
-                hdr_meta.ExposureValue);
+    if (!buffer) {
+        GST_ERROR("Invalid buffer");
+        return FALSE;
+    }
 
-        return TRUE;
+    try {
+        return AttachMetadata(buffer, frame_number,
+                              provider_->ProcessFrameBySet(frame_number, sequencer_set,
+                                                           exposure_time));
     } catch (const std::exception& e) {
         GST_ERROR("Failed to process HDR metadata: %s", e.what());
         return FALSE;
     }
 }
 
+gboolean
+HdrMetadataPlugin::AttachMetadata(GstBuffer* buffer, guint64 frame_number,
+                                  const HdrMetadata::HdrMetadata& hdr_meta) {
+    // Attach metadata to the buffer
+    GstHdrMeta* meta = gst_buffer_add_hdr_meta(
+        buffer,
+        hdr_meta.MasterSequence,
+        hdr_meta.ExposureSequenceIndex,
+        hdr_meta.ExposureCount,
+        hdr_meta.ExposureValue,
+        hdr_meta.HdrProfile
+    );
+
+    if (!meta) {
+        GST_ERROR("Failed to attach HDR metadata to buffer");
+        return FALSE;
+    }
+
+    GST_LOG("Attached HDR metadata: frame=%lu, master=%lu, profile=%d, "
+            "exp_idx=%d/%d, exp_value=%u",
+            frame_number, hdr_meta.MasterSequence, hdr_meta.HdrProfile,
+            hdr_meta.ExposureSequenceIndex, hdr_meta.ExposureCount,
+            hdr_meta.ExposureValue);
+
+    return TRUE;
+}
+
+gboolean
+HdrMetadataPlugin::UsesSequencerSets() const {
+    return by_sequencer_set_;
+}
+
 gboolean
 HdrMetadataPlugin::IsConfigured() const {
     return is_configured_;
@@ -100,6 +161,7 @@ void
 HdrMetadataPlugin::Reset() {
     provider_.reset();
     is_configured_ = FALSE;
+    by_sequencer_set_ = FALSE;
     GST_INFO("HDR metadata plugin reset");
 }
 
@@ -111,6 +173,14 @@ HdrMetadataPlugin::GetCurrentProfile() const {
     return provider_->GetCurrentProfile();
 }
 
+gint
+HdrMetadataPlugin::GetProfileCount() const {
+    if (!is_configured_ || !provider_) {
+        return 0;
+    }
+    return provider_->GetProfileCount();
+}
+
 gint
 HdrMetadataPlugin::GetProfileWindowSize(gint profile) const {
     if (!is_configured_ || !provider_) {
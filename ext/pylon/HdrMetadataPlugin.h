@@ -14,6 +14,7 @@
 // Forward declaration to avoid including the full provider header
 namespace HdrMetadata {
     class HdrMetadataProvider;
+    struct HdrMetadata;
 }
 
 /**
@@ -34,16 +35,21 @@ public:
 
     /**
      * Configure HDR profiles
-     * @param profile0_exposures Exposure values for profile 0 in microseconds
-     * @param profile1_exposures Exposure values for profile 1 in microseconds
-     * @param adjusted_profile0 Output: Adjusted exposure values for profile 0
-     * @param adjusted_profile1 Output: Adjusted exposure values for profile 1 (with duplicates resolved)
+     * @param profile_exposures Exposure values of every profile in microseconds
+     * @param adjusted_profiles Output: Adjusted exposure values (with duplicates resolved)
      * @return TRUE on success
      */
-    gboolean Configure(const std::vector<guint32>& profile0_exposures,
-                       const std::vector<guint32>& profile1_exposures,
-                       std::vector<guint32>& adjusted_profile0,
-                       std::vector<guint32>& adjusted_profile1);
+    gboolean Configure(const std::vector<std::vector<guint32>>& profile_exposures,
+                       std::vector<std::vector<guint32>>& adjusted_profiles);
+
+    /**
+     * Configure HDR profiles for frames identified by their sequencer set
+     * (ChunkSequencerSetActive). Exposures are kept as given, so identical
+     * exposures with different gains are supported.
+     * @param profile_exposures Exposure values of every profile in microseconds
+     * @return TRUE on success
+     */
+    gboolean ConfigureSequencerSets(const std::vector<std::vector<guint32>>& profile_exposures);
 
     /**
      * Process frame and attach HDR metadata to buffer
@@ -56,6 +62,25 @@ public:
                                       guint64 frame_number,
                                       guint32 exposure_time);
 
+    /**
+     * Process frame identified by its sequencer set and attach HDR metadata
+     * @param buffer GStreamer buffer to attach metadata to
+     * @param frame_number Frame number from camera
+     * @param sequencer_set Active sequencer set (from chunk data)
+     * @param exposure_time Actual exposure time in microseconds, informative only
+     * @return TRUE if metadata was attached, FALSE on error
+     */
+    gboolean ProcessAndAttachMetadataBySet(GstBuffer* buffer,
+                                           guint64 frame_number,
+                                           guint32 sequencer_set,
+                                           guint32 exposure_time);
+
+    /**
+     * Check if frames are identified by their sequencer set
+     * @return TRUE if configured with ConfigureSequencerSets
+     */
+    gboolean UsesSequencerSets() const;
+
     /**
      * Check if HDR is configured
      * @return TRUE if configured
@@ -69,13 +94,19 @@ public:
 
     /**
      * Get current HDR profile
-     * @return Current profile (0 or 1), or -1 if not configured
+     * @return Current profile, or -1 if not configured
      */
     gint GetCurrentProfile() const;
 
+    /**
+     * Get number of configured profiles
+     * @return Profile count, 0 if not configured
+     */
+    gint GetProfileCount() const;
+
     /**
      * Get window size for a profile
-     * @param profile Profile number (0 or 1)
+     * @param profile Profile number
      * @return Window size (number of exposures)
      */
     gint GetProfileWindowSize(gint profile) const;
@@ -83,6 +114,10 @@ public:
 private:
     std::unique_ptr<HdrMetadata::HdrMetadataProvider> provider_;
     gboolean is_configured_;
+    gboolean by_sequencer_set_;
+
+    gboolean AttachMetadata(GstBuffer* buffer, guint64 frame_number,
+                            const HdrMetadata::HdrMetadata& hdr_meta);
 };
 
 #endif // HDR_METADATA_PLUGIN_H
\ No newline at end of file
@@ -95,19 +95,19 @@ hdr_metadata_plugin_configure(HdrMetadataPlugin* plugin,
         std::vector<guint32> profile1_exposures = parse_exposure_sequence(hdr_sequence1);
 
         // Configure the plugin
-        std::vector<guint32> adjusted0, adjusted1;
+        std::vector<std::vector<guint32>> adjusted;
         auto* cpp_plugin = reinterpret_cast<::HdrMetadataPlugin*>(plugin);
-        gboolean result = cpp_plugin->Configure(profile0_exposures, profile1_exposures,
-                                           adjusted0, adjusted1);
+        gboolean result = cpp_plugin->Configure({profile0_exposures, profile1_exposures},
+                                                adjusted);
 
         if (result) {
             // Convert adjusted sequences back to strings
             if (adjusted_sequence0) {
-                *adjusted_sequence0 = format_exposure_sequence(adjusted0);
+                *adjusted_sequence0 = format_exposure_sequence(adjusted[0]);
             }
 
             if (adjusted_sequence1) {
-                *adjusted_sequence1 = format_exposure_sequence(adjusted1);
+                *adjusted_sequence1 = format_exposure_sequence(adjusted[1]);
             }
         } else if (error) {
             *error = g_strdup("Failed to configure HDR plugin");
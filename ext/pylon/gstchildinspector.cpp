@@ -239,9 +239,8 @@ static gchar *gst_child_inspector_type_to_string(GParamSpec *pspec,
   return to_string;
 }
 
-gchar *gst_child_inspector_property_to_string(GObject *object,
-                                              GParamSpec *param,
-                                              guint alignment) {
+static gchar *gst_child_inspector_param_spec_to_string(GParamSpec *param,
+                                                      guint alignment) {
   GValue value G_VALUE_INIT;
   const gchar *name = NULL;
   const gchar *blurb = NULL;
@@ -250,7 +249,6 @@ gchar *gst_child_inspector_property_to_string(GObject *object,
   gchar *prop = NULL;
 
   g_return_val_if_fail(param, NULL);
-  g_return_val_if_fail(G_IS_OBJECT(object), NULL);
 
   name = g_param_spec_get_name(param);
   blurb = g_param_spec_get_blurb(param);
@@ -276,14 +274,39 @@ gchar *gst_child_inspector_property_to_string(GObject *object,
   return prop;
 }
 
-gchar *gst_child_inspector_properties_to_string(GObject *object,
-                                                guint alignment, gchar *title) {
-  GParamSpec **property_specs = NULL;
-  guint num_properties = 0, i = 0;
+gchar *gst_child_inspector_property_to_string(GObject *object,
+                                              GParamSpec *param,
+                                              guint alignment) {
+  g_return_val_if_fail(G_IS_OBJECT(object), NULL);
+
+  return gst_child_inspector_param_spec_to_string(param, alignment);
+}
+
+gchar *gst_child_inspector_param_specs_to_string(GParamSpec **specs,
+                                                 guint n_specs,
+                                                 guint alignment,
+                                                 const gchar *title) {
   GString *props = NULL;
   gchar *prop = NULL;
+  guint i = 0;
 
-  gchar *props_ = NULL;
+  g_return_val_if_fail(specs || 0 == n_specs, NULL);
+
+  props = g_string_new(title);
+  for (i = 0; i < n_specs; i++) {
+    prop = gst_child_inspector_param_spec_to_string(specs[i], alignment);
+    g_string_append_printf(props, "\n%s", prop);
+    g_free(prop);
+  }
+
+  return g_string_free(props, FALSE);
+}
+
+gchar *gst_child_inspector_properties_to_string(GObject *object,
+                                                guint alignment, gchar *title) {
+  GParamSpec **property_specs = NULL;
+  guint num_properties = 0;
+  gchar *props = NULL;
 
   g_return_val_if_fail(G_IS_OBJECT(object), NULL);
 
@@ -292,15 +315,9 @@ gchar *gst_child_inspector_properties_to_string(GObject *object,
   property_specs = g_object_class_list_properties(G_OBJECT_GET_CLASS(object),
                                                   &num_properties);
 
-  props = g_string_new(title);
-  for (i = 0; i < num_properties; i++) {
-    prop = gst_child_inspector_property_to_string(object, property_specs[i],
-                                                  alignment);
-    g_string_append_printf(props, "\n%s", prop);
-    g_free(prop);
-  }
+  props = gst_child_inspector_param_specs_to_string(
+      property_specs, num_properties, alignment, title);
 
   g_free(property_specs);
-  props_ = g_string_free(props, FALSE);
-  return props_;
+  return props;
 }
@@ -40,5 +40,9 @@ gchar *gst_child_inspector_property_to_string(GObject *object,
                                               guint alignment);
 gchar *gst_child_inspector_properties_to_string(GObject *object,
                                                 guint alignment, gchar *title);
+gchar *gst_child_inspector_param_specs_to_string(GParamSpec **specs,
+                                                 guint n_specs,
+                                                 guint alignment,
+                                                 const gchar *title);
 
 #endif /* __GST_CHILD_INSPECTOR_H__ */
@@ -19,6 +19,7 @@ gst_hdr_meta_init (GstMeta *meta, gpointer params, GstBuffer *buffer)
     hdr_meta->exposure_count = 0;
     hdr_meta->exposure_value = 0;
     hdr_meta->hdr_profile = 0;
+    hdr_meta->exposure_generation = 0;
 
     return TRUE;
 }
@@ -47,6 +48,8 @@ gst_hdr_meta_transform (GstBuffer *dest, GstMeta *meta,
 
         if (!dest_meta)
             return FALSE;
+
+        dest_meta->exposure_generation = src_meta->exposure_generation;
     } else {
         /* Don't transform for other types (subset, etc.) */
         return FALSE;
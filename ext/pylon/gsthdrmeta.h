@@ -24,6 +24,8 @@ typedef struct _GstHdrMeta GstHdrMeta;
  * @exposure_count: Total number of exposures in current HDR profile
  * @exposure_value: Actual exposure time in microseconds
  * @hdr_profile: Current HDR profile (0 or 1)
+ * @exposure_generation: Number of HDR auto exposure adjustments in the
+ *   exposures programmed for this frame, 0 while the exposures are static
  *
  * HDR metadata for tracking exposure sequences in multi-exposure HDR imaging.
  * This metadata is plugin-independent and can be used by any source element.
@@ -36,6 +38,7 @@ struct _GstHdrMeta {
     guint8  exposure_count;
     guint32 exposure_value;
     guint8  hdr_profile;
+    guint32 exposure_generation;
 };
 
 GType gst_hdr_meta_api_get_type (void);
@@ -47,11 +47,24 @@
 #include "gst/pylon/gstpylonobject.h"
 #include "gstchildinspector.h"
 #include "gstpylon.h"
+#include "gstpylondebayer.h"
 #include "gstpylondisconnecthandler.h"
+#include "gstpyloneventhandler.h"
 #include "gstpylonimagehandler.h"
+#include "gstpylonsequencerprogram.h"
 #include "gstpylonsysmembufferfactory.h"
+#include "gstpylonunpack.h"
+#include "gstpylonworkerpool.h"
+#include "gstpylonyuvconvert.h"
 
+#include <gst/video/video.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 /* retry open camera limits in case of collision with other
@@ -64,6 +77,10 @@ constexpr int FAILED_OPEN_RETRY_WAIT_TIME_MS = 1000;
 typedef struct {
   const std::string st_name;
   std::vector<PixelFormatMappingType> format_map;
+  /* the camera delivers a different format, converted on the host */
+  bool converted;
+  /* fixed colorimetry of the output, NULL to leave it to the caps */
+  const gchar *colorimetry;
 } GstStPixelFormats;
 
 typedef enum {
@@ -80,6 +97,13 @@ static std::string gst_pylon_get_camera_fullname(
 static std::string gst_pylon_get_sgrabber_name(
     Pylon::CBaslerUniversalInstantCamera &camera);
 static void free_ptr_grab_result(gpointer data);
+static gboolean gst_pylon_is_converting(GstPylon *self);
+static void gst_pylon_release_converted_buffers(GstPylon *self);
+static GstBuffer *gst_pylon_acquire_converted_buffer(GstPylon *self,
+                                                     gsize size);
+static gsize gst_pylon_convert_result(
+    GstPylon *self, GstBuffer **buf,
+    Pylon::CBaslerUniversalGrabResultPtr *grab_result_ptr);
 static void gst_pylon_query_format(
     GstPylon *self, GValue *outvalue,
     const std::vector<PixelFormatMappingType> &pixel_format_mapping);
@@ -91,6 +115,10 @@ static void gst_pylon_query_framerate(GstPylon *self, GValue *outvalue);
 static void gst_pylon_query_caps(
     GstPylon *self, GstStructure *st,
     const std::vector<PixelFormatMappingType> &pixel_format_mapping);
+static bool gst_pylon_set_scaling(GstPylon *self, const std::string &feature,
+                                  gint64 factor);
+static void gst_pylon_query_scalings(GstPylon *self);
+static void gst_pylon_apply_scaling(GstPylon *self, gint width, gint height);
 static void gst_pylon_add_result_meta(
     GstPylon *self, GstBuffer *buf,
     Pylon::CBaslerUniversalGrabResultPtr &grab_result_ptr);
@@ -103,27 +131,210 @@ static std::vector<std::string> gst_pylon_pfnc_to_gst(
 static std::vector<std::string> gst_pylon_pfnc_list_to_gst(
     const GenApi::StringList_t &genapi_formats,
     const std::vector<PixelFormatMappingType> &pixel_format_mapping);
-static void gst_pylon_append_properties(
-    Pylon::CBaslerUniversalInstantCamera *camera,
-    const std::string &device_full_name, const std::string &device_type_str,
-    GstPylonCache &feature_cache, GenApi::INodeMap &nodemap,
-    gchar **device_properties, guint alignment);
-static void gst_pylon_append_camera_properties(
-    Pylon::CBaslerUniversalInstantCamera *camera, gchar **camera_properties,
-    guint alignment);
-static void gst_pylon_append_stream_grabber_properties(
-    Pylon::CBaslerUniversalInstantCamera *camera, gchar **sgrabber_properties,
-    guint alignment);
-typedef void (*GetStringProperties)(Pylon::CBaslerUniversalInstantCamera *,
-                                    gchar **, guint);
-static gchar *gst_pylon_get_string_properties(
-    GetStringProperties get_device_string_properties);
+static gchar *gst_pylon_get_cached_string_properties(
+    const gchar *name_suffix, const gchar *device_type_str);
 
 static constexpr gint DEFAULT_ALIGNMENT = 35;
 
 // Default trigger source for HDR sequencer transitions
 static constexpr const char* HDR_SEQUENCER_TRIGGER = "ExposureActive";
 
+/* Streams register writes to the camera in a single batch instead of one
+ * transaction per write, on cameras supporting it. Feature reads are not
+ * reliable while streaming, so everything has to be read before. */
+class GstPylonRegisterStreaming {
+ public:
+  explicit GstPylonRegisterStreaming(
+      Pylon::CBaslerUniversalInstantCamera &camera)
+      : camera(camera) {
+    active = camera.DeviceRegistersStreamingStart.TryExecute();
+    GST_DEBUG("Register streaming %s", active ? "started" : "not supported");
+  }
+
+  ~GstPylonRegisterStreaming() {
+    /* error path, the writes are already lost */
+    if (active) {
+      try {
+        camera.DeviceRegistersStreamingEnd.TryExecute();
+      } catch (const Pylon::GenericException &) {
+      }
+    }
+  }
+
+  GstPylonRegisterStreaming(const GstPylonRegisterStreaming &) = delete;
+  GstPylonRegisterStreaming &operator=(const GstPylonRegisterStreaming &) =
+      delete;
+
+  /* transfers the batch, throws if the camera rejects it */
+  void End() {
+    if (active) {
+      active = false;
+      camera.DeviceRegistersStreamingEnd.Execute();
+    }
+  }
+
+ private:
+  Pylon::CBaslerUniversalInstantCamera &camera;
+  bool active;
+};
+
+/* Binning and decimation reduce the resolution of the whole sensor */
+static const char *const scaling_features[] = {"Binning", "Decimation"};
+
+/* Features an HDR sequence copies into every sequencer set besides the frame
+ * layout */
+static const std::vector<std::string> hdr_sequenced_features = {
+    "ExposureTime", "ExposureTimeAbs", "Gain", "GainRaw"};
+
+/* Forgets the programming the sequencer sets hold when a feature copied into
+ * them is written or invalidated outside of the programming, e.g. through a
+ * property. The frame layout is part of the programming hash instead. */
+class GstPylonSequencerWatch {
+ public:
+  explicit GstPylonSequencerWatch(std::atomic<std::size_t> &hash)
+      : hash(hash) {}
+
+  GstPylonSequencerWatch(const GstPylonSequencerWatch &) = delete;
+  GstPylonSequencerWatch &operator=(const GstPylonSequencerWatch &) = delete;
+
+  /* replaces the watched features, missing ones are skipped */
+  void Watch(GenApi::INodeMap &nodemap,
+             const std::vector<std::string> &features) {
+    Release();
+
+    for (const auto &feature : features) {
+      GenApi::INode *node = nodemap.GetNode(feature.c_str());
+
+      if (node && callbacks.find(node) == callbacks.end()) {
+        callbacks[node] = GenApi::Register(
+            node, *this, &GstPylonSequencerWatch::OnNodeChanged);
+      }
+    }
+  }
+
+  /* has to run before the nodemap is destroyed */
+  void Release() {
+    for (const auto &callback : callbacks) {
+      callback.first->DeregisterCallback(callback.second);
+    }
+    callbacks.clear();
+  }
+
+ private:
+  void OnNodeChanged(GenApi::INode *node) {
+    if (0 != hash.exchange(0)) {
+      GST_DEBUG("%s changed, the sequencer sets will be programmed again",
+                node->GetName().c_str());
+    }
+  }
+
+  std::atomic<std::size_t> &hash;
+  std::map<GenApi::INode *, GenApi::CallbackHandleType> callbacks;
+};
+
+/* A full field of view read out at a reduced resolution */
+typedef struct {
+  std::string feature;
+  gint64 factor;
+  gint width;
+  gint height;
+} GstPylonScaling;
+
+/* Switches binning and decimation off for as long as it lives, to query
+ * the full resolution geometry, and restores them along with the frame
+ * size they may have clamped. Cameras that are grabbing are left alone. */
+class GstPylonFullResolution {
+ public:
+  explicit GstPylonFullResolution(Pylon::CBaslerUniversalInstantCamera &camera)
+      : camera(camera) {
+    try {
+      if (camera.IsGrabbing()) {
+        return;
+      }
+
+      GenApi::INodeMap &nodemap = camera.GetNodeMap();
+      width = camera.Width.GetValue();
+      height = camera.Height.GetValue();
+      active = true;
+
+      for (const auto &feature : scaling_features) {
+        for (const auto &direction : {"Horizontal", "Vertical"}) {
+          const std::string name = std::string(feature) + direction;
+          Pylon::CIntegerParameter param(nodemap, name.c_str());
+
+          if (param.IsWritable() && 1 != param.GetValue()) {
+            factors.emplace_back(name, param.GetValue());
+            param.TrySetValue(1);
+          }
+        }
+      }
+    } catch (const Pylon::GenericException &e) {
+      GST_WARNING("Failed to switch binning and decimation off: %s",
+                  e.GetDescription());
+    }
+  }
+
+  ~GstPylonFullResolution() {
+    if (!active) {
+      return;
+    }
+
+    try {
+      GenApi::INodeMap &nodemap = camera.GetNodeMap();
+
+      for (const auto &factor : factors) {
+        Pylon::CIntegerParameter(nodemap, factor.first.c_str())
+            .TrySetValue(factor.second);
+      }
+      camera.Width.TrySetValue(width);
+      camera.Height.TrySetValue(height);
+    } catch (const Pylon::GenericException &e) {
+      GST_WARNING("Failed to restore binning and decimation: %s",
+                  e.GetDescription());
+    }
+  }
+
+  GstPylonFullResolution(const GstPylonFullResolution &) = delete;
+  GstPylonFullResolution &operator=(const GstPylonFullResolution &) = delete;
+
+ private:
+  Pylon::CBaslerUniversalInstantCamera &camera;
+  std::vector<std::pair<std::string, gint64>> factors;
+  gint64 width = 0;
+  gint64 height = 0;
+  bool active = false;
+};
+
+/* Multiple ROI reads a grid of column and row ranges and stitches their
+ * intersections into one frame. ace uses the first naming, ace 2 and dart 2
+ * the second. */
+typedef struct {
+  const char *enable;
+  const char *selector;
+  const char *offset;
+  const char *size;
+} GstPylonRoiAxis;
+
+static const std::vector<GstPylonRoiAxis> roi_columns = {
+    {"ROIColumnsEnable", "ROIColumnIndex", "ROIColumnOffset", "ROIColumnSize"},
+    {"BslMultipleROIColumnsEnable", "BslMultipleROIColumnSelector",
+     "BslMultipleROIColumnOffset", "BslMultipleROIColumnSize"}};
+
+static const std::vector<GstPylonRoiAxis> roi_rows = {
+    {"ROIRowsEnable", "ROIRowIndex", "ROIRowOffset", "ROIRowSize"},
+    {"BslMultipleROIRowsEnable", "BslMultipleROIRowSelector",
+     "BslMultipleROIRowOffset", "BslMultipleROIRowSize"}};
+
+/* A region on the sensor and where it lands in the stitched frame */
+typedef struct {
+  gint x;
+  gint y;
+  gint width;
+  gint height;
+  gint frame_x;
+  gint frame_y;
+} GstPylonRoi;
+
 struct _GstPylon {
   GstElement *gstpylonsrc;
   std::shared_ptr<Pylon::CBaslerUniversalInstantCamera> camera =
@@ -132,14 +343,49 @@ struct _GstPylon {
   GObject *gstream_grabber;
   GstPylonImageHandler image_handler;
   GstPylonDisconnectHandler disconnect_handler;
+  GstPylonEventHandler event_handler;
 
   std::shared_ptr<GstPylonBufferFactory> buffer_factory;
   GstPylonMemoryTypeEnum mem_type;
 
+  /* prefer packed pixel formats over their unpacked equivalents */
+  gboolean packed_formats = FALSE;
+  /* expands the packed format negotiated, if any, to 16-bit samples */
+  GstPylonUnpack unpack;
+  /* demosaics the Bayer format negotiated for a video/x-raw format, if any */
+  GstPylonDebayer debayer;
+  /* subsamples the format negotiated for NV12 or I420, if any, to the plane
+   * layout of convert_info */
+  GstPylonYuvConvert yuv_convert;
+  GstVideoInfo convert_info;
+  /* shared by the conversions, created on first use */
+  std::unique_ptr<GstPylonWorkerPool> convert_pool;
+  /* output buffers of the conversions, sized on the first frame */
+  GstBufferPool *convert_buffers = NULL;
+
   std::string requested_device_user_name;
   std::string requested_device_serial_number;
   gint requested_device_index;
 
+  /* first sequencer set of every programmed profile, empty when not in HDR
+   * mode */
+  std::vector<guint> hdr_profile_sets;
+  /* what the sequencer sets currently hold, 0 if unknown. Not kept across
+   * opening the camera, other applications may reprogram it meanwhile. */
+  std::atomic<std::size_t> sequencer_hash{0};
+  GstPylonSequencerWatch sequencer_watch{sequencer_hash};
+
+  /* full frame sizes at the binning and decimation factors supported */
+  std::vector<GstPylonScaling> scalings;
+  /* binning or decimation was set for the negotiated size */
+  bool scaling_applied = false;
+
+  /* regions of the multiple ROI readout, empty when it is not configured */
+  std::vector<GstPylonRoi> rois;
+  /* size of the stitched frame */
+  gint roi_width = 0;
+  gint roi_height = 0;
+
 #ifdef NVMM_ENABLED
   GstPylonNvsurfaceLayoutEnum nvsurface_layout;
   guint gpu_id;
@@ -149,9 +395,13 @@ struct _GstPylon {
 using GrabResultPair = std::pair<std::shared_ptr<GstPylonBufferFactory>,
                                  Pylon::CBaslerUniversalGrabResultPtr *>;
 
+/* native formats first, a format the camera delivers is never converted */
 static const std::vector<GstStPixelFormats> gst_structure_formats = {
-    {"video/x-raw", pixel_format_mapping_raw},
-    {"video/x-bayer", pixel_format_mapping_bayer}};
+    {"video/x-raw", pixel_format_mapping_raw, false, NULL},
+    {"video/x-bayer", pixel_format_mapping_bayer, false, NULL},
+    {"video/x-raw", pixel_format_mapping_debayer, true, NULL},
+    /* the matrix of the RGB conversion, Basler cameras encode YUV alike */
+    {"video/x-raw", pixel_format_mapping_yuv, true, "bt601"}};
 
 static std::string gst_pylon_get_camera_fullname(
     Pylon::CBaslerUniversalInstantCamera &camera) {
@@ -204,6 +454,9 @@ static void gst_pylon_apply_set(GstPylon *self, std::string &set) {
   }
 
   self->camera->UserSetLoad.Execute();
+
+  /* the user set brings its own sequencer sets */
+  self->sequencer_hash = 0;
 }
 
 GstPylon *gst_pylon_new(GstElement *gstpylonsrc, const gchar *device_user_name,
@@ -312,12 +565,14 @@ GstPylon *gst_pylon_new(GstElement *gstpylonsrc, const gchar *device_user_name,
     GenApi::INodeMap &cam_nodemap = self->camera->GetNodeMap();
     self->gcamera = gst_pylon_object_new(
         self->camera, gst_pylon_get_camera_fullname(*self->camera),
+        gst_pylon_object_get_camera_cache_name(*self->camera),
         &cam_nodemap, enable_correction);
 
     GenApi::INodeMap &sgrabber_nodemap =
         self->camera->GetStreamGrabberNodeMap();
     self->gstream_grabber = gst_pylon_object_new(
         self->camera, gst_pylon_get_sgrabber_name(*self->camera),
+        gst_pylon_object_get_sgrabber_cache_name(*self->camera),
         &sgrabber_nodemap, enable_correction);
 
     /* Register event handlers after device instances are requested so they do
@@ -329,6 +584,7 @@ GstPylon *gst_pylon_new(GstElement *gstpylonsrc, const gchar *device_user_name,
     self->camera->RegisterConfiguration(&self->disconnect_handler,
                                         Pylon::RegistrationMode_Append,
                                         Pylon::Cleanup_None);
+    self->event_handler.SetData(self->gstpylonsrc);
     self->mem_type = MEM_SYSMEM;
 
 #ifdef NVMM_ENABLED
@@ -399,6 +655,8 @@ gboolean gst_pylon_set_pfs_config(GstPylon *self, const gchar *pfs_location,
   try {
     Pylon::CFeaturePersistence::Load(pfs_location, &self->camera->GetNodeMap(),
                                      check_nodemap_sanity);
+    /* the feature file may contain sequencer sets */
+    self->sequencer_hash = 0;
   } catch (const Pylon::GenericException &e) {
     g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_FAILED,
                 "PFS file error: %s", e.GetDescription());
@@ -408,6 +666,370 @@ gboolean gst_pylon_set_pfs_config(GstPylon *self, const gchar *pfs_location,
   return TRUE;
 }
 
+gboolean gst_pylon_configure_events(GstPylon *self, const gchar *events,
+                                    GError **err) {
+  g_return_val_if_fail(self, FALSE);
+  g_return_val_if_fail(events, FALSE);
+  g_return_val_if_fail(err && *err == NULL, FALSE);
+
+  std::vector<std::string> names;
+  gchar **tokens = g_strsplit(events, ",", -1);
+  for (gchar **token = tokens; *token; token++) {
+    g_strstrip(*token);
+    if (**token) {
+      names.push_back(*token);
+    }
+  }
+  g_strfreev(tokens);
+
+  try {
+    self->event_handler.Configure(*self->camera, names);
+  } catch (const Pylon::GenericException &e) {
+    g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
+                "Camera event configuration error: %s", e.GetDescription());
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/* Parses regions given as "x,y,width,height" separated by ';' */
+static std::vector<GstPylonRoi> gst_pylon_parse_rois(const gchar *rois) {
+  std::vector<GstPylonRoi> regions;
+  std::string error_msg;
+
+  gchar **tokens = g_strsplit(rois, ";", -1);
+  for (gchar **token = tokens; *token; token++) {
+    g_strstrip(*token);
+    if (!**token) {
+      continue;
+    }
+
+    GstPylonRoi roi = {0, 0, 0, 0, 0, 0};
+    gchar trailing = '\0';
+    if (4 != sscanf(*token, " %d , %d , %d , %d %c", &roi.x, &roi.y,
+                    &roi.width, &roi.height, &trailing) ||
+        roi.x < 0 || roi.y < 0 || roi.width <= 0 || roi.height <= 0) {
+      error_msg = std::string("Invalid region \"") + *token +
+                  "\", expected x,y,width,height";
+      break;
+    }
+    regions.push_back(roi);
+  }
+  g_strfreev(tokens);
+
+  if (!error_msg.empty()) {
+    throw Pylon::GenericException(error_msg.c_str(), __FILE__, __LINE__);
+  }
+
+  return regions;
+}
+
+/* The distinct (offset, size) ranges of the regions along one axis in
+ * sensor order. The camera reads every range completely, so ranges must
+ * either match or be disjoint. */
+static std::vector<std::pair<gint, gint>> gst_pylon_roi_ranges(
+    const std::vector<GstPylonRoi> &regions, bool columns) {
+  std::vector<std::pair<gint, gint>> ranges;
+
+  for (const auto &roi : regions) {
+    ranges.emplace_back(columns ? roi.x : roi.y,
+                        columns ? roi.width : roi.height);
+  }
+  std::sort(ranges.begin(), ranges.end());
+  ranges.erase(std::unique(ranges.begin(), ranges.end()), ranges.end());
+
+  for (std::size_t i = 1; i < ranges.size(); i++) {
+    if (ranges[i - 1].first + ranges[i - 1].second > ranges[i].first) {
+      std::string msg = std::string("Overlapping region ") +
+                        (columns ? "columns " : "rows ") +
+                        std::to_string(ranges[i - 1].first) + "+" +
+                        std::to_string(ranges[i - 1].second) + " and " +
+                        std::to_string(ranges[i].first) + "+" +
+                        std::to_string(ranges[i].second);
+      throw Pylon::GenericException(msg.c_str(), __FILE__, __LINE__);
+    }
+  }
+
+  return ranges;
+}
+
+static const GstPylonRoiAxis *gst_pylon_find_roi_axis(
+    GenApi::INodeMap &nodemap, const std::vector<GstPylonRoiAxis> &axes) {
+  for (const auto &axis : axes) {
+    if (Pylon::CBooleanParameter(nodemap, axis.enable).IsWritable()) {
+      return &axis;
+    }
+  }
+
+  return NULL;
+}
+
+/* Programs one range per selector entry, in the order of the entries */
+static void gst_pylon_set_roi_axis(
+    GenApi::INodeMap &nodemap, const GstPylonRoiAxis &axis,
+    const std::vector<std::pair<gint, gint>> &ranges) {
+  GenApi::INode *selector = nodemap.GetNode(axis.selector);
+  Pylon::CIntegerParameter offset(nodemap, axis.offset);
+  Pylon::CIntegerParameter size(nodemap, axis.size);
+
+  if (!selector) {
+    throw Pylon::GenericException(
+        (std::string("Missing feature ") + axis.selector).c_str(), __FILE__,
+        __LINE__);
+  }
+
+  Pylon::CBooleanParameter(nodemap, axis.enable).SetValue(true);
+
+  std::vector<gint64> entries;
+  bool is_enum =
+      GenApi::intfIEnumeration == selector->GetPrincipalInterfaceType();
+  if (is_enum) {
+    GenApi::NodeList_t enum_entries;
+    Pylon::CEnumParameter(selector).GetEntries(enum_entries);
+    for (const auto &e : enum_entries) {
+      if (GenApi::IsAvailable(e)) {
+        entries.push_back(dynamic_cast<GenApi::IEnumEntry *>(e)->GetValue());
+      }
+    }
+  } else {
+    Pylon::CIntegerParameter index(selector);
+    const gint64 inc = std::max<gint64>(1, index.GetInc());
+    for (gint64 i = index.GetMin(); i <= index.GetMax(); i += inc) {
+      entries.push_back(i);
+    }
+  }
+
+  if (entries.size() < ranges.size()) {
+    std::string msg = std::string(axis.selector) + " supports " +
+                      std::to_string(entries.size()) + " ranges, " +
+                      std::to_string(ranges.size()) + " requested";
+    throw Pylon::GenericException(msg.c_str(), __FILE__, __LINE__);
+  }
+
+  for (std::size_t i = 0; i < entries.size(); i++) {
+    if (is_enum) {
+      Pylon::CEnumParameter(selector).SetIntValue(entries[i]);
+    } else {
+      Pylon::CIntegerParameter(selector).SetValue(entries[i]);
+    }
+
+    /* ranges left over from an earlier configuration are shrunk as far as
+     * the camera allows, the frame size check catches any that remain */
+    if (i >= ranges.size()) {
+      if (!size.TrySetValue(0)) {
+        size.TrySetToMinimum();
+      }
+      GST_INFO("Cleared Feature %s %" G_GINT64_FORMAT, axis.selector,
+               entries[i]);
+      continue;
+    }
+
+    /* the previous range may keep the new offset out of bounds */
+    size.TrySetToMinimum();
+    offset.SetValue(ranges[i].first, Pylon::IntegerValueCorrection_None);
+    size.SetValue(ranges[i].second, Pylon::IntegerValueCorrection_None);
+    GST_INFO("Set Feature %s %" G_GINT64_FORMAT ": %s %d, %s %d",
+             axis.selector, entries[i], axis.offset, ranges[i].first,
+             axis.size, ranges[i].second);
+  }
+}
+
+gboolean gst_pylon_configure_rois(GstPylon *self, const gchar *rois,
+                                  GError **err) {
+  g_return_val_if_fail(self, FALSE);
+  g_return_val_if_fail(rois, FALSE);
+  g_return_val_if_fail(err && *err == NULL, FALSE);
+
+  GenApi::INodeMap &nodemap = self->camera->GetNodeMap();
+
+  self->rois.clear();
+  self->roi_width = 0;
+  self->roi_height = 0;
+
+  try {
+    std::vector<GstPylonRoi> regions = gst_pylon_parse_rois(rois);
+    const GstPylonRoiAxis *columns =
+        gst_pylon_find_roi_axis(nodemap, roi_columns);
+    const GstPylonRoiAxis *rows = gst_pylon_find_roi_axis(nodemap, roi_rows);
+
+    if (regions.empty()) {
+      if (columns) {
+        Pylon::CBooleanParameter(nodemap, columns->enable).TrySetValue(false);
+      }
+      if (rows) {
+        Pylon::CBooleanParameter(nodemap, rows->enable).TrySetValue(false);
+      }
+      return TRUE;
+    }
+
+    if (!columns || !rows) {
+      throw Pylon::GenericException(
+          "The camera does not support multiple ROI", __FILE__, __LINE__);
+    }
+
+    std::vector<std::pair<gint, gint>> column_ranges =
+        gst_pylon_roi_ranges(regions, true);
+    std::vector<std::pair<gint, gint>> row_ranges =
+        gst_pylon_roi_ranges(regions, false);
+
+    gst_pylon_set_roi_axis(nodemap, *columns, column_ranges);
+    gst_pylon_set_roi_axis(nodemap, *rows, row_ranges);
+
+    /* ranges are stitched in sensor order */
+    for (auto &roi : regions) {
+      for (const auto &range : column_ranges) {
+        roi.frame_x += range.first < roi.x ? range.second : 0;
+      }
+      for (const auto &range : row_ranges) {
+        roi.frame_y += range.first < roi.y ? range.second : 0;
+      }
+    }
+    for (const auto &range : column_ranges) {
+      self->roi_width += range.second;
+    }
+    for (const auto &range : row_ranges) {
+      self->roi_height += range.second;
+    }
+
+    /* the stitched offsets above are only valid if the camera reads exactly
+     * the requested ranges */
+    if (self->camera->Width.GetValue() != self->roi_width ||
+        self->camera->Height.GetValue() != self->roi_height) {
+      std::string msg =
+          "Camera reports a " + std::to_string(self->camera->Width.GetValue()) +
+          "x" + std::to_string(self->camera->Height.GetValue()) +
+          " frame for " + std::to_string(self->roi_width) + "x" +
+          std::to_string(self->roi_height) + " of regions";
+      throw Pylon::GenericException(msg.c_str(), __FILE__, __LINE__);
+    }
+
+    self->rois = regions;
+  } catch (const Pylon::GenericException &e) {
+    self->roi_width = 0;
+    self->roi_height = 0;
+    g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
+                "Multiple ROI configuration error: %s", e.GetDescription());
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/* Where the frames are read from the sensor, sequencer sets may change it */
+static const std::vector<std::string> frame_offset_features = {"OffsetX",
+                                                               "OffsetY"};
+
+/* Features fixing the layout of the negotiated frames, every sequencer set
+ * has to keep them */
+static std::vector<std::string> gst_pylon_frame_layout_features() {
+  std::vector<std::string> features = {"Width", "Height", "PixelFormat"};
+
+  for (const auto &feature : scaling_features) {
+    for (const auto &direction : {"Horizontal", "Vertical"}) {
+      features.push_back(std::string(feature) + direction);
+    }
+  }
+
+  return features;
+}
+
+static std::string gst_pylon_read_features(
+    GenApi::INodeMap &nodemap, const std::vector<std::string> &features) {
+  std::string values;
+
+  for (const auto &feature : features) {
+    Pylon::CParameter param(nodemap, feature.c_str());
+
+    if (param.IsReadable()) {
+      values += feature + "=" + std::string(param.ToString()) + ";";
+    }
+  }
+
+  return values;
+}
+
+static std::string gst_pylon_frame_layout(GenApi::INodeMap &nodemap) {
+  return gst_pylon_read_features(nodemap, gst_pylon_frame_layout_features());
+}
+
+/* Identifies a sequencer programming together with the frame layout and
+ * offsets copied into the sets */
+static std::size_t gst_pylon_sequencer_hash(GstPylon *self,
+                                            const std::string &program) {
+  GenApi::INodeMap &nodemap = self->camera->GetNodeMap();
+  std::string key = program + "|" + gst_pylon_frame_layout(nodemap) + "|" +
+                    gst_pylon_read_features(nodemap, frame_offset_features);
+
+  /* 0 is reserved for an unknown sequencer state */
+  return std::max<std::size_t>(1, std::hash<std::string>{}(key));
+}
+
+/* Remembers what the sets hold until one of the @features copied into them
+ * changes */
+static void gst_pylon_sequencer_set_programmed(
+    GstPylon *self, std::size_t hash, const std::vector<std::string> &features) {
+  self->sequencer_watch.Watch(self->camera->GetNodeMap(), features);
+  self->sequencer_hash = hash;
+}
+
+/* Restarting with the programming the sets already hold only needs the
+ * sequencer to run again */
+static gboolean gst_pylon_sequencer_is_programmed(GstPylon *self,
+                                                  std::size_t hash) {
+  if (hash != self->sequencer_hash) {
+    return FALSE;
+  }
+
+  GenApi::INodeMap &nodemap = self->camera->GetNodeMap();
+  Pylon::CEnumParameter sequencerMode(nodemap, "SequencerMode");
+
+  if (sequencerMode.GetValue() != "On") {
+    sequencerMode.SetValue("On");
+    /* features depending on the sequencer mode were invalidated */
+    self->sequencer_hash = hash;
+  }
+
+  GST_INFO("Sequencer already holds the requested sets, skipping programming");
+
+  return TRUE;
+}
+
+gboolean gst_pylon_parse_hdr_step(const gchar *step, gdouble *exposure,
+                                  gdouble *gain) {
+  gchar **parts = NULL;
+  gchar *end = NULL;
+  gboolean ret = FALSE;
+
+  g_return_val_if_fail(step, FALSE);
+  g_return_val_if_fail(exposure, FALSE);
+  g_return_val_if_fail(gain, FALSE);
+
+  parts = g_strsplit(step, ":", 2);
+  if (!parts[0]) {
+    goto out;
+  }
+
+  *exposure = g_ascii_strtod(g_strstrip(parts[0]), &end);
+  if (end == parts[0] || '\0' != *end || *exposure <= 0.0) {
+    goto out;
+  }
+
+  *gain = 0.0;
+  if (parts[1]) {
+    *gain = g_ascii_strtod(g_strstrip(parts[1]), &end);
+    if (end == parts[1] || '\0' != *end) {
+      goto out;
+    }
+  }
+
+  ret = TRUE;
+
+out:
+  g_strfreev(parts);
+  return ret;
+}
+
 gboolean gst_pylon_configure_hdr_sequence(GstPylon *self, const gchar *hdr_sequence,
                                           GError **err) {
   g_return_val_if_fail(self, FALSE);
@@ -440,34 +1062,32 @@ gboolean gst_pylon_configure_hdr_sequence(GstPylon *self, const gchar *hdr_seque
     gdouble *gains = g_new0(gdouble, num_steps);
 
     for (guint i = 0; i < num_steps; i++) {
-      gchar **parts = g_strsplit(steps[i], ":", 2);
-
-      if (parts[0]) {
-        exposures[i] = g_strtod(parts[0], NULL);
-
-        // Parse gain if provided, otherwise default to 0
-        if (parts[1]) {
-          gains[i] = g_strtod(parts[1], NULL);
-        } else {
-          gains[i] = 0.0;
-        }
-
+      // Gain defaults to 0 if not provided
+      if (gst_pylon_parse_hdr_step(steps[i], &exposures[i], &gains[i])) {
         GST_DEBUG("Step %d: exposure=%.2f μs, gain=%.2f", i, exposures[i], gains[i]);
       } else {
-        g_strfreev(parts);
+        g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
+                    "Failed to parse step %d \"%s\"", i, steps[i]);
         g_strfreev(steps);
         g_free(exposures);
         g_free(gains);
-        g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
-                    "Failed to parse step %d", i);
         return FALSE;
       }
-
-      g_strfreev(parts);
     }
 
     GST_DEBUG("Configuring sequencer for %d steps", num_steps);
 
+    std::size_t hash =
+        gst_pylon_sequencer_hash(self, std::string("hdr:") + hdr_sequence);
+    if (gst_pylon_sequencer_is_programmed(self, hash)) {
+      g_strfreev(steps);
+      g_free(exposures);
+      g_free(gains);
+      self->hdr_profile_sets = {0};
+      return TRUE;
+    }
+    self->sequencer_hash = 0;
+
     // Check if sequencer features are available
     Pylon::CEnumParameter sequencerMode(nodemap, "SequencerMode");
     if (!sequencerMode.IsValid()) {
@@ -605,6 +1225,36 @@ gboolean gst_pylon_configure_hdr_sequence(GstPylon *self, const gchar *hdr_seque
       return FALSE;
     }
 
+    // Everything read in the loop below is read now, the set writes are
+    // streamed to the camera as one batch
+    Pylon::CCommandParameter setLoad(nodemap, "SequencerSetLoad");
+    Pylon::CCommandParameter setSave(nodemap, "SequencerSetSave");
+    bool can_select = setSelector.IsValid() && setSelector.IsWritable();
+    bool can_load = setLoad.IsValid() && setLoad.IsWritable();
+    bool can_save = setSave.IsValid() && setSave.IsWritable();
+    bool can_width = seqWidth.IsValid() && seqWidth.IsWritable();
+    bool can_height = seqHeight.IsValid() && seqHeight.IsWritable();
+    bool can_format = seqPixelFormat.IsValid() && seqPixelFormat.IsWritable();
+    bool can_gain = has_gain_float && seqGain.IsWritable();
+    bool can_gain_raw = !can_gain && has_gain_raw && seqGainRaw.IsWritable();
+    bool can_exposure = exposureTime.IsWritable();
+    bool can_next = setNext.IsValid() && setNext.IsWritable();
+
+    if (!can_select) {
+      GST_WARNING("SequencerSetSelector not available - all steps go to the active set");
+    }
+    if (!can_load || !can_save) {
+      GST_DEBUG("SequencerSetLoad/Save not available - changes may apply immediately");
+    }
+    if (!can_exposure) {
+      GST_WARNING("Cannot set exposure time of the sequencer sets");
+    }
+    if (!can_next) {
+      GST_WARNING("Cannot configure the next set of the sequencer sets");
+    }
+
+    GstPylonRegisterStreaming streaming(*self->camera);
+
     for (guint i = 0; i < num_steps; i++) {
       gdouble exposure = exposures[i];
       gdouble gain = gains[i];
@@ -613,105 +1263,54 @@ gboolean gst_pylon_configure_hdr_sequence(GstPylon *self, const gchar *hdr_seque
       GST_DEBUG("Configuring set %d: exposure=%.2f μs, gain=%.2f, next=%d",
                 i, exposure, gain, next_set);
 
-      // Select the set
-      if (setSelector.IsValid() && setSelector.IsWritable()) {
-        GST_INFO("=== Configuring Sequencer Set %d ===", i);
+      // Select the set and load its current configuration (ace 2 uses
+      // SequencerSetLoad)
+      if (can_select) {
         setSelector.SetValue(i);
-        GST_INFO("SequencerSetSelector set to: %d", i);
-
-        // Load the current set configuration (ace 2 uses SequencerSetLoad)
-        GenApi::INode* loadNode = nodemap.GetNode("SequencerSetLoad");
-        if (loadNode) {
-          GenApi::ICommand* loadCmd = dynamic_cast<GenApi::ICommand*>(loadNode);
-          if (loadCmd && GenApi::IsWritable(loadCmd)) {
-            GST_INFO("Executing SequencerSetLoad for Set %d", i);
-            loadCmd->Execute();
-            GST_INFO("SequencerSetLoad executed successfully for Set %d", i);
-          } else {
-            GST_DEBUG("SequencerSetLoad command not writable for Set %d", i);
-          }
-        } else {
-          GST_DEBUG("SequencerSetLoad command not found - changes may apply immediately");
+        if (can_load) {
+          setLoad.Execute();
         }
-      } else {
-        GST_WARNING("Cannot select sequencer set %d - SequencerSetSelector not available", i);
       }
 
       // Preserve image format settings in each set
-      if (seqWidth.IsValid() && seqWidth.IsWritable()) {
-        gint64 current_w = seqWidth.GetValue();
-        GST_INFO("Set %d: Width is %ld, setting to %ld", i, current_w, width_val);
+      if (can_width) {
         seqWidth.SetValue(width_val);
-        GST_INFO("Set %d: Width set to %ld", i, width_val);
       }
-      if (seqHeight.IsValid() && seqHeight.IsWritable()) {
-        gint64 current_h = seqHeight.GetValue();
-        GST_INFO("Set %d: Height is %ld, setting to %ld", i, current_h, height_val);
+      if (can_height) {
         seqHeight.SetValue(height_val);
-        GST_INFO("Set %d: Height set to %ld", i, height_val);
       }
-      if (seqPixelFormat.IsValid() && seqPixelFormat.IsWritable()) {
-        Pylon::String_t current_fmt = seqPixelFormat.GetValue();
-        GST_INFO("Set %d: PixelFormat is %s, setting to %s", i,
-                 current_fmt.c_str(), pixelformat_val.c_str());
+      if (can_format) {
         seqPixelFormat.SetValue(pixelformat_val);
-        GST_INFO("Set %d: PixelFormat set to %s", i, pixelformat_val.c_str());
       }
 
       // Set Gain for this set
-      if (has_gain_float && seqGain.IsWritable()) {
-        gdouble current_gain = seqGain.IsReadable() ? seqGain.GetValue() : -1.0;
-        GST_INFO("Set %d: Gain is %.2f, setting to %.2f", i, current_gain, gain);
+      if (can_gain) {
         seqGain.SetValue(gain);
-        GST_INFO("Set %d: Gain set to %.2f", i, gain);
-      } else if (has_gain_raw && seqGainRaw.IsWritable()) {
-        gint64 current_gain = seqGainRaw.IsReadable() ? seqGainRaw.GetValue() : -1;
-        GST_INFO("Set %d: GainRaw is %ld, setting to %.0f", i, current_gain, gain);
+      } else if (can_gain_raw) {
         seqGainRaw.SetValue((gint64)gain);
-        GST_INFO("Set %d: GainRaw set to %.0f", i, gain);
       } else if (gain != 0.0) {
         GST_WARNING("Set %d: Gain parameter not available or not writable, cannot set gain=%.2f",
                     i, gain);
       }
 
       // Set exposure time for this set
-      if (exposureTime.IsValid() && exposureTime.IsWritable()) {
-        gdouble current_exp = exposureTime.GetValue();
-        GST_INFO("Set %d: ExposureTime was %.2f μs, setting to %.2f μs",
-                 i, current_exp, exposure);
+      if (can_exposure) {
         exposureTime.SetValue(exposure);
-        GST_INFO("Set %d: ExposureTime configured to %.2f μs", i, exposure);
-      } else {
-        GST_WARNING("Cannot set exposure time for set %d", i);
       }
 
       // Configure next set in sequence
-      if (setNext.IsValid() && setNext.IsWritable()) {
-        gint64 current_next = setNext.GetValue();
-        GST_INFO("Set %d: SequencerSetNext was %ld, setting to %d",
-                 i, current_next, next_set);
+      if (can_next) {
         setNext.SetValue(next_set);
-        GST_INFO("Set %d: SequencerSetNext configured to %d", i, next_set);
-      } else {
-        GST_WARNING("Cannot configure next set for set %d", i);
       }
 
       // Save the configured set (ace 2 uses SequencerSetSave)
-      GenApi::INode* saveNode = nodemap.GetNode("SequencerSetSave");
-      if (saveNode) {
-        GenApi::ICommand* saveCmd = dynamic_cast<GenApi::ICommand*>(saveNode);
-        if (saveCmd && GenApi::IsWritable(saveCmd)) {
-          GST_INFO("Executing SequencerSetSave for Set %d", i);
-          saveCmd->Execute();
-          GST_INFO("SequencerSetSave executed successfully for Set %d", i);
-        } else {
-          GST_DEBUG("SequencerSetSave command not writable for Set %d", i);
-        }
-      } else {
-        GST_DEBUG("SequencerSetSave command not found - changes may apply immediately");
+      if (can_save) {
+        setSave.Execute();
       }
     }
 
+    streaming.End();
+
     // Exit configuration mode
     if (seqConfigMode.IsValid() && seqConfigMode.IsWritable()) {
       GST_INFO("Exiting sequencer configuration mode");
@@ -733,6 +1332,8 @@ gboolean gst_pylon_configure_hdr_sequence(GstPylon *self, const gchar *hdr_seque
     g_strfreev(steps);
     g_free(exposures);
     g_free(gains);
+    self->hdr_profile_sets = {0};
+    gst_pylon_sequencer_set_programmed(self, hash, hdr_sequenced_features);
     GST_INFO("HDR sequence configuration completed successfully");
 
   } catch (const Pylon::GenericException &e) {
@@ -758,107 +1359,97 @@ gboolean gst_pylon_configure_dual_hdr_sequence(GstPylon *self,
     return FALSE;
   }
 
-  GST_INFO("Configuring dual HDR profiles with path branching:");
-  GST_INFO("  Profile 0: %s", hdr_sequence1);
-  GST_INFO("  Profile 1: %s", hdr_sequence2);
+  const gchar *sequences[] = {hdr_sequence1, hdr_sequence2, NULL};
 
-  try {
-    GenApi::INodeMap &nodemap = self->camera->GetNodeMap();
+  return gst_pylon_configure_hdr_profiles(self, sequences, err);
+}
 
-    // Parse exposure:gain pairs from both sequences
-    // Format: "exposure1:gain1,exposure2:gain2" or "exposure1,exposure2" (gain defaults to 0)
-    gchar **steps1 = g_strsplit(hdr_sequence1, ",", -1);
-    gchar **steps2 = g_strsplit(hdr_sequence2, ",", -1);
-    guint num_steps1 = g_strv_length(steps1);
-    guint num_steps2 = g_strv_length(steps2);
-
-    // Validate sequence lengths
-    if (num_steps1 == 0 || num_steps2 == 0) {
-      g_strfreev(steps1);
-      g_strfreev(steps2);
-      g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
-                  "HDR sequences must have at least 1 step");
-      return FALSE;
-    }
+/* Software signal that jumps to a profile. Profile 0 uses the last signal so
+ * that two profiles keep the SoftwareSignal1 -> profile 1, SoftwareSignal2 ->
+ * profile 0 wiring of the original dual profile mode. */
+static std::string gst_pylon_hdr_profile_signal(guint profile,
+                                                guint n_profiles) {
+  return "SoftwareSignal" + std::to_string(0 == profile ? n_profiles : profile);
+}
 
-    // Parse Profile 0 steps into exposure and gain arrays
-    gdouble *exposures1 = g_new0(gdouble, num_steps1);
-    gdouble *gains1 = g_new0(gdouble, num_steps1);
+gboolean gst_pylon_configure_hdr_profiles(GstPylon *self,
+                                          const gchar *const *sequences,
+                                          GError **err) {
+  g_return_val_if_fail(self, FALSE);
+  g_return_val_if_fail(sequences, FALSE);
+  g_return_val_if_fail(err && *err == NULL, FALSE);
 
-    for (guint i = 0; i < num_steps1; i++) {
-      gchar **parts = g_strsplit(steps1[i], ":", 2);
+  struct HdrStep {
+    gdouble exposure;
+    gdouble gain;
+  };
 
-      if (parts[0]) {
-        exposures1[i] = g_strtod(parts[0], NULL);
-        gains1[i] = parts[1] ? g_strtod(parts[1], NULL) : 0.0;
-        GST_DEBUG("Profile 0 Step %d: exposure=%.2f μs, gain=%.2f", i, exposures1[i], gains1[i]);
-      } else {
-        g_strfreev(parts);
-        g_strfreev(steps1);
-        g_strfreev(steps2);
-        g_free(exposures1);
-        g_free(gains1);
-        g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
-                    "Failed to parse Profile 0 step %d", i);
-        return FALSE;
-      }
+  guint n_profiles = g_strv_length(const_cast<gchar **>(sequences));
+  std::vector<std::vector<HdrStep>> profiles;
+  std::vector<guint> first_set;
+  guint total_sets = 0;
 
-      g_strfreev(parts);
-    }
+  if (n_profiles < 2 || n_profiles > GST_PYLON_HDR_MAX_PROFILES) {
+    g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
+                "HDR profile mode requires 2 to %d profiles, got %u",
+                GST_PYLON_HDR_MAX_PROFILES, n_profiles);
+    return FALSE;
+  }
 
-    // Parse Profile 1 steps into exposure and gain arrays
-    gdouble *exposures2 = g_new0(gdouble, num_steps2);
-    gdouble *gains2 = g_new0(gdouble, num_steps2);
+  // Parse exposure:gain pairs of every profile
+  // Format: "exposure1:gain1,exposure2:gain2" or "exposure1,exposure2" (gain defaults to 0)
+  for (guint p = 0; p < n_profiles; p++) {
+    gchar **steps = g_strsplit(sequences[p], ",", -1);
+    std::vector<HdrStep> profile;
 
-    for (guint i = 0; i < num_steps2; i++) {
-      gchar **parts = g_strsplit(steps2[i], ":", 2);
+    for (guint i = 0; steps[i]; i++) {
+      HdrStep step = {0.0, 0.0};
 
-      if (parts[0]) {
-        exposures2[i] = g_strtod(parts[0], NULL);
-        gains2[i] = parts[1] ? g_strtod(parts[1], NULL) : 0.0;
-        GST_DEBUG("Profile 1 Step %d: exposure=%.2f μs, gain=%.2f", i, exposures2[i], gains2[i]);
-      } else {
-        g_strfreev(parts);
-        g_strfreev(steps1);
-        g_strfreev(steps2);
-        g_free(exposures1);
-        g_free(gains1);
-        g_free(exposures2);
-        g_free(gains2);
+      if (!gst_pylon_parse_hdr_step(steps[i], &step.exposure, &step.gain)) {
         g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
-                    "Failed to parse Profile 1 step %d", i);
+                    "Failed to parse Profile %u step %u \"%s\"", p, i,
+                    steps[i]);
+        g_strfreev(steps);
         return FALSE;
       }
 
-      g_strfreev(parts);
+      profile.push_back(step);
     }
+    g_strfreev(steps);
 
-    // Check maximum sets limit (most cameras support 16 sets)
-    guint total_sets = num_steps1 + num_steps2;
-    if (total_sets > 16) {
-      g_strfreev(steps1);
-      g_strfreev(steps2);
-      g_free(exposures1);
-      g_free(gains1);
-      g_free(exposures2);
-      g_free(gains2);
+    if (profile.empty()) {
       g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
-                  "Total number of sets (%d) exceeds typical camera limit of 16", total_sets);
+                  "HDR profile %u must have at least 1 step", p);
       return FALSE;
     }
 
-    GST_INFO("Profile 0: %d steps, Profile 1: %d steps, Total sets: %d",
-              num_steps1, num_steps2, total_sets);
+    // Profiles occupy consecutive sets in the order they are given
+    first_set.push_back(total_sets);
+    total_sets += profile.size();
+    profiles.push_back(profile);
+  }
+
+  GST_INFO("Configuring %u HDR profiles using %u sequencer sets", n_profiles,
+           total_sets);
+
+  try {
+    GenApi::INodeMap &nodemap = self->camera->GetNodeMap();
+
+    std::string program = "hdr-profiles:";
+    for (guint p = 0; p < n_profiles; p++) {
+      program += std::string(sequences[p]) + ";";
+    }
+
+    std::size_t hash = gst_pylon_sequencer_hash(self, program);
+    if (gst_pylon_sequencer_is_programmed(self, hash)) {
+      self->hdr_profile_sets = first_set;
+      return TRUE;
+    }
+    self->sequencer_hash = 0;
 
     // Check if sequencer features are available
     Pylon::CEnumParameter sequencerMode(nodemap, "SequencerMode");
     if (!sequencerMode.IsValid()) {
-      g_strfreev(steps1);
-      g_strfreev(steps2);
-      g_free(exposures1);
-      g_free(gains1);
-      g_free(exposures2);
-      g_free(gains2);
       g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
                   "Camera does not support sequencer mode");
       return FALSE;
@@ -873,20 +1464,15 @@ gboolean gst_pylon_configure_dual_hdr_sequence(GstPylon *self,
     gint64 height_val = currentHeight.GetValue();
     Pylon::String_t pixelformat_val = currentPixelFormat.GetValue();
 
-    GST_INFO("Current camera settings: Width=%ld, Height=%ld, PixelFormat=%s",
-              width_val, height_val, pixelformat_val.c_str());
-
     // First make sure sequencer mode is OFF
     if (sequencerMode.IsWritable()) {
       sequencerMode.SetValue("Off");
-      GST_INFO("Sequencer mode disabled for configuration");
     }
 
     // Enter sequencer configuration mode
     Pylon::CEnumParameter seqConfigMode(nodemap, "SequencerConfigurationMode");
     if (seqConfigMode.IsValid() && seqConfigMode.IsWritable()) {
       seqConfigMode.SetValue("On");
-      GST_INFO("Entered sequencer configuration mode");
     }
 
     // Get sequencer parameters
@@ -899,16 +1485,49 @@ gboolean gst_pylon_configure_dual_hdr_sequence(GstPylon *self,
     Pylon::CEnumParameter seqPixelFormat(nodemap, "PixelFormat");
     Pylon::CFloatParameter exposureTime(nodemap, "ExposureTime");
 
-    // Check for path selector support
-    if (!pathSelector.IsValid()) {
-      g_strfreev(steps1);
-      g_strfreev(steps2);
-      g_free(exposures1);
-      g_free(gains1);
-      g_free(exposures2);
-      g_free(gains2);
+    if (!pathSelector.IsValid() || !seqTriggerSource.IsValid()) {
       g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
-                  "Camera does not support SequencerPathSelector - required for dual profiles");
+                  "Camera does not support SequencerPathSelector - required "
+                  "for multiple profiles");
+      return FALSE;
+    }
+
+    // Every set has one jump path per other profile plus the default path,
+    // and the profiles share the sequencer set budget of the camera
+    gint64 n_paths = pathSelector.GetMax() + 1;
+    gint64 n_sets = setSelector.GetMax() + 1;
+
+    if (n_paths < n_profiles) {
+      g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
+                  "%u profiles need %u sequencer paths per set, the camera "
+                  "has %" G_GINT64_FORMAT,
+                  n_profiles, n_profiles, n_paths);
+      return FALSE;
+    }
+
+    if (total_sets > n_sets) {
+      g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
+                  "Total number of sets (%u) exceeds the camera limit of "
+                  "%" G_GINT64_FORMAT,
+                  total_sets, n_sets);
+      return FALSE;
+    }
+
+    for (guint p = 0; p < n_profiles; p++) {
+      std::string signal = gst_pylon_hdr_profile_signal(p, n_profiles);
+      if (!seqTriggerSource.CanSetValue(signal.c_str())) {
+        g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
+                    "%u profiles need %s, not available as sequencer "
+                    "trigger source",
+                    n_profiles, signal.c_str());
+        return FALSE;
+      }
+    }
+
+    if (!seqTriggerSource.CanSetValue(HDR_SEQUENCER_TRIGGER)) {
+      g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
+                  "Cannot set SequencerTriggerSource to %s",
+                  HDR_SEQUENCER_TRIGGER);
       return FALSE;
     }
 
@@ -916,7 +1535,6 @@ gboolean gst_pylon_configure_dual_hdr_sequence(GstPylon *self,
     Pylon::CIntegerParameter seqSetStart(nodemap, "SequencerSetStart");
     if (seqSetStart.IsValid() && seqSetStart.IsWritable()) {
       seqSetStart.SetValue(0);
-      GST_INFO("SequencerSetStart = 0");
     }
 
     // Get Gain parameter if available
@@ -927,18 +1545,12 @@ gboolean gst_pylon_configure_dual_hdr_sequence(GstPylon *self,
 
     if (nodemap.GetNode("Gain")) {
       seqGain.Attach(nodemap.GetNode("Gain"));
-      if (seqGain.IsValid()) {
-        has_gain_float = true;
-        GST_INFO("Camera supports Gain parameter (float)");
-      }
+      has_gain_float = seqGain.IsValid();
     }
 
     if (!has_gain_float && nodemap.GetNode("GainRaw")) {
       seqGainRaw.Attach(nodemap.GetNode("GainRaw"));
-      if (seqGainRaw.IsValid()) {
-        has_gain_raw = true;
-        GST_INFO("Camera supports GainRaw parameter (integer)");
-      }
+      has_gain_raw = seqGainRaw.IsValid();
     }
 
     // Check exposure time parameter
@@ -946,233 +1558,353 @@ gboolean gst_pylon_configure_dual_hdr_sequence(GstPylon *self,
       // Try alternative name
       exposureTime.Attach(nodemap.GetNode("ExposureTimeAbs"));
       if (!exposureTime.IsValid()) {
-        g_strfreev(steps1);
-        g_strfreev(steps2);
-        g_free(exposures1);
-        g_free(gains1);
-        g_free(exposures2);
-        g_free(gains2);
         g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
                     "Camera does not have ExposureTime parameter");
         return FALSE;
       }
     }
 
-    // Helper lambda to configure common settings for each set
-    auto configureCommonSettings = [&](guint set_num, gdouble exposure, gdouble gain) {
-      GST_INFO("=== Configuring Set %d ===", set_num);
+    Pylon::CCommandParameter setLoad(nodemap, "SequencerSetLoad");
+    Pylon::CCommandParameter setSave(nodemap, "SequencerSetSave");
+
+    // Everything read in the loop below is read now, the set writes are
+    // streamed to the camera as one batch
+    bool can_load = setLoad.IsValid() && setLoad.IsWritable();
+    bool can_save = setSave.IsValid() && setSave.IsWritable();
+    bool can_width = seqWidth.IsValid() && seqWidth.IsWritable();
+    bool can_height = seqHeight.IsValid() && seqHeight.IsWritable();
+    bool can_format = seqPixelFormat.IsValid() && seqPixelFormat.IsWritable();
+    bool can_gain = has_gain_float && seqGain.IsWritable();
+    bool can_gain_raw = !can_gain && has_gain_raw && seqGainRaw.IsWritable();
+
+    GstPylonRegisterStreaming streaming(*self->camera);
+
+    for (guint p = 0; p < n_profiles; p++) {
+      for (guint i = 0; i < profiles[p].size(); i++) {
+        const HdrStep &step = profiles[p][i];
+        guint set_num = first_set[p] + i;
+        guint path = 0;
+
+        GST_DEBUG("Profile %u set %u: exposure=%.2f μs, gain=%.2f", p,
+                  set_num, step.exposure, step.gain);
+
+        // Select and load the set
+        setSelector.SetValue(set_num);
+        if (can_load) {
+          setLoad.Execute();
+        }
 
-      // Select the set
-      setSelector.SetValue(set_num);
+        // Set common parameters (width, height, pixel format)
+        if (can_width) {
+          seqWidth.SetValue(width_val);
+        }
+        if (can_height) {
+          seqHeight.SetValue(height_val);
+        }
+        if (can_format) {
+          seqPixelFormat.SetValue(pixelformat_val);
+        }
 
-      // Load the current set configuration
-      GenApi::INode* loadNode = nodemap.GetNode("SequencerSetLoad");
-      if (loadNode) {
-        GenApi::ICommand* loadCmd = dynamic_cast<GenApi::ICommand*>(loadNode);
-        if (loadCmd && GenApi::IsWritable(loadCmd)) {
-          loadCmd->Execute();
+        // Set gain for this set
+        if (can_gain) {
+          seqGain.SetValue(step.gain);
+        } else if (can_gain_raw) {
+          seqGainRaw.SetValue((gint64)step.gain);
+        } else if (step.gain != 0.0) {
+          GST_WARNING("Gain parameter not available or not writable, cannot "
+                      "set gain=%.2f",
+                      step.gain);
         }
-      }
 
-      // Set common parameters (width, height, pixel format)
-      if (seqWidth.IsValid() && seqWidth.IsWritable()) {
-        seqWidth.SetValue(width_val);
+        exposureTime.SetValue(step.exposure);
+
+        // Jump paths are checked first: the signal of each other profile
+        // leads to its first set
+        for (guint target = 0; target < n_profiles; target++) {
+          if (target == p) {
+            continue;
+          }
+
+          pathSelector.SetValue(path++);
+          setNext.SetValue(first_set[target]);
+          seqTriggerSource.SetValue(
+              gst_pylon_hdr_profile_signal(target, n_profiles).c_str());
+        }
+
+        // Default path: normal progression, the last set loops back to the
+        // first set of the same profile
+        pathSelector.SetValue(path);
+        setNext.SetValue(i + 1 == profiles[p].size() ? first_set[p]
+                                                     : set_num + 1);
+        seqTriggerSource.SetValue(HDR_SEQUENCER_TRIGGER);
+
+        // Save the set ONCE with ALL paths configured
+        if (can_save) {
+          setSave.Execute();
+        }
       }
-      if (seqHeight.IsValid() && seqHeight.IsWritable()) {
-        seqHeight.SetValue(height_val);
+    }
+
+    streaming.End();
+
+    // Exit configuration mode
+    if (seqConfigMode.IsValid() && seqConfigMode.IsWritable()) {
+      seqConfigMode.SetValue("Off");
+    }
+
+    // Enable sequencer mode
+    if (sequencerMode.IsWritable()) {
+      sequencerMode.SetValue("On");
+    }
+
+    self->hdr_profile_sets = first_set;
+    gst_pylon_sequencer_set_programmed(self, hash, hdr_sequenced_features);
+    GST_INFO("%u HDR profiles configured successfully", n_profiles);
+
+  } catch (const Pylon::GenericException &e) {
+    g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_FAILED,
+                "Failed to configure HDR profiles: %s", e.GetDescription());
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+gboolean gst_pylon_configure_sequencer_program(GstPylon *self,
+                                               const gchar *location,
+                                               GError **err) {
+  g_return_val_if_fail(self, FALSE);
+  g_return_val_if_fail(location, FALSE);
+  g_return_val_if_fail(err && *err == NULL, FALSE);
+
+  GstPylonSequencerProgram program;
+
+  if (!gst_pylon_sequencer_program_load(location, &program, err)) {
+    return FALSE;
+  }
+
+  GST_INFO("Configuring sequencer program %s with %zu sets", location,
+           program.sets.size());
+
+  try {
+    GenApi::INodeMap &nodemap = self->camera->GetNodeMap();
+
+    std::string description = "program:" + std::to_string(program.start);
+    for (const auto &set : program.sets) {
+      description += "[";
+      for (const auto &feature : set.features) {
+        description += feature.first + "=" + feature.second + ";";
       }
-      if (seqPixelFormat.IsValid() && seqPixelFormat.IsWritable()) {
-        seqPixelFormat.SetValue(pixelformat_val);
+      for (const auto &path : set.paths) {
+        description += std::to_string(path.next) + ":" + path.trigger + ";";
       }
+      description += "]";
+    }
 
-      // Set gain for this set
-      if (has_gain_float && seqGain.IsWritable()) {
-        seqGain.SetValue(gain);
-        GST_INFO("  Gain = %.2f", gain);
-      } else if (has_gain_raw && seqGainRaw.IsWritable()) {
-        seqGainRaw.SetValue((gint64)gain);
-        GST_INFO("  GainRaw = %.0f", gain);
-      } else if (gain != 0.0) {
-        GST_WARNING("  Gain parameter not available or not writable, cannot set gain=%.2f", gain);
+    std::size_t hash = gst_pylon_sequencer_hash(self, description);
+    if (gst_pylon_sequencer_is_programmed(self, hash)) {
+      self->hdr_profile_sets.clear();
+      return TRUE;
+    }
+    self->sequencer_hash = 0;
+
+    Pylon::CEnumParameter sequencerMode(nodemap, "SequencerMode");
+    if (!sequencerMode.IsValid()) {
+      g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
+                  "Camera does not support sequencer mode");
+      return FALSE;
+    }
+
+    // The frame layout is fixed by the negotiated caps
+    std::string layout = gst_pylon_frame_layout(nodemap);
+
+    if (sequencerMode.IsWritable()) {
+      sequencerMode.SetValue("Off");
+    }
+
+    Pylon::CEnumParameter seqConfigMode(nodemap, "SequencerConfigurationMode");
+    if (seqConfigMode.IsValid() && seqConfigMode.IsWritable()) {
+      seqConfigMode.SetValue("On");
+    }
+
+    Pylon::CIntegerParameter setSelector(nodemap, "SequencerSetSelector");
+    Pylon::CIntegerParameter pathSelector(nodemap, "SequencerPathSelector");
+    Pylon::CIntegerParameter setNext(nodemap, "SequencerSetNext");
+    Pylon::CEnumParameter seqTriggerSource(nodemap, "SequencerTriggerSource");
+    Pylon::CCommandParameter setLoad(nodemap, "SequencerSetLoad");
+    Pylon::CCommandParameter setSave(nodemap, "SequencerSetSave");
+
+    gint64 n_sets = setSelector.GetMax() + 1;
+    gint64 n_paths = pathSelector.IsValid() ? pathSelector.GetMax() + 1 : 1;
+
+    if (static_cast<gint64>(program.sets.size()) > n_sets) {
+      g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
+                  "Sequencer program has %zu sets, the camera supports "
+                  "%" G_GINT64_FORMAT,
+                  program.sets.size(), n_sets);
+      return FALSE;
+    }
+
+    // Validate the whole program first, feature reads are not reliable
+    // while the set writes are streamed
+    for (guint i = 0; i < program.sets.size(); i++) {
+      const GstPylonSequencerSet &set = program.sets[i];
+
+      if (static_cast<gint64>(set.paths.size()) > n_paths) {
+        g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
+                    "Set %u has %zu paths, the camera supports "
+                    "%" G_GINT64_FORMAT,
+                    i, set.paths.size(), n_paths);
+        return FALSE;
       }
 
-      // Set exposure time
-      exposureTime.SetValue(exposure);
-      GST_INFO("  ExposureTime = %.2f μs", exposure);
-    };
+      for (const auto &feature : set.features) {
+        Pylon::CParameter param(nodemap, feature.first.c_str());
 
-    // Helper lambda to save current set configuration
-    auto saveSet = [&]() {
-      GenApi::INode* saveNode = nodemap.GetNode("SequencerSetSave");
-      if (saveNode) {
-        GenApi::ICommand* saveCmd = dynamic_cast<GenApi::ICommand*>(saveNode);
-        if (saveCmd && GenApi::IsWritable(saveCmd)) {
-          saveCmd->Execute();
-          GST_DEBUG("  SequencerSetSave executed");
+        if (!param.IsValid()) {
+          g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
+                      "Set %u: camera has no feature %s", i,
+                      feature.first.c_str());
+          return FALSE;
+        }
+
+        if (!param.IsWritable()) {
+          g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
+                      "Set %u: feature %s is not writable", i,
+                      feature.first.c_str());
+          return FALSE;
         }
       }
-    };
 
-    // Calculate set indices for profiles
-    guint profile0_first = 0;
-    guint profile0_last = num_steps1 - 1;
-    guint profile1_first = num_steps1;
-    guint profile1_last = num_steps1 + num_steps2 - 1;
-
-    GST_INFO("Set allocation: Profile 0 [%d-%d], Profile 1 [%d-%d]",
-             profile0_first, profile0_last, profile1_first, profile1_last);
-
-    // ===== Configure Profile 0 sets =====
-    for (guint i = 0; i < num_steps1; i++) {
-      guint set_num = i;
-      gdouble exposure = exposures1[i];
-      gdouble gain = gains1[i];
-
-      GST_INFO("=== Configuring Set %d (Profile 0, step %d/%d: %.2fμs, gain=%.2f) ===",
-               set_num, i+1, num_steps1, exposure, gain);
-
-      configureCommonSettings(set_num, exposure, gain);
-
-      // ALL sets in Profile 0 get software signal on Path 0
-      // Path 0: Switch to Profile 1 on SoftwareSignal1 (checked first)
-      pathSelector.SetValue(0);
-      setNext.SetValue(profile1_first);
-      if (!seqTriggerSource.IsValid()) {
-        g_strfreev(steps1);
-        g_strfreev(steps2);
-        g_free(exposures1);
-        g_free(gains1);
-        g_free(exposures2);
-        g_free(gains2);
-        throw Pylon::GenericException("SequencerTriggerSource parameter not available", __FILE__, __LINE__);
+      for (const auto &path : set.paths) {
+        if (!seqTriggerSource.CanSetValue(path.trigger.c_str())) {
+          g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
+                      "Set %u: %s is not a sequencer trigger source", i,
+                      path.trigger.c_str());
+          return FALSE;
+        }
       }
-      if (!seqTriggerSource.CanSetValue("SoftwareSignal1")) {
-        g_strfreev(steps1);
-        g_strfreev(steps2);
-        g_free(exposures1);
-        g_free(gains1);
-        g_free(exposures2);
-        g_free(gains2);
-        throw Pylon::GenericException("Cannot set SequencerTriggerSource to SoftwareSignal1", __FILE__, __LINE__);
+    }
+
+    bool can_load = setLoad.IsValid() && setLoad.IsWritable();
+    bool can_save = setSave.IsValid() && setSave.IsWritable();
+
+    GstPylonRegisterStreaming streaming(*self->camera);
+
+    for (guint i = 0; i < program.sets.size(); i++) {
+      const GstPylonSequencerSet &set = program.sets[i];
+
+      setSelector.SetValue(i);
+      if (can_load) {
+        setLoad.Execute();
       }
-      seqTriggerSource.SetValue("SoftwareSignal1");
-      GST_INFO("  Path 0: Next = %d, Trigger = SoftwareSignal1 (switch to Profile 1)", profile1_first);
-
-      // Path 1: Default path - normal progression with ExposureActive trigger
-      pathSelector.SetValue(1);
-      if (i == profile0_last) {
-        // Last set: loop back to beginning
-        setNext.SetValue(profile0_first);
-        GST_INFO("  Path 1 (default): Next = %d, Trigger = %s (loop Profile 0)", profile0_first, HDR_SEQUENCER_TRIGGER);
-      } else {
-        // Other sets: go to next set
-        setNext.SetValue(set_num + 1);
-        GST_INFO("  Path 1 (default): Next = %d, Trigger = %s", set_num + 1, HDR_SEQUENCER_TRIGGER);
+
+      for (const auto &feature : set.features) {
+        GST_DEBUG("Set %u: %s = %s", i, feature.first.c_str(),
+                  feature.second.c_str());
+        Pylon::CParameter(nodemap, feature.first.c_str())
+            .FromString(feature.second.c_str());
       }
-      if (!seqTriggerSource.CanSetValue(HDR_SEQUENCER_TRIGGER)) {
-        g_strfreev(steps1);
-        g_strfreev(steps2);
-        g_free(exposures1);
-        g_free(gains1);
-        g_free(exposures2);
-        g_free(gains2);
-        throw Pylon::GenericException(
-          (std::string("Cannot set SequencerTriggerSource to ") + HDR_SEQUENCER_TRIGGER).c_str(),
-          __FILE__, __LINE__);
+
+      for (guint p = 0; p < set.paths.size(); p++) {
+        const GstPylonSequencerPath &path = set.paths[p];
+
+        if (pathSelector.IsValid()) {
+          pathSelector.SetValue(p);
+        }
+        setNext.SetValue(path.next);
+        seqTriggerSource.SetValue(path.trigger.c_str());
+
+        GST_DEBUG("Set %u path %u: next = %u, trigger = %s", i, p, path.next,
+                  path.trigger.c_str());
+      }
+
+      // Save the set ONCE with ALL paths configured
+      if (can_save) {
+        setSave.Execute();
       }
-      seqTriggerSource.SetValue(HDR_SEQUENCER_TRIGGER);
-
-      // Save the set ONCE with BOTH paths configured
-      saveSet();
-    }
-
-    // ===== Configure Profile 1 sets =====
-    for (guint i = 0; i < num_steps2; i++) {
-      guint set_num = profile1_first + i;
-      gdouble exposure = exposures2[i];
-      gdouble gain = gains2[i];
-
-      GST_INFO("=== Configuring Set %d (Profile 1, step %d/%d: %.2fμs, gain=%.2f) ===",
-               set_num, i+1, num_steps2, exposure, gain);
-
-      configureCommonSettings(set_num, exposure, gain);
-
-      // ALL sets in Profile 1 get software signal on Path 0
-      // Path 0: Switch to Profile 0 on SoftwareSignal2 (checked first)
-      pathSelector.SetValue(0);
-      setNext.SetValue(profile0_first);
-      if (!seqTriggerSource.IsValid()) {
-        g_strfreev(steps1);
-        g_strfreev(steps2);
-        g_free(exposures1);
-        g_free(gains1);
-        g_free(exposures2);
-        g_free(gains2);
-        throw Pylon::GenericException("SequencerTriggerSource parameter not available", __FILE__, __LINE__);
+    }
+
+    streaming.End();
+
+    // Read the geometry back from every set writing features, the values
+    // depend on each other and the camera may have corrected them
+    for (guint i = 0; i < program.sets.size(); i++) {
+      const GstPylonSequencerSet &set = program.sets[i];
+
+      if (set.features.empty()) {
+        continue;
       }
-      if (!seqTriggerSource.CanSetValue("SoftwareSignal2")) {
-        g_strfreev(steps1);
-        g_strfreev(steps2);
-        g_free(exposures1);
-        g_free(gains1);
-        g_free(exposures2);
-        g_free(gains2);
-        throw Pylon::GenericException("Cannot set SequencerTriggerSource to SoftwareSignal2", __FILE__, __LINE__);
+
+      setSelector.SetValue(i);
+      if (can_load) {
+        setLoad.Execute();
       }
-      seqTriggerSource.SetValue("SoftwareSignal2");
-      GST_INFO("  Path 0: Next = %d, Trigger = SoftwareSignal2 (switch to Profile 0)", profile0_first);
-
-      // Path 1: Default path - normal progression with ExposureActive trigger
-      pathSelector.SetValue(1);
-      if (set_num == profile1_last) {
-        // Last set: loop back to beginning
-        setNext.SetValue(profile1_first);
-        GST_INFO("  Path 1 (default): Next = %d, Trigger = %s (loop Profile 1)", profile1_first, HDR_SEQUENCER_TRIGGER);
-      } else {
-        // Other sets: go to next set
-        setNext.SetValue(set_num + 1);
-        GST_INFO("  Path 1 (default): Next = %d, Trigger = %s", set_num + 1, HDR_SEQUENCER_TRIGGER);
+
+      std::string set_layout = gst_pylon_frame_layout(nodemap);
+      if (set_layout != layout) {
+        g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
+                    "Set %u changes the frame layout to %s, all sets must "
+                    "keep the negotiated %s",
+                    i, set_layout.c_str(), layout.c_str());
+        return FALSE;
       }
-      if (!seqTriggerSource.CanSetValue(HDR_SEQUENCER_TRIGGER)) {
-        g_strfreev(steps1);
-        g_strfreev(steps2);
-        g_free(exposures1);
-        g_free(gains1);
-        g_free(exposures2);
-        g_free(gains2);
-        throw Pylon::GenericException(
-          (std::string("Cannot set SequencerTriggerSource to ") + HDR_SEQUENCER_TRIGGER).c_str(),
-          __FILE__, __LINE__);
+
+      for (const auto &feature : set.features) {
+        if (std::find(frame_offset_features.begin(),
+                      frame_offset_features.end(),
+                      feature.first) == frame_offset_features.end()) {
+          continue;
+        }
+
+        gint64 offset =
+            Pylon::CIntegerParameter(nodemap, feature.first.c_str())
+                .GetValue();
+        if (offset != g_ascii_strtoll(feature.second.c_str(), NULL, 10)) {
+          g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
+                      "Set %u: %s is %" G_GINT64_FORMAT " instead of %s", i,
+                      feature.first.c_str(), offset, feature.second.c_str());
+          return FALSE;
+        }
       }
-      seqTriggerSource.SetValue(HDR_SEQUENCER_TRIGGER);
+    }
 
-      // Save the set ONCE with BOTH paths configured
-      saveSet();
+    Pylon::CIntegerParameter seqSetStart(nodemap, "SequencerSetStart");
+    if (seqSetStart.IsValid() && seqSetStart.IsWritable()) {
+      seqSetStart.SetValue(program.start);
     }
 
-    // Exit configuration mode
     if (seqConfigMode.IsValid() && seqConfigMode.IsWritable()) {
       seqConfigMode.SetValue("Off");
-      GST_INFO("Exited sequencer configuration mode");
     }
 
-    // Enable sequencer mode
     if (sequencerMode.IsWritable()) {
       sequencerMode.SetValue("On");
-      GST_INFO("Sequencer mode enabled");
     }
 
-    g_strfreev(steps1);
-    g_strfreev(steps2);
-    g_free(exposures1);
-    g_free(gains1);
-    g_free(exposures2);
-    g_free(gains2);
-    GST_INFO("Dual HDR profile configuration with path branching completed successfully");
+    // The geometry is part of the hash, everything else is watched
+    std::vector<std::string> geometry = gst_pylon_frame_layout_features();
+    geometry.insert(geometry.end(), frame_offset_features.begin(),
+                    frame_offset_features.end());
+
+    std::vector<std::string> features;
+    for (const auto &set : program.sets) {
+      for (const auto &feature : set.features) {
+        if (std::find(geometry.begin(), geometry.end(), feature.first) ==
+            geometry.end()) {
+          features.push_back(feature.first);
+        }
+      }
+    }
+
+    self->hdr_profile_sets.clear();
+    gst_pylon_sequencer_set_programmed(self, hash, features);
+    GST_INFO("Sequencer program %s configured successfully", location);
 
   } catch (const Pylon::GenericException &e) {
     g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_FAILED,
-                "Failed to configure dual HDR profiles: %s", e.GetDescription());
+                "Failed to configure sequencer program %s: %s", location,
+                e.GetDescription());
     return FALSE;
   }
 
@@ -1182,94 +1914,122 @@ gboolean gst_pylon_configure_dual_hdr_sequence(GstPylon *self,
 gboolean gst_pylon_switch_hdr_profile(GstPylon *self, gint profile, GError **err) {
   g_return_val_if_fail(self, FALSE);
   g_return_val_if_fail(err && *err == NULL, FALSE);
-  g_return_val_if_fail(profile == 0 || profile == 1, FALSE);
+  g_return_val_if_fail(profile >= 0, FALSE);
+
+  guint n_profiles = self->hdr_profile_sets.size();
+
+  if (static_cast<guint>(profile) >= n_profiles) {
+    g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
+                "HDR profile %d not programmed, %u profiles configured",
+                profile, n_profiles);
+    return FALSE;
+  }
+
+  /* a single sequence has nothing to jump to */
+  if (n_profiles < 2) {
+    return TRUE;
+  }
+
+  /* every set of the other profiles listens for this signal on its jump
+   * path to the profile */
+  std::string signal = gst_pylon_hdr_profile_signal(profile, n_profiles);
 
   try {
     GenApi::INodeMap &nodemap = self->camera->GetNodeMap();
-
-    // Use SoftwareSignalSelector and SoftwareSignalPulse to trigger the profile switch
     Pylon::CEnumParameter signalSelector(nodemap, "SoftwareSignalSelector");
     Pylon::CCommandParameter signalPulse(nodemap, "SoftwareSignalPulse");
 
-    if (signalSelector.IsValid() && signalPulse.IsValid()) {
-      // Select the appropriate software signal
-      // To switch TO Profile 1: trigger SoftwareSignal1 (Set 1 Path 1 listens for this)
-      // To switch TO Profile 0: trigger SoftwareSignal2 (Set 4 Path 1 listens for this)
-      const char* signal_value = (profile == 1) ? "SoftwareSignal1" : "SoftwareSignal2";
-
-      GST_DEBUG("Attempting to switch to profile %d using signal %s", profile, signal_value);
-
-      if (signalSelector.CanSetValue(signal_value)) {
-        signalSelector.SetValue(signal_value);
-        GST_DEBUG("SoftwareSignalSelector set to %s", signal_value);
-
-        // Execute the pulse command
-        if (GenApi::IsWritable(signalPulse.GetNode())) {
-          signalPulse.Execute();
-          GST_INFO("Executed %s pulse to switch to HDR Profile %d", signal_value, profile);
-
-          // Verify the signal was set correctly
-          try {
-            Pylon::String_t current_signal = signalSelector.GetValue();
-            GST_DEBUG("After pulse, SoftwareSignalSelector reads: %s", current_signal.c_str());
-          } catch (...) {
-            GST_DEBUG("Could not read back SoftwareSignalSelector value");
-          }
+    if (!signalSelector.IsValid() || !signalPulse.IsValid()) {
+      throw Pylon::GenericException(
+          "Camera does not support software signals", __FILE__, __LINE__);
+    }
 
-          return TRUE;
-        } else {
-          GST_WARNING("SoftwareSignalPulse command not writable after selecting %s", signal_value);
-        }
-      } else {
-        GST_WARNING("Cannot set SoftwareSignalSelector to %s", signal_value);
-      }
-    } else {
-      GST_WARNING("SoftwareSignalSelector=%d, SoftwareSignalPulse=%d",
-                  signalSelector.IsValid(), signalPulse.IsValid());
+    if (!signalSelector.CanSetValue(signal.c_str())) {
+      std::string msg = "SoftwareSignalSelector cannot be set to " + signal;
+      throw Pylon::GenericException(msg.c_str(), __FILE__, __LINE__);
     }
 
-    // If the primary method didn't work, log more details for debugging
-    GST_WARNING("Software signal switching failed - debugging info:");
+    signalSelector.SetValue(signal.c_str());
+    signalPulse.Execute();
 
-    // Check what signals are available
-    if (signalSelector.IsValid()) {
-      GenApi::StringList_t available_signals;
-      signalSelector.GetSettableValues(available_signals);
-      GST_WARNING("Available software signals:");
-      for (const auto& sig : available_signals) {
-        GST_WARNING("  - %s", sig.c_str());
-      }
+    GST_INFO("Executed %s pulse to switch to HDR profile %d", signal.c_str(),
+             profile);
+  } catch (const Pylon::GenericException &e) {
+    g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_FAILED,
+                "Failed to switch to HDR profile %d: %s", profile,
+                e.GetDescription());
+    return FALSE;
+  }
 
-      // Try to read current value
-      try {
-        Pylon::String_t current = signalSelector.GetValue();
-        GST_WARNING("Current SoftwareSignalSelector value: %s", current.c_str());
-      } catch (...) {
-        GST_WARNING("Could not read current SoftwareSignalSelector value");
-      }
-    }
+  return TRUE;
+}
 
-    GST_ERROR("Could not trigger software signal for profile switching");
-    GST_ERROR("Attempting to switch to profile %d failed", profile);
-    GST_ERROR("The sequencer will continue with the current profile");
+static Pylon::CFloatParameter gst_pylon_get_exposure_parameter(
+    GenApi::INodeMap &nodemap) {
+  Pylon::CFloatParameter exposureTime;
 
-    // Don't return FALSE to avoid failing the pipeline, but the switch didn't work
-    return TRUE;
+  if (nodemap.GetNode("ExposureTime")) {
+    exposureTime.Attach(nodemap.GetNode("ExposureTime"));
+  } else if (nodemap.GetNode("ExposureTimeAbs")) {
+    exposureTime.Attach(nodemap.GetNode("ExposureTimeAbs"));
+  }
+
+  return exposureTime;
+}
+
+gboolean gst_pylon_get_exposure_limits(GstPylon *self, gdouble *min,
+                                       gdouble *max, GError **err) {
+  g_return_val_if_fail(self, FALSE);
+  g_return_val_if_fail(min && max, FALSE);
+  g_return_val_if_fail(err && *err == NULL, FALSE);
+
+  try {
+    Pylon::CFloatParameter exposureTime =
+        gst_pylon_get_exposure_parameter(self->camera->GetNodeMap());
+
+    if (!exposureTime.IsValid()) {
+      g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
+                  "Camera does not have ExposureTime parameter");
+      return FALSE;
+    }
 
+    *min = exposureTime.GetMin();
+    *max = exposureTime.GetMax();
   } catch (const Pylon::GenericException &e) {
     g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_FAILED,
-                "Failed to switch HDR profile: %s", e.GetDescription());
+                "Failed to query exposure limits: %s", e.GetDescription());
     return FALSE;
   }
+
+  return TRUE;
 }
 
 void gst_pylon_free(GstPylon *self) {
   g_return_if_fail(self);
 
+  /* a background limits search must not outlive the connection */
+  gst_pylon_object_stop_limits_search((GstPylonObject *)self->gcamera);
+  gst_pylon_object_stop_limits_search((GstPylonObject *)self->gstream_grabber);
+
+  try {
+    self->event_handler.Reset(*self->camera);
+  } catch (const Pylon::GenericException &e) {
+    GST_WARNING("Failed to disable camera events: %s", e.GetDescription());
+  }
   self->camera->DeregisterImageEventHandler(&self->image_handler);
   self->camera->DeregisterConfiguration(&self->disconnect_handler);
+
+  /* the objects may outlive the camera, e.g. when handed out as children,
+   * they must not touch the nodemaps destroyed by Close() */
+  gst_pylon_object_release_nodes((GstPylonObject *)self->gcamera);
+  gst_pylon_object_release_nodes((GstPylonObject *)self->gstream_grabber);
+  self->sequencer_watch.Release();
+
   self->camera->Close();
   g_object_unref(self->gcamera);
+  g_object_unref(self->gstream_grabber);
+
+  gst_pylon_release_converted_buffers(self);
 
   delete self;
 }
@@ -1321,6 +2081,140 @@ static void gst_pylon_add_result_meta(
   g_return_if_fail(buf);
 
   gst_buffer_add_pylon_meta(buf, grab_result_ptr);
+  GstPylonMeta *meta = gst_buffer_get_pylon_meta(buf);
+
+  /* the ExposureEnd event usually arrives before the frame is transferred,
+   * frames it arrives late for carry no exposure end */
+  guint64 exposure_end = 0;
+  if (self->event_handler.TakeExposureEnd(grab_result_ptr->GetBlockID(),
+                                          exposure_end)) {
+    GstCaps *ref = gst_caps_from_string("timestamp/x-pylon-exposure-end");
+    gst_buffer_add_reference_timestamp_meta(buf, ref, exposure_end,
+                                            GST_CLOCK_TIME_NONE);
+    gst_caps_unref(ref);
+  }
+
+  /* regions in frame coordinates, their sensor position as parameter */
+  for (std::size_t i = 0; i < self->rois.size(); i++) {
+    const GstPylonRoi &roi = self->rois[i];
+    GstVideoRegionOfInterestMeta *roi_meta =
+        gst_buffer_add_video_region_of_interest_meta(
+            buf, "pylon-roi", roi.frame_x, roi.frame_y, roi.width,
+            roi.height);
+    roi_meta->id = static_cast<gint>(i);
+    gst_video_region_of_interest_meta_add_param(
+        roi_meta, gst_structure_new("pylon-roi", "sensor-x", G_TYPE_INT,
+                                    roi.x, "sensor-y", G_TYPE_INT, roi.y,
+                                    NULL));
+  }
+}
+
+static gboolean gst_pylon_is_converting(GstPylon *self) {
+  return GST_PYLON_UNPACK_NONE != self->unpack.GetLayout() ||
+         GST_PYLON_DEBAYER_NONE != self->debayer.GetOutput() ||
+         GST_PYLON_YUV_OUTPUT_NONE != self->yuv_convert.GetOutput();
+}
+
+static void gst_pylon_release_converted_buffers(GstPylon *self) {
+  /* buffers still downstream are freed when they return */
+  if (self->convert_buffers) {
+    gst_buffer_pool_set_active(self->convert_buffers, FALSE);
+    gst_object_unref(self->convert_buffers);
+    self->convert_buffers = NULL;
+  }
+}
+
+static GstBuffer *gst_pylon_acquire_converted_buffer(GstPylon *self,
+                                                     gsize size) {
+  GstBuffer *buf = NULL;
+
+  if (!self->convert_buffers) {
+    GstBufferPool *pool = gst_buffer_pool_new();
+    GstStructure *config = gst_buffer_pool_get_config(pool);
+
+    gst_buffer_pool_config_set_params(config, NULL, size, 0, 0);
+    if (gst_buffer_pool_set_config(pool, config) &&
+        gst_buffer_pool_set_active(pool, TRUE)) {
+      self->convert_buffers = pool;
+    } else {
+      GST_WARNING("Failed to set up the conversion buffer pool");
+      gst_object_unref(pool);
+    }
+  }
+
+  if (!self->convert_buffers ||
+      GST_FLOW_OK !=
+          gst_buffer_pool_acquire_buffer(self->convert_buffers, &buf, NULL)) {
+    buf = gst_buffer_new_allocate(NULL, size, NULL);
+  }
+
+  return buf;
+}
+
+/* Converted frames are written into a pooled buffer, the grab result is
+ * released to the camera once its metadata has been read. Returns the
+ * stride of the converted rows, of the luma plane for planar output. */
+static gsize gst_pylon_convert_result(
+    GstPylon *self, GstBuffer **buf,
+    Pylon::CBaslerUniversalGrabResultPtr *grab_result_ptr) {
+  const gint width = (*grab_result_ptr)->GetWidth();
+  const gint height = (*grab_result_ptr)->GetHeight();
+  const GstPylonDebayerOutput output = self->debayer.GetOutput();
+  const gboolean debayer = GST_PYLON_DEBAYER_NONE != output;
+  const gboolean planar =
+      GST_PYLON_YUV_OUTPUT_NONE != self->yuv_convert.GetOutput();
+  const uint8_t *src =
+      static_cast<const uint8_t *>((*grab_result_ptr)->GetBuffer());
+  size_t src_stride = 0;
+  gsize dst_stride = 0;
+  gsize size = 0;
+  GstMapInfo info;
+
+  if (!(*grab_result_ptr)->GetStride(src_stride)) {
+    if (GST_PYLON_UNPACK_NONE != self->unpack.GetLayout()) {
+      src_stride = GstPylonUnpack::GetRowBytes(self->unpack.GetLayout(), width);
+    } else {
+      src_stride =
+          (width * Pylon::BitPerPixel((*grab_result_ptr)->GetPixelType()) +
+           7) /
+          8;
+    }
+    src_stride += (*grab_result_ptr)->GetPaddingX();
+  }
+
+  if (planar) {
+    dst_stride = GST_VIDEO_INFO_PLANE_STRIDE(&self->convert_info, 0);
+    size = GST_VIDEO_INFO_SIZE(&self->convert_info);
+  } else {
+    dst_stride = GST_ROUND_UP_4(
+        width * (debayer ? GstPylonDebayer::GetPixelSize(output) : 2));
+    size = dst_stride * height;
+  }
+
+  *buf = gst_pylon_acquire_converted_buffer(self, size);
+  gst_buffer_map(*buf, &info, GST_MAP_WRITE);
+  if (planar) {
+    uint8_t *planes[GST_VIDEO_MAX_PLANES] = {NULL};
+    size_t strides[GST_VIDEO_MAX_PLANES] = {0};
+
+    for (guint p = 0; p < GST_VIDEO_INFO_N_PLANES(&self->convert_info); p++) {
+      planes[p] =
+          info.data + GST_VIDEO_INFO_PLANE_OFFSET(&self->convert_info, p);
+      strides[p] = GST_VIDEO_INFO_PLANE_STRIDE(&self->convert_info, p);
+    }
+    self->yuv_convert.Process(src, src_stride, planes, strides, width, height,
+                              self->convert_pool.get());
+  } else if (debayer) {
+    self->debayer.Process(src, src_stride, info.data, dst_stride, width,
+                          height, self->convert_pool.get());
+  } else {
+    self->unpack.Process(src, src_stride,
+                         reinterpret_cast<uint16_t *>(info.data), dst_stride,
+                         width, height, self->convert_pool.get());
+  }
+  gst_buffer_unmap(*buf, &info);
+
+  return dst_stride;
 }
 
 static void free_ptr_grab_result(gpointer data) {
@@ -1346,6 +2240,7 @@ gboolean gst_pylon_capture(GstPylon *self, GstBuffer **buf,
   gint retry_frame_counter = 0;
   static const gint max_frames_to_skip = G_MAXINT - 16;
   Pylon::CBaslerUniversalGrabResultPtr *grab_result_ptr = NULL;
+  gsize converted_stride = 0;
 
   while (retry_grab) {
     grab_result_ptr = self->image_handler.WaitForImage();
@@ -1432,20 +2327,27 @@ gboolean gst_pylon_capture(GstPylon *self, GstBuffer **buf,
     *buf = gst_buffer_new_wrapped_full(
         GST_MEMORY_FLAG_READONLY, surf, sizeof(*surf), 0, sizeof(*surf),
         buffer_ref, static_cast<GDestroyNotify>(free_ptr_grab_result));
-  } else {
+  } else if (gst_pylon_is_converting(self)) {
+#else
+  if (gst_pylon_is_converting(self)) {
 #endif
+    converted_stride = gst_pylon_convert_result(self, buf, grab_result_ptr);
+  } else {
     gsize buffer_size = (*grab_result_ptr)->GetImageSize();
     auto buffer_ref = new GrabResultPair(self->buffer_factory, grab_result_ptr);
     *buf = gst_buffer_new_wrapped_full(
         static_cast<GstMemoryFlags>(0), (*grab_result_ptr)->GetBuffer(),
         buffer_size, 0, buffer_size, buffer_ref,
         static_cast<GDestroyNotify>(free_ptr_grab_result));
-#ifdef NVMM_ENABLED
   }
-#endif
 
   gst_pylon_add_result_meta(self, *buf, *grab_result_ptr);
 
+  /* pylon reports the stride of the camera rows */
+  if (converted_stride) {
+    gst_buffer_get_pylon_meta(*buf)->stride = converted_stride;
+  }
+
   // Debug output for HDR sequences - show actual exposure time of captured frame
   try {
     static gint frame_counter = 0;
@@ -1506,6 +2408,10 @@ gboolean gst_pylon_capture(GstPylon *self, GstBuffer **buf,
     GST_DEBUG("Could not read exposure time for debug: %s", e.GetDescription());
   }
 
+  if (converted_stride) {
+    delete grab_result_ptr;
+  }
+
   return TRUE;
 }
 
@@ -1542,8 +2448,13 @@ static std::vector<std::string> gst_pylon_pfnc_list_to_gst(
     std::vector<std::string> gst_fmts =
         gst_pylon_pfnc_to_gst(std::string(genapi_fmt), pixel_format_mapping);
 
-    /* Insert every matching gst format */
-    formats_list.insert(formats_list.end(), gst_fmts.begin(), gst_fmts.end());
+    /* Insert every matching gst format, once */
+    for (const auto &gst_fmt : gst_fmts) {
+      if (std::find(formats_list.begin(), formats_list.end(), gst_fmt) ==
+          formats_list.end()) {
+        formats_list.push_back(gst_fmt);
+      }
+    }
   }
 
   return formats_list;
@@ -1687,11 +2598,141 @@ static void gst_pylon_query_caps(
     g_value_unset(&value);
   }
 
+  /* the regions are stitched into a frame of a single size */
+  if (!self->rois.empty()) {
+    gst_structure_set(st, "width", G_TYPE_INT, self->roi_width, "height",
+                      G_TYPE_INT, self->roi_height, NULL);
+  }
+
   /* Reset offset after querying */
   self->camera->OffsetX.TrySetValue(orig_offset_x);
   self->camera->OffsetY.TrySetValue(orig_offset_y);
 }
 
+static bool gst_pylon_set_scaling(GstPylon *self, const std::string &feature,
+                                  gint64 factor) {
+  GenApi::INodeMap &nodemap = self->camera->GetNodeMap();
+  Pylon::CIntegerParameter horizontal(nodemap,
+                                      (feature + "Horizontal").c_str());
+  Pylon::CIntegerParameter vertical(nodemap, (feature + "Vertical").c_str());
+
+  /* cameras without the feature only support the factor 1 */
+  if (1 == factor && !horizontal.IsValid() && !vertical.IsValid()) {
+    return true;
+  }
+
+  return horizontal.TrySetValue(factor) && vertical.TrySetValue(factor);
+}
+
+/* Reads the full frame size at every factor supported in both directions,
+ * binning first as it keeps the light of the pixels combined. Expects
+ * binning and decimation to be off. */
+static void gst_pylon_query_scalings(GstPylon *self) {
+  GenApi::INodeMap &nodemap = self->camera->GetNodeMap();
+
+  if (self->camera->IsGrabbing()) {
+    return;
+  }
+
+  self->scalings.clear();
+
+  for (const auto &feature : scaling_features) {
+    Pylon::CIntegerParameter horizontal(
+        nodemap, (std::string(feature) + "Horizontal").c_str());
+    Pylon::CIntegerParameter vertical(
+        nodemap, (std::string(feature) + "Vertical").c_str());
+
+    if (!horizontal.IsWritable() || !vertical.IsWritable()) {
+      continue;
+    }
+
+    gint64 max_factor = std::min(horizontal.GetMax(), vertical.GetMax());
+    for (gint64 factor = 2; factor <= max_factor; factor++) {
+      bool known = std::any_of(
+          self->scalings.begin(), self->scalings.end(),
+          [factor](const GstPylonScaling &s) { return s.factor == factor; });
+
+      if (known || !horizontal.TrySetValue(factor) ||
+          !vertical.TrySetValue(factor)) {
+        continue;
+      }
+
+      self->scalings.push_back(
+          {feature, factor, static_cast<gint>(self->camera->Width.GetMax()),
+           static_cast<gint>(self->camera->Height.GetMax())});
+      GST_DEBUG("%s %" G_GINT64_FORMAT ": %dx%d", feature, factor,
+                self->scalings.back().width, self->scalings.back().height);
+    }
+
+    horizontal.TrySetValue(1);
+    vertical.TrySetValue(1);
+  }
+}
+
+/* A full field of view at a reduced size is read out binned or decimated,
+ * other sizes are cropped at full resolution */
+static void gst_pylon_apply_scaling(GstPylon *self, gint width, gint height) {
+  auto scaling = std::find_if(self->scalings.begin(), self->scalings.end(),
+                              [width, height](const GstPylonScaling &s) {
+                                return s.width == width && s.height == height;
+                              });
+
+  if (scaling != self->scalings.end()) {
+    for (const auto &feature : scaling_features) {
+      gint64 factor = scaling->feature == feature ? scaling->factor : 1;
+
+      if (!gst_pylon_set_scaling(self, feature, factor)) {
+        throw Pylon::GenericException(
+            (std::string("Unable to set ") + feature + " " +
+             std::to_string(factor))
+                .c_str(),
+            __FILE__, __LINE__);
+      }
+    }
+    GST_INFO("Set Feature %sHorizontal/%sVertical: %" G_GINT64_FORMAT,
+             scaling->feature.c_str(), scaling->feature.c_str(),
+             scaling->factor);
+    self->scaling_applied = true;
+    return;
+  }
+
+  /* factors set by the user are kept as long as the size fits */
+  GenApi::INodeMap &nodemap = self->camera->GetNodeMap();
+  Pylon::CIntegerParameter width_max(nodemap, "WidthMax");
+  Pylon::CIntegerParameter height_max(nodemap, "HeightMax");
+
+  if (self->scaling_applied ||
+      (width_max.IsReadable() && width > width_max.GetValue()) ||
+      (height_max.IsReadable() && height > height_max.GetValue())) {
+    for (const auto &feature : scaling_features) {
+      gst_pylon_set_scaling(self, feature, 1);
+    }
+    self->scaling_applied = false;
+  }
+}
+
+gboolean gst_pylon_get_scaled_size(GstPylon *self, gint max_width,
+                                   gint max_height, gint *width,
+                                   gint *height) {
+  g_return_val_if_fail(self, FALSE);
+  g_return_val_if_fail(width, FALSE);
+  g_return_val_if_fail(height, FALSE);
+
+  gboolean found = FALSE;
+
+  /* the largest one that fits */
+  for (const auto &scaling : self->scalings) {
+    if (scaling.width <= max_width && scaling.height <= max_height &&
+        (!found || scaling.width * scaling.height > *width * *height)) {
+      *width = scaling.width;
+      *height = scaling.height;
+      found = TRUE;
+    }
+  }
+
+  return found;
+}
+
 GstCaps *gst_pylon_query_configuration(GstPylon *self, GError **err) {
   g_return_val_if_fail(self, NULL);
   g_return_val_if_fail(err && *err == NULL, NULL);
@@ -1699,19 +2740,43 @@ GstCaps *gst_pylon_query_configuration(GstPylon *self, GError **err) {
   /* Build gst caps */
   GstCaps *caps = gst_caps_new_empty();
 
+  /* sizes are reported at full resolution, the binned and decimated full
+   * frames are among them */
+  GstPylonFullResolution full_resolution(*self->camera);
+
+  try {
+    /* binned regions would not cover what the user selected */
+    if (self->rois.empty()) {
+      gst_pylon_query_scalings(self);
+    } else {
+      self->scalings.clear();
+    }
+  } catch (const Pylon::GenericException &e) {
+    GST_WARNING("Failed to query binning and decimation: %s",
+                e.GetDescription());
+    self->scalings.clear();
+  }
+
   for (const auto &gst_structure_format : gst_structure_formats) {
     GstStructure *st =
         gst_structure_new_empty(gst_structure_format.st_name.c_str());
     try {
       gst_pylon_query_caps(self, st, gst_structure_format.format_map);
+      if (gst_structure_format.colorimetry) {
+        gst_structure_set(st, "colorimetry", G_TYPE_STRING,
+                          gst_structure_format.colorimetry, NULL);
+      }
       gst_caps_append_structure(caps, st);
 
 #ifdef NVMM_ENABLED
       /* We need the copy since the append has taken ownership of the "old" st
+       * Converted formats are produced in system memory only.
        */
-      gst_caps_append_structure_full(
-          caps, gst_structure_copy(st),
-          gst_caps_features_new("memory:NVMM", NULL));
+      if (!gst_structure_format.converted) {
+        gst_caps_append_structure_full(
+            caps, gst_structure_copy(st),
+            gst_caps_features_new("memory:NVMM", NULL));
+      }
 #endif
 
     } catch (const Pylon::GenericException &e) {
@@ -1766,15 +2831,51 @@ gboolean gst_pylon_set_configuration(GstPylon *self, const GstCaps *conf,
           __LINE__);
     }
 
+    const std::string st_name = gst_structure_get_name(st);
     bool fmt_valid = false;
+    GstPylonUnpackLayout unpack_layout = GST_PYLON_UNPACK_NONE;
+    gint unpack_shift = 0;
+    GstPylonBayerPattern bayer_pattern = GST_PYLON_BAYER_RGGB;
+    GstPylonDebayerOutput debayer_output = GST_PYLON_DEBAYER_NONE;
+    GstPylonYuvInput yuv_input = GST_PYLON_YUV_INPUT_NONE;
     for (const auto &gst_structure_format : gst_structure_formats) {
-      const std::vector<std::string> pfnc_formats =
+      if (fmt_valid || gst_structure_format.st_name != st_name) {
+        continue;
+      }
+
+      std::vector<std::string> pfnc_formats =
           gst_pylon_gst_to_pfnc(gst_format, gst_structure_format.format_map);
 
+      /* packed formats trade host CPU time for link bandwidth */
+      std::stable_partition(
+          pfnc_formats.begin(), pfnc_formats.end(),
+          [self](const std::string &fmt) {
+            return self->packed_formats ==
+                   (GST_PYLON_UNPACK_NONE != GstPylonUnpack::GetLayout(fmt));
+          });
+
       /* In case of ambiguous format mapping choose first */
       for (auto &fmt : pfnc_formats) {
         fmt_valid = pixelformat.TrySetValue(fmt.c_str());
-        if (fmt_valid) break;
+        if (fmt_valid) {
+          unpack_layout = GstPylonUnpack::GetLayout(fmt);
+          /* GRAY16_LE samples use the full 16-bit range, the 10 and 12-bit
+           * bayer caps carry right aligned samples */
+          if ("GRAY16_LE" == gst_format) {
+            unpack_shift = 16 - GstPylonUnpack::GetSampleBits(fmt);
+            if (unpack_shift > 0 && GST_PYLON_UNPACK_NONE == unpack_layout) {
+              unpack_layout = GST_PYLON_UNPACK_16;
+            }
+          }
+          if (gst_structure_format.converted &&
+              GstPylonDebayer::GetPattern(fmt, &bayer_pattern)) {
+            debayer_output = GstPylonDebayer::GetOutput(gst_format);
+          } else if (gst_structure_format.converted) {
+            yuv_input = GstPylonYuvConvert::GetInput(fmt);
+          }
+          GST_INFO("Set Feature PixelFormat: %s", fmt.c_str());
+          break;
+        }
       }
     }
 
@@ -1784,13 +2885,42 @@ gboolean gst_pylon_set_configuration(GstPylon *self, const GstCaps *conf,
           __FILE__, __LINE__);
     }
 
-    Pylon::CIntegerParameter width(nodemap, "Width");
-    width.SetValue(gst_width, Pylon::IntegerValueCorrection_None);
-    GST_INFO("Set Feature Width: %d", gst_width);
+    self->unpack.Configure(unpack_layout, unpack_shift);
+    self->debayer.Configure(bayer_pattern, debayer_output);
+    self->yuv_convert.Configure(yuv_input,
+                                GstPylonYuvConvert::GetOutput(gst_format));
+    if (GST_PYLON_YUV_OUTPUT_NONE != self->yuv_convert.GetOutput() &&
+        !gst_video_info_from_caps(&self->convert_info, conf)) {
+      throw Pylon::GenericException(
+          "Unable to compute the plane layout of the configuration", __FILE__,
+          __LINE__);
+    }
+    /* the frame size may have changed */
+    gst_pylon_release_converted_buffers(self);
+    if (gst_pylon_is_converting(self) && !self->convert_pool) {
+      self->convert_pool.reset(new GstPylonWorkerPool());
+    }
+
+    /* the regions define the frame size */
+    const bool multiple_roi = !self->rois.empty();
+    if (multiple_roi) {
+      if (gst_width != self->roi_width || gst_height != self->roi_height) {
+        std::string msg = "The regions are stitched into a " +
+                          std::to_string(self->roi_width) + "x" +
+                          std::to_string(self->roi_height) + " frame";
+        throw Pylon::GenericException(msg.c_str(), __FILE__, __LINE__);
+      }
+    } else {
+      gst_pylon_apply_scaling(self, gst_width, gst_height);
 
-    Pylon::CIntegerParameter height(nodemap, "Height");
-    height.SetValue(gst_height, Pylon::IntegerValueCorrection_None);
-    GST_INFO("Set Feature Height: %d", gst_height);
+      Pylon::CIntegerParameter width(nodemap, "Width");
+      width.SetValue(gst_width, Pylon::IntegerValueCorrection_None);
+      GST_INFO("Set Feature Width: %d", gst_width);
+
+      Pylon::CIntegerParameter height(nodemap, "Height");
+      height.SetValue(gst_height, Pylon::IntegerValueCorrection_None);
+      GST_INFO("Set Feature Height: %d", gst_height);
+    }
 
     /* set the cached offsetx/y values
      * respect the rounding value adjustment rules
@@ -1805,8 +2935,9 @@ gboolean gst_pylon_set_configuration(GstPylon *self, const GstCaps *conf,
     auto &offsety_cache = cam_properties->dimension_cache.offsety;
     auto enable_correction = cam_properties->enable_correction;
 
+    /* offsets are kept for when the regions are dropped */
     bool value_corrected = false;
-    if (offsetx_cache >= 0) {
+    if (!multiple_roi && offsetx_cache >= 0) {
       Pylon::CIntegerParameter offsetx(nodemap, "OffsetX");
       if (enable_correction) {
         try {
@@ -1829,7 +2960,7 @@ gboolean gst_pylon_set_configuration(GstPylon *self, const GstCaps *conf,
     }
 
     value_corrected = false;
-    if (offsety_cache >= 0) {
+    if (!multiple_roi && offsety_cache >= 0) {
       Pylon::CIntegerParameter offsety(nodemap, "OffsetY");
       if (enable_correction) {
         try {
@@ -1899,123 +3030,74 @@ gboolean gst_pylon_set_configuration(GstPylon *self, const GstCaps *conf,
   return TRUE;
 }
 
-static void gst_pylon_append_properties(
-    Pylon::CBaslerUniversalInstantCamera *camera,
-    const std::string &device_full_name, const std::string &device_type_str,
-    GstPylonCache &feature_cache, GenApi::INodeMap &nodemap,
-    gchar **device_properties, guint alignment) {
-  g_return_if_fail(camera);
-  g_return_if_fail(device_properties);
-
-  GType device_type =
-      gst_pylon_object_register(device_full_name, feature_cache, nodemap);
-  GObject *device_obj = G_OBJECT(g_object_new(device_type, NULL));
-
-  gchar *device_name = g_strdup_printf(
-      "%*s %s:\n", alignment, camera->GetDeviceInfo().GetFriendlyName().c_str(),
-      device_type_str.c_str());
-
-  gchar *properties = gst_child_inspector_properties_to_string(
-      device_obj, alignment, device_name);
-
-  if (NULL == *device_properties) {
-    *device_properties = g_strdup(properties);
-  } else {
-    *device_properties =
-        g_strconcat(*device_properties, "\n", properties, NULL);
-  }
-
-  g_free(device_name);
-  g_free(properties);
-
-  g_object_unref(device_obj);
-}
-
-static void gst_pylon_append_camera_properties(
-    Pylon::CBaslerUniversalInstantCamera *camera, gchar **camera_properties,
-    guint alignment) {
-  g_return_if_fail(camera);
-  g_return_if_fail(camera_properties);
-
-  GenApi::INodeMap &nodemap = camera->GetNodeMap();
-  std::string camera_name = gst_pylon_get_camera_fullname(*camera);
-  std::string device_type = "Camera";
-  std::string cache_filename =
-      std::string(camera->DeviceModelName.GetValue() + "_" +
-                  camera->DeviceFirmwareVersion.GetValue() + "_" + VERSION);
-
-  GstPylonCache feature_cache(cache_filename);
-
-  gst_pylon_append_properties(camera, camera_name, device_type, feature_cache,
-                              nodemap, camera_properties, alignment);
-}
-
-static void gst_pylon_append_stream_grabber_properties(
-    Pylon::CBaslerUniversalInstantCamera *camera, gchar **sgrabber_properties,
-    guint alignment) {
-  g_return_if_fail(camera);
-  g_return_if_fail(sgrabber_properties);
+/* Documents the properties of every device described in the feature cache
+ * directory, without touching the devices themselves. Caches written by
+ * other plugin versions are skipped, they may not match what this version
+ * installs. */
+static gchar *gst_pylon_get_cached_string_properties(
+    const gchar *name_suffix, const gchar *device_type_str) {
+  gchar *device_properties = NULL;
 
-  GenApi::INodeMap &nodemap = camera->GetStreamGrabberNodeMap();
-  std::string sgrabber_name = gst_pylon_get_sgrabber_name(*camera);
-  std::string device_type = "Stream Grabber";
-  std::string cache_filename =
-      std::string(camera->GetDeviceInfo().GetModelName() + "_" +
-                  Pylon::GetPylonVersionString() + "_" + VERSION);
+  for (const auto &path : GstPylonCache::ListCacheFiles()) {
+    std::vector<GParamSpec *> specs;
+    std::string name;
 
-  GstPylonCache feature_cache(cache_filename);
+    try {
+      std::unique_ptr<GstPylonCache> cache = GstPylonCache::FromFile(path);
+      name = cache->GetName();
 
-  gst_pylon_append_properties(camera, sgrabber_name, device_type, feature_cache,
-                              nodemap, sgrabber_properties, alignment);
-}
+      if (!g_str_has_suffix(name.c_str(), name_suffix)) {
+        continue;
+      }
 
-static gchar *gst_pylon_get_string_properties(
-    GetStringProperties get_device_string_properties) {
-  gchar *camera_properties = NULL;
+      specs = cache->GetParamSpecs();
+    } catch (const Pylon::GenericException &e) {
+      GST_DEBUG("Skipping feature cache %s: %s", path.c_str(),
+                e.GetDescription());
+      continue;
+    }
 
-  Pylon::CTlFactory &factory = Pylon::CTlFactory::GetInstance();
-  Pylon::DeviceInfoList_t device_list;
+    if (specs.empty()) {
+      continue;
+    }
 
-  factory.EnumerateDevices(device_list);
+    for (const auto &spec : specs) {
+      g_param_spec_ref_sink(spec);
+    }
 
-  for (const auto &device : device_list) {
-    try {
-      Pylon::CBaslerUniversalInstantCamera camera(factory.CreateDevice(device),
-                                                  Pylon::Cleanup_Delete);
-      camera.Open();
+    name.resize(name.size() - strlen(name_suffix));
+    gchar *device_name = g_strdup_printf("%*s %s:\n", DEFAULT_ALIGNMENT,
+                                         name.c_str(), device_type_str);
 
-      /* Set the camera to a valid state
-       * close left open transactions on the device
-       */
-      camera.DeviceFeaturePersistenceEnd.TryExecute();
-      camera.DeviceRegistersStreamingEnd.TryExecute();
+    gchar *properties = gst_child_inspector_param_specs_to_string(
+        specs.data(), specs.size(), DEFAULT_ALIGNMENT, device_name);
 
-      /* Set the camera to a valid state
-       * load the factory default set
-       */
-      if (camera.UserSetSelector.IsWritable()) {
-        camera.UserSetSelector.SetValue("Default");
-        camera.UserSetLoad.Execute();
-      }
+    if (NULL == device_properties) {
+      device_properties = properties;
+    } else {
+      gchar *joined = g_strconcat(device_properties, "\n", properties, NULL);
+      g_free(device_properties);
+      g_free(properties);
+      device_properties = joined;
+    }
 
-      get_device_string_properties(&camera, &camera_properties,
-                                   DEFAULT_ALIGNMENT);
-      camera.Close();
-    } catch (const Pylon::GenericException &) {
-      continue;
+    g_free(device_name);
+    for (const auto &spec : specs) {
+      g_param_spec_unref(spec);
     }
   }
 
-  return camera_properties;
+  return device_properties;
 }
 
 gchar *gst_pylon_camera_get_string_properties() {
-  return gst_pylon_get_string_properties(gst_pylon_append_camera_properties);
+  return gst_pylon_get_cached_string_properties(
+      GST_PYLON_OBJECT_CACHE_NAME_SUFFIX, "Camera");
 }
 
 gchar *gst_pylon_stream_grabber_get_string_properties() {
-  return gst_pylon_get_string_properties(
-      gst_pylon_append_stream_grabber_properties);
+  return gst_pylon_get_cached_string_properties(
+      GST_PYLON_OBJECT_SGRABBER_CACHE_NAME_SUFFIX, "Stream Grabber");
 }
 
 GObject *gst_pylon_get_camera(GstPylon *self) {
@@ -2030,6 +3112,15 @@ GObject *gst_pylon_get_stream_grabber(GstPylon *self) {
   return G_OBJECT(g_object_ref(self->gstream_grabber));
 }
 
+GstStructure *gst_pylon_apply_features(GstPylon *self,
+                                       const GstStructure *features) {
+  g_return_val_if_fail(self, NULL);
+  g_return_val_if_fail(features, NULL);
+
+  return gst_pylon_object_apply_properties(
+      reinterpret_cast<GstPylonObject *>(self->gcamera), features);
+}
+
 gboolean gst_pylon_is_same_device(GstPylon *self, const gint device_index,
                                   const gchar *device_user_name,
                                   const gchar *device_serial_number) {
@@ -2043,6 +3134,58 @@ gboolean gst_pylon_is_same_device(GstPylon *self, const gint device_index,
          self->requested_device_serial_number == serial_number;
 }
 
+gboolean gst_pylon_latch_timestamp(GstPylon *self, guint64 *ticks,
+                                   GError **err) {
+  g_return_val_if_fail(self, FALSE);
+  g_return_val_if_fail(ticks, FALSE);
+  g_return_val_if_fail(err && *err == NULL, FALSE);
+
+  try {
+    /* SFNC 2.x cameras (ace 2, boost, USB) latch in nanoseconds, GigE
+     * cameras following the GEV naming use their own tick frequency */
+    if (self->camera->TimestampLatch.IsWritable()) {
+      self->camera->TimestampLatch.Execute();
+      *ticks = self->camera->TimestampLatchValue.GetValue();
+    } else if (self->camera->GevTimestampControlLatch.IsWritable()) {
+      self->camera->GevTimestampControlLatch.Execute();
+      *ticks = self->camera->GevTimestampValue.GetValue();
+    } else {
+      throw Pylon::GenericException(
+          "Camera does not support latching its timestamp counter", __FILE__,
+          __LINE__);
+    }
+  } catch (const Pylon::GenericException &e) {
+    g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_FAILED, "%s",
+                e.GetDescription());
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+guint64 gst_pylon_get_timestamp_frequency(GstPylon *self) {
+  guint64 frequency = GST_SECOND;
+
+  g_return_val_if_fail(self, frequency);
+
+  try {
+    if (self->camera->GevTimestampTickFrequency.IsReadable()) {
+      frequency = self->camera->GevTimestampTickFrequency.GetValue();
+    }
+  } catch (const Pylon::GenericException &e) {
+    GST_WARNING("Failed to read timestamp tick frequency: %s",
+                e.GetDescription());
+  }
+
+  return frequency;
+}
+
+void gst_pylon_set_packed_formats(GstPylon *self, gboolean packed_formats) {
+  g_return_if_fail(self);
+
+  self->packed_formats = packed_formats;
+}
+
 #ifdef NVMM_ENABLED
 void gst_pylon_set_nvsurface_layout(
     GstPylon *self, const GstPylonNvsurfaceLayoutEnum nvsurface_layout) {
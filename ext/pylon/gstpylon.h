@@ -44,6 +44,15 @@ typedef enum {
   ENUM_ABORT = 2,
 } GstPylonCaptureErrorEnum;
 
+typedef enum {
+  ENUM_HDR_LOOKUP_EXPOSURE = 0,
+  ENUM_HDR_LOOKUP_SEQUENCER_SET = 1,
+} GstPylonHdrLookupEnum;
+
+/* upper bound of preprogrammed HDR profiles, the camera usually runs out of
+ * software signals or sequencer paths before that */
+#define GST_PYLON_HDR_MAX_PROFILES 8
+
 #ifdef NVMM_ENABLED
 typedef enum {
   ENUM_BLOCK_LINEAR = 0,
@@ -70,27 +79,53 @@ gboolean gst_pylon_capture(GstPylon *self, GstBuffer **buf,
 GstCaps *gst_pylon_query_configuration(GstPylon *self, GError **err);
 gboolean gst_pylon_get_startup_geometry(GstPylon *self, gint *start_width,
                                         gint *start_height);
+gboolean gst_pylon_get_scaled_size(GstPylon *self, gint max_width,
+                                   gint max_height, gint *width,
+                                   gint *height);
 gboolean gst_pylon_set_configuration(GstPylon *self, const GstCaps *conf,
                                      GError **err);
 gboolean gst_pylon_set_pfs_config(GstPylon *self, const gchar *pfs_location,
                                   GError **err);
+/* Parses one exposure[:gain] step of an HDR sequence, FALSE if the step
+ * is empty, malformed or its exposure is not positive */
+gboolean gst_pylon_parse_hdr_step(const gchar *step, gdouble *exposure,
+                                  gdouble *gain);
 gboolean gst_pylon_configure_hdr_sequence(GstPylon *self, const gchar *hdr_sequence,
                                           GError **err);
 gboolean gst_pylon_configure_dual_hdr_sequence(GstPylon *self,
                                                const gchar *hdr_sequence1,
                                                const gchar *hdr_sequence2,
                                                GError **err);
+gboolean gst_pylon_configure_hdr_profiles(GstPylon *self,
+                                          const gchar *const *sequences,
+                                          GError **err);
+gboolean gst_pylon_configure_events(GstPylon *self, const gchar *events,
+                                    GError **err);
+gboolean gst_pylon_configure_rois(GstPylon *self, const gchar *rois,
+                                  GError **err);
+gboolean gst_pylon_configure_sequencer_program(GstPylon *self,
+                                               const gchar *location,
+                                               GError **err);
 gboolean gst_pylon_switch_hdr_profile(GstPylon *self, gint profile, GError **err);
+gboolean gst_pylon_get_exposure_limits(GstPylon *self, gdouble *min,
+                                       gdouble *max, GError **err);
 gchar *gst_pylon_camera_get_string_properties();
 gchar *gst_pylon_stream_grabber_get_string_properties();
 
 GObject *gst_pylon_get_camera(GstPylon *self);
 GObject *gst_pylon_get_stream_grabber(GstPylon *self);
+GstStructure *gst_pylon_apply_features(GstPylon *self,
+                                       const GstStructure *features);
 
 gboolean gst_pylon_is_same_device(GstPylon *self, const gint device_index,
                                   const gchar *device_user_name,
                                   const gchar *device_serial_number);
 
+gboolean gst_pylon_latch_timestamp(GstPylon *self, guint64 *ticks,
+                                   GError **err);
+guint64 gst_pylon_get_timestamp_frequency(GstPylon *self);
+void gst_pylon_set_packed_formats(GstPylon *self, gboolean packed_formats);
+
 #ifdef NVMM_ENABLED
 void gst_pylon_set_nvsurface_layout(
     GstPylon *self, const GstPylonNvsurfaceLayoutEnum nvsurface_layout);
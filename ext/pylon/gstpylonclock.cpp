@@ -0,0 +1,365 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Pipeline clock derived from the camera timestamp counter
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "gst/pylon/gstpylondebug.h"
+#include "gstpylonclock.h"
+
+/* latches taking longer than this factor times the fastest latch seen so far
+ * were delayed on the link and are not used for calibration */
+static constexpr guint64 LATCH_COST_OUTLIER_FACTOR = 4;
+
+struct _GstPylonClock {
+  GstSystemClock parent;
+
+  GstPylon *pylon;
+  guint64 frequency;
+
+  GThread *thread;
+  GMutex lock;
+  GCond cond;
+  gboolean running;
+
+  GstClockTime latch_interval;
+  GstClockTime min_latch_cost;
+
+  /* statistics, protected by the object lock */
+  GstClockTimeDiff sync_error;
+  GstClockTime latch_cost;
+  guint64 latch_count;
+};
+
+enum {
+  PROP_0,
+  PROP_LATCH_INTERVAL,
+  PROP_SYNC_ERROR,
+  PROP_LATCH_COST,
+  PROP_DRIFT,
+  PROP_LATCH_COUNT,
+};
+
+#define PROP_LATCH_INTERVAL_DEFAULT GST_SECOND
+#define PROP_LATCH_INTERVAL_MIN (10 * GST_MSECOND)
+#define PROP_LATCH_INTERVAL_MAX (60 * GST_SECOND)
+
+static void gst_pylon_clock_set_property(GObject *object, guint property_id,
+                                         const GValue *value,
+                                         GParamSpec *pspec);
+static void gst_pylon_clock_get_property(GObject *object, guint property_id,
+                                         GValue *value, GParamSpec *pspec);
+static void gst_pylon_clock_finalize(GObject *object);
+static gboolean gst_pylon_clock_latch(GstPylonClock *self, GError **err);
+static gpointer gst_pylon_clock_latch_thread(gpointer data);
+
+G_DEFINE_TYPE(GstPylonClock, gst_pylon_clock, GST_TYPE_SYSTEM_CLOCK);
+
+static void gst_pylon_clock_class_init(GstPylonClockClass *klass) {
+  GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+
+  gobject_class->set_property = gst_pylon_clock_set_property;
+  gobject_class->get_property = gst_pylon_clock_get_property;
+  gobject_class->finalize = gst_pylon_clock_finalize;
+
+  g_object_class_install_property(
+      gobject_class, PROP_LATCH_INTERVAL,
+      g_param_spec_uint64(
+          "latch-interval", "Latch interval",
+          "Time in nanoseconds between two latches of the camera timestamp "
+          "counter.",
+          PROP_LATCH_INTERVAL_MIN, PROP_LATCH_INTERVAL_MAX,
+          PROP_LATCH_INTERVAL_DEFAULT,
+          static_cast<GParamFlags>(G_PARAM_READWRITE |
+                                   G_PARAM_STATIC_STRINGS)));
+  g_object_class_install_property(
+      gobject_class, PROP_SYNC_ERROR,
+      g_param_spec_int64(
+          "sync-error", "Sync error",
+          "Difference in nanoseconds between the last latched camera "
+          "timestamp and the time the clock predicted for it.",
+          G_MININT64, G_MAXINT64, 0,
+          static_cast<GParamFlags>(G_PARAM_READABLE | G_PARAM_STATIC_STRINGS)));
+  g_object_class_install_property(
+      gobject_class, PROP_LATCH_COST,
+      g_param_spec_uint64(
+          "latch-cost", "Latch cost",
+          "Host time in nanoseconds spent on the last timestamp latch round "
+          "trip.",
+          0, G_MAXUINT64, 0,
+          static_cast<GParamFlags>(G_PARAM_READABLE | G_PARAM_STATIC_STRINGS)));
+  g_object_class_install_property(
+      gobject_class, PROP_DRIFT,
+      g_param_spec_double(
+          "drift", "Drift",
+          "Calibrated drift of the camera counter against the host clock in "
+          "parts per million.",
+          -G_MAXDOUBLE, G_MAXDOUBLE, 0.0,
+          static_cast<GParamFlags>(G_PARAM_READABLE | G_PARAM_STATIC_STRINGS)));
+  g_object_class_install_property(
+      gobject_class, PROP_LATCH_COUNT,
+      g_param_spec_uint64(
+          "latch-count", "Latch count",
+          "Number of successful camera timestamp latches.", 0, G_MAXUINT64, 0,
+          static_cast<GParamFlags>(G_PARAM_READABLE | G_PARAM_STATIC_STRINGS)));
+}
+
+static void gst_pylon_clock_init(GstPylonClock *self) {
+  self->pylon = NULL;
+  self->frequency = GST_SECOND;
+  self->thread = NULL;
+  g_mutex_init(&self->lock);
+  g_cond_init(&self->cond);
+  self->running = FALSE;
+  self->latch_interval = PROP_LATCH_INTERVAL_DEFAULT;
+  self->min_latch_cost = GST_CLOCK_TIME_NONE;
+  self->sync_error = 0;
+  self->latch_cost = 0;
+  self->latch_count = 0;
+}
+
+static void gst_pylon_clock_set_property(GObject *object, guint property_id,
+                                         const GValue *value,
+                                         GParamSpec *pspec) {
+  GstPylonClock *self = GST_PYLON_CLOCK(object);
+
+  switch (property_id) {
+    case PROP_LATCH_INTERVAL:
+      g_mutex_lock(&self->lock);
+      self->latch_interval = g_value_get_uint64(value);
+      g_cond_signal(&self->cond);
+      g_mutex_unlock(&self->lock);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+      break;
+  }
+}
+
+static void gst_pylon_clock_get_property(GObject *object, guint property_id,
+                                         GValue *value, GParamSpec *pspec) {
+  GstPylonClock *self = GST_PYLON_CLOCK(object);
+  GstClockTime rate_num = 1;
+  GstClockTime rate_denom = 1;
+
+  switch (property_id) {
+    case PROP_LATCH_INTERVAL:
+      g_mutex_lock(&self->lock);
+      g_value_set_uint64(value, self->latch_interval);
+      g_mutex_unlock(&self->lock);
+      break;
+    case PROP_SYNC_ERROR:
+      GST_OBJECT_LOCK(self);
+      g_value_set_int64(value, self->sync_error);
+      GST_OBJECT_UNLOCK(self);
+      break;
+    case PROP_LATCH_COST:
+      GST_OBJECT_LOCK(self);
+      g_value_set_uint64(value, self->latch_cost);
+      GST_OBJECT_UNLOCK(self);
+      break;
+    case PROP_DRIFT:
+      gst_clock_get_calibration(GST_CLOCK(self), NULL, NULL, &rate_num,
+                                &rate_denom);
+      g_value_set_double(
+          value, (gdouble)rate_num / (gdouble)rate_denom * 1e6 - 1e6);
+      break;
+    case PROP_LATCH_COUNT:
+      GST_OBJECT_LOCK(self);
+      g_value_set_uint64(value, self->latch_count);
+      GST_OBJECT_UNLOCK(self);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+      break;
+  }
+}
+
+static void gst_pylon_clock_finalize(GObject *object) {
+  GstPylonClock *self = GST_PYLON_CLOCK(object);
+
+  gst_pylon_clock_detach(self);
+
+  g_mutex_clear(&self->lock);
+  g_cond_clear(&self->cond);
+
+  G_OBJECT_CLASS(gst_pylon_clock_parent_class)->finalize(object);
+}
+
+GstClock *gst_pylon_clock_new(const gchar *name) {
+  GstClock *clock =
+      GST_CLOCK(g_object_new(GST_TYPE_PYLON_CLOCK, "name", name, NULL));
+
+  /* clear floating flag */
+  gst_object_ref_sink(clock);
+
+  return clock;
+}
+
+GstClockTime gst_pylon_clock_ticks_to_time(GstPylonClock *self,
+                                           guint64 ticks) {
+  g_return_val_if_fail(GST_IS_PYLON_CLOCK(self), GST_CLOCK_TIME_NONE);
+
+  return gst_util_uint64_scale(ticks, GST_SECOND, self->frequency);
+}
+
+/* latch the camera counter and use the result as calibration point */
+static gboolean gst_pylon_clock_latch(GstPylonClock *self, GError **err) {
+  GstClock *clock = GST_CLOCK(self);
+  GstClockTime before = GST_CLOCK_TIME_NONE;
+  GstClockTime after = GST_CLOCK_TIME_NONE;
+  GstClockTime internal = GST_CLOCK_TIME_NONE;
+  GstClockTime external = GST_CLOCK_TIME_NONE;
+  GstClockTime predicted = GST_CLOCK_TIME_NONE;
+  GstClockTime cinternal = 0;
+  GstClockTime cexternal = 0;
+  GstClockTime rate_num = 1;
+  GstClockTime rate_denom = 1;
+  GstClockTimeDiff sync_error = 0;
+  GstClockTime cost = 0;
+  gdouble r_squared = 0.0;
+  guint64 ticks = 0;
+
+  before = gst_clock_get_internal_time(clock);
+  if (!gst_pylon_latch_timestamp(self->pylon, &ticks, err)) {
+    return FALSE;
+  }
+  after = gst_clock_get_internal_time(clock);
+
+  /* the latch happened somewhere within the round trip, assume the middle */
+  cost = after - before;
+  internal = before + cost / 2;
+  external = gst_pylon_clock_ticks_to_time(self, ticks);
+
+  if (0 == self->latch_count) {
+    gst_clock_set_calibration(clock, internal, external, 1, 1);
+  } else {
+    gst_clock_get_calibration(clock, &cinternal, &cexternal, &rate_num,
+                              &rate_denom);
+    predicted = gst_clock_adjust_with_calibration(
+        clock, internal, cinternal, cexternal, rate_num, rate_denom);
+    sync_error = GST_CLOCK_DIFF(predicted, external);
+
+    if (cost > self->min_latch_cost * LATCH_COST_OUTLIER_FACTOR) {
+      GST_DEBUG_OBJECT(self,
+                       "Latch took %" GST_TIME_FORMAT
+                       ", not using it for calibration",
+                       GST_TIME_ARGS(cost));
+    } else {
+      gst_clock_add_observation(clock, internal, external, &r_squared);
+    }
+  }
+
+  if (!GST_CLOCK_TIME_IS_VALID(self->min_latch_cost) ||
+      cost < self->min_latch_cost) {
+    self->min_latch_cost = cost;
+  }
+
+  GST_LOG_OBJECT(self,
+                 "Latched camera time %" GST_TIME_FORMAT " at %" GST_TIME_FORMAT
+                 ", sync error %" G_GINT64_FORMAT " ns, cost %" G_GUINT64_FORMAT
+                 " ns",
+                 GST_TIME_ARGS(external), GST_TIME_ARGS(internal), sync_error,
+                 cost);
+
+  GST_OBJECT_LOCK(self);
+  self->sync_error = sync_error;
+  self->latch_cost = cost;
+  self->latch_count++;
+  GST_OBJECT_UNLOCK(self);
+
+  return TRUE;
+}
+
+static gpointer gst_pylon_clock_latch_thread(gpointer data) {
+  GstPylonClock *self = GST_PYLON_CLOCK(data);
+  GError *error = NULL;
+  gint64 end_time = 0;
+
+  g_mutex_lock(&self->lock);
+  while (self->running) {
+    end_time =
+        g_get_monotonic_time() + self->latch_interval / GST_USECOND;
+
+    /* interval changes restart the wait, a stop request ends it */
+    while (self->running &&
+           g_cond_wait_until(&self->cond, &self->lock, end_time)) {
+    }
+
+    if (!self->running) {
+      break;
+    }
+
+    g_mutex_unlock(&self->lock);
+    if (!gst_pylon_clock_latch(self, &error)) {
+      GST_WARNING_OBJECT(self, "Failed to latch camera timestamp: %s",
+                         error->message);
+      g_clear_error(&error);
+    }
+    g_mutex_lock(&self->lock);
+  }
+  g_mutex_unlock(&self->lock);
+
+  return NULL;
+}
+
+gboolean gst_pylon_clock_attach(GstPylonClock *self, GstPylon *pylon,
+                                GError **err) {
+  g_return_val_if_fail(GST_IS_PYLON_CLOCK(self), FALSE);
+  g_return_val_if_fail(pylon, FALSE);
+  g_return_val_if_fail(err && *err == NULL, FALSE);
+
+  gst_pylon_clock_detach(self);
+
+  self->pylon = pylon;
+  self->frequency = gst_pylon_get_timestamp_frequency(pylon);
+  self->min_latch_cost = GST_CLOCK_TIME_NONE;
+
+  GST_OBJECT_LOCK(self);
+  self->latch_count = 0;
+  GST_OBJECT_UNLOCK(self);
+
+  /* calibrate synchronously so the clock is valid once provided */
+  if (!gst_pylon_clock_latch(self, err)) {
+    self->pylon = NULL;
+    return FALSE;
+  }
+
+  GST_INFO_OBJECT(self,
+                  "Camera clock attached, counter frequency %" G_GUINT64_FORMAT
+                  " Hz",
+                  self->frequency);
+
+  g_mutex_lock(&self->lock);
+  self->running = TRUE;
+  g_mutex_unlock(&self->lock);
+
+  self->thread =
+      g_thread_new("pylon-clock", gst_pylon_clock_latch_thread, self);
+
+  return TRUE;
+}
+
+void gst_pylon_clock_detach(GstPylonClock *self) {
+  g_return_if_fail(GST_IS_PYLON_CLOCK(self));
+
+  if (!self->thread) {
+    self->pylon = NULL;
+    return;
+  }
+
+  g_mutex_lock(&self->lock);
+  self->running = FALSE;
+  g_cond_signal(&self->cond);
+  g_mutex_unlock(&self->lock);
+
+  g_thread_join(self->thread);
+  self->thread = NULL;
+  self->pylon = NULL;
+
+  GST_INFO_OBJECT(self, "Camera clock detached, free running on last "
+                        "calibration");
+}
@@ -0,0 +1,38 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Pipeline clock derived from the camera timestamp counter
+ */
+
+#ifndef _GST_PYLON_CLOCK_H_
+#define _GST_PYLON_CLOCK_H_
+
+#include "gstpylon.h"
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_PYLON_CLOCK gst_pylon_clock_get_type()
+G_DECLARE_FINAL_TYPE(GstPylonClock, gst_pylon_clock, GST, PYLON_CLOCK,
+                     GstSystemClock)
+
+/**
+ * GstPylonClock:
+ *
+ * A #GstSystemClock whose time follows the timestamp counter of a camera.
+ * The counter is latched periodically from a background thread and every
+ * latch is fed to gst_clock_add_observation(), so the GstClock calibration
+ * interpolates between latches and tracks the drift between the camera and
+ * the host. When detached from the camera the clock keeps running on the
+ * last calibration.
+ */
+GstClock *gst_pylon_clock_new(const gchar *name);
+gboolean gst_pylon_clock_attach(GstPylonClock *self, GstPylon *pylon,
+                                GError **err);
+void gst_pylon_clock_detach(GstPylonClock *self);
+GstClockTime gst_pylon_clock_ticks_to_time(GstPylonClock *self,
+                                           guint64 ticks);
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,216 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Camera control thread for runtime feature writes
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "gstpyloncontrol.h"
+
+GST_DEBUG_CATEGORY_STATIC(gst_pylon_control_debug);
+#define GST_CAT_DEFAULT gst_pylon_control_debug
+
+#define NO_PROFILE_REQUEST -1
+
+typedef struct {
+  gchar *name;
+  GstPylonControlFunc func;
+  gpointer user_data;
+  GDestroyNotify notify;
+} GstPylonControlCommand;
+
+struct _GstPylonControl {
+  GstElement *element;
+  GstPylon *pylon;
+
+  GThread *thread;
+  GMutex lock;
+  GCond cond;
+  GQueue commands;
+  gint requested_profile;
+  gboolean busy;
+  gboolean stopping;
+};
+
+static void gst_pylon_control_command_free(GstPylonControlCommand *command) {
+  if (command->notify) {
+    command->notify(command->user_data);
+  }
+  g_free(command->name);
+  g_free(command);
+}
+
+static gboolean gst_pylon_control_switch_profile(GstPylon *pylon,
+                                                 gpointer user_data,
+                                                 GError **err) {
+  return gst_pylon_switch_hdr_profile(pylon, GPOINTER_TO_INT(user_data), err);
+}
+
+static void gst_pylon_control_execute(GstPylonControl *self,
+                                      const gchar *name,
+                                      GstPylonControlFunc func,
+                                      gpointer user_data) {
+  GError *error = NULL;
+  gint64 start = g_get_monotonic_time();
+
+  if (func(self->pylon, user_data, &error)) {
+    GST_DEBUG("Executed %s in %" G_GINT64_FORMAT " us", name,
+              g_get_monotonic_time() - start);
+    return;
+  }
+
+  GST_ELEMENT_WARNING(self->element, LIBRARY, SETTINGS,
+                      ("Failed to execute camera command \"%s\".", name),
+                      ("%s", error ? error->message : "Unknown error"));
+  g_clear_error(&error);
+}
+
+static gpointer gst_pylon_control_thread(gpointer data) {
+  GstPylonControl *self = static_cast<GstPylonControl *>(data);
+
+  g_mutex_lock(&self->lock);
+
+  for (;;) {
+    GstPylonControlCommand *command = NULL;
+    gint profile = NO_PROFILE_REQUEST;
+
+    while (!self->stopping && NO_PROFILE_REQUEST == self->requested_profile &&
+           g_queue_is_empty(&self->commands)) {
+      self->busy = FALSE;
+      g_cond_broadcast(&self->cond);
+      g_cond_wait(&self->cond, &self->lock);
+    }
+
+    if (self->stopping) {
+      break;
+    }
+
+    /* profile switches are latency critical, serve them first */
+    profile = self->requested_profile;
+    self->requested_profile = NO_PROFILE_REQUEST;
+    if (NO_PROFILE_REQUEST == profile) {
+      command =
+          static_cast<GstPylonControlCommand *>(g_queue_pop_head(&self->commands));
+    }
+    self->busy = TRUE;
+
+    g_mutex_unlock(&self->lock);
+
+    if (NO_PROFILE_REQUEST != profile) {
+      gst_pylon_control_execute(self, "switch HDR profile",
+                                gst_pylon_control_switch_profile,
+                                GINT_TO_POINTER(profile));
+    } else {
+      gst_pylon_control_execute(self, command->name, command->func,
+                                command->user_data);
+      gst_pylon_control_command_free(command);
+    }
+
+    g_mutex_lock(&self->lock);
+  }
+
+  self->busy = FALSE;
+  g_cond_broadcast(&self->cond);
+  g_mutex_unlock(&self->lock);
+
+  return NULL;
+}
+
+GstPylonControl *gst_pylon_control_new(GstElement *element, GstPylon *pylon) {
+  GstPylonControl *self = NULL;
+
+  g_return_val_if_fail(element, NULL);
+  g_return_val_if_fail(pylon, NULL);
+
+  GST_DEBUG_CATEGORY_INIT(gst_pylon_control_debug, "pyloncontrol", 0,
+                          "Pylon camera control thread");
+
+  self = g_new0(GstPylonControl, 1);
+  self->element = element;
+  self->pylon = pylon;
+  g_mutex_init(&self->lock);
+  g_cond_init(&self->cond);
+  g_queue_init(&self->commands);
+  self->requested_profile = NO_PROFILE_REQUEST;
+  self->busy = FALSE;
+  self->stopping = FALSE;
+
+  self->thread =
+      g_thread_new("pylon-control", gst_pylon_control_thread, self);
+
+  return self;
+}
+
+void gst_pylon_control_free(GstPylonControl *self) {
+  g_return_if_fail(self);
+
+  /* the command being executed completes, pending ones are dropped */
+  g_mutex_lock(&self->lock);
+  self->stopping = TRUE;
+  g_cond_broadcast(&self->cond);
+  g_mutex_unlock(&self->lock);
+
+  g_thread_join(self->thread);
+
+  if (!g_queue_is_empty(&self->commands)) {
+    GST_DEBUG("Dropping %u pending camera commands",
+              g_queue_get_length(&self->commands));
+  }
+  g_queue_foreach(&self->commands,
+                  reinterpret_cast<GFunc>(gst_pylon_control_command_free),
+                  NULL);
+  g_queue_clear(&self->commands);
+
+  g_mutex_clear(&self->lock);
+  g_cond_clear(&self->cond);
+  g_free(self);
+}
+
+void gst_pylon_control_push(GstPylonControl *self, const gchar *name,
+                            GstPylonControlFunc func, gpointer user_data,
+                            GDestroyNotify notify) {
+  GstPylonControlCommand *command = NULL;
+
+  g_return_if_fail(self);
+  g_return_if_fail(func);
+
+  command = g_new0(GstPylonControlCommand, 1);
+  command->name = g_strdup(name);
+  command->func = func;
+  command->user_data = user_data;
+  command->notify = notify;
+
+  g_mutex_lock(&self->lock);
+  g_queue_push_tail(&self->commands, command);
+  g_cond_broadcast(&self->cond);
+  g_mutex_unlock(&self->lock);
+}
+
+void gst_pylon_control_request_hdr_profile(GstPylonControl *self,
+                                           gint profile) {
+  g_return_if_fail(self);
+  g_return_if_fail(profile >= 0);
+
+  g_mutex_lock(&self->lock);
+  if (NO_PROFILE_REQUEST != self->requested_profile) {
+    GST_DEBUG("Profile %d request superseded by profile %d",
+              self->requested_profile, profile);
+  }
+  self->requested_profile = profile;
+  g_cond_broadcast(&self->cond);
+  g_mutex_unlock(&self->lock);
+}
+
+void gst_pylon_control_flush(GstPylonControl *self) {
+  g_return_if_fail(self);
+
+  g_mutex_lock(&self->lock);
+  while (!self->stopping &&
+         (self->busy || NO_PROFILE_REQUEST != self->requested_profile ||
+          !g_queue_is_empty(&self->commands))) {
+    g_cond_wait(&self->cond, &self->lock);
+  }
+  g_mutex_unlock(&self->lock);
+}
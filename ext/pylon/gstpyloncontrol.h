@@ -0,0 +1,45 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Camera control thread for runtime feature writes
+ */
+
+#ifndef _GST_PYLON_CONTROL_H_
+#define _GST_PYLON_CONTROL_H_
+
+#include "gstpylon.h"
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+typedef struct _GstPylonControl GstPylonControl;
+
+/* runs on the control thread, returns FALSE and sets err on failure */
+typedef gboolean (*GstPylonControlFunc)(GstPylon *pylon, gpointer user_data,
+                                        GError **err);
+
+/**
+ * GstPylonControl:
+ *
+ * Dedicated thread executing camera writes requested at runtime, so that
+ * blocking GenICam transactions never delay the streaming thread. Commands
+ * run in the order they were pushed. HDR profile switches have their own
+ * slot: a newer request replaces one not yet executed, and it runs before
+ * the queued commands.
+ *
+ * Failures are posted as element warnings on the owning element.
+ */
+GstPylonControl *gst_pylon_control_new(GstElement *element, GstPylon *pylon);
+void gst_pylon_control_free(GstPylonControl *self);
+
+void gst_pylon_control_push(GstPylonControl *self, const gchar *name,
+                            GstPylonControlFunc func, gpointer user_data,
+                            GDestroyNotify notify);
+void gst_pylon_control_request_hdr_profile(GstPylonControl *self,
+                                           gint profile);
+/* block until every command pushed so far has been executed */
+void gst_pylon_control_flush(GstPylonControl *self);
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,414 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Bilinear demosaicing of 8-bit Bayer frames
+ */
+
+#include "gstpylondebayer.h"
+
+#include <algorithm>
+
+/* Per pixel, with c the sample itself, h the mean of its left and right
+ * neighbours, v of the ones above and below, d of the four diagonals and
+ * cross of the four direct neighbours:
+ *
+ *   red or blue site: own color c, green cross, other color d
+ *   green site:       own color h, green c,     other color v
+ *
+ * where the own color is red on rows holding red samples. Means round up
+ * pairwise, as the SIMD averaging instructions do, so every code path
+ * produces the same output. */
+static inline uint8_t avg(uint8_t a, uint8_t b) {
+  return static_cast<uint8_t>((a + b + 1) >> 1);
+}
+
+static inline int mirror(int x, int size) {
+  if (x < 0) {
+    return size > 1 ? 1 : 0;
+  }
+  if (x >= size) {
+    return size > 1 ? size - 2 : 0;
+  }
+  return x;
+}
+
+static inline void store_pixel(uint8_t *dst, int x, uint8_t r, uint8_t g,
+                               uint8_t b, GstPylonDebayerOutput output) {
+  switch (output) {
+    case GST_PYLON_DEBAYER_RGB:
+      dst[x * 3] = r;
+      dst[x * 3 + 1] = g;
+      dst[x * 3 + 2] = b;
+      break;
+    case GST_PYLON_DEBAYER_BGRX:
+      dst[x * 4] = b;
+      dst[x * 4 + 1] = g;
+      dst[x * 4 + 2] = r;
+      dst[x * 4 + 3] = 0xFF;
+      break;
+    default:
+      dst[x] = avg(avg(r, b), g);
+      break;
+  }
+}
+
+static void debayer_row_scalar(const uint8_t *up, const uint8_t *row,
+                               const uint8_t *down, uint8_t *dst, int width,
+                               bool red_row, int site_parity,
+                               GstPylonDebayerOutput output, int x,
+                               int x_end) {
+  for (; x < x_end; x++) {
+    int left = mirror(x - 1, width);
+    int right = mirror(x + 1, width);
+    uint8_t h = avg(row[left], row[right]);
+    uint8_t v = avg(up[x], down[x]);
+    uint8_t d = avg(avg(up[left], up[right]), avg(down[left], down[right]));
+    bool site = (x & 1) == site_parity;
+    uint8_t own = site ? row[x] : h;
+    uint8_t g = site ? avg(h, v) : row[x];
+    uint8_t other = site ? d : v;
+
+    if (red_row) {
+      store_pixel(dst, x, own, g, other, output);
+    } else {
+      store_pixel(dst, x, other, g, own, output);
+    }
+  }
+}
+
+static void debayer_row_c(const uint8_t *up, const uint8_t *row,
+                          const uint8_t *down, uint8_t *dst, int width,
+                          bool red_row, int site_parity,
+                          GstPylonDebayerOutput output) {
+  debayer_row_scalar(up, row, down, dst, width, red_row, site_parity, output,
+                     0, width);
+}
+
+/* The SIMD loops start at x = 1, so the left neighbours of a block are in
+ * the row, and stop while the right ones are. Blocks start on odd columns,
+ * the color sites are the odd or even lanes depending on the row. */
+#if defined(GST_PYLON_ARCH_X86)
+alignas(16) static const uint8_t RGB_SHUFFLE[3][3][16] = {
+    {{0, 0x80, 0x80, 1, 0x80, 0x80, 2, 0x80, 0x80, 3, 0x80, 0x80, 4, 0x80,
+      0x80, 5},
+     {0x80, 0, 0x80, 0x80, 1, 0x80, 0x80, 2, 0x80, 0x80, 3, 0x80, 0x80, 4,
+      0x80, 0x80},
+     {0x80, 0x80, 0, 0x80, 0x80, 1, 0x80, 0x80, 2, 0x80, 0x80, 3, 0x80, 0x80,
+      4, 0x80}},
+    {{0x80, 0x80, 6, 0x80, 0x80, 7, 0x80, 0x80, 8, 0x80, 0x80, 9, 0x80, 0x80,
+      10, 0x80},
+     {5, 0x80, 0x80, 6, 0x80, 0x80, 7, 0x80, 0x80, 8, 0x80, 0x80, 9, 0x80,
+      0x80, 10},
+     {0x80, 5, 0x80, 0x80, 6, 0x80, 0x80, 7, 0x80, 0x80, 8, 0x80, 0x80, 9,
+      0x80, 0x80}},
+    {{0x80, 11, 0x80, 0x80, 12, 0x80, 0x80, 13, 0x80, 0x80, 14, 0x80, 0x80,
+      15, 0x80, 0x80},
+     {0x80, 0x80, 11, 0x80, 0x80, 12, 0x80, 0x80, 13, 0x80, 0x80, 14, 0x80,
+      0x80, 15, 0x80},
+     {10, 0x80, 0x80, 11, 0x80, 0x80, 12, 0x80, 0x80, 13, 0x80, 0x80, 14,
+      0x80, 0x80, 15}}};
+
+GST_PYLON_TARGET_SSE41 static inline __m128i rgb_block_sse41(
+    __m128i r, __m128i g, __m128i b, int block) {
+  const __m128i *masks = reinterpret_cast<const __m128i *>(RGB_SHUFFLE[block]);
+
+  return _mm_or_si128(
+      _mm_or_si128(_mm_shuffle_epi8(r, _mm_load_si128(&masks[0])),
+                   _mm_shuffle_epi8(g, _mm_load_si128(&masks[1]))),
+      _mm_shuffle_epi8(b, _mm_load_si128(&masks[2])));
+}
+
+/* stores 16 pixels */
+GST_PYLON_TARGET_SSE41 static inline void store_block_sse41(
+    uint8_t *dst, int x, __m128i r, __m128i g, __m128i b,
+    GstPylonDebayerOutput output) {
+  switch (output) {
+    case GST_PYLON_DEBAYER_RGB: {
+      __m128i *out = reinterpret_cast<__m128i *>(dst + x * 3);
+      _mm_storeu_si128(out, rgb_block_sse41(r, g, b, 0));
+      _mm_storeu_si128(out + 1, rgb_block_sse41(r, g, b, 1));
+      _mm_storeu_si128(out + 2, rgb_block_sse41(r, g, b, 2));
+      break;
+    }
+    case GST_PYLON_DEBAYER_BGRX: {
+      __m128i *out = reinterpret_cast<__m128i *>(dst + x * 4);
+      __m128i alpha = _mm_set1_epi8(-1);
+      __m128i bg_lo = _mm_unpacklo_epi8(b, g);
+      __m128i bg_hi = _mm_unpackhi_epi8(b, g);
+      __m128i ra_lo = _mm_unpacklo_epi8(r, alpha);
+      __m128i ra_hi = _mm_unpackhi_epi8(r, alpha);
+      _mm_storeu_si128(out, _mm_unpacklo_epi16(bg_lo, ra_lo));
+      _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(bg_lo, ra_lo));
+      _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(bg_hi, ra_hi));
+      _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(bg_hi, ra_hi));
+      break;
+    }
+    default:
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x),
+                       _mm_avg_epu8(_mm_avg_epu8(r, b), g));
+      break;
+  }
+}
+
+GST_PYLON_TARGET_SSE41 static inline __m128i load_sse41(const uint8_t *src) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+}
+
+GST_PYLON_TARGET_SSE41 static void debayer_row_sse41(
+    const uint8_t *up, const uint8_t *row, const uint8_t *down, uint8_t *dst,
+    int width, bool red_row, int site_parity,
+    GstPylonDebayerOutput output) {
+  const __m128i site =
+      _mm_set1_epi16(site_parity ? 0x00FF : static_cast<short>(0xFF00));
+  int x = 1;
+
+  debayer_row_scalar(up, row, down, dst, width, red_row, site_parity, output,
+                     0, std::min(1, width));
+
+  for (; x + 17 <= width; x += 16) {
+    __m128i c = load_sse41(row + x);
+    __m128i h = _mm_avg_epu8(load_sse41(row + x - 1), load_sse41(row + x + 1));
+    __m128i v = _mm_avg_epu8(load_sse41(up + x), load_sse41(down + x));
+    __m128i d = _mm_avg_epu8(
+        _mm_avg_epu8(load_sse41(up + x - 1), load_sse41(up + x + 1)),
+        _mm_avg_epu8(load_sse41(down + x - 1), load_sse41(down + x + 1)));
+    __m128i own = _mm_blendv_epi8(h, c, site);
+    __m128i g = _mm_blendv_epi8(c, _mm_avg_epu8(h, v), site);
+    __m128i other = _mm_blendv_epi8(v, d, site);
+
+    if (red_row) {
+      store_block_sse41(dst, x, own, g, other, output);
+    } else {
+      store_block_sse41(dst, x, other, g, own, output);
+    }
+  }
+
+  debayer_row_scalar(up, row, down, dst, width, red_row, site_parity, output,
+                     std::min(x, width), width);
+}
+
+GST_PYLON_TARGET_AVX2 static inline __m256i load_avx2(const uint8_t *src) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
+}
+
+GST_PYLON_TARGET_AVX2 static void debayer_row_avx2(
+    const uint8_t *up, const uint8_t *row, const uint8_t *down, uint8_t *dst,
+    int width, bool red_row, int site_parity,
+    GstPylonDebayerOutput output) {
+  const __m256i site =
+      _mm256_set1_epi16(site_parity ? 0x00FF : static_cast<short>(0xFF00));
+  int x = 1;
+
+  debayer_row_scalar(up, row, down, dst, width, red_row, site_parity, output,
+                     0, std::min(1, width));
+
+  for (; x + 33 <= width; x += 32) {
+    __m256i c = load_avx2(row + x);
+    __m256i h =
+        _mm256_avg_epu8(load_avx2(row + x - 1), load_avx2(row + x + 1));
+    __m256i v = _mm256_avg_epu8(load_avx2(up + x), load_avx2(down + x));
+    __m256i d = _mm256_avg_epu8(
+        _mm256_avg_epu8(load_avx2(up + x - 1), load_avx2(up + x + 1)),
+        _mm256_avg_epu8(load_avx2(down + x - 1), load_avx2(down + x + 1)));
+    __m256i own = _mm256_blendv_epi8(h, c, site);
+    __m256i g = _mm256_blendv_epi8(c, _mm256_avg_epu8(h, v), site);
+    __m256i other = _mm256_blendv_epi8(v, d, site);
+    __m256i r = red_row ? own : other;
+    __m256i b = red_row ? other : own;
+
+    /* the interleaving shuffles do not cross 128-bit lanes */
+    store_block_sse41(dst, x, _mm256_castsi256_si128(r),
+                      _mm256_castsi256_si128(g), _mm256_castsi256_si128(b),
+                      output);
+    store_block_sse41(dst, x + 16, _mm256_extracti128_si256(r, 1),
+                      _mm256_extracti128_si256(g, 1),
+                      _mm256_extracti128_si256(b, 1), output);
+  }
+
+  debayer_row_scalar(up, row, down, dst, width, red_row, site_parity, output,
+                     std::min(x, width), width);
+}
+#endif
+
+#if defined(GST_PYLON_ARCH_ARM64)
+static void debayer_row_neon(const uint8_t *up, const uint8_t *row,
+                             const uint8_t *down, uint8_t *dst, int width,
+                             bool red_row, int site_parity,
+                             GstPylonDebayerOutput output) {
+  const uint8x16_t site = vreinterpretq_u8_u16(
+      vdupq_n_u16(site_parity ? 0x00FF : 0xFF00));
+  const uint8x16_t alpha = vdupq_n_u8(0xFF);
+  int x = 1;
+
+  debayer_row_scalar(up, row, down, dst, width, red_row, site_parity, output,
+                     0, std::min(1, width));
+
+  for (; x + 17 <= width; x += 16) {
+    uint8x16_t c = vld1q_u8(row + x);
+    uint8x16_t h = vrhaddq_u8(vld1q_u8(row + x - 1), vld1q_u8(row + x + 1));
+    uint8x16_t v = vrhaddq_u8(vld1q_u8(up + x), vld1q_u8(down + x));
+    uint8x16_t d =
+        vrhaddq_u8(vrhaddq_u8(vld1q_u8(up + x - 1), vld1q_u8(up + x + 1)),
+                   vrhaddq_u8(vld1q_u8(down + x - 1), vld1q_u8(down + x + 1)));
+    uint8x16_t own = vbslq_u8(site, c, h);
+    uint8x16_t g = vbslq_u8(site, vrhaddq_u8(h, v), c);
+    uint8x16_t other = vbslq_u8(site, d, v);
+    uint8x16_t r = red_row ? own : other;
+    uint8x16_t b = red_row ? other : own;
+
+    switch (output) {
+      case GST_PYLON_DEBAYER_RGB: {
+        uint8x16x3_t pixels = {{r, g, b}};
+        vst3q_u8(dst + x * 3, pixels);
+        break;
+      }
+      case GST_PYLON_DEBAYER_BGRX: {
+        uint8x16x4_t pixels = {{b, g, r, alpha}};
+        vst4q_u8(dst + x * 4, pixels);
+        break;
+      }
+      default:
+        vst1q_u8(dst + x, vrhaddq_u8(vrhaddq_u8(r, b), g));
+        break;
+    }
+  }
+
+  debayer_row_scalar(up, row, down, dst, width, red_row, site_parity, output,
+                     std::min(x, width), width);
+}
+#endif
+
+static GstPylonDebayerRowFunc select_debayer_row(GstPylonSimdLevel level) {
+  switch (level) {
+#if defined(GST_PYLON_ARCH_X86)
+    case GST_PYLON_SIMD_AVX2:
+      return debayer_row_avx2;
+    case GST_PYLON_SIMD_SSE41:
+      return debayer_row_sse41;
+#endif
+#if defined(GST_PYLON_ARCH_ARM64)
+    case GST_PYLON_SIMD_NEON:
+      return debayer_row_neon;
+#endif
+    default:
+      return debayer_row_c;
+  }
+}
+
+GstPylonDebayer::GstPylonDebayer()
+    : pattern(GST_PYLON_BAYER_RGGB),
+      output(GST_PYLON_DEBAYER_NONE),
+      simd_level(gst_pylon_simd_detect()),
+      debayer_row(select_debayer_row(simd_level)) {}
+
+bool GstPylonDebayer::GetPattern(const std::string &pfnc_name,
+                                 GstPylonBayerPattern *pattern) {
+  static const struct {
+    const char *pfnc_name;
+    GstPylonBayerPattern pattern;
+  } patterns[] = {{"BayerRG8", GST_PYLON_BAYER_RGGB},
+                  {"BayerBG8", GST_PYLON_BAYER_BGGR},
+                  {"BayerGR8", GST_PYLON_BAYER_GRBG},
+                  {"BayerGB8", GST_PYLON_BAYER_GBRG}};
+
+  for (const auto &entry : patterns) {
+    if (pfnc_name == entry.pfnc_name) {
+      *pattern = entry.pattern;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+GstPylonDebayerOutput GstPylonDebayer::GetOutput(
+    const std::string &gst_format) {
+  if ("RGB" == gst_format) {
+    return GST_PYLON_DEBAYER_RGB;
+  }
+  if ("BGRx" == gst_format) {
+    return GST_PYLON_DEBAYER_BGRX;
+  }
+  if ("GRAY8" == gst_format) {
+    return GST_PYLON_DEBAYER_GRAY8;
+  }
+
+  return GST_PYLON_DEBAYER_NONE;
+}
+
+int GstPylonDebayer::GetPixelSize(GstPylonDebayerOutput output) {
+  switch (output) {
+    case GST_PYLON_DEBAYER_RGB:
+      return 3;
+    case GST_PYLON_DEBAYER_BGRX:
+      return 4;
+    default:
+      return 1;
+  }
+}
+
+void GstPylonDebayer::Configure(GstPylonBayerPattern pattern,
+                                GstPylonDebayerOutput output) {
+  this->pattern = pattern;
+  this->output = output;
+}
+
+GstPylonDebayerOutput GstPylonDebayer::GetOutput() const {
+  return this->output;
+}
+
+GstPylonSimdLevel GstPylonDebayer::GetSimdLevel() const {
+  return this->simd_level;
+}
+
+void GstPylonDebayer::SetSimdLevel(GstPylonSimdLevel level) {
+  GstPylonSimdLevel cpu = gst_pylon_simd_detect_cpu();
+
+  if (GST_PYLON_SIMD_SCALAR == level || level == cpu ||
+      (GST_PYLON_SIMD_NEON != cpu && GST_PYLON_SIMD_NEON != level &&
+       level < cpu)) {
+    this->simd_level = level;
+    this->debayer_row = select_debayer_row(level);
+  }
+}
+
+void GstPylonDebayer::Process(const uint8_t *src, size_t src_stride,
+                              uint8_t *dst, size_t dst_stride, int width,
+                              int height, GstPylonWorkerPool *pool) const {
+  if (GST_PYLON_DEBAYER_NONE == this->output) {
+    return;
+  }
+
+  /* row 0 holds red for RGGB and GRBG, its color sites are on even columns
+   * for RGGB and BGGR. Both alternate from row to row. */
+  const bool first_red_row = GST_PYLON_BAYER_RGGB == this->pattern ||
+                             GST_PYLON_BAYER_GRBG == this->pattern;
+  const int first_site_parity = GST_PYLON_BAYER_RGGB == this->pattern ||
+                                        GST_PYLON_BAYER_BGGR == this->pattern
+                                    ? 0
+                                    : 1;
+
+  auto debayer_rows = [&](size_t begin, size_t end) {
+    for (size_t y = begin; y < end; y++) {
+      int row = static_cast<int>(y);
+
+      this->debayer_row(src + mirror(row - 1, height) * src_stride,
+                        src + y * src_stride,
+                        src + mirror(row + 1, height) * src_stride,
+                        dst + y * dst_stride, width,
+                        first_red_row != static_cast<bool>(y & 1),
+                        first_site_parity ^ static_cast<int>(y & 1),
+                        this->output);
+    }
+  };
+
+  if (pool && pool->GetThreadCount() > 1 &&
+      static_cast<size_t>(width) * height >=
+          GST_PYLON_DEBAYER_MIN_THREADED_PIXELS) {
+    /* a few stripes per thread balance uneven scheduling */
+    pool->Run(height,
+              std::max<size_t>(1, height / (pool->GetThreadCount() * 4)),
+              debayer_rows);
+  } else {
+    debayer_rows(0, height);
+  }
+}
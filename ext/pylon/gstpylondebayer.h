@@ -0,0 +1,79 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Bilinear demosaicing of 8-bit Bayer frames
+ */
+
+#ifndef _GST_PYLON_DEBAYER_H_
+#define _GST_PYLON_DEBAYER_H_
+
+#include "gstpylonsimd.h"
+#include "gstpylonworkerpool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/* frames smaller than this are demosaiced on the calling thread */
+#define GST_PYLON_DEBAYER_MIN_THREADED_PIXELS (512 * 1024)
+
+typedef enum {
+  GST_PYLON_BAYER_RGGB = 0,
+  GST_PYLON_BAYER_BGGR = 1,
+  GST_PYLON_BAYER_GRBG = 2,
+  GST_PYLON_BAYER_GBRG = 3,
+} GstPylonBayerPattern;
+
+typedef enum {
+  GST_PYLON_DEBAYER_NONE = 0,
+  GST_PYLON_DEBAYER_RGB = 1,
+  GST_PYLON_DEBAYER_BGRX = 2,
+  /* (R + 2G + B) / 4 of the interpolated pixel */
+  GST_PYLON_DEBAYER_GRAY8 = 3,
+} GstPylonDebayerOutput;
+
+typedef void (*GstPylonDebayerRowFunc)(const uint8_t *up, const uint8_t *row,
+                                       const uint8_t *down, uint8_t *dst,
+                                       int width, bool red_row,
+                                       int site_parity,
+                                       GstPylonDebayerOutput output);
+
+/**
+ * GstPylonDebayer:
+ *
+ * Interpolates the two missing colors of every pixel from its 3x3
+ * neighbourhood: the mean of the two or four nearest samples of each
+ * color. Borders are mirrored, which keeps the color of the mirrored
+ * samples, so any width and height of at least 2 is supported. Large
+ * frames are split into row stripes over a worker pool.
+ */
+class GstPylonDebayer {
+ public:
+  GstPylonDebayer();
+
+  /* false if the PFNC format is not an 8-bit Bayer format */
+  static bool GetPattern(const std::string &pfnc_name,
+                         GstPylonBayerPattern *pattern);
+  /* GST_PYLON_DEBAYER_NONE if the GStreamer format is not produced */
+  static GstPylonDebayerOutput GetOutput(const std::string &gst_format);
+  static int GetPixelSize(GstPylonDebayerOutput output);
+
+  /* GST_PYLON_DEBAYER_NONE disables Process() */
+  void Configure(GstPylonBayerPattern pattern, GstPylonDebayerOutput output);
+  GstPylonDebayerOutput GetOutput() const;
+
+  GstPylonSimdLevel GetSimdLevel() const;
+  /* fall back to a lower code path, used by the benchmark */
+  void SetSimdLevel(GstPylonSimdLevel level);
+
+  void Process(const uint8_t *src, size_t src_stride, uint8_t *dst,
+               size_t dst_stride, int width, int height,
+               GstPylonWorkerPool *pool) const;
+
+ private:
+  GstPylonBayerPattern pattern;
+  GstPylonDebayerOutput output;
+  GstPylonSimdLevel simd_level;
+  GstPylonDebayerRowFunc debayer_row;
+};
+
+#endif
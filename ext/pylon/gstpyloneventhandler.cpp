@@ -0,0 +1,245 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * GenICam camera events posted as element messages
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "gst/pylon/gstpylondebug.h"
+#include "gstpyloneventhandler.h"
+
+/* SFNC 2.x names the event data Event<Name>Timestamp, older GigE cameras
+ * <Name>EventTimestamp */
+static std::string gst_pylon_event_find_node(GenApi::INodeMap &nodemap,
+                                             const std::string &event,
+                                             const std::string &field) {
+  const std::string candidates[] = {"Event" + event + field,
+                                    event + "Event" + field};
+
+  for (const auto &candidate : candidates) {
+    if (nodemap.GetNode(candidate.c_str())) {
+      return candidate;
+    }
+  }
+
+  return "";
+}
+
+/* the smallest all ones mask covering the maximum of an id node */
+static guint64 gst_pylon_event_id_mask(gint64 max) {
+  guint64 mask = 0;
+
+  if (max <= 0) {
+    return G_MAXUINT64;
+  }
+
+  while (mask < static_cast<guint64>(max)) {
+    mask = (mask << 1) | 1;
+  }
+
+  return mask;
+}
+
+GstPylonEventHandler::GstPylonEventHandler()
+    : gstpylonsrc(NULL), frame_id_mask(G_MAXUINT64), stopping(false) {}
+
+GstPylonEventHandler::~GstPylonEventHandler() { this->StopThread(); }
+
+void GstPylonEventHandler::SetData(GstElement *gstpylonsrc) {
+  this->gstpylonsrc = gstpylonsrc;
+}
+
+void GstPylonEventHandler::Configure(
+    Pylon::CBaslerUniversalInstantCamera &camera,
+    const std::vector<std::string> &events) {
+  GenApi::INodeMap &nodemap = camera.GetNodeMap();
+  Pylon::CEnumParameter selector(nodemap, "EventSelector");
+  Pylon::CEnumParameter notification(nodemap, "EventNotification");
+
+  this->Reset(camera);
+
+  /* the callbacks refer to the sources by index */
+  this->sources.reserve(events.size());
+
+  for (const auto &event : events) {
+    Source source = {event, gst_pylon_event_find_node(nodemap, event,
+                                                      "Timestamp"),
+                     gst_pylon_event_find_node(nodemap, event, "FrameID")};
+
+    if (source.timestamp_node.empty()) {
+      std::string msg = "No data for camera event " + event;
+      throw Pylon::GenericException(msg.c_str(), __FILE__, __LINE__);
+    }
+
+    selector.SetValue(event.c_str());
+    if (!notification.TrySetValue("On")) {
+      notification.SetValue("GenICamEvent");
+    }
+
+    camera.RegisterCameraEventHandler(
+        this, source.timestamp_node.c_str(), this->sources.size(),
+        Pylon::RegistrationMode_Append, Pylon::Cleanup_None,
+        Pylon::CameraEventAvailability_Mandatory);
+    this->sources.push_back(source);
+
+    GST_DEBUG("Enabled camera event %s on %s", event.c_str(),
+              source.timestamp_node.c_str());
+  }
+
+  if (this->sources.empty()) {
+    return;
+  }
+
+  camera.GrabCameraEvents = true;
+
+  this->stopping = false;
+  this->thread = std::thread(&GstPylonEventHandler::Run, this);
+}
+
+void GstPylonEventHandler::Reset(
+    Pylon::CBaslerUniversalInstantCamera &camera) {
+  GenApi::INodeMap &nodemap = camera.GetNodeMap();
+  Pylon::CEnumParameter selector(nodemap, "EventSelector");
+  Pylon::CEnumParameter notification(nodemap, "EventNotification");
+
+  this->StopThread();
+
+  for (const auto &source : this->sources) {
+    camera.DeregisterCameraEventHandler(this, source.timestamp_node.c_str());
+    if (selector.TrySetValue(source.name.c_str())) {
+      notification.TrySetValue("Off");
+    }
+  }
+
+  if (!this->sources.empty()) {
+    camera.GrabCameraEvents = false;
+  }
+
+  this->sources.clear();
+  std::lock_guard<std::mutex> guard(this->mutex);
+  this->events.clear();
+  this->exposure_ends.clear();
+  this->frame_id_mask = G_MAXUINT64;
+}
+
+/* Runs on a pylon thread, the event data is only valid during the call */
+void GstPylonEventHandler::OnCameraEvent(
+    Pylon::CBaslerUniversalInstantCamera &camera, intptr_t user_provided_id,
+    GenApi::INode *node) {
+  const Source &source = this->sources[user_provided_id];
+  Event event = {&source, 0, 0, FALSE};
+  guint64 frame_id_mask = G_MAXUINT64;
+
+  try {
+    event.timestamp = Pylon::CIntegerParameter(node).GetValue();
+
+    if (!source.frame_id_node.empty()) {
+      Pylon::CIntegerParameter frame_id(camera.GetNodeMap(),
+                                        source.frame_id_node.c_str());
+      if (frame_id.IsReadable()) {
+        event.frame_id = frame_id.GetValue();
+        event.has_frame_id = TRUE;
+        /* the event data is only available while the event is handled */
+        frame_id_mask = gst_pylon_event_id_mask(frame_id.GetMax());
+      }
+    }
+  } catch (const Pylon::GenericException &e) {
+    GST_WARNING("Unable to read camera event %s: %s", source.name.c_str(),
+                e.GetDescription());
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  if (event.has_frame_id && "ExposureEnd" == source.name) {
+    this->frame_id_mask = frame_id_mask;
+    this->exposure_ends.emplace_back(event.frame_id, event.timestamp);
+    if (this->exposure_ends.size() > GST_PYLON_EVENT_MAX_PENDING_FRAMES) {
+      this->exposure_ends.pop_front();
+    }
+  }
+
+  this->events.push_back(event);
+  this->cv.notify_one();
+}
+
+gboolean GstPylonEventHandler::TakeExposureEnd(guint64 frame_id,
+                                               guint64 &timestamp) {
+  std::lock_guard<std::mutex> guard(this->mutex);
+  const guint64 mask = this->frame_id_mask;
+
+  /* events arrive in frame order, the oldest one is checked first */
+  while (!this->exposure_ends.empty()) {
+    const auto &oldest = this->exposure_ends.front();
+    guint64 behind = (frame_id - oldest.first) & mask;
+
+    if (0 == behind) {
+      timestamp = oldest.second;
+      this->exposure_ends.pop_front();
+      return TRUE;
+    }
+
+    /* an event ahead of the frame is kept for a later one */
+    if (behind > mask / 2) {
+      break;
+    }
+
+    GST_LOG("Dropping ExposureEnd of undelivered frame %" G_GUINT64_FORMAT,
+            oldest.first);
+    this->exposure_ends.pop_front();
+  }
+
+  return FALSE;
+}
+
+/* posting may block on synchronous bus handlers, keep it off the pylon
+ * threads */
+void GstPylonEventHandler::Run() {
+  std::unique_lock<std::mutex> lock(this->mutex);
+
+  for (;;) {
+    this->cv.wait(lock,
+                  [this] { return this->stopping || !this->events.empty(); });
+
+    if (this->stopping) {
+      break;
+    }
+
+    Event event = this->events.front();
+    this->events.pop_front();
+
+    lock.unlock();
+
+    GstStructure *st = gst_structure_new(
+        "pylon-camera-event", "event", G_TYPE_STRING,
+        event.source->name.c_str(), "timestamp", G_TYPE_UINT64,
+        event.timestamp, NULL);
+    if (event.has_frame_id) {
+      gst_structure_set(st, "frame-id", G_TYPE_UINT64, event.frame_id, NULL);
+    }
+
+    GST_LOG("Camera event: %" GST_PTR_FORMAT, st);
+
+    gst_element_post_message(
+        this->gstpylonsrc,
+        gst_message_new_element(GST_OBJECT_CAST(this->gstpylonsrc), st));
+
+    lock.lock();
+  }
+}
+
+void GstPylonEventHandler::StopThread() {
+  if (!this->thread.joinable()) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(this->mutex);
+    this->stopping = true;
+    this->cv.notify_one();
+  }
+
+  this->thread.join();
+}
@@ -0,0 +1,84 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * GenICam camera events posted as element messages
+ */
+
+#ifndef _GST_PYLON_EVENT_HANDLER_H_
+#define _GST_PYLON_EVENT_HANDLER_H_
+
+#include <gst/gst.h>
+#include <gst/pylon/gstpylonincludes.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/* exposure end timestamps kept for frames not delivered yet */
+#define GST_PYLON_EVENT_MAX_PENDING_FRAMES 64
+
+/**
+ * GstPylonEventHandler:
+ *
+ * Receives the camera events enabled by Configure(), e.g. ExposureEnd,
+ * FrameStartOvertrigger or FrameBufferOverrun. The pylon callback only
+ * copies the event data into a queue, a dedicated thread posts a
+ * "pylon-camera-event" element message per event. ExposureEnd timestamps
+ * are kept by frame id until the frame is captured. Event frame ids are as
+ * wide as the camera reports them, e.g. 16 bits on GigE, so they are
+ * compared with the block id of the frame modulo that width.
+ */
+class GstPylonEventHandler : public Pylon::CBaslerUniversalCameraEventHandler {
+ public:
+  GstPylonEventHandler();
+  ~GstPylonEventHandler();
+  void SetData(GstElement *gstpylonsrc);
+
+  /* Enable the notification of each event, throws if the camera does not
+   * know one of them. Must be called before grabbing starts. */
+  void Configure(Pylon::CBaslerUniversalInstantCamera &camera,
+                 const std::vector<std::string> &events);
+  /* Disable all configured events */
+  void Reset(Pylon::CBaslerUniversalInstantCamera &camera);
+
+  void OnCameraEvent(Pylon::CBaslerUniversalInstantCamera &camera,
+                     intptr_t user_provided_id, GenApi::INode *node) override;
+
+  /* Take the ExposureEnd timestamp in ticks reported for a frame. Events
+   * of earlier frames are dropped, their frames were not delivered. */
+  gboolean TakeExposureEnd(guint64 frame_id, guint64 &timestamp);
+
+ private:
+  struct Source {
+    std::string name;
+    std::string timestamp_node;
+    std::string frame_id_node;
+  };
+
+  struct Event {
+    const Source *source;
+    guint64 timestamp;
+    guint64 frame_id;
+    gboolean has_frame_id;
+  };
+
+  void Run();
+  void StopThread();
+
+  GstElement *gstpylonsrc;
+  std::vector<Source> sources;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<Event> events;
+  std::deque<std::pair<guint64, guint64>> exposure_ends;
+  /* all ones in the width of the ExposureEnd frame id */
+  guint64 frame_id_mask;
+  bool stopping;
+  std::thread thread;
+};
+
+#endif
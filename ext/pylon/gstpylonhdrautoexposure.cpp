@@ -0,0 +1,411 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Closed loop exposure control of HDR windows
+ */
+
+#include "gstpylonhdrautoexposure.h"
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr int HISTOGRAM_EDGES = GST_PYLON_HDR_HISTOGRAM_BINS - 1;
+
+/* rows measured per image, spread evenly over its height */
+static constexpr int SAMPLE_ROWS = 64;
+
+/* largest change of an exposure time in one adjustment */
+static constexpr double MAX_STEP = 1.25;
+/* coverage below target * DEADBAND lets the exposure move back, which keeps
+ * the controller from parking far inside its target */
+static constexpr double DEADBAND = 0.25;
+/* smaller changes are not worth reprogramming the sequencer for */
+static constexpr double MIN_CHANGE = 0.01;
+
+static void histogram_row_scalar(const uint8_t *row, int width, int x,
+                                 uint32_t *above) {
+  uint32_t bins[GST_PYLON_HDR_HISTOGRAM_BINS] = {0};
+  uint32_t sum = 0;
+
+  for (; x < width; x++) {
+    bins[row[x] >> 4]++;
+  }
+
+  for (int k = HISTOGRAM_EDGES; k > 0; k--) {
+    sum += bins[k];
+    above[k - 1] += sum;
+  }
+}
+
+static void histogram_row_c(const uint8_t *row, int width, uint32_t *above) {
+  histogram_row_scalar(row, width, 0, above);
+}
+
+/* The vector kernels compare every sample against the 15 inner bin edges
+ * and keep one 8-bit counter per lane and edge, flushed before it can
+ * overflow. */
+#if defined(GST_PYLON_ARCH_X86)
+GST_PYLON_TARGET_SSE41 static void histogram_row_sse41(const uint8_t *row,
+                                                       int width,
+                                                       uint32_t *above) {
+  const __m128i zero = _mm_setzero_si128();
+  int x = 0;
+
+  while (x + 16 <= width) {
+    __m128i counts[HISTOGRAM_EDGES];
+    int block_end = std::min(width - 15, x + 255 * 16);
+
+    for (int k = 0; k < HISTOGRAM_EDGES; k++) {
+      counts[k] = zero;
+    }
+
+    for (; x < block_end; x += 16) {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + x));
+
+      for (int k = 0; k < HISTOGRAM_EDGES; k++) {
+        __m128i edge = _mm_set1_epi8(static_cast<char>((k + 1) * 16));
+        __m128i ge = _mm_cmpeq_epi8(_mm_max_epu8(v, edge), v);
+        counts[k] = _mm_sub_epi8(counts[k], ge);
+      }
+    }
+
+    for (int k = 0; k < HISTOGRAM_EDGES; k++) {
+      __m128i sad = _mm_sad_epu8(counts[k], zero);
+      above[k] += _mm_cvtsi128_si32(sad) + _mm_extract_epi32(sad, 2);
+    }
+  }
+
+  histogram_row_scalar(row, width, x, above);
+}
+
+GST_PYLON_TARGET_AVX2 static void histogram_row_avx2(const uint8_t *row,
+                                                     int width,
+                                                     uint32_t *above) {
+  const __m256i zero = _mm256_setzero_si256();
+  int x = 0;
+
+  while (x + 32 <= width) {
+    __m256i counts[HISTOGRAM_EDGES];
+    int block_end = std::min(width - 31, x + 255 * 32);
+
+    for (int k = 0; k < HISTOGRAM_EDGES; k++) {
+      counts[k] = zero;
+    }
+
+    for (; x < block_end; x += 32) {
+      __m256i v =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row + x));
+
+      for (int k = 0; k < HISTOGRAM_EDGES; k++) {
+        __m256i edge = _mm256_set1_epi8(static_cast<char>((k + 1) * 16));
+        __m256i ge = _mm256_cmpeq_epi8(_mm256_max_epu8(v, edge), v);
+        counts[k] = _mm256_sub_epi8(counts[k], ge);
+      }
+    }
+
+    for (int k = 0; k < HISTOGRAM_EDGES; k++) {
+      __m256i sad = _mm256_sad_epu8(counts[k], zero);
+      __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(sad),
+                                  _mm256_extracti128_si256(sad, 1));
+      above[k] += _mm_cvtsi128_si32(sum) + _mm_extract_epi32(sum, 2);
+    }
+  }
+
+  histogram_row_scalar(row, width, x, above);
+}
+#endif
+
+#if defined(GST_PYLON_ARCH_ARM64)
+static void histogram_row_neon(const uint8_t *row, int width,
+                               uint32_t *above) {
+  int x = 0;
+
+  while (x + 16 <= width) {
+    uint8x16_t counts[HISTOGRAM_EDGES];
+    int block_end = std::min(width - 15, x + 255 * 16);
+
+    for (int k = 0; k < HISTOGRAM_EDGES; k++) {
+      counts[k] = vdupq_n_u8(0);
+    }
+
+    for (; x < block_end; x += 16) {
+      uint8x16_t v = vld1q_u8(row + x);
+
+      for (int k = 0; k < HISTOGRAM_EDGES; k++) {
+        uint8x16_t edge = vdupq_n_u8(static_cast<uint8_t>((k + 1) * 16));
+        counts[k] = vsubq_u8(counts[k], vcgeq_u8(v, edge));
+      }
+    }
+
+    for (int k = 0; k < HISTOGRAM_EDGES; k++) {
+      above[k] += vaddlvq_u8(counts[k]);
+    }
+  }
+
+  histogram_row_scalar(row, width, x, above);
+}
+#endif
+
+/* packed formats, one sample every pixel_stride bytes */
+static void histogram_row_strided(const uint8_t *row, int width,
+                                  int pixel_stride, uint32_t *above) {
+  uint32_t bins[GST_PYLON_HDR_HISTOGRAM_BINS] = {0};
+  uint32_t sum = 0;
+
+  for (int x = 0; x < width; x++) {
+    bins[row[x * pixel_stride] >> 4]++;
+  }
+
+  for (int k = HISTOGRAM_EDGES; k > 0; k--) {
+    sum += bins[k];
+    above[k - 1] += sum;
+  }
+}
+
+static GstPylonHdrHistogramRowFunc select_histogram_row(
+    GstPylonSimdLevel level) {
+  switch (level) {
+#if defined(GST_PYLON_ARCH_X86)
+    case GST_PYLON_SIMD_AVX2:
+      return histogram_row_avx2;
+    case GST_PYLON_SIMD_SSE41:
+      return histogram_row_sse41;
+#endif
+#if defined(GST_PYLON_ARCH_ARM64)
+    case GST_PYLON_SIMD_NEON:
+      return histogram_row_neon;
+#endif
+    default:
+      return histogram_row_c;
+  }
+}
+
+/* Multiplicative step moving a coverage towards its target: a full step
+ * when it is far above, half a step (in the log domain) when close, and
+ * half a step back when well below. */
+static double coverage_step(double coverage, double target) {
+  if (coverage > 2.0 * target) {
+    return MAX_STEP;
+  }
+  if (coverage > target) {
+    return std::sqrt(MAX_STEP);
+  }
+  if (coverage < target * DEADBAND) {
+    return 1.0 / std::sqrt(MAX_STEP);
+  }
+  return 1.0;
+}
+
+GstPylonHdrAutoExposure::GstPylonHdrAutoExposure()
+    : min_exposure(1.0),
+      max_exposure(1e6),
+      highlight_target(0.01),
+      shadow_target(0.05),
+      interval(8),
+      pixel_stride(1),
+      offset(0),
+      simd_level(gst_pylon_simd_detect()),
+      histogram_row(select_histogram_row(simd_level)) {}
+
+bool GstPylonHdrAutoExposure::Configure(
+    const std::vector<std::vector<uint32_t>> &profiles, double min_exposure,
+    double max_exposure) {
+  std::vector<Profile> configured;
+
+  if (profiles.empty() || !(min_exposure > 0.0) ||
+      max_exposure < min_exposure) {
+    return false;
+  }
+
+  for (const auto &exposures : profiles) {
+    Profile profile = {};
+
+    if (exposures.empty()) {
+      return false;
+    }
+
+    for (uint32_t exposure : exposures) {
+      profile.exposures.push_back(
+          std::min(std::max<double>(exposure, min_exposure), max_exposure));
+    }
+
+    profile.shortest = std::distance(
+        profile.exposures.begin(),
+        std::min_element(profile.exposures.begin(), profile.exposures.end()));
+    profile.longest = std::distance(
+        profile.exposures.begin(),
+        std::max_element(profile.exposures.begin(), profile.exposures.end()));
+
+    configured.push_back(profile);
+  }
+
+  this->profiles = configured;
+  this->min_exposure = min_exposure;
+  this->max_exposure = max_exposure;
+
+  return true;
+}
+
+void GstPylonHdrAutoExposure::SetTargets(double highlight, double shadow) {
+  this->highlight_target = std::min(std::max(highlight, 0.0), 1.0);
+  this->shadow_target = std::min(std::max(shadow, 0.0), 1.0);
+}
+
+void GstPylonHdrAutoExposure::SetInterval(unsigned int windows) {
+  this->interval = std::max(1u, windows);
+}
+
+void GstPylonHdrAutoExposure::SetSampleLayout(int pixel_stride, int offset) {
+  this->pixel_stride = std::max(1, pixel_stride);
+  this->offset = std::max(0, offset);
+}
+
+GstPylonSimdLevel GstPylonHdrAutoExposure::GetSimdLevel() const {
+  return this->simd_level;
+}
+
+void GstPylonHdrAutoExposure::SetSimdLevel(GstPylonSimdLevel level) {
+  GstPylonSimdLevel cpu = gst_pylon_simd_detect_cpu();
+
+  if (GST_PYLON_SIMD_SCALAR == level || level == cpu ||
+      (GST_PYLON_SIMD_NEON != cpu && GST_PYLON_SIMD_NEON != level &&
+       level < cpu)) {
+    this->simd_level = level;
+    this->histogram_row = select_histogram_row(level);
+  }
+}
+
+void GstPylonHdrAutoExposure::Measure(const uint8_t *data, int stride,
+                                      int width, int height,
+                                      GstPylonHdrHistogram *histogram) const {
+  uint32_t above[HISTOGRAM_EDGES] = {0};
+  int row_step = std::max(1, height / SAMPLE_ROWS);
+  uint32_t samples = 0;
+
+  for (int y = row_step / 2; y < height; y += row_step) {
+    const uint8_t *row = data + static_cast<size_t>(y) * stride + this->offset;
+
+    if (1 == this->pixel_stride) {
+      this->histogram_row(row, width, above);
+    } else {
+      histogram_row_strided(row, width, this->pixel_stride, above);
+    }
+    samples += width;
+  }
+
+  histogram->samples = samples;
+  histogram->bins[0] = samples - above[0];
+  for (int k = 1; k < HISTOGRAM_EDGES; k++) {
+    histogram->bins[k] = above[k - 1] - above[k];
+  }
+  histogram->bins[HISTOGRAM_EDGES] = above[HISTOGRAM_EDGES - 1];
+}
+
+bool GstPylonHdrAutoExposure::AddFrame(unsigned int profile_index,
+                                       unsigned int index,
+                                       const uint8_t *data, int stride,
+                                       int width, int height,
+                                       std::vector<uint32_t> &exposures) {
+  bool adjusted = false;
+
+  if (profile_index >= this->profiles.size()) {
+    return false;
+  }
+
+  Profile &profile = this->profiles[profile_index];
+  if (index >= profile.exposures.size()) {
+    return false;
+  }
+
+  if (index == profile.shortest) {
+    this->Measure(data, stride, width, height, &profile.highlights);
+    profile.have_highlights = profile.highlights.samples > 0;
+  }
+  if (index == profile.longest) {
+    this->Measure(data, stride, width, height, &profile.shadows);
+    profile.have_shadows = profile.shadows.samples > 0;
+  }
+
+  /* the window ends with its last exposure */
+  if (index + 1 != profile.exposures.size()) {
+    return false;
+  }
+
+  profile.windows++;
+  if (profile.windows >= this->interval && profile.have_highlights &&
+      profile.have_shadows) {
+    adjusted = this->Adjust(profile);
+  }
+  profile.have_highlights = false;
+  profile.have_shadows = false;
+
+  if (!adjusted) {
+    return false;
+  }
+
+  profile.windows = 0;
+  exposures.clear();
+  for (double exposure : profile.exposures) {
+    exposures.push_back(
+        std::max<uint32_t>(1, static_cast<uint32_t>(std::lround(exposure))));
+  }
+
+  return true;
+}
+
+bool GstPylonHdrAutoExposure::Adjust(Profile &profile) const {
+  double shortest = profile.exposures[profile.shortest];
+  double longest = profile.exposures[profile.longest];
+  double highlights =
+      static_cast<double>(profile.highlights.bins[HISTOGRAM_EDGES]) /
+      profile.highlights.samples;
+  double shadows =
+      static_cast<double>(profile.shadows.bins[0]) / profile.shadows.samples;
+  double highlight_step = coverage_step(highlights, this->highlight_target);
+  double shadow_step = coverage_step(shadows, this->shadow_target);
+  double new_shortest = shortest / highlight_step;
+  double new_longest = longest * shadow_step;
+  std::vector<double> exposures;
+  bool changed = false;
+
+  /* a single exposure only moves for coverage above target, highlights
+   * first */
+  if (profile.shortest == profile.longest) {
+    if (highlight_step > 1.0) {
+      new_shortest = shortest / highlight_step;
+    } else if (shadow_step > 1.0) {
+      new_shortest = shortest * shadow_step;
+    } else {
+      new_shortest = shortest;
+    }
+    new_longest = new_shortest;
+  }
+
+  new_shortest =
+      std::min(std::max(new_shortest, this->min_exposure), this->max_exposure);
+  new_longest =
+      std::min(std::max(new_longest, this->min_exposure), this->max_exposure);
+  /* the scene exceeds the range of the window, highlights win */
+  new_longest = std::max(new_longest, new_shortest);
+
+  for (double exposure : profile.exposures) {
+    double position = 0.0;
+
+    if (longest > shortest) {
+      position = std::log(exposure / shortest) / std::log(longest / shortest);
+    }
+    exposures.push_back(new_shortest *
+                        std::pow(new_longest / new_shortest, position));
+  }
+
+  for (size_t i = 0; i < exposures.size(); i++) {
+    if (std::fabs(exposures[i] / profile.exposures[i] - 1.0) >= MIN_CHANGE) {
+      changed = true;
+    }
+  }
+
+  if (changed) {
+    profile.exposures = exposures;
+  }
+
+  return changed;
+}
@@ -0,0 +1,98 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Closed loop exposure control of HDR windows
+ */
+
+#ifndef _GST_PYLON_HDR_AUTO_EXPOSURE_H_
+#define _GST_PYLON_HDR_AUTO_EXPOSURE_H_
+
+#include "gstpylonsimd.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#define GST_PYLON_HDR_HISTOGRAM_BINS 16
+
+/* coarse luminance histogram, bins of 16 code values */
+struct GstPylonHdrHistogram {
+  uint32_t bins[GST_PYLON_HDR_HISTOGRAM_BINS];
+  uint32_t samples;
+};
+
+/* adds the samples of a row at or above each inner bin edge to above */
+typedef void (*GstPylonHdrHistogramRowFunc)(const uint8_t *row, int width,
+                                            uint32_t *above);
+
+/**
+ * GstPylonHdrAutoExposure:
+ *
+ * Keeps the exposure times of the HDR profiles matched to the scene. Every
+ * window, the shortest exposure is measured for clipped highlights and the
+ * longest one for black shadows, each on a subsampled 8-bit histogram.
+ *
+ * Once per interval of windows the shortest exposure is shortened while
+ * more than the highlight target clips, and lengthened while far below it.
+ * The longest exposure follows the shadow target the same way. Exposures in
+ * between keep their relative position on a logarithmic scale. A single
+ * step changes an exposure by 25% at most.
+ */
+class GstPylonHdrAutoExposure {
+ public:
+  GstPylonHdrAutoExposure();
+
+  /* exposure times of every profile and the limits of the camera, all in
+   * microseconds */
+  bool Configure(const std::vector<std::vector<uint32_t>> &profiles,
+                 double min_exposure, double max_exposure);
+  /* fraction of samples allowed to clip in the shortest exposure and to
+   * stay black in the longest one */
+  void SetTargets(double highlight, double shadow);
+  /* windows between two adjustments, covers the frames still in flight
+   * with the previous exposures */
+  void SetInterval(unsigned int windows);
+  /* bytes between two luminance samples and offset of the first one, picks
+   * luma or green out of packed formats */
+  void SetSampleLayout(int pixel_stride, int offset);
+
+  GstPylonSimdLevel GetSimdLevel() const;
+  /* fall back to a lower code path, used by the benchmark */
+  void SetSimdLevel(GstPylonSimdLevel level);
+
+  void Measure(const uint8_t *data, int stride, int width, int height,
+               GstPylonHdrHistogram *histogram) const;
+
+  /* Feeds one exposure of a window. Returns true with the new exposure
+   * times of the profile once a window ends an interval that needs an
+   * adjustment. */
+  bool AddFrame(unsigned int profile, unsigned int index, const uint8_t *data,
+                int stride, int width, int height,
+                std::vector<uint32_t> &exposures);
+
+ private:
+  struct Profile {
+    std::vector<double> exposures;
+    size_t shortest;
+    size_t longest;
+    GstPylonHdrHistogram highlights;
+    GstPylonHdrHistogram shadows;
+    bool have_highlights;
+    bool have_shadows;
+    unsigned int windows;
+  };
+
+  bool Adjust(Profile &profile) const;
+
+  std::vector<Profile> profiles;
+  double min_exposure;
+  double max_exposure;
+  double highlight_target;
+  double shadow_target;
+  unsigned int interval;
+  int pixel_stride;
+  int offset;
+  GstPylonSimdLevel simd_level;
+  GstPylonHdrHistogramRowFunc histogram_row;
+};
+
+#endif
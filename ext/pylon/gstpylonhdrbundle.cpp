@@ -0,0 +1,746 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * HDR window bundling element driven by GstHdrMeta
+ */
+
+/**
+ * SECTION:element-pylonhdrbundle
+ *
+ * The pylonhdrbundle element collects the frames of one HDR exposure window,
+ * as identified by the master_sequence of their #GstHdrMeta, and pushes the
+ * window downstream as a single unit.
+ *
+ * In "memories" output mode every window becomes one buffer with one memory
+ * per exposure. Each exposure keeps its #GstHdrMeta and gets a #GstVideoMeta
+ * whose id is the exposure_sequence_index and whose plane offsets point into
+ * the bundled buffer. The caps describe a single exposure and announce the
+ * bundle with an exposure-count field. A buffer holds at most
+ * gst_buffer_get_max_memory() memories, longer windows are rejected in this
+ * mode. In "list" output mode the original buffers are pushed together as a
+ * #GstBufferList under the upstream caps.
+ *
+ * Windows with missing exposures are detected when a frame of a different
+ * window arrives, and are dropped or pushed with GST_BUFFER_FLAG_CORRUPTED
+ * depending on the incomplete property.
+ *
+ * <refsect2>
+ * <title>Example launch line</title>
+ * |[
+ * gst-launch-1.0 pylonsrc hdr-sequence="19,150" ! pylonhdrbundle ! fakesink
+ * ]|
+ * </refsect2>
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "gsthdrmeta.h"
+#include "gstpylonhdrbundle.h"
+
+#include <gst/video/video.h>
+
+GST_DEBUG_CATEGORY_STATIC(gst_pylon_hdr_bundle_debug);
+#define GST_CAT_DEFAULT gst_pylon_hdr_bundle_debug
+
+/* exposure_sequence_index is a guint8 */
+#define HDR_BUNDLE_MAX_EXPOSURES (G_MAXUINT8 + 1)
+
+/* caps field announcing the exposures of a bundled buffer */
+#define HDR_BUNDLE_EXPOSURES_FIELD "exposure-count"
+
+struct _GstPylonHdrBundle {
+  GstElement parent;
+
+  GstPad *sinkpad;
+  GstPad *srcpad;
+
+  GstPylonHdrBundleOutputEnum output;
+  GstPylonHdrBundleIncompleteEnum incomplete;
+
+  /* window being collected */
+  guint64 master_sequence;
+  guint exposure_count;
+  guint n_frames;
+  GstBuffer *frames[HDR_BUNDLE_MAX_EXPOSURES];
+
+  /* memories output: caps of the exposures, the exposure count announced
+   * downstream, 0 before the first window, and the serialized events held
+   * back until then */
+  GstCaps *sink_caps;
+  guint caps_exposures;
+  GQueue pending_events;
+
+  guint64 complete_windows;
+  guint64 incomplete_windows;
+};
+
+enum {
+  PROP_0,
+  PROP_OUTPUT,
+  PROP_INCOMPLETE,
+  PROP_COMPLETE_WINDOWS,
+  PROP_INCOMPLETE_WINDOWS,
+};
+
+#define PROP_OUTPUT_DEFAULT ENUM_BUNDLE_MEMORIES
+#define PROP_INCOMPLETE_DEFAULT ENUM_INCOMPLETE_DROP
+
+#define GST_TYPE_HDR_BUNDLE_OUTPUT_ENUM \
+  (gst_pylon_hdr_bundle_output_enum_get_type())
+#define GST_TYPE_HDR_BUNDLE_INCOMPLETE_ENUM \
+  (gst_pylon_hdr_bundle_incomplete_enum_get_type())
+
+static GType gst_pylon_hdr_bundle_output_enum_get_type(void) {
+  static gsize gtype = 0;
+  static const GEnumValue values[] = {
+      {ENUM_BUNDLE_MEMORIES, "memories",
+       "One buffer per window with one memory and video meta per exposure"},
+      {ENUM_BUNDLE_LIST, "list",
+       "One buffer list per window holding the exposure buffers"},
+      {0, NULL, NULL}};
+
+  if (g_once_init_enter(&gtype)) {
+    GType tmp =
+        g_enum_register_static("GstPylonHdrBundleOutputEnum", values);
+    g_once_init_leave(&gtype, tmp);
+  }
+
+  return (GType)gtype;
+}
+
+static GType gst_pylon_hdr_bundle_incomplete_enum_get_type(void) {
+  static gsize gtype = 0;
+  static const GEnumValue values[] = {
+      {ENUM_INCOMPLETE_DROP, "drop", "Drop windows with missing exposures"},
+      {ENUM_INCOMPLETE_FLAG, "flag",
+       "Push windows with missing exposures flagged as corrupted"},
+      {0, NULL, NULL}};
+
+  if (g_once_init_enter(&gtype)) {
+    GType tmp =
+        g_enum_register_static("GstPylonHdrBundleIncompleteEnum", values);
+    g_once_init_leave(&gtype, tmp);
+  }
+
+  return (GType)gtype;
+}
+
+/* pad templates */
+static GstStaticPadTemplate gst_pylon_hdr_bundle_sink_template =
+    GST_STATIC_PAD_TEMPLATE("sink", GST_PAD_SINK, GST_PAD_ALWAYS,
+                            GST_STATIC_CAPS("video/x-raw(ANY);"
+                                            "video/x-bayer(ANY)"));
+
+static GstStaticPadTemplate gst_pylon_hdr_bundle_src_template =
+    GST_STATIC_PAD_TEMPLATE("src", GST_PAD_SRC, GST_PAD_ALWAYS,
+                            GST_STATIC_CAPS("video/x-raw(ANY);"
+                                            "video/x-bayer(ANY)"));
+
+/* prototypes */
+static void gst_pylon_hdr_bundle_set_property(GObject *object,
+                                              guint property_id,
+                                              const GValue *value,
+                                              GParamSpec *pspec);
+static void gst_pylon_hdr_bundle_get_property(GObject *object,
+                                              guint property_id,
+                                              GValue *value,
+                                              GParamSpec *pspec);
+static void gst_pylon_hdr_bundle_finalize(GObject *object);
+static GstStateChangeReturn gst_pylon_hdr_bundle_change_state(
+    GstElement *element, GstStateChange transition);
+static GstFlowReturn gst_pylon_hdr_bundle_chain(GstPad *pad, GstObject *parent,
+                                                GstBuffer *buf);
+static gboolean gst_pylon_hdr_bundle_sink_event(GstPad *pad,
+                                                GstObject *parent,
+                                                GstEvent *event);
+static gboolean gst_pylon_hdr_bundle_query(GstPad *pad, GstObject *parent,
+                                           GstQuery *query);
+static GstFlowReturn gst_pylon_hdr_bundle_finish_window(
+    GstPylonHdrBundle *self);
+static void gst_pylon_hdr_bundle_clear_window(GstPylonHdrBundle *self);
+static void gst_pylon_hdr_bundle_clear_caps(GstPylonHdrBundle *self);
+
+G_DEFINE_TYPE(GstPylonHdrBundle, gst_pylon_hdr_bundle, GST_TYPE_ELEMENT);
+
+static void gst_pylon_hdr_bundle_class_init(GstPylonHdrBundleClass *klass) {
+  GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+  GstElementClass *element_class = GST_ELEMENT_CLASS(klass);
+
+  GST_DEBUG_CATEGORY_INIT(gst_pylon_hdr_bundle_debug, "pylonhdrbundle", 0,
+                          "debug category for pylonhdrbundle element");
+
+  gst_element_class_add_static_pad_template(
+      element_class, &gst_pylon_hdr_bundle_sink_template);
+  gst_element_class_add_static_pad_template(
+      element_class, &gst_pylon_hdr_bundle_src_template);
+
+  gst_element_class_set_static_metadata(
+      element_class, "Basler/Pylon HDR window bundler",
+      "Filter/Video", "Bundles the exposures of an HDR window into one unit",
+      "Basler AG <support.europe@baslerweb.com>");
+
+  gobject_class->set_property = gst_pylon_hdr_bundle_set_property;
+  gobject_class->get_property = gst_pylon_hdr_bundle_get_property;
+  gobject_class->finalize = gst_pylon_hdr_bundle_finalize;
+
+  g_object_class_install_property(
+      gobject_class, PROP_OUTPUT,
+      g_param_spec_enum(
+          "output", "Output mode",
+          "How a complete window is pushed downstream. memories holds at "
+          "most 16 exposures per window and announces them in the "
+          "exposure-count caps field.",
+          GST_TYPE_HDR_BUNDLE_OUTPUT_ENUM, PROP_OUTPUT_DEFAULT,
+          static_cast<GParamFlags>(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                                   GST_PARAM_MUTABLE_READY)));
+  g_object_class_install_property(
+      gobject_class, PROP_INCOMPLETE,
+      g_param_spec_enum(
+          "incomplete", "Incomplete windows",
+          "What to do with windows that miss one or more exposures.",
+          GST_TYPE_HDR_BUNDLE_INCOMPLETE_ENUM, PROP_INCOMPLETE_DEFAULT,
+          static_cast<GParamFlags>(G_PARAM_READWRITE |
+                                   G_PARAM_STATIC_STRINGS)));
+  g_object_class_install_property(
+      gobject_class, PROP_COMPLETE_WINDOWS,
+      g_param_spec_uint64(
+          "complete-windows", "Complete windows",
+          "Number of complete windows pushed since the element started.", 0,
+          G_MAXUINT64, 0,
+          static_cast<GParamFlags>(G_PARAM_READABLE | G_PARAM_STATIC_STRINGS)));
+  g_object_class_install_property(
+      gobject_class, PROP_INCOMPLETE_WINDOWS,
+      g_param_spec_uint64(
+          "incomplete-windows", "Incomplete windows",
+          "Number of windows with missing exposures since the element "
+          "started.",
+          0, G_MAXUINT64, 0,
+          static_cast<GParamFlags>(G_PARAM_READABLE | G_PARAM_STATIC_STRINGS)));
+
+  element_class->change_state =
+      GST_DEBUG_FUNCPTR(gst_pylon_hdr_bundle_change_state);
+}
+
+static void gst_pylon_hdr_bundle_init(GstPylonHdrBundle *self) {
+  self->sinkpad = gst_pad_new_from_static_template(
+      &gst_pylon_hdr_bundle_sink_template, "sink");
+  gst_pad_set_chain_function(self->sinkpad,
+                             GST_DEBUG_FUNCPTR(gst_pylon_hdr_bundle_chain));
+  gst_pad_set_event_function(
+      self->sinkpad, GST_DEBUG_FUNCPTR(gst_pylon_hdr_bundle_sink_event));
+  gst_pad_set_query_function(self->sinkpad,
+                             GST_DEBUG_FUNCPTR(gst_pylon_hdr_bundle_query));
+  GST_PAD_SET_PROXY_ALLOCATION(self->sinkpad);
+  gst_element_add_pad(GST_ELEMENT(self), self->sinkpad);
+
+  self->srcpad = gst_pad_new_from_static_template(
+      &gst_pylon_hdr_bundle_src_template, "src");
+  gst_pad_set_query_function(self->srcpad,
+                             GST_DEBUG_FUNCPTR(gst_pylon_hdr_bundle_query));
+  gst_element_add_pad(GST_ELEMENT(self), self->srcpad);
+
+  self->output = PROP_OUTPUT_DEFAULT;
+  self->incomplete = PROP_INCOMPLETE_DEFAULT;
+  self->master_sequence = 0;
+  self->exposure_count = 0;
+  self->n_frames = 0;
+  for (guint i = 0; i < HDR_BUNDLE_MAX_EXPOSURES; i++) {
+    self->frames[i] = NULL;
+  }
+  self->sink_caps = NULL;
+  self->caps_exposures = 0;
+  g_queue_init(&self->pending_events);
+  self->complete_windows = 0;
+  self->incomplete_windows = 0;
+}
+
+static void gst_pylon_hdr_bundle_set_property(GObject *object,
+                                              guint property_id,
+                                              const GValue *value,
+                                              GParamSpec *pspec) {
+  GstPylonHdrBundle *self = GST_PYLON_HDR_BUNDLE(object);
+
+  GST_OBJECT_LOCK(self);
+
+  switch (property_id) {
+    case PROP_OUTPUT:
+      self->output =
+          static_cast<GstPylonHdrBundleOutputEnum>(g_value_get_enum(value));
+      break;
+    case PROP_INCOMPLETE:
+      self->incomplete = static_cast<GstPylonHdrBundleIncompleteEnum>(
+          g_value_get_enum(value));
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+      break;
+  }
+
+  GST_OBJECT_UNLOCK(self);
+}
+
+static void gst_pylon_hdr_bundle_get_property(GObject *object,
+                                              guint property_id,
+                                              GValue *value,
+                                              GParamSpec *pspec) {
+  GstPylonHdrBundle *self = GST_PYLON_HDR_BUNDLE(object);
+
+  GST_OBJECT_LOCK(self);
+
+  switch (property_id) {
+    case PROP_OUTPUT:
+      g_value_set_enum(value, self->output);
+      break;
+    case PROP_INCOMPLETE:
+      g_value_set_enum(value, self->incomplete);
+      break;
+    case PROP_COMPLETE_WINDOWS:
+      g_value_set_uint64(value, self->complete_windows);
+      break;
+    case PROP_INCOMPLETE_WINDOWS:
+      g_value_set_uint64(value, self->incomplete_windows);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+      break;
+  }
+
+  GST_OBJECT_UNLOCK(self);
+}
+
+static void gst_pylon_hdr_bundle_finalize(GObject *object) {
+  GstPylonHdrBundle *self = GST_PYLON_HDR_BUNDLE(object);
+
+  gst_pylon_hdr_bundle_clear_window(self);
+  gst_pylon_hdr_bundle_clear_caps(self);
+
+  G_OBJECT_CLASS(gst_pylon_hdr_bundle_parent_class)->finalize(object);
+}
+
+static GstStateChangeReturn gst_pylon_hdr_bundle_change_state(
+    GstElement *element, GstStateChange transition) {
+  GstPylonHdrBundle *self = GST_PYLON_HDR_BUNDLE(element);
+  GstStateChangeReturn ret = GST_STATE_CHANGE_SUCCESS;
+
+  if (GST_STATE_CHANGE_READY_TO_PAUSED == transition) {
+    GST_OBJECT_LOCK(self);
+    self->complete_windows = 0;
+    self->incomplete_windows = 0;
+    GST_OBJECT_UNLOCK(self);
+  }
+
+  ret = GST_ELEMENT_CLASS(gst_pylon_hdr_bundle_parent_class)
+            ->change_state(element, transition);
+
+  if (GST_STATE_CHANGE_PAUSED_TO_READY == transition) {
+    gst_pylon_hdr_bundle_clear_window(self);
+    gst_pylon_hdr_bundle_clear_caps(self);
+  }
+
+  return ret;
+}
+
+static void gst_pylon_hdr_bundle_clear_window(GstPylonHdrBundle *self) {
+  for (guint i = 0; i < self->exposure_count; i++) {
+    if (self->frames[i]) {
+      gst_buffer_unref(self->frames[i]);
+      self->frames[i] = NULL;
+    }
+  }
+
+  self->n_frames = 0;
+  self->exposure_count = 0;
+}
+
+static void gst_pylon_hdr_bundle_clear_caps(GstPylonHdrBundle *self) {
+  GstEvent *event = NULL;
+
+  gst_caps_replace(&self->sink_caps, NULL);
+  self->caps_exposures = 0;
+  while ((event = static_cast<GstEvent *>(
+              g_queue_pop_head(&self->pending_events)))) {
+    gst_event_unref(event);
+  }
+}
+
+static gboolean gst_pylon_hdr_bundle_is_memories(GstPylonHdrBundle *self) {
+  gboolean ret = FALSE;
+
+  GST_OBJECT_LOCK(self);
+  ret = ENUM_BUNDLE_MEMORIES == self->output;
+  GST_OBJECT_UNLOCK(self);
+
+  return ret;
+}
+
+/* the caps of a single exposure, as the other pad sees them */
+static GstCaps *gst_pylon_hdr_bundle_strip_caps(GstCaps *caps) {
+  caps = gst_caps_make_writable(caps);
+
+  for (guint i = 0; i < gst_caps_get_size(caps); i++) {
+    gst_structure_remove_field(gst_caps_get_structure(caps, i),
+                               HDR_BUNDLE_EXPOSURES_FIELD);
+  }
+
+  return caps;
+}
+
+static void gst_pylon_hdr_bundle_push_pending(GstPylonHdrBundle *self) {
+  GstEvent *event = NULL;
+
+  while ((event = static_cast<GstEvent *>(
+              g_queue_pop_head(&self->pending_events)))) {
+    gst_pad_push_event(self->srcpad, event);
+  }
+}
+
+/* announces bundles of @exposures downstream and sends the events held
+ * back for the first announcement */
+static gboolean gst_pylon_hdr_bundle_announce(GstPylonHdrBundle *self,
+                                              guint exposures) {
+  GstCaps *caps = NULL;
+
+  if (!self->sink_caps) {
+    GST_ERROR_OBJECT(self, "Window received before caps");
+    return FALSE;
+  }
+
+  caps = gst_caps_copy(self->sink_caps);
+  gst_caps_set_simple(caps, HDR_BUNDLE_EXPOSURES_FIELD, G_TYPE_INT,
+                      static_cast<gint>(exposures), NULL);
+
+  GST_DEBUG_OBJECT(self, "Announcing %" GST_PTR_FORMAT, caps);
+  if (!gst_pad_push_event(self->srcpad, gst_event_new_caps(caps))) {
+    gst_caps_unref(caps);
+    return FALSE;
+  }
+  gst_caps_unref(caps);
+  self->caps_exposures = exposures;
+
+  gst_pylon_hdr_bundle_push_pending(self);
+
+  return TRUE;
+}
+
+/* build a single buffer holding all exposures of the window */
+static GstBuffer *gst_pylon_hdr_bundle_make_buffer(GstPylonHdrBundle *self) {
+  GstBuffer *out = gst_buffer_new();
+  GstBuffer *first = NULL;
+  GstBuffer *last = NULL;
+  gsize offset = 0;
+
+  for (guint i = 0; i < self->exposure_count; i++) {
+    GstBuffer *frame = self->frames[i];
+    GstHdrMeta *hdr_meta = NULL;
+    GstHdrMeta *out_hdr_meta = NULL;
+    GstVideoMeta *video_meta = NULL;
+
+    if (!frame) {
+      continue;
+    }
+
+    if (!first) {
+      first = frame;
+      gst_buffer_copy_into(out, first,
+                           static_cast<GstBufferCopyFlags>(
+                               GST_BUFFER_COPY_FLAGS |
+                               GST_BUFFER_COPY_TIMESTAMPS),
+                           0, -1);
+    }
+    last = frame;
+
+    gst_buffer_append_memory(out, gst_buffer_get_all_memory(frame));
+
+    hdr_meta = gst_buffer_get_hdr_meta(frame);
+    out_hdr_meta = gst_buffer_add_hdr_meta(
+        out, hdr_meta->master_sequence, hdr_meta->exposure_sequence_index,
+        hdr_meta->exposure_count, hdr_meta->exposure_value,
+        hdr_meta->hdr_profile);
+    out_hdr_meta->exposure_generation = hdr_meta->exposure_generation;
+
+    /* one video meta per exposure, its id is the exposure index */
+    video_meta = gst_buffer_get_video_meta(frame);
+    if (video_meta) {
+      gsize plane_offset[GST_VIDEO_MAX_PLANES] = {0};
+      GstVideoMeta *out_meta = NULL;
+
+      for (guint p = 0; p < video_meta->n_planes; p++) {
+        plane_offset[p] = offset + video_meta->offset[p];
+      }
+
+      out_meta = gst_buffer_add_video_meta_full(
+          out, video_meta->flags, video_meta->format, video_meta->width,
+          video_meta->height, video_meta->n_planes, plane_offset,
+          video_meta->stride);
+      out_meta->id = hdr_meta->exposure_sequence_index;
+    }
+
+    offset += gst_buffer_get_size(frame);
+  }
+
+  /* the bundle spans from the first to the end of the last exposure */
+  if (first != last && GST_BUFFER_PTS_IS_VALID(first) &&
+      GST_BUFFER_PTS_IS_VALID(last) && GST_BUFFER_DURATION_IS_VALID(last)) {
+    GST_BUFFER_DURATION(out) = GST_BUFFER_PTS(last) +
+                               GST_BUFFER_DURATION(last) -
+                               GST_BUFFER_PTS(first);
+  }
+  GST_BUFFER_OFFSET(out) = self->master_sequence;
+  GST_BUFFER_OFFSET_END(out) = self->master_sequence + 1;
+
+  return out;
+}
+
+static GstFlowReturn gst_pylon_hdr_bundle_finish_window(
+    GstPylonHdrBundle *self) {
+  GstPylonHdrBundleOutputEnum output = ENUM_BUNDLE_MEMORIES;
+  GstPylonHdrBundleIncompleteEnum incomplete = ENUM_INCOMPLETE_DROP;
+  GstFlowReturn ret = GST_FLOW_OK;
+  gboolean complete = FALSE;
+
+  if (0 == self->n_frames) {
+    return GST_FLOW_OK;
+  }
+
+  complete = (self->n_frames == self->exposure_count);
+
+  GST_OBJECT_LOCK(self);
+  output = self->output;
+  incomplete = self->incomplete;
+  if (complete) {
+    self->complete_windows++;
+  } else {
+    self->incomplete_windows++;
+  }
+  GST_OBJECT_UNLOCK(self);
+
+  if (!complete) {
+    GST_DEBUG_OBJECT(self, "Window %" G_GUINT64_FORMAT " has %u of %u exposures",
+                     self->master_sequence, self->n_frames,
+                     self->exposure_count);
+
+    if (ENUM_INCOMPLETE_DROP == incomplete) {
+      gst_pylon_hdr_bundle_clear_window(self);
+      return GST_FLOW_OK;
+    }
+  }
+
+  if (ENUM_BUNDLE_MEMORIES == output) {
+    GstBuffer *out = gst_pylon_hdr_bundle_make_buffer(self);
+    guint exposures = self->exposure_count;
+
+    if (!complete) {
+      GST_BUFFER_FLAG_SET(out, GST_BUFFER_FLAG_CORRUPTED);
+    }
+
+    gst_pylon_hdr_bundle_clear_window(self);
+
+    if (exposures != self->caps_exposures &&
+        !gst_pylon_hdr_bundle_announce(self, exposures)) {
+      gst_buffer_unref(out);
+      return GST_FLOW_NOT_NEGOTIATED;
+    }
+
+    GST_LOG_OBJECT(self, "Pushing window %" GST_PTR_FORMAT, out);
+    ret = gst_pad_push(self->srcpad, out);
+  } else {
+    GstBufferList *list = gst_buffer_list_new_sized(self->n_frames);
+
+    for (guint i = 0; i < self->exposure_count; i++) {
+      GstBuffer *frame = self->frames[i];
+
+      if (!frame) {
+        continue;
+      }
+      self->frames[i] = NULL;
+
+      if (!complete) {
+        frame = gst_buffer_make_writable(frame);
+        GST_BUFFER_FLAG_SET(frame, GST_BUFFER_FLAG_CORRUPTED);
+      }
+      gst_buffer_list_add(list, frame);
+    }
+
+    gst_pylon_hdr_bundle_clear_window(self);
+
+    GST_LOG_OBJECT(self, "Pushing window as list of %u buffers",
+                   gst_buffer_list_length(list));
+    ret = gst_pad_push_list(self->srcpad, list);
+  }
+
+  return ret;
+}
+
+static GstFlowReturn gst_pylon_hdr_bundle_chain(GstPad *pad, GstObject *parent,
+                                                GstBuffer *buf) {
+  GstPylonHdrBundle *self = GST_PYLON_HDR_BUNDLE(parent);
+  GstHdrMeta *hdr_meta = gst_buffer_get_hdr_meta(buf);
+  GstFlowReturn ret = GST_FLOW_OK;
+  guint index = 0;
+
+  if (!hdr_meta) {
+    GST_LOG_OBJECT(self, "Buffer without HDR meta, passing through");
+
+    /* sink_caps are only kept for memories output, where such a buffer is
+     * a bundle of one exposure */
+    if (self->sink_caps && 1 != self->caps_exposures &&
+        !gst_pylon_hdr_bundle_announce(self, 1)) {
+      gst_buffer_unref(buf);
+      return GST_FLOW_NOT_NEGOTIATED;
+    }
+
+    return gst_pad_push(self->srcpad, buf);
+  }
+
+  index = hdr_meta->exposure_sequence_index;
+
+  if (0 == hdr_meta->exposure_count || index >= hdr_meta->exposure_count) {
+    GST_WARNING_OBJECT(self, "Dropping buffer with invalid HDR meta (%u/%u)",
+                       index, hdr_meta->exposure_count);
+    gst_buffer_unref(buf);
+    return GST_FLOW_OK;
+  }
+
+  /* a frame not fitting the window being collected means the window had a
+   * gap, push what was collected so far */
+  if (self->n_frames > 0 &&
+      (hdr_meta->master_sequence != self->master_sequence ||
+       hdr_meta->exposure_count != self->exposure_count ||
+       self->frames[index])) {
+    ret = gst_pylon_hdr_bundle_finish_window(self);
+    if (GST_FLOW_OK != ret) {
+      gst_buffer_unref(buf);
+      return ret;
+    }
+  }
+
+  if (0 == self->n_frames) {
+    /* appending more memories would merge them into a copy */
+    if (hdr_meta->exposure_count > gst_buffer_get_max_memory() &&
+        gst_pylon_hdr_bundle_is_memories(self)) {
+      GST_ELEMENT_ERROR(self, STREAM, FORMAT,
+                        ("Windows of %u exposures do not fit one buffer.",
+                         hdr_meta->exposure_count),
+                        ("At most %u exposures per window in memories output, "
+                         "use output=list",
+                         gst_buffer_get_max_memory()));
+      gst_buffer_unref(buf);
+      return GST_FLOW_ERROR;
+    }
+
+    self->master_sequence = hdr_meta->master_sequence;
+    self->exposure_count = hdr_meta->exposure_count;
+  }
+
+  self->frames[index] = buf;
+  self->n_frames++;
+
+  if (self->n_frames == self->exposure_count) {
+    ret = gst_pylon_hdr_bundle_finish_window(self);
+  }
+
+  return ret;
+}
+
+static gboolean gst_pylon_hdr_bundle_sink_event(GstPad *pad,
+                                                GstObject *parent,
+                                                GstEvent *event) {
+  GstPylonHdrBundle *self = GST_PYLON_HDR_BUNDLE(parent);
+  GstFlowReturn flow = GST_FLOW_OK;
+  GstCaps *caps = NULL;
+
+  switch (GST_EVENT_TYPE(event)) {
+    case GST_EVENT_CAPS:
+      if (!gst_pylon_hdr_bundle_is_memories(self)) {
+        break;
+      }
+
+      /* the exposure count is only known from the HDR metas, the caps are
+       * announced with the first window */
+      gst_event_parse_caps(event, &caps);
+      gst_caps_replace(&self->sink_caps, caps);
+      gst_event_unref(event);
+
+      return 0 == self->caps_exposures ||
+             gst_pylon_hdr_bundle_announce(self, self->caps_exposures);
+    case GST_EVENT_EOS:
+      flow = gst_pylon_hdr_bundle_finish_window(self);
+
+      /* no window announced the caps, the held back events still go */
+      gst_pylon_hdr_bundle_push_pending(self);
+
+      if (GST_FLOW_FLUSHING == flow) {
+        gst_event_unref(event);
+        return FALSE;
+      }
+
+      if (GST_FLOW_NOT_LINKED == flow || flow < GST_FLOW_EOS) {
+        /* the last window was lost, fail like a source would */
+        GST_ELEMENT_FLOW_ERROR(self, flow);
+        gst_pad_event_default(pad, parent, event);
+        return FALSE;
+      }
+      break;
+    case GST_EVENT_FLUSH_STOP:
+      gst_pylon_hdr_bundle_clear_window(self);
+      break;
+    default:
+      /* caps before segment and the rest, as upstream sent them */
+      if (self->sink_caps && 0 == self->caps_exposures &&
+          GST_EVENT_IS_SERIALIZED(event)) {
+        g_queue_push_tail(&self->pending_events, event);
+        return TRUE;
+      }
+      break;
+  }
+
+  return gst_pad_event_default(pad, parent, event);
+}
+
+static gboolean gst_pylon_hdr_bundle_query(GstPad *pad, GstObject *parent,
+                                           GstQuery *query) {
+  GstPylonHdrBundle *self = GST_PYLON_HDR_BUNDLE(parent);
+  GstPad *otherpad = NULL;
+  GstCaps *filter = NULL;
+  GstCaps *peer_filter = NULL;
+  GstCaps *peer_caps = NULL;
+  GstCaps *templ = NULL;
+  GstCaps *caps = NULL;
+
+  if (GST_QUERY_CAPS != GST_QUERY_TYPE(query)) {
+    return gst_pad_query_default(pad, parent, query);
+  }
+
+  /* the caps of the other pad, without the bundle announcement the
+   * exposures do not have */
+  otherpad = pad == self->srcpad ? self->sinkpad : self->srcpad;
+  gst_query_parse_caps(query, &filter);
+  if (filter) {
+    peer_filter = gst_pylon_hdr_bundle_strip_caps(gst_caps_ref(filter));
+  }
+
+  peer_caps = gst_pylon_hdr_bundle_strip_caps(
+      gst_pad_peer_query_caps(otherpad, peer_filter));
+  templ = gst_pad_get_pad_template_caps(pad);
+  caps = gst_caps_intersect(peer_caps, templ);
+  gst_caps_unref(templ);
+  gst_caps_unref(peer_caps);
+  if (peer_filter) {
+    gst_caps_unref(peer_filter);
+  }
+
+  /* downstream may ask for a specific exposure count */
+  if (filter && pad == self->srcpad) {
+    GstCaps *tmp =
+        gst_caps_intersect_full(filter, caps, GST_CAPS_INTERSECT_FIRST);
+    gst_caps_unref(caps);
+    caps = tmp;
+  }
+
+  GST_LOG_OBJECT(pad, "Caps %" GST_PTR_FORMAT, caps);
+  gst_query_set_caps_result(query, caps);
+  gst_caps_unref(caps);
+
+  return TRUE;
+}
@@ -0,0 +1,29 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * HDR window bundling element driven by GstHdrMeta
+ */
+
+#ifndef _GST_PYLON_HDR_BUNDLE_H_
+#define _GST_PYLON_HDR_BUNDLE_H_
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_PYLON_HDR_BUNDLE gst_pylon_hdr_bundle_get_type()
+G_DECLARE_FINAL_TYPE(GstPylonHdrBundle, gst_pylon_hdr_bundle, GST,
+                     PYLON_HDR_BUNDLE, GstElement)
+
+typedef enum {
+  ENUM_BUNDLE_MEMORIES = 0,
+  ENUM_BUNDLE_LIST = 1,
+} GstPylonHdrBundleOutputEnum;
+
+typedef enum {
+  ENUM_INCOMPLETE_DROP = 0,
+  ENUM_INCOMPLETE_FLAG = 1,
+} GstPylonHdrBundleIncompleteEnum;
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,632 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Multithreaded HDR exposure fusion element
+ */
+
+/**
+ * SECTION:element-pylonhdrfusion
+ *
+ * The pylonhdrfusion element merges the exposures of an HDR window into a
+ * single frame. It consumes the windows produced by pylonhdrbundle in
+ * "memories" output mode, where every exposure is described by a #GstHdrMeta
+ * carrying its exposure time and a #GstVideoMeta whose id is the
+ * exposure_sequence_index.
+ *
+ * Samples are combined with a weighted merge: clipped and black samples get
+ * no weight, and longer exposures are favoured for their better signal to
+ * noise ratio. The "radiance" output is a linear 16-bit frame in code values
+ * of the shortest exposure with 8 fractional bits, the "tonemapped" output
+ * compresses it to 8 bits with a logarithmic curve.
+ *
+ * The merge uses SSE4.1, AVX2 or NEON when the CPU supports it and splits the
+ * frame into row stripes processed by a pool of worker threads. The
+ * GST_PYLON_SIMD environment variable forces a lower code path.
+ *
+ * <refsect2>
+ * <title>Example launch line</title>
+ * |[
+ * gst-launch-1.0 pylonsrc hdr-sequence="19,150" ! pylonhdrbundle !
+ *     pylonhdrfusion output=tonemapped ! videoconvert ! autovideosink
+ * ]|
+ * </refsect2>
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "gsthdrmeta.h"
+#include "gstpylonhdrfusion.h"
+#include "gstpylonhdrmerge.h"
+#include "gstpylonworkerpool.h"
+
+#include <gst/video/video.h>
+
+#include <cstring>
+#include <vector>
+
+GST_DEBUG_CATEGORY_STATIC(gst_pylon_hdr_fusion_debug);
+#define GST_CAT_DEFAULT gst_pylon_hdr_fusion_debug
+
+#define BAYER_16BIT_SUFFIX "16le"
+
+struct _GstPylonHdrFusion {
+  GstBaseTransform parent;
+
+  GstPylonHdrFusionOutputEnum output;
+  guint n_threads;
+
+  /* negotiated layout of one exposure and of the fused frame */
+  gint width;
+  gint height;
+  gint in_stride;
+  gint out_stride;
+  gboolean out_16bit;
+
+  GstPylonWorkerPool *pool;
+  GstPylonHdrMerge *merge;
+  std::vector<double> *exposure_times;
+};
+
+enum {
+  PROP_0,
+  PROP_OUTPUT,
+  PROP_N_THREADS,
+  PROP_SIMD,
+};
+
+#define PROP_OUTPUT_DEFAULT ENUM_FUSION_RADIANCE
+#define PROP_N_THREADS_DEFAULT 0
+#define PROP_N_THREADS_MAX 256
+
+#define GST_TYPE_HDR_FUSION_OUTPUT_ENUM \
+  (gst_pylon_hdr_fusion_output_enum_get_type())
+
+static GType gst_pylon_hdr_fusion_output_enum_get_type(void) {
+  static gsize gtype = 0;
+  static const GEnumValue values[] = {
+      {ENUM_FUSION_RADIANCE, "radiance",
+       "Linear 16-bit radiance with 8 fractional bits"},
+      {ENUM_FUSION_TONEMAPPED, "tonemapped",
+       "8-bit frame with a logarithmic tone curve"},
+      {0, NULL, NULL}};
+
+  if (g_once_init_enter(&gtype)) {
+    GType tmp =
+        g_enum_register_static("GstPylonHdrFusionOutputEnum", values);
+    g_once_init_leave(&gtype, tmp);
+  }
+
+  return (GType)gtype;
+}
+
+/* pad templates */
+// clang-format off
+static GstStaticPadTemplate gst_pylon_hdr_fusion_sink_template =
+    GST_STATIC_PAD_TEMPLATE(
+        "sink", GST_PAD_SINK, GST_PAD_ALWAYS,
+        GST_STATIC_CAPS(GST_VIDEO_CAPS_MAKE("GRAY8") ";"
+                        "video/x-bayer,format={rggb,bggr,gbrg,grbg},"
+                        "width=" GST_VIDEO_SIZE_RANGE
+                        ",height=" GST_VIDEO_SIZE_RANGE
+                        ",framerate=" GST_VIDEO_FPS_RANGE));
+
+static GstStaticPadTemplate gst_pylon_hdr_fusion_src_template =
+    GST_STATIC_PAD_TEMPLATE(
+        "src", GST_PAD_SRC, GST_PAD_ALWAYS,
+        GST_STATIC_CAPS(GST_VIDEO_CAPS_MAKE("{GRAY16_LE, GRAY8}") ";"
+                        "video/x-bayer,format={rggb16le,bggr16le,gbrg16le,"
+                        "grbg16le,rggb,bggr,gbrg,grbg},"
+                        "width=" GST_VIDEO_SIZE_RANGE
+                        ",height=" GST_VIDEO_SIZE_RANGE
+                        ",framerate=" GST_VIDEO_FPS_RANGE));
+// clang-format on
+
+/* prototypes */
+static void gst_pylon_hdr_fusion_set_property(GObject *object,
+                                              guint property_id,
+                                              const GValue *value,
+                                              GParamSpec *pspec);
+static void gst_pylon_hdr_fusion_get_property(GObject *object,
+                                              guint property_id,
+                                              GValue *value,
+                                              GParamSpec *pspec);
+static void gst_pylon_hdr_fusion_finalize(GObject *object);
+static gboolean gst_pylon_hdr_fusion_start(GstBaseTransform *trans);
+static gboolean gst_pylon_hdr_fusion_stop(GstBaseTransform *trans);
+static GstCaps *gst_pylon_hdr_fusion_transform_caps(GstBaseTransform *trans,
+                                                    GstPadDirection direction,
+                                                    GstCaps *caps,
+                                                    GstCaps *filter);
+static gboolean gst_pylon_hdr_fusion_transform_size(
+    GstBaseTransform *trans, GstPadDirection direction, GstCaps *caps,
+    gsize size, GstCaps *othercaps, gsize *othersize);
+static gboolean gst_pylon_hdr_fusion_set_caps(GstBaseTransform *trans,
+                                              GstCaps *incaps,
+                                              GstCaps *outcaps);
+static gboolean gst_pylon_hdr_fusion_transform_meta(GstBaseTransform *trans,
+                                                    GstBuffer *outbuf,
+                                                    GstMeta *meta,
+                                                    GstBuffer *inbuf);
+static GstFlowReturn gst_pylon_hdr_fusion_transform(GstBaseTransform *trans,
+                                                    GstBuffer *inbuf,
+                                                    GstBuffer *outbuf);
+
+G_DEFINE_TYPE(GstPylonHdrFusion, gst_pylon_hdr_fusion,
+              GST_TYPE_BASE_TRANSFORM);
+
+static void gst_pylon_hdr_fusion_class_init(GstPylonHdrFusionClass *klass) {
+  GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+  GstElementClass *element_class = GST_ELEMENT_CLASS(klass);
+  GstBaseTransformClass *base_transform_class =
+      GST_BASE_TRANSFORM_CLASS(klass);
+
+  GST_DEBUG_CATEGORY_INIT(gst_pylon_hdr_fusion_debug, "pylonhdrfusion", 0,
+                          "debug category for pylonhdrfusion element");
+
+  gst_element_class_add_static_pad_template(
+      element_class, &gst_pylon_hdr_fusion_sink_template);
+  gst_element_class_add_static_pad_template(
+      element_class, &gst_pylon_hdr_fusion_src_template);
+
+  gst_element_class_set_static_metadata(
+      element_class, "Basler/Pylon HDR exposure fusion", "Filter/Video",
+      "Merges the exposures of an HDR window into a single frame",
+      "Basler AG <support.europe@baslerweb.com>");
+
+  gobject_class->set_property = gst_pylon_hdr_fusion_set_property;
+  gobject_class->get_property = gst_pylon_hdr_fusion_get_property;
+  gobject_class->finalize = gst_pylon_hdr_fusion_finalize;
+
+  g_object_class_install_property(
+      gobject_class, PROP_OUTPUT,
+      g_param_spec_enum(
+          "output", "Output",
+          "Linear 16-bit radiance or tone mapped 8-bit frame.",
+          GST_TYPE_HDR_FUSION_OUTPUT_ENUM, PROP_OUTPUT_DEFAULT,
+          static_cast<GParamFlags>(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                                   GST_PARAM_MUTABLE_READY)));
+  g_object_class_install_property(
+      gobject_class, PROP_N_THREADS,
+      g_param_spec_uint(
+          "n-threads", "Number of threads",
+          "Threads merging a window, including the streaming thread. 0 uses "
+          "one thread per CPU core.",
+          0, PROP_N_THREADS_MAX, PROP_N_THREADS_DEFAULT,
+          static_cast<GParamFlags>(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                                   GST_PARAM_MUTABLE_READY)));
+  g_object_class_install_property(
+      gobject_class, PROP_SIMD,
+      g_param_spec_string(
+          "simd", "SIMD code path",
+          "Instruction set used by the merge: scalar, sse4.1, avx2 or neon.",
+          NULL,
+          static_cast<GParamFlags>(G_PARAM_READABLE | G_PARAM_STATIC_STRINGS)));
+
+  base_transform_class->start = GST_DEBUG_FUNCPTR(gst_pylon_hdr_fusion_start);
+  base_transform_class->stop = GST_DEBUG_FUNCPTR(gst_pylon_hdr_fusion_stop);
+  base_transform_class->transform_caps =
+      GST_DEBUG_FUNCPTR(gst_pylon_hdr_fusion_transform_caps);
+  base_transform_class->transform_size =
+      GST_DEBUG_FUNCPTR(gst_pylon_hdr_fusion_transform_size);
+  base_transform_class->set_caps =
+      GST_DEBUG_FUNCPTR(gst_pylon_hdr_fusion_set_caps);
+  base_transform_class->transform_meta =
+      GST_DEBUG_FUNCPTR(gst_pylon_hdr_fusion_transform_meta);
+  base_transform_class->transform =
+      GST_DEBUG_FUNCPTR(gst_pylon_hdr_fusion_transform);
+}
+
+static void gst_pylon_hdr_fusion_init(GstPylonHdrFusion *self) {
+  self->output = PROP_OUTPUT_DEFAULT;
+  self->n_threads = PROP_N_THREADS_DEFAULT;
+  self->width = 0;
+  self->height = 0;
+  self->in_stride = 0;
+  self->out_stride = 0;
+  self->out_16bit = FALSE;
+  self->pool = NULL;
+  self->merge = NULL;
+  self->exposure_times = new std::vector<double>();
+}
+
+static void gst_pylon_hdr_fusion_set_property(GObject *object,
+                                              guint property_id,
+                                              const GValue *value,
+                                              GParamSpec *pspec) {
+  GstPylonHdrFusion *self = GST_PYLON_HDR_FUSION(object);
+
+  GST_OBJECT_LOCK(self);
+
+  switch (property_id) {
+    case PROP_OUTPUT:
+      self->output =
+          static_cast<GstPylonHdrFusionOutputEnum>(g_value_get_enum(value));
+      break;
+    case PROP_N_THREADS:
+      self->n_threads = g_value_get_uint(value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+      break;
+  }
+
+  GST_OBJECT_UNLOCK(self);
+}
+
+static void gst_pylon_hdr_fusion_get_property(GObject *object,
+                                              guint property_id,
+                                              GValue *value,
+                                              GParamSpec *pspec) {
+  GstPylonHdrFusion *self = GST_PYLON_HDR_FUSION(object);
+
+  GST_OBJECT_LOCK(self);
+
+  switch (property_id) {
+    case PROP_OUTPUT:
+      g_value_set_enum(value, self->output);
+      break;
+    case PROP_N_THREADS:
+      g_value_set_uint(value, self->n_threads);
+      break;
+    case PROP_SIMD:
+      g_value_set_string(value,
+                         gst_pylon_simd_level_name(gst_pylon_simd_detect()));
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+      break;
+  }
+
+  GST_OBJECT_UNLOCK(self);
+}
+
+static void gst_pylon_hdr_fusion_finalize(GObject *object) {
+  GstPylonHdrFusion *self = GST_PYLON_HDR_FUSION(object);
+
+  delete self->pool;
+  self->pool = NULL;
+  delete self->merge;
+  self->merge = NULL;
+  delete self->exposure_times;
+  self->exposure_times = NULL;
+
+  G_OBJECT_CLASS(gst_pylon_hdr_fusion_parent_class)->finalize(object);
+}
+
+static gboolean gst_pylon_hdr_fusion_start(GstBaseTransform *trans) {
+  GstPylonHdrFusion *self = GST_PYLON_HDR_FUSION(trans);
+  guint n_threads = 0;
+
+  GST_OBJECT_LOCK(self);
+  n_threads = self->n_threads;
+  GST_OBJECT_UNLOCK(self);
+
+  self->pool = new GstPylonWorkerPool(n_threads);
+  self->merge = new GstPylonHdrMerge();
+  self->exposure_times->clear();
+
+  GST_INFO_OBJECT(self, "Merging with %u threads using %s",
+                  self->pool->GetThreadCount(),
+                  gst_pylon_simd_level_name(self->merge->GetSimdLevel()));
+
+  return TRUE;
+}
+
+static gboolean gst_pylon_hdr_fusion_stop(GstBaseTransform *trans) {
+  GstPylonHdrFusion *self = GST_PYLON_HDR_FUSION(trans);
+
+  delete self->pool;
+  self->pool = NULL;
+  delete self->merge;
+  self->merge = NULL;
+
+  return TRUE;
+}
+
+static gboolean gst_pylon_hdr_fusion_is_bayer(const GstStructure *st) {
+  return 0 == g_strcmp0(gst_structure_get_name(st), "video/x-bayer");
+}
+
+/* format of the other pad for a single format string */
+static gchar *gst_pylon_hdr_fusion_map_format(
+    const gchar *format, gboolean is_bayer, GstPadDirection direction,
+    GstPylonHdrFusionOutputEnum output) {
+  if (GST_PAD_SINK == direction) {
+    gboolean wide = ENUM_FUSION_RADIANCE == output;
+
+    if (is_bayer) {
+      return wide ? g_strconcat(format, BAYER_16BIT_SUFFIX, NULL)
+                  : g_strdup(format);
+    }
+    return g_strdup(wide ? "GRAY16_LE" : "GRAY8");
+  }
+
+  if (is_bayer) {
+    if (g_str_has_suffix(format, BAYER_16BIT_SUFFIX)) {
+      return g_strndup(format, strlen(format) - strlen(BAYER_16BIT_SUFFIX));
+    }
+    return g_strdup(format);
+  }
+  return g_strdup("GRAY8");
+}
+
+static GstCaps *gst_pylon_hdr_fusion_transform_caps(GstBaseTransform *trans,
+                                                    GstPadDirection direction,
+                                                    GstCaps *caps,
+                                                    GstCaps *filter) {
+  GstPylonHdrFusion *self = GST_PYLON_HDR_FUSION(trans);
+  GstPylonHdrFusionOutputEnum output = ENUM_FUSION_RADIANCE;
+  GstCaps *result = gst_caps_new_empty();
+
+  GST_OBJECT_LOCK(self);
+  output = self->output;
+  GST_OBJECT_UNLOCK(self);
+
+  for (guint i = 0; i < gst_caps_get_size(caps); i++) {
+    GstStructure *st = gst_structure_copy(gst_caps_get_structure(caps, i));
+    const GValue *format = gst_structure_get_value(st, "format");
+    gboolean is_bayer = gst_pylon_hdr_fusion_is_bayer(st);
+
+    /* a fused frame is no bundle of exposures */
+    if (GST_PAD_SINK == direction) {
+      gst_structure_remove_field(st, "exposure-count");
+    }
+
+    if (format && G_VALUE_HOLDS_STRING(format)) {
+      gchar *other = gst_pylon_hdr_fusion_map_format(
+          g_value_get_string(format), is_bayer, direction, output);
+      gst_structure_set(st, "format", G_TYPE_STRING, other, NULL);
+      g_free(other);
+    } else if (format && GST_VALUE_HOLDS_LIST(format)) {
+      GValue list = G_VALUE_INIT;
+
+      g_value_init(&list, GST_TYPE_LIST);
+      for (guint j = 0; j < gst_value_list_get_size(format); j++) {
+        const GValue *item = gst_value_list_get_value(format, j);
+        GValue other = G_VALUE_INIT;
+
+        if (!G_VALUE_HOLDS_STRING(item)) {
+          continue;
+        }
+
+        g_value_init(&other, G_TYPE_STRING);
+        g_value_take_string(
+            &other, gst_pylon_hdr_fusion_map_format(g_value_get_string(item),
+                                                    is_bayer, direction,
+                                                    output));
+        gst_value_list_append_and_take_value(&list, &other);
+      }
+      gst_structure_take_value(st, "format", &list);
+    }
+
+    gst_caps_append_structure(result, st);
+  }
+
+  if (filter) {
+    GstCaps *tmp =
+        gst_caps_intersect_full(filter, result, GST_CAPS_INTERSECT_FIRST);
+    gst_caps_unref(result);
+    result = tmp;
+  }
+
+  GST_DEBUG_OBJECT(self, "Transformed %" GST_PTR_FORMAT " into %" GST_PTR_FORMAT,
+                   caps, result);
+
+  return result;
+}
+
+/* size of one frame as described by the caps */
+static gboolean gst_pylon_hdr_fusion_get_layout(GstCaps *caps, gint *width,
+                                                gint *height, gint *stride,
+                                                gboolean *is_16bit) {
+  GstStructure *st = gst_caps_get_structure(caps, 0);
+
+  if (gst_pylon_hdr_fusion_is_bayer(st)) {
+    const gchar *format = gst_structure_get_string(st, "format");
+
+    if (!format || !gst_structure_get_int(st, "width", width) ||
+        !gst_structure_get_int(st, "height", height)) {
+      return FALSE;
+    }
+    *is_16bit = g_str_has_suffix(format, BAYER_16BIT_SUFFIX);
+    *stride = *width * (*is_16bit ? 2 : 1);
+  } else {
+    GstVideoInfo info;
+
+    if (!gst_video_info_from_caps(&info, caps)) {
+      return FALSE;
+    }
+    *width = GST_VIDEO_INFO_WIDTH(&info);
+    *height = GST_VIDEO_INFO_HEIGHT(&info);
+    *stride = GST_VIDEO_INFO_PLANE_STRIDE(&info, 0);
+    *is_16bit = GST_VIDEO_FORMAT_GRAY16_LE == GST_VIDEO_INFO_FORMAT(&info);
+  }
+
+  return TRUE;
+}
+
+static gboolean gst_pylon_hdr_fusion_transform_size(
+    GstBaseTransform *trans, GstPadDirection direction, GstCaps *caps,
+    gsize size, GstCaps *othercaps, gsize *othersize) {
+  gint width = 0;
+  gint height = 0;
+  gint stride = 0;
+  gboolean is_16bit = FALSE;
+
+  /* one frame in the layout of the other pad */
+  if (!gst_pylon_hdr_fusion_get_layout(othercaps, &width, &height, &stride,
+                                       &is_16bit)) {
+    return FALSE;
+  }
+
+  switch (direction) {
+    case GST_PAD_SINK:
+      /* a whole window is merged into a single output frame */
+      *othersize = static_cast<gsize>(stride) * height;
+      break;
+    case GST_PAD_SRC:
+      /* the window length is only known from the HDR metas of the input
+       * buffer, report the smallest window of a single frame */
+      *othersize = static_cast<gsize>(stride) * height;
+      break;
+    default:
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+static gboolean gst_pylon_hdr_fusion_set_caps(GstBaseTransform *trans,
+                                              GstCaps *incaps,
+                                              GstCaps *outcaps) {
+  GstPylonHdrFusion *self = GST_PYLON_HDR_FUSION(trans);
+  gint out_width = 0;
+  gint out_height = 0;
+  gboolean in_16bit = FALSE;
+
+  if (!gst_pylon_hdr_fusion_get_layout(incaps, &self->width, &self->height,
+                                       &self->in_stride, &in_16bit) ||
+      !gst_pylon_hdr_fusion_get_layout(outcaps, &out_width, &out_height,
+                                       &self->out_stride, &self->out_16bit)) {
+    GST_ERROR_OBJECT(self, "Unable to parse caps");
+    return FALSE;
+  }
+
+  if (self->width != out_width || self->height != out_height) {
+    GST_ERROR_OBJECT(self, "Input and output dimensions differ");
+    return FALSE;
+  }
+
+  GST_INFO_OBJECT(self, "Fusing %dx%d exposures into %d-bit frames",
+                  self->width, self->height, self->out_16bit ? 16 : 8);
+
+  return TRUE;
+}
+
+static gboolean gst_pylon_hdr_fusion_transform_meta(GstBaseTransform *trans,
+                                                    GstBuffer *outbuf,
+                                                    GstMeta *meta,
+                                                    GstBuffer *inbuf) {
+  GType api = meta->info->api;
+
+  /* per exposure metas do not describe the fused frame */
+  if (GST_VIDEO_META_API_TYPE == api || GST_HDR_META_API_TYPE == api) {
+    return FALSE;
+  }
+
+  return GST_BASE_TRANSFORM_CLASS(gst_pylon_hdr_fusion_parent_class)
+      ->transform_meta(trans, outbuf, meta, inbuf);
+}
+
+static GstFlowReturn gst_pylon_hdr_fusion_transform(GstBaseTransform *trans,
+                                                    GstBuffer *inbuf,
+                                                    GstBuffer *outbuf) {
+  GstPylonHdrFusion *self = GST_PYLON_HDR_FUSION(trans);
+  std::vector<double> exposure_times;
+  std::vector<GstMapInfo> maps;
+  std::vector<const uint8_t *> src;
+  std::vector<int> src_stride;
+  GstMapInfo out_map;
+  gpointer state = NULL;
+  GstMeta *meta = NULL;
+  GstFlowReturn ret = GST_FLOW_OK;
+  guint position = 0;
+
+  /* one exposure per HDR meta, in the order they were bundled */
+  while ((meta = gst_buffer_iterate_meta_filtered(inbuf, &state,
+                                                  GST_HDR_META_API_TYPE))) {
+    GstHdrMeta *hdr_meta = reinterpret_cast<GstHdrMeta *>(meta);
+    GstVideoMeta *video_meta =
+        gst_buffer_get_video_meta_id(inbuf, hdr_meta->exposure_sequence_index);
+    gsize offset = 0;
+    gint stride = self->in_stride;
+    gsize frame_size = 0;
+    guint idx = 0;
+    guint length = 0;
+    gsize skip = 0;
+    GstMapInfo map;
+
+    if (video_meta) {
+      offset = video_meta->offset[0];
+      stride = video_meta->stride[0];
+    } else {
+      offset = position * static_cast<gsize>(self->in_stride) * self->height;
+    }
+    position++;
+
+    /* the last row ends after its samples, not after the stride */
+    frame_size = static_cast<gsize>(stride) * (self->height - 1) + self->width;
+
+    if (!gst_buffer_find_memory(inbuf, offset, frame_size, &idx, &length,
+                                &skip) ||
+        !gst_buffer_map_range(inbuf, idx, length, &map, GST_MAP_READ)) {
+      GST_ELEMENT_ERROR(self, STREAM, FAILED,
+                        ("Exposure %u is out of the buffer bounds",
+                         hdr_meta->exposure_sequence_index),
+                        (NULL));
+      ret = GST_FLOW_ERROR;
+      goto unmap;
+    }
+
+    maps.push_back(map);
+    src.push_back(map.data + skip);
+    src_stride.push_back(stride);
+    exposure_times.push_back(hdr_meta->exposure_value);
+  }
+
+  /* not an HDR window, the merge reduces to a plain conversion */
+  if (maps.empty()) {
+    GstMapInfo map;
+
+    if (!gst_buffer_map(inbuf, &map, GST_MAP_READ)) {
+      GST_ELEMENT_ERROR(self, STREAM, FAILED, ("Unable to map input buffer"),
+                        (NULL));
+      return GST_FLOW_ERROR;
+    }
+
+    maps.push_back(map);
+    src.push_back(map.data);
+    src_stride.push_back(self->in_stride);
+    exposure_times.push_back(1.0);
+  }
+
+  if (exposure_times != *self->exposure_times) {
+    if (!self->merge->Configure(exposure_times)) {
+      GST_ELEMENT_ERROR(self, STREAM, FAILED,
+                        ("Invalid exposure times in HDR window"), (NULL));
+      ret = GST_FLOW_ERROR;
+      goto unmap;
+    }
+    *self->exposure_times = exposure_times;
+    GST_DEBUG_OBJECT(self, "Configured merge for %zu exposures",
+                     exposure_times.size());
+  }
+
+  if (!gst_buffer_map(outbuf, &out_map, GST_MAP_WRITE)) {
+    GST_ELEMENT_ERROR(self, STREAM, FAILED, ("Unable to map output buffer"),
+                      (NULL));
+    ret = GST_FLOW_ERROR;
+    goto unmap;
+  }
+
+  if (self->out_16bit) {
+    self->merge->Process(src.data(), src_stride.data(),
+                         reinterpret_cast<uint16_t *>(out_map.data),
+                         self->out_stride, self->width, self->height,
+                         self->pool);
+  } else {
+    self->merge->ProcessToneMapped(src.data(), src_stride.data(),
+                                   out_map.data, self->out_stride,
+                                   self->width, self->height, self->pool);
+  }
+
+  gst_buffer_unmap(outbuf, &out_map);
+
+unmap:
+  for (auto &map : maps) {
+    gst_buffer_unmap(inbuf, &map);
+  }
+
+  return ret;
+}
@@ -0,0 +1,25 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Multithreaded HDR exposure fusion element
+ */
+
+#ifndef _GST_PYLON_HDR_FUSION_H_
+#define _GST_PYLON_HDR_FUSION_H_
+
+#include <gst/base/gstbasetransform.h>
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_PYLON_HDR_FUSION gst_pylon_hdr_fusion_get_type()
+G_DECLARE_FINAL_TYPE(GstPylonHdrFusion, gst_pylon_hdr_fusion, GST,
+                     PYLON_HDR_FUSION, GstBaseTransform)
+
+typedef enum {
+  ENUM_FUSION_RADIANCE = 0,
+  ENUM_FUSION_TONEMAPPED = 1,
+} GstPylonHdrFusionOutputEnum;
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,403 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Weighted exposure merge for HDR windows
+ */
+
+#include "gstpylonhdrmerge.h"
+
+#include <algorithm>
+#include <cmath>
+
+/* radiance is stored with 8 fractional bits */
+static constexpr float RADIANCE_SCALE = 256.0f;
+
+/* Per sample weight: a hat over the 8-bit range, zero for black and clipped
+ * samples. Combined with the exposure time ratio r_k the merged radiance in
+ * code values of the shortest exposure is sum(h * v) / sum(h * r_k). */
+static inline uint32_t hat_weight(uint32_t v) { return std::min(v, 255 - v); }
+
+static void merge_row_scalar(const uint8_t *const *rows, const float *ratios,
+                             size_t n_rows, size_t shortest, uint16_t *dst,
+                             int width, int x) {
+  for (; x < width; x++) {
+    float num = 0.0f;
+    float den = 0.0f;
+    float radiance = 0.0f;
+
+    for (size_t k = 0; k < n_rows; k++) {
+      uint32_t v = rows[k][x];
+      uint32_t h = hat_weight(v);
+      num += static_cast<float>(h * v);
+      den += static_cast<float>(h) * ratios[k];
+    }
+
+    /* every sample is black or clipped, trust the shortest exposure */
+    if (den > 0.0f) {
+      radiance = RADIANCE_SCALE * num / den;
+    } else {
+      radiance = RADIANCE_SCALE * rows[shortest][x];
+    }
+
+    dst[x] = static_cast<uint16_t>(std::min(radiance + 0.5f, 65535.0f));
+  }
+}
+
+static void merge_row_c(const uint8_t *const *rows, const float *ratios,
+                        size_t n_rows, size_t shortest, uint16_t *dst,
+                        int width) {
+  merge_row_scalar(rows, ratios, n_rows, shortest, dst, width, 0);
+}
+
+#if defined(GST_PYLON_ARCH_X86)
+GST_PYLON_TARGET_SSE41 static inline void merge_group_sse41(
+    __m128i v, __m128i h, __m128 ratio, __m128 *num, __m128 *den) {
+  __m128 hf = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(h));
+  __m128i hv = _mm_mullo_epi32(_mm_cvtepu8_epi32(h), _mm_cvtepu8_epi32(v));
+
+  *num = _mm_add_ps(*num, _mm_cvtepi32_ps(hv));
+  *den = _mm_add_ps(*den, _mm_mul_ps(hf, ratio));
+}
+
+GST_PYLON_TARGET_SSE41 static inline __m128i resolve_group_sse41(
+    __m128 num, __m128 den, __m128i s) {
+  const __m128 scale = _mm_set1_ps(RADIANCE_SCALE);
+  __m128 valid = _mm_cmpgt_ps(den, _mm_setzero_ps());
+  __m128 merged = _mm_mul_ps(_mm_div_ps(num, den), scale);
+  __m128 fallback = _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(s)), scale);
+
+  return _mm_cvtps_epi32(_mm_blendv_ps(fallback, merged, valid));
+}
+
+GST_PYLON_TARGET_SSE41 static void merge_row_sse41(const uint8_t *const *rows,
+                                                   const float *ratios,
+                                                   size_t n_rows,
+                                                   size_t shortest,
+                                                   uint16_t *dst, int width) {
+  const __m128i ones = _mm_set1_epi8(-1);
+  int x = 0;
+
+  for (; x + 16 <= width; x += 16) {
+    __m128 num[4] = {_mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(),
+                     _mm_setzero_ps()};
+    __m128 den[4] = {_mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(),
+                     _mm_setzero_ps()};
+
+    for (size_t k = 0; k < n_rows; k++) {
+      __m128i v =
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(rows[k] + x));
+      __m128i h = _mm_min_epu8(v, _mm_xor_si128(v, ones));
+      __m128 ratio = _mm_set1_ps(ratios[k]);
+
+      merge_group_sse41(v, h, ratio, &num[0], &den[0]);
+      merge_group_sse41(_mm_srli_si128(v, 4), _mm_srli_si128(h, 4), ratio,
+                        &num[1], &den[1]);
+      merge_group_sse41(_mm_srli_si128(v, 8), _mm_srli_si128(h, 8), ratio,
+                        &num[2], &den[2]);
+      merge_group_sse41(_mm_srli_si128(v, 12), _mm_srli_si128(h, 12), ratio,
+                        &num[3], &den[3]);
+    }
+
+    __m128i s =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(rows[shortest] + x));
+    __m128i r0 = resolve_group_sse41(num[0], den[0], s);
+    __m128i r1 = resolve_group_sse41(num[1], den[1], _mm_srli_si128(s, 4));
+    __m128i r2 = resolve_group_sse41(num[2], den[2], _mm_srli_si128(s, 8));
+    __m128i r3 = resolve_group_sse41(num[3], den[3], _mm_srli_si128(s, 12));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x),
+                     _mm_packus_epi32(r0, r1));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x + 8),
+                     _mm_packus_epi32(r2, r3));
+  }
+
+  merge_row_scalar(rows, ratios, n_rows, shortest, dst, width, x);
+}
+
+GST_PYLON_TARGET_AVX2 static inline void merge_group_avx2(
+    __m128i v, __m128i h, __m256 ratio, __m256 *num, __m256 *den) {
+  __m256i h32 = _mm256_cvtepu8_epi32(h);
+  __m256i hv = _mm256_mullo_epi32(h32, _mm256_cvtepu8_epi32(v));
+
+  *num = _mm256_add_ps(*num, _mm256_cvtepi32_ps(hv));
+  *den = _mm256_add_ps(*den, _mm256_mul_ps(_mm256_cvtepi32_ps(h32), ratio));
+}
+
+GST_PYLON_TARGET_AVX2 static inline __m256i resolve_group_avx2(__m256 num,
+                                                               __m256 den,
+                                                               __m128i s) {
+  const __m256 scale = _mm256_set1_ps(RADIANCE_SCALE);
+  __m256 valid = _mm256_cmp_ps(den, _mm256_setzero_ps(), _CMP_GT_OQ);
+  __m256 merged = _mm256_mul_ps(_mm256_div_ps(num, den), scale);
+  __m256 fallback =
+      _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(s)), scale);
+
+  return _mm256_cvtps_epi32(_mm256_blendv_ps(fallback, merged, valid));
+}
+
+GST_PYLON_TARGET_AVX2 static void merge_row_avx2(const uint8_t *const *rows,
+                                                 const float *ratios,
+                                                 size_t n_rows,
+                                                 size_t shortest,
+                                                 uint16_t *dst, int width) {
+  const __m256i ones = _mm256_set1_epi8(-1);
+  int x = 0;
+
+  for (; x + 32 <= width; x += 32) {
+    __m256 num[4] = {_mm256_setzero_ps(), _mm256_setzero_ps(),
+                     _mm256_setzero_ps(), _mm256_setzero_ps()};
+    __m256 den[4] = {_mm256_setzero_ps(), _mm256_setzero_ps(),
+                     _mm256_setzero_ps(), _mm256_setzero_ps()};
+
+    for (size_t k = 0; k < n_rows; k++) {
+      __m256i v =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rows[k] + x));
+      __m256i h = _mm256_min_epu8(v, _mm256_xor_si256(v, ones));
+      __m256 ratio = _mm256_set1_ps(ratios[k]);
+      __m128i v_lo = _mm256_castsi256_si128(v);
+      __m128i v_hi = _mm256_extracti128_si256(v, 1);
+      __m128i h_lo = _mm256_castsi256_si128(h);
+      __m128i h_hi = _mm256_extracti128_si256(h, 1);
+
+      merge_group_avx2(v_lo, h_lo, ratio, &num[0], &den[0]);
+      merge_group_avx2(_mm_srli_si128(v_lo, 8), _mm_srli_si128(h_lo, 8),
+                       ratio, &num[1], &den[1]);
+      merge_group_avx2(v_hi, h_hi, ratio, &num[2], &den[2]);
+      merge_group_avx2(_mm_srli_si128(v_hi, 8), _mm_srli_si128(h_hi, 8),
+                       ratio, &num[3], &den[3]);
+    }
+
+    __m256i s = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(rows[shortest] + x));
+    __m128i s_lo = _mm256_castsi256_si128(s);
+    __m128i s_hi = _mm256_extracti128_si256(s, 1);
+    __m256i r0 = resolve_group_avx2(num[0], den[0], s_lo);
+    __m256i r1 = resolve_group_avx2(num[1], den[1], _mm_srli_si128(s_lo, 8));
+    __m256i r2 = resolve_group_avx2(num[2], den[2], s_hi);
+    __m256i r3 = resolve_group_avx2(num[3], den[3], _mm_srli_si128(s_hi, 8));
+
+    /* packus works per 128-bit lane, restore the pixel order */
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i *>(dst + x),
+        _mm256_permute4x64_epi64(_mm256_packus_epi32(r0, r1), 0xD8));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i *>(dst + x + 16),
+        _mm256_permute4x64_epi64(_mm256_packus_epi32(r2, r3), 0xD8));
+  }
+
+  merge_row_scalar(rows, ratios, n_rows, shortest, dst, width, x);
+}
+#endif
+
+#if defined(GST_PYLON_ARCH_ARM64)
+static inline void merge_group_neon(uint16x4_t v, uint16x4_t h, float ratio,
+                                    float32x4_t *num, float32x4_t *den) {
+  float32x4_t hf = vcvtq_f32_u32(vmovl_u16(h));
+  float32x4_t hv = vcvtq_f32_u32(vmull_u16(h, v));
+
+  *num = vaddq_f32(*num, hv);
+  *den = vmlaq_n_f32(*den, hf, ratio);
+}
+
+static inline uint16x4_t resolve_group_neon(float32x4_t num, float32x4_t den,
+                                            uint16x4_t s) {
+  uint32x4_t valid = vcgtq_f32(den, vdupq_n_f32(0.0f));
+  float32x4_t merged = vmulq_n_f32(vdivq_f32(num, den), RADIANCE_SCALE);
+  float32x4_t fallback =
+      vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(s)), RADIANCE_SCALE);
+
+  return vqmovn_u32(vcvtnq_u32_f32(vbslq_f32(valid, merged, fallback)));
+}
+
+static void merge_row_neon(const uint8_t *const *rows, const float *ratios,
+                           size_t n_rows, size_t shortest, uint16_t *dst,
+                           int width) {
+  int x = 0;
+
+  for (; x + 16 <= width; x += 16) {
+    float32x4_t num[4] = {vdupq_n_f32(0.0f), vdupq_n_f32(0.0f),
+                          vdupq_n_f32(0.0f), vdupq_n_f32(0.0f)};
+    float32x4_t den[4] = {vdupq_n_f32(0.0f), vdupq_n_f32(0.0f),
+                          vdupq_n_f32(0.0f), vdupq_n_f32(0.0f)};
+
+    for (size_t k = 0; k < n_rows; k++) {
+      uint8x16_t v = vld1q_u8(rows[k] + x);
+      uint8x16_t h = vminq_u8(v, vmvnq_u8(v));
+      uint16x8_t v_lo = vmovl_u8(vget_low_u8(v));
+      uint16x8_t v_hi = vmovl_u8(vget_high_u8(v));
+      uint16x8_t h_lo = vmovl_u8(vget_low_u8(h));
+      uint16x8_t h_hi = vmovl_u8(vget_high_u8(h));
+
+      merge_group_neon(vget_low_u16(v_lo), vget_low_u16(h_lo), ratios[k],
+                       &num[0], &den[0]);
+      merge_group_neon(vget_high_u16(v_lo), vget_high_u16(h_lo), ratios[k],
+                       &num[1], &den[1]);
+      merge_group_neon(vget_low_u16(v_hi), vget_low_u16(h_hi), ratios[k],
+                       &num[2], &den[2]);
+      merge_group_neon(vget_high_u16(v_hi), vget_high_u16(h_hi), ratios[k],
+                       &num[3], &den[3]);
+    }
+
+    uint8x16_t s = vld1q_u8(rows[shortest] + x);
+    uint16x8_t s_lo = vmovl_u8(vget_low_u8(s));
+    uint16x8_t s_hi = vmovl_u8(vget_high_u8(s));
+
+    vst1q_u16(dst + x,
+              vcombine_u16(resolve_group_neon(num[0], den[0],
+                                              vget_low_u16(s_lo)),
+                           resolve_group_neon(num[1], den[1],
+                                              vget_high_u16(s_lo))));
+    vst1q_u16(dst + x + 8,
+              vcombine_u16(resolve_group_neon(num[2], den[2],
+                                              vget_low_u16(s_hi)),
+                           resolve_group_neon(num[3], den[3],
+                                              vget_high_u16(s_hi))));
+  }
+
+  merge_row_scalar(rows, ratios, n_rows, shortest, dst, width, x);
+}
+#endif
+
+static GstPylonHdrMergeRowFunc select_merge_row(GstPylonSimdLevel level) {
+  switch (level) {
+#if defined(GST_PYLON_ARCH_X86)
+    case GST_PYLON_SIMD_AVX2:
+      return merge_row_avx2;
+    case GST_PYLON_SIMD_SSE41:
+      return merge_row_sse41;
+#endif
+#if defined(GST_PYLON_ARCH_ARM64)
+    case GST_PYLON_SIMD_NEON:
+      return merge_row_neon;
+#endif
+    default:
+      return merge_row_c;
+  }
+}
+
+GstPylonHdrMerge::GstPylonHdrMerge()
+    : shortest(0),
+      tone_lut(65536, 0),
+      simd_level(gst_pylon_simd_detect()),
+      merge_row(select_merge_row(simd_level)) {}
+
+bool GstPylonHdrMerge::Configure(const std::vector<double> &exposure_times) {
+  if (exposure_times.empty()) {
+    return false;
+  }
+
+  for (double time : exposure_times) {
+    if (!(time > 0.0)) {
+      return false;
+    }
+  }
+
+  auto min_it = std::min_element(exposure_times.begin(), exposure_times.end());
+  double min_time = *min_it;
+  double max_ratio =
+      *std::max_element(exposure_times.begin(), exposure_times.end()) /
+      min_time;
+
+  this->shortest = std::distance(exposure_times.begin(), min_it);
+  this->ratios.clear();
+  for (double time : exposure_times) {
+    this->ratios.push_back(static_cast<float>(time / min_time));
+  }
+
+  /* one code value of the longest exposure maps to 1 in the log domain */
+  double slope = max_ratio / RADIANCE_SCALE;
+  double norm = std::log1p(65535.0 * slope);
+  for (size_t i = 0; i < this->tone_lut.size(); i++) {
+    this->tone_lut[i] = static_cast<uint8_t>(
+        std::lround(255.0 * std::log1p(i * slope) / norm));
+  }
+
+  return true;
+}
+
+size_t GstPylonHdrMerge::GetExposureCount() const {
+  return this->ratios.size();
+}
+
+uint8_t GstPylonHdrMerge::MapTone(uint16_t radiance) const {
+  return this->tone_lut[radiance];
+}
+
+GstPylonSimdLevel GstPylonHdrMerge::GetSimdLevel() const {
+  return this->simd_level;
+}
+
+void GstPylonHdrMerge::SetSimdLevel(GstPylonSimdLevel level) {
+  GstPylonSimdLevel cpu = gst_pylon_simd_detect_cpu();
+
+  if (GST_PYLON_SIMD_SCALAR == level || level == cpu ||
+      (GST_PYLON_SIMD_NEON != cpu && GST_PYLON_SIMD_NEON != level &&
+       level < cpu)) {
+    this->simd_level = level;
+    this->merge_row = select_merge_row(level);
+  }
+}
+
+static size_t stripe_rows(GstPylonWorkerPool *pool, int height) {
+  /* a few stripes per thread balance uneven scheduling */
+  return std::max<size_t>(1, height / (pool->GetThreadCount() * 4));
+}
+
+void GstPylonHdrMerge::Process(const uint8_t *const *src,
+                               const int *src_stride, uint16_t *dst,
+                               int dst_stride, int width, int height,
+                               GstPylonWorkerPool *pool) const {
+  const size_t n = this->ratios.size();
+
+  auto merge_rows = [&](size_t begin, size_t end) {
+    std::vector<const uint8_t *> rows(n);
+
+    for (size_t y = begin; y < end; y++) {
+      for (size_t k = 0; k < n; k++) {
+        rows[k] = src[k] + y * src_stride[k];
+      }
+      this->merge_row(rows.data(), this->ratios.data(), n, this->shortest,
+                      reinterpret_cast<uint16_t *>(
+                          reinterpret_cast<uint8_t *>(dst) + y * dst_stride),
+                      width);
+    }
+  };
+
+  if (pool) {
+    pool->Run(height, stripe_rows(pool, height), merge_rows);
+  } else {
+    merge_rows(0, height);
+  }
+}
+
+void GstPylonHdrMerge::ProcessToneMapped(const uint8_t *const *src,
+                                         const int *src_stride, uint8_t *dst,
+                                         int dst_stride, int width,
+                                         int height,
+                                         GstPylonWorkerPool *pool) const {
+  const size_t n = this->ratios.size();
+
+  auto merge_rows = [&](size_t begin, size_t end) {
+    std::vector<const uint8_t *> rows(n);
+    std::vector<uint16_t> radiance(width);
+
+    for (size_t y = begin; y < end; y++) {
+      uint8_t *out = dst + y * dst_stride;
+
+      for (size_t k = 0; k < n; k++) {
+        rows[k] = src[k] + y * src_stride[k];
+      }
+      this->merge_row(rows.data(), this->ratios.data(), n, this->shortest,
+                      radiance.data(), width);
+
+      for (int x = 0; x < width; x++) {
+        out[x] = this->tone_lut[radiance[x]];
+      }
+    }
+  };
+
+  if (pool) {
+    pool->Run(height, stripe_rows(pool, height), merge_rows);
+  } else {
+    merge_rows(0, height);
+  }
+}
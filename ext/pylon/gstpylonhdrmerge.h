@@ -0,0 +1,63 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Weighted exposure merge for HDR windows
+ */
+
+#ifndef _GST_PYLON_HDR_MERGE_H_
+#define _GST_PYLON_HDR_MERGE_H_
+
+#include "gstpylonsimd.h"
+#include "gstpylonworkerpool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+typedef void (*GstPylonHdrMergeRowFunc)(const uint8_t *const *rows,
+                                        const float *ratios, size_t n_rows,
+                                        size_t shortest, uint16_t *dst,
+                                        int width);
+
+/**
+ * GstPylonHdrMerge:
+ *
+ * Merges the 8-bit exposures of one HDR window into a linear radiance image.
+ * Every sample is weighted with a hat function of its value, so clipped and
+ * black samples do not contribute, and with its exposure time, which favours
+ * the exposures with the best signal to noise ratio.
+ *
+ * The 16-bit radiance is expressed in code values of the shortest exposure
+ * with 8 fractional bits. The tone mapped 8-bit output applies a global
+ * logarithmic curve spanning the dynamic range of the window.
+ */
+class GstPylonHdrMerge {
+ public:
+  GstPylonHdrMerge();
+
+  /* one exposure time per input image, in any unit */
+  bool Configure(const std::vector<double> &exposure_times);
+  size_t GetExposureCount() const;
+
+  GstPylonSimdLevel GetSimdLevel() const;
+  /* fall back to a lower code path, used by the benchmark */
+  void SetSimdLevel(GstPylonSimdLevel level);
+
+  void Process(const uint8_t *const *src, const int *src_stride,
+               uint16_t *dst, int dst_stride, int width, int height,
+               GstPylonWorkerPool *pool) const;
+  void ProcessToneMapped(const uint8_t *const *src, const int *src_stride,
+                         uint8_t *dst, int dst_stride, int width, int height,
+                         GstPylonWorkerPool *pool) const;
+  /* the tone curve ProcessToneMapped applies to the radiance, used by the
+   * benchmark */
+  uint8_t MapTone(uint16_t radiance) const;
+
+ private:
+  std::vector<float> ratios;
+  size_t shortest;
+  std::vector<uint8_t> tone_lut;
+  GstPylonSimdLevel simd_level;
+  GstPylonHdrMergeRowFunc merge_row;
+};
+
+#endif
@@ -36,6 +36,9 @@
 
 #include "version.h"
 
+#include "gsthdrmeta.h"
+#include "gstpylonhdrbundle.h"
+#include "gstpylonhdrfusion.h"
 #include "gstpylonsrc.h"
 #include <pylon/PylonVersionNumber.h>
 
@@ -46,8 +49,22 @@ static gboolean plugin_init(GstPlugin* plugin) {
            PYLON_VERSIONSTRING_MINOR,
            PYLON_VERSIONSTRING_SUBMINOR,
            PYLON_VERSIONSTRING_BUILD);
-  return gst_element_register(plugin, "pylonsrc", GST_RANK_NONE,
-                              GST_TYPE_PYLON_SRC);
+  /* registered up front, so applications and tests find the HDR meta by
+   * name before the first frame carries one */
+  gst_hdr_meta_get_info();
+
+  if (!gst_element_register(plugin, "pylonsrc", GST_RANK_NONE,
+                            GST_TYPE_PYLON_SRC)) {
+    return FALSE;
+  }
+
+  if (!gst_element_register(plugin, "pylonhdrbundle", GST_RANK_NONE,
+                            GST_TYPE_PYLON_HDR_BUNDLE)) {
+    return FALSE;
+  }
+
+  return gst_element_register(plugin, "pylonhdrfusion", GST_RANK_NONE,
+                              GST_TYPE_PYLON_HDR_FUSION);
 }
 
 GST_PLUGIN_DEFINE (GST_VERSION_MAJOR, GST_VERSION_MINOR,
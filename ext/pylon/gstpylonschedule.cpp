@@ -0,0 +1,372 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Feature changes scheduled for a frame number or camera timestamp
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "gstpylonschedule.h"
+
+GST_DEBUG_CATEGORY_STATIC(gst_pylon_schedule_debug);
+#define GST_CAT_DEFAULT gst_pylon_schedule_debug
+
+typedef enum {
+  SCHEDULE_PENDING,
+  SCHEDULE_ISSUED,
+  SCHEDULE_APPLIED,
+  SCHEDULE_FAILED,
+  /* the control thread was stopped before the entry was written */
+  SCHEDULE_DROPPED,
+} GstPylonScheduleState;
+
+typedef struct {
+  GstPylonSchedule *schedule;
+  /* held by the schedule and by a pushed control command */
+  gint ref_count;
+  guint id;
+  GstStructure *features;
+  guint64 frame_number;
+  guint64 timestamp;
+  GstPylonScheduleState state;
+  /* first camera tick, or last delivered frame, after the write */
+  guint64 effect_ticks;
+  guint64 effect_frame;
+} GstPylonScheduleEntry;
+
+struct _GstPylonSchedule {
+  GstElement *element;
+
+  GMutex lock;
+  GList *entries;
+  guint next_id;
+  guint current_id;
+  guint64 last_frame_number;
+  guint64 last_timestamp;
+  guint64 frame_ticks;
+};
+
+static GstPylonScheduleEntry *gst_pylon_schedule_entry_ref(
+    GstPylonScheduleEntry *entry) {
+  g_atomic_int_inc(&entry->ref_count);
+  return entry;
+}
+
+static void gst_pylon_schedule_entry_unref(GstPylonScheduleEntry *entry) {
+  if (g_atomic_int_dec_and_test(&entry->ref_count)) {
+    gst_structure_free(entry->features);
+    g_free(entry);
+  }
+}
+
+static void gst_pylon_schedule_post_dropped(GstPylonSchedule *self,
+                                            GstPylonScheduleEntry *entry) {
+  GstStructure *st = gst_structure_new(
+      "pylon-schedule-dropped", "id", G_TYPE_UINT, entry->id, "features",
+      GST_TYPE_STRUCTURE, entry->features, NULL);
+
+  GST_INFO("Schedule entry dropped: %" GST_PTR_FORMAT, st);
+
+  gst_element_post_message(self->element,
+                           gst_message_new_element(
+                               GST_OBJECT_CAST(self->element), st));
+}
+
+/* Destroy notify of the control command, runs after the entry was executed
+ * or when the control thread is freed with the command still queued */
+static void gst_pylon_schedule_command_done(gpointer user_data) {
+  GstPylonScheduleEntry *entry =
+      static_cast<GstPylonScheduleEntry *>(user_data);
+  GstPylonSchedule *self = entry->schedule;
+  gboolean dropped = FALSE;
+
+  g_mutex_lock(&self->lock);
+  if (SCHEDULE_ISSUED == entry->state) {
+    entry->state = SCHEDULE_DROPPED;
+    dropped = TRUE;
+  }
+  g_mutex_unlock(&self->lock);
+
+  if (dropped) {
+    gst_pylon_schedule_post_dropped(self, entry);
+  }
+
+  gst_pylon_schedule_entry_unref(entry);
+}
+
+/* runs on the control thread */
+static gboolean gst_pylon_schedule_execute(GstPylon *pylon, gpointer user_data,
+                                           GError **err) {
+  GstPylonScheduleEntry *entry =
+      static_cast<GstPylonScheduleEntry *>(user_data);
+  GstPylonSchedule *self = entry->schedule;
+  GstStructure *results = NULL;
+  GError *latch_error = NULL;
+  guint64 ticks = GST_PYLON_SCHEDULE_NONE;
+  gboolean applied = TRUE;
+
+  /* features are not modified once the entry is added */
+  results = gst_pylon_apply_features(pylon, entry->features);
+  for (gint i = 0; results && i < gst_structure_n_fields(results); i++) {
+    const gchar *name = gst_structure_nth_field_name(results, i);
+    gboolean field_applied = FALSE;
+
+    gst_structure_get_boolean(results, name, &field_applied);
+    if (!field_applied) {
+      g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
+                  "Scheduled feature \"%s\" of entry %u was not applied", name,
+                  entry->id);
+      applied = FALSE;
+      break;
+    }
+  }
+  if (results) {
+    gst_structure_free(results);
+  }
+
+  if (!gst_pylon_latch_timestamp(pylon, &ticks, &latch_error)) {
+    GST_DEBUG("Counting frames for entry %u: %s", entry->id,
+              latch_error->message);
+    g_clear_error(&latch_error);
+    ticks = GST_PYLON_SCHEDULE_NONE;
+  }
+
+  g_mutex_lock(&self->lock);
+  entry->state = applied ? SCHEDULE_APPLIED : SCHEDULE_FAILED;
+  entry->effect_ticks = ticks;
+  entry->effect_frame = self->last_frame_number;
+  g_mutex_unlock(&self->lock);
+
+  return applied;
+}
+
+static gboolean gst_pylon_schedule_is_due(GstPylonSchedule *self,
+                                          GstPylonScheduleEntry *entry,
+                                          guint64 frame_number,
+                                          guint64 timestamp) {
+  if (GST_PYLON_SCHEDULE_NONE == entry->frame_number &&
+      GST_PYLON_SCHEDULE_NONE == entry->timestamp) {
+    return TRUE;
+  }
+
+  if (GST_PYLON_SCHEDULE_NONE != entry->frame_number &&
+      frame_number + GST_PYLON_SCHEDULE_LEAD_FRAMES >= entry->frame_number) {
+    return TRUE;
+  }
+
+  /* without a frame period yet, wait for the second frame */
+  if (GST_PYLON_SCHEDULE_NONE != entry->timestamp && self->frame_ticks > 0 &&
+      timestamp + GST_PYLON_SCHEDULE_LEAD_FRAMES * self->frame_ticks >=
+          entry->timestamp) {
+    return TRUE;
+  }
+
+  return FALSE;
+}
+
+static gboolean gst_pylon_schedule_is_in_effect(GstPylonScheduleEntry *entry,
+                                                guint64 frame_number,
+                                                guint64 timestamp) {
+  if (GST_PYLON_SCHEDULE_NONE != entry->effect_ticks) {
+    return timestamp >= entry->effect_ticks;
+  }
+
+  return GST_PYLON_SCHEDULE_NONE == entry->effect_frame ||
+         frame_number > entry->effect_frame;
+}
+
+static void gst_pylon_schedule_post_applied(GstPylonSchedule *self,
+                                            GstPylonScheduleEntry *entry,
+                                            guint64 frame_number,
+                                            guint64 timestamp) {
+  GstStructure *st = gst_structure_new(
+      "pylon-schedule-applied", "id", G_TYPE_UINT, entry->id, "frame-number",
+      G_TYPE_UINT64, frame_number, "timestamp", G_TYPE_UINT64, timestamp,
+      "features", GST_TYPE_STRUCTURE, entry->features, NULL);
+
+  if (GST_PYLON_SCHEDULE_NONE != entry->frame_number) {
+    gst_structure_set(st, "requested-frame-number", G_TYPE_UINT64,
+                      entry->frame_number, NULL);
+  }
+  if (GST_PYLON_SCHEDULE_NONE != entry->timestamp) {
+    gst_structure_set(st, "requested-timestamp", G_TYPE_UINT64,
+                      entry->timestamp, NULL);
+  }
+
+  GST_INFO("Schedule entry applied: %" GST_PTR_FORMAT, st);
+
+  gst_element_post_message(self->element,
+                           gst_message_new_element(
+                               GST_OBJECT_CAST(self->element), st));
+}
+
+GstPylonSchedule *gst_pylon_schedule_new(GstElement *element) {
+  GstPylonSchedule *self = NULL;
+
+  g_return_val_if_fail(element, NULL);
+
+  GST_DEBUG_CATEGORY_INIT(gst_pylon_schedule_debug, "pylonschedule", 0,
+                          "Pylon scheduled feature changes");
+
+  self = g_new0(GstPylonSchedule, 1);
+  self->element = element;
+  g_mutex_init(&self->lock);
+  self->entries = NULL;
+  self->next_id = 1;
+  self->current_id = 0;
+  self->last_frame_number = GST_PYLON_SCHEDULE_NONE;
+  self->last_timestamp = GST_PYLON_SCHEDULE_NONE;
+  self->frame_ticks = 0;
+
+  return self;
+}
+
+void gst_pylon_schedule_free(GstPylonSchedule *self) {
+  g_return_if_fail(self);
+
+  gst_pylon_schedule_clear(self);
+  g_mutex_clear(&self->lock);
+  g_free(self);
+}
+
+guint gst_pylon_schedule_add(GstPylonSchedule *self,
+                             const GstStructure *features,
+                             guint64 frame_number, guint64 timestamp) {
+  GstPylonScheduleEntry *entry = NULL;
+  guint id = 0;
+
+  g_return_val_if_fail(self, 0);
+  g_return_val_if_fail(features, 0);
+
+  entry = g_new0(GstPylonScheduleEntry, 1);
+  entry->schedule = self;
+  entry->ref_count = 1;
+  entry->features = gst_structure_copy(features);
+  entry->frame_number = frame_number;
+  entry->timestamp = timestamp;
+  entry->state = SCHEDULE_PENDING;
+  entry->effect_ticks = GST_PYLON_SCHEDULE_NONE;
+  entry->effect_frame = GST_PYLON_SCHEDULE_NONE;
+
+  g_mutex_lock(&self->lock);
+  id = entry->id = self->next_id++;
+  self->entries = g_list_append(self->entries, entry);
+  g_mutex_unlock(&self->lock);
+
+  GST_DEBUG("Scheduled entry %u at frame %" G_GUINT64_FORMAT
+            ", timestamp %" G_GUINT64_FORMAT ": %" GST_PTR_FORMAT,
+            id, frame_number, timestamp, features);
+
+  return id;
+}
+
+gboolean gst_pylon_schedule_cancel(GstPylonSchedule *self, guint id) {
+  gboolean ret = FALSE;
+
+  g_return_val_if_fail(self, FALSE);
+
+  g_mutex_lock(&self->lock);
+  for (GList *l = self->entries; l; l = l->next) {
+    GstPylonScheduleEntry *entry =
+        static_cast<GstPylonScheduleEntry *>(l->data);
+
+    if (entry->id == id && SCHEDULE_PENDING == entry->state) {
+      self->entries = g_list_delete_link(self->entries, l);
+      gst_pylon_schedule_entry_unref(entry);
+      ret = TRUE;
+      break;
+    }
+  }
+  g_mutex_unlock(&self->lock);
+
+  return ret;
+}
+
+void gst_pylon_schedule_clear(GstPylonSchedule *self) {
+  g_return_if_fail(self);
+
+  g_mutex_lock(&self->lock);
+  g_list_free_full(self->entries,
+                   reinterpret_cast<GDestroyNotify>(
+                       gst_pylon_schedule_entry_unref));
+  self->entries = NULL;
+  self->current_id = 0;
+  self->last_frame_number = GST_PYLON_SCHEDULE_NONE;
+  self->last_timestamp = GST_PYLON_SCHEDULE_NONE;
+  self->frame_ticks = 0;
+  g_mutex_unlock(&self->lock);
+}
+
+guint gst_pylon_schedule_process_frame(GstPylonSchedule *self,
+                                       GstPylonControl *control,
+                                       guint64 frame_number,
+                                       guint64 timestamp) {
+  GList *issued = NULL;
+  GList *in_effect = NULL;
+  guint current_id = 0;
+
+  g_return_val_if_fail(self, 0);
+
+  g_mutex_lock(&self->lock);
+
+  if (GST_PYLON_SCHEDULE_NONE != self->last_timestamp &&
+      frame_number > self->last_frame_number &&
+      timestamp > self->last_timestamp) {
+    self->frame_ticks = (timestamp - self->last_timestamp) /
+                        (frame_number - self->last_frame_number);
+  }
+  self->last_frame_number = frame_number;
+  self->last_timestamp = timestamp;
+
+  for (GList *l = self->entries; l;) {
+    GstPylonScheduleEntry *entry =
+        static_cast<GstPylonScheduleEntry *>(l->data);
+    GList *next = l->next;
+
+    if (SCHEDULE_PENDING == entry->state && control &&
+        gst_pylon_schedule_is_due(self, entry, frame_number, timestamp)) {
+      entry->state = SCHEDULE_ISSUED;
+      issued = g_list_append(issued, entry);
+    } else if (SCHEDULE_FAILED == entry->state ||
+               SCHEDULE_DROPPED == entry->state) {
+      /* the failure or the drop was posted already */
+      self->entries = g_list_delete_link(self->entries, l);
+      gst_pylon_schedule_entry_unref(entry);
+    } else if (SCHEDULE_APPLIED == entry->state &&
+               gst_pylon_schedule_is_in_effect(entry, frame_number,
+                                               timestamp)) {
+      self->current_id = entry->id;
+      self->entries = g_list_delete_link(self->entries, l);
+      in_effect = g_list_append(in_effect, entry);
+    }
+
+    l = next;
+  }
+  current_id = self->current_id;
+
+  g_mutex_unlock(&self->lock);
+
+  for (GList *l = issued; l; l = l->next) {
+    GstPylonScheduleEntry *entry =
+        static_cast<GstPylonScheduleEntry *>(l->data);
+    gchar *name = g_strdup_printf("scheduled features %u", entry->id);
+
+    gst_pylon_control_push(control, name, gst_pylon_schedule_execute,
+                           gst_pylon_schedule_entry_ref(entry),
+                           gst_pylon_schedule_command_done);
+    g_free(name);
+  }
+  g_list_free(issued);
+
+  for (GList *l = in_effect; l; l = l->next) {
+    GstPylonScheduleEntry *entry =
+        static_cast<GstPylonScheduleEntry *>(l->data);
+
+    gst_pylon_schedule_post_applied(self, entry, frame_number, timestamp);
+    gst_pylon_schedule_entry_unref(entry);
+  }
+  g_list_free(in_effect);
+
+  return current_id;
+}
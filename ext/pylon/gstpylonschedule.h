@@ -0,0 +1,62 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Feature changes scheduled for a frame number or camera timestamp
+ */
+
+#ifndef _GST_PYLON_SCHEDULE_H_
+#define _GST_PYLON_SCHEDULE_H_
+
+#include "gstpyloncontrol.h"
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+#define GST_PYLON_SCHEDULE_NONE G_MAXUINT64
+
+/* frames between issuing a write and the frame it is scheduled for, covers
+ * the frames already exposed while the write is in flight */
+#define GST_PYLON_SCHEDULE_LEAD_FRAMES 2
+
+typedef struct _GstPylonSchedule GstPylonSchedule;
+
+/**
+ * GstPylonSchedule:
+ *
+ * Camera feature changes requested for a frame number or a camera timestamp
+ * in ticks. Entries are handed to the #GstPylonControl thread
+ * %GST_PYLON_SCHEDULE_LEAD_FRAMES frames ahead of their target and written
+ * as one feature transaction. After the write the camera timestamp is
+ * latched, frames exposed past the latch are the ones the change is in
+ * effect on. Cameras that cannot latch their timestamp count the frames
+ * delivered after the write instead.
+ *
+ * The first frame an entry is in effect on posts a "pylon-schedule-applied"
+ * element message. Entries still queued when the control thread is stopped
+ * post a "pylon-schedule-dropped" element message instead.
+ */
+GstPylonSchedule *gst_pylon_schedule_new(GstElement *element);
+void gst_pylon_schedule_free(GstPylonSchedule *self);
+
+/* Returns the id of the new entry. With neither a frame number nor a
+ * timestamp the entry is issued on the next frame. */
+guint gst_pylon_schedule_add(GstPylonSchedule *self,
+                             const GstStructure *features,
+                             guint64 frame_number, guint64 timestamp);
+/* entries already handed to the control thread cannot be cancelled */
+gboolean gst_pylon_schedule_cancel(GstPylonSchedule *self, guint id);
+/* drop all entries, the control thread must be stopped */
+void gst_pylon_schedule_clear(GstPylonSchedule *self);
+
+/* Called by the streaming thread for every frame, issues the entries due
+ * and returns the id of the last entry in effect on the frame. Entries
+ * taking effect on the same frame are reported by their applied messages,
+ * only the last one added is returned. */
+guint gst_pylon_schedule_process_frame(GstPylonSchedule *self,
+                                       GstPylonControl *control,
+                                       guint64 frame_number,
+                                       guint64 timestamp);
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,179 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Declarative sequencer programs loaded from a key file
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "gstpylonsequencerprogram.h"
+
+#define SEQUENCER_GROUP "Sequencer"
+#define SET_GROUP_FORMAT "Set %u"
+#define DEFAULT_TRIGGER "ExposureActive"
+
+static gboolean gst_pylon_sequencer_program_is_reserved(const gchar *key) {
+  return !g_strcmp0(key, "Transitions") || !g_strcmp0(key, "Next") ||
+         !g_strcmp0(key, "Trigger");
+}
+
+static gboolean gst_pylon_sequencer_program_parse_set(
+    GKeyFile *file, const gchar *group, guint index, guint n_sets,
+    const gchar *default_trigger, GstPylonSequencerSet &set, GError **err) {
+  gchar **keys = NULL;
+  gchar **transitions = NULL;
+  gchar *trigger = NULL;
+  GError *error = NULL;
+  gboolean ret = FALSE;
+  guint next = (index + 1) % n_sets;
+
+  keys = g_key_file_get_keys(file, group, NULL, err);
+  if (!keys) {
+    goto out;
+  }
+
+  for (guint i = 0; keys[i]; i++) {
+    gchar *value = NULL;
+
+    if (gst_pylon_sequencer_program_is_reserved(keys[i])) {
+      continue;
+    }
+
+    value = g_key_file_get_value(file, group, keys[i], err);
+    if (!value) {
+      goto out;
+    }
+    g_strstrip(value);
+    set.features.emplace_back(keys[i], value);
+    g_free(value);
+  }
+
+  transitions =
+      g_key_file_get_string_list(file, group, "Transitions", NULL, NULL);
+  for (guint i = 0; transitions && transitions[i]; i++) {
+    gchar **parts = g_strsplit(g_strstrip(transitions[i]), ":", 2);
+    gchar *end = NULL;
+    guint64 target = g_ascii_strtoull(parts[0], &end, 10);
+
+    if (end == parts[0] || !parts[1] || target >= n_sets) {
+      g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
+                  "[%s] invalid transition \"%s\", expected <set>:<trigger> "
+                  "with a set below %u",
+                  group, transitions[i], n_sets);
+      g_strfreev(parts);
+      goto out;
+    }
+
+    set.paths.push_back({static_cast<guint>(target), g_strstrip(parts[1])});
+    g_strfreev(parts);
+  }
+
+  if (g_key_file_has_key(file, group, "Next", NULL)) {
+    gint value = g_key_file_get_integer(file, group, "Next", &error);
+    if (error) {
+      g_propagate_prefixed_error(err, error, "[%s] ", group);
+      goto out;
+    }
+    if (value < 0 || static_cast<guint>(value) >= n_sets) {
+      g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
+                  "[%s] Next=%d is not a set of this program", group, value);
+      goto out;
+    }
+    next = value;
+  }
+
+  trigger = g_key_file_get_string(file, group, "Trigger", NULL);
+  set.paths.push_back(
+      {next, trigger ? g_strstrip(trigger) : default_trigger});
+
+  ret = TRUE;
+
+out:
+  g_free(trigger);
+  g_strfreev(transitions);
+  g_strfreev(keys);
+  return ret;
+}
+
+gboolean gst_pylon_sequencer_program_load(const gchar *location,
+                                          GstPylonSequencerProgram *program,
+                                          GError **err) {
+  GKeyFile *file = NULL;
+  gchar *trigger = NULL;
+  gchar *group = NULL;
+  GError *error = NULL;
+  gboolean ret = FALSE;
+  guint n_sets = 0;
+
+  g_return_val_if_fail(location, FALSE);
+  g_return_val_if_fail(program, FALSE);
+  g_return_val_if_fail(err && *err == NULL, FALSE);
+
+  file = g_key_file_new();
+  if (!g_key_file_load_from_file(file, location, G_KEY_FILE_NONE, &error)) {
+    g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
+                "Failed to read sequencer program %s: %s", location,
+                error->message);
+    g_error_free(error);
+    goto out;
+  }
+
+  /* sets are numbered without gaps, the first missing one ends the program */
+  for (;; n_sets++) {
+    group = g_strdup_printf(SET_GROUP_FORMAT, n_sets);
+    if (!g_key_file_has_group(file, group)) {
+      break;
+    }
+    g_clear_pointer(&group, g_free);
+  }
+  g_clear_pointer(&group, g_free);
+
+  if (0 == n_sets) {
+    g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
+                "Sequencer program %s has no [" SET_GROUP_FORMAT "] group",
+                location, 0);
+    goto out;
+  }
+
+  program->sets.clear();
+  program->start = 0;
+
+  if (g_key_file_has_key(file, SEQUENCER_GROUP, "Start", NULL)) {
+    gint start = g_key_file_get_integer(file, SEQUENCER_GROUP, "Start", &error);
+    if (error || start < 0 || static_cast<guint>(start) >= n_sets) {
+      g_set_error(err, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
+                  "[" SEQUENCER_GROUP "] Start must be a set below %u", n_sets);
+      g_clear_error(&error);
+      goto out;
+    }
+    program->start = start;
+  }
+
+  trigger = g_key_file_get_string(file, SEQUENCER_GROUP, "Trigger", NULL);
+  if (!trigger) {
+    trigger = g_strdup(DEFAULT_TRIGGER);
+  }
+  g_strstrip(trigger);
+
+  for (guint i = 0; i < n_sets; i++) {
+    GstPylonSequencerSet set;
+
+    group = g_strdup_printf(SET_GROUP_FORMAT, i);
+    if (!gst_pylon_sequencer_program_parse_set(file, group, i, n_sets, trigger,
+                                               set, err)) {
+      goto out;
+    }
+    g_clear_pointer(&group, g_free);
+
+    program->sets.push_back(set);
+  }
+
+  ret = TRUE;
+
+out:
+  g_free(group);
+  g_free(trigger);
+  g_key_file_free(file);
+  return ret;
+}
@@ -0,0 +1,49 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Declarative sequencer programs loaded from a key file
+ */
+
+#ifndef _GST_PYLON_SEQUENCER_PROGRAM_H_
+#define _GST_PYLON_SEQUENCER_PROGRAM_H_
+
+#include <gst/gst.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/* transition to another set, taken when the trigger fires */
+struct GstPylonSequencerPath {
+  guint next;
+  std::string trigger;
+};
+
+struct GstPylonSequencerSet {
+  /* feature name and value, applied in file order */
+  std::vector<std::pair<std::string, std::string>> features;
+  /* checked in order, the last one is the default path */
+  std::vector<GstPylonSequencerPath> paths;
+};
+
+struct GstPylonSequencerProgram {
+  guint start = 0;
+  std::vector<GstPylonSequencerSet> sets;
+};
+
+/**
+ * gst_pylon_sequencer_program_load:
+ *
+ * Parses a sequencer program. The optional [Sequencer] group holds the
+ * start set (Start) and the default trigger (Trigger). Every set is a
+ * [Set N] group, numbered from 0 without gaps. Its keys are camera
+ * features written in file order, except for the reserved keys:
+ *
+ *   Transitions: list of set:trigger jumps checked before the default path
+ *   Next: set following this one, defaults to the next set, wrapping around
+ *   Trigger: trigger of the default path, defaults to the program trigger
+ */
+gboolean gst_pylon_sequencer_program_load(const gchar *location,
+                                          GstPylonSequencerProgram *program,
+                                          GError **err);
+
+#endif
@@ -0,0 +1,121 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Runtime selection of SIMD code paths
+ */
+
+#ifndef _GST_PYLON_SIMD_H_
+#define _GST_PYLON_SIMD_H_
+
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || \
+    defined(_M_IX86)
+#  define GST_PYLON_ARCH_X86 1
+#  ifdef _MSC_VER
+#    include <intrin.h>
+#  endif
+#  include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#  define GST_PYLON_ARCH_ARM64 1
+#  include <arm_neon.h>
+#endif
+
+/* per function target attributes let the SSE4.1/AVX2 kernels live next to
+ * the scalar code without building the whole file for a newer CPU. MSVC
+ * accepts the intrinsics without them. */
+#if defined(GST_PYLON_ARCH_X86) && (defined(__GNUC__) || defined(__clang__))
+#  define GST_PYLON_TARGET_SSE41 __attribute__((target("sse4.1")))
+#  define GST_PYLON_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#  define GST_PYLON_TARGET_SSE41
+#  define GST_PYLON_TARGET_AVX2
+#endif
+
+typedef enum {
+  GST_PYLON_SIMD_SCALAR = 0,
+  GST_PYLON_SIMD_SSE41 = 1,
+  GST_PYLON_SIMD_AVX2 = 2,
+  GST_PYLON_SIMD_NEON = 3,
+} GstPylonSimdLevel;
+
+static inline const char *gst_pylon_simd_level_name(GstPylonSimdLevel level) {
+  switch (level) {
+    case GST_PYLON_SIMD_SSE41:
+      return "sse4.1";
+    case GST_PYLON_SIMD_AVX2:
+      return "avx2";
+    case GST_PYLON_SIMD_NEON:
+      return "neon";
+    default:
+      return "scalar";
+  }
+}
+
+static inline GstPylonSimdLevel gst_pylon_simd_detect_cpu() {
+#if defined(GST_PYLON_ARCH_X86)
+#  if defined(__GNUC__) || defined(__clang__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return GST_PYLON_SIMD_AVX2;
+  }
+  if (__builtin_cpu_supports("sse4.1")) {
+    return GST_PYLON_SIMD_SSE41;
+  }
+#  elif defined(_MSC_VER)
+  int info[4] = {0};
+  __cpuid(info, 0);
+  int max_leaf = info[0];
+  __cpuid(info, 1);
+  bool sse41 = (info[2] & (1 << 19)) != 0;
+  bool osxsave = (info[2] & (1 << 27)) != 0;
+  bool avx = (info[2] & (1 << 28)) != 0;
+  if (max_leaf >= 7 && osxsave && avx &&
+      (_xgetbv(0) & 0x6) == 0x6) {
+    __cpuidex(info, 7, 0);
+    if (info[1] & (1 << 5)) {
+      return GST_PYLON_SIMD_AVX2;
+    }
+  }
+  if (sse41) {
+    return GST_PYLON_SIMD_SSE41;
+  }
+#  endif
+  return GST_PYLON_SIMD_SCALAR;
+#elif defined(GST_PYLON_ARCH_ARM64)
+  return GST_PYLON_SIMD_NEON;
+#else
+  return GST_PYLON_SIMD_SCALAR;
+#endif
+}
+
+/* Best code path for this CPU. The GST_PYLON_SIMD environment variable
+ * (scalar, sse4.1, avx2, neon) can lower it for debugging and
+ * benchmarking, it never raises it above what the CPU supports. */
+static inline GstPylonSimdLevel gst_pylon_simd_detect() {
+  static const GstPylonSimdLevel level = [] {
+    GstPylonSimdLevel cpu = gst_pylon_simd_detect_cpu();
+    const char *env = std::getenv("GST_PYLON_SIMD");
+
+    if (!env) {
+      return cpu;
+    }
+
+    for (int l = GST_PYLON_SIMD_SCALAR; l <= GST_PYLON_SIMD_NEON; l++) {
+      GstPylonSimdLevel requested = static_cast<GstPylonSimdLevel>(l);
+      if (0 == std::strcmp(env, gst_pylon_simd_level_name(requested))) {
+        if (GST_PYLON_SIMD_SCALAR == requested ||
+            (requested <= cpu && GST_PYLON_SIMD_NEON != cpu) ||
+            requested == cpu) {
+          return requested;
+        }
+      }
+    }
+
+    return cpu;
+  }();
+
+  return level;
+}
+
+#endif
@@ -50,15 +50,22 @@
 
 #include "gst/pylon/gstpylondebug.h"
 #include "gst/pylon/gstpylonmeta.h"
+#include "gst/pylon/gstpylonobject.h"
 #include "gstpylon.h"
+#include "gstpylonclock.h"
 #include "gstpylonsrc.h"
 #include "HdrMetadataPlugin.h"
-#include "HdrProfileSwitcher.h"
 #include "gsthdrmeta.h"
+#include "gstpyloncontrol.h"
+#include "gstpylonschedule.h"
+#include "gstpylonhdrautoexposure.h"
 
 #include <gst/pylon/gstpylonincludes.h>
 #include <gst/video/video.h>
 
+#include <algorithm>
+#include <vector>
+
 struct _GstPylonSrc {
   GstPushSrc base_pylonsrc;
   GstPylon *pylon;
@@ -74,9 +81,34 @@ struct _GstPylonSrc {
   GstPylonCaptureErrorEnum capture_error;
   gchar *hdr_sequence;
   gchar *hdr_sequence2;
+  gchar *hdr_profiles;
   gint hdr_profile;
+  GstPylonHdrLookupEnum hdr_lookup;
+  gchar *sequencer_program;
+  gboolean hdr_auto_exposure;
+  gdouble hdr_ae_highlight_target;
+  gdouble hdr_ae_shadow_target;
+  guint hdr_ae_interval;
   HdrMetadataPlugin *hdr_plugin;
-  HdrProfileSwitcher *hdr_switcher;
+  GstPylonHdrAutoExposure *hdr_ae;
+  /* exposures found by the auto exposure per profile, empty for profiles
+   * not adjusted yet, programmed the next time acquisition is stopped */
+  std::vector<std::vector<guint32>> *hdr_ae_exposures;
+  /* the exposures were found for other HDR sequences than configured */
+  gboolean hdr_ae_stale;
+  /* adjustments found and adjustments programmed into the sequencer */
+  guint hdr_ae_adjustments;
+  gint hdr_ae_generation;
+  GstPylonControl *control;
+  GstPylonSchedule *schedule;
+  gint last_hdr_profile;
+  guint64 last_frame_number;
+  guint64 switch_request_frame;
+  gboolean camera_clock;
+  gchar *events;
+  gboolean packed_formats;
+  gchar *rois;
+  GstClock *clock;
   GObject *cam;
   GObject *stream;
 
@@ -96,6 +128,7 @@ static void gst_pylon_src_finalize(GObject *object);
 
 static GstCaps *gst_pylon_src_get_caps(GstBaseSrc *src, GstCaps *filter);
 static gboolean gst_pylon_src_is_bayer(GstStructure *st);
+static gint gst_pylon_src_get_bayer_pixel_size(GstStructure *st);
 static GstCaps *gst_pylon_src_fixate(GstBaseSrc *src, GstCaps *caps);
 static gboolean gst_pylon_src_set_caps(GstBaseSrc *src, GstCaps *caps);
 static gboolean gst_pylon_src_decide_allocation(GstBaseSrc *src,
@@ -107,6 +140,32 @@ static gboolean gst_pylon_src_query(GstBaseSrc *src, GstQuery *query);
 static void gst_plyon_src_add_metadata(GstPylonSrc *self, GstBuffer *buf);
 static GstFlowReturn gst_pylon_src_create(GstPushSrc *src, GstBuffer **buf);
 static void gst_pylon_src_enable_hdr_chunks(GstPylonSrc *self);
+static void gst_pylon_src_enable_sequencer_chunks(GstPylonSrc *self);
+static gchar **gst_pylon_src_get_hdr_sequences(GstPylonSrc *self);
+static gchar *gst_pylon_src_adjust_hdr_sequence(
+    const gchar *sequence, const std::vector<guint32> &exposures);
+static GstClock *gst_pylon_src_provide_clock(GstElement *element);
+static void gst_pylon_src_release_clock(GstPylonSrc *self,
+                                        gboolean post_lost);
+static void gst_pylon_src_release_control(GstPylonSrc *self);
+static void gst_pylon_src_check_hdr_profile(GstPylonSrc *self,
+                                            guint64 frame_number);
+static void gst_pylon_src_setup_auto_exposure(
+    GstPylonSrc *self, GstCaps *caps,
+    const std::vector<std::vector<guint32>> &profile_exposures);
+static void gst_pylon_src_run_auto_exposure(GstPylonSrc *self, GstBuffer *buf);
+static gboolean gst_pylon_src_apply_auto_exposure(GstPylonSrc *self,
+                                                  gchar **sequences);
+static void gst_pylon_src_forget_auto_exposure(GstPylonSrc *self);
+
+static GstStructure *gst_pylon_src_apply_features(
+    GstPylonSrc *self, const GstStructure *features);
+static guint gst_pylon_src_schedule_features(GstPylonSrc *self,
+                                             const GstStructure *features,
+                                             guint64 frame_number,
+                                             guint64 timestamp);
+static gboolean gst_pylon_src_cancel_schedule(GstPylonSrc *self, guint id);
+static void gst_pylon_src_run_schedule(GstPylonSrc *self, GstBuffer *buf);
 
 static void gst_pylon_src_child_proxy_init(GstChildProxyInterface *iface);
 
@@ -121,7 +180,18 @@ enum {
   PROP_CAPTURE_ERROR,
   PROP_HDR_SEQUENCE,
   PROP_HDR_SEQUENCE2,
+  PROP_HDR_PROFILES,
   PROP_HDR_PROFILE,
+  PROP_HDR_LOOKUP,
+  PROP_SEQUENCER_PROGRAM,
+  PROP_HDR_AUTO_EXPOSURE,
+  PROP_HDR_AE_HIGHLIGHT_TARGET,
+  PROP_HDR_AE_SHADOW_TARGET,
+  PROP_HDR_AE_INTERVAL,
+  PROP_CAMERA_CLOCK,
+  PROP_EVENTS,
+  PROP_PACKED_FORMATS,
+  PROP_ROIS,
   PROP_CAM,
   PROP_STREAM,
 #ifdef NVMM_ENABLED
@@ -140,7 +210,20 @@ enum {
 #define PROP_ENABLE_CORRECTION_DEFAULT TRUE
 #define PROP_HDR_SEQUENCE_DEFAULT NULL
 #define PROP_HDR_SEQUENCE2_DEFAULT NULL
+#define PROP_HDR_PROFILES_DEFAULT NULL
 #define PROP_HDR_PROFILE_DEFAULT 0
+#define PROP_HDR_LOOKUP_DEFAULT ENUM_HDR_LOOKUP_EXPOSURE
+#define PROP_SEQUENCER_PROGRAM_DEFAULT NULL
+#define PROP_HDR_AUTO_EXPOSURE_DEFAULT FALSE
+#define PROP_HDR_AE_HIGHLIGHT_TARGET_DEFAULT 0.01
+#define PROP_HDR_AE_SHADOW_TARGET_DEFAULT 0.05
+#define PROP_HDR_AE_INTERVAL_DEFAULT 8
+#define PROP_HDR_AE_INTERVAL_MAX 1000
+#define NO_FRAME_NUMBER G_MAXUINT64
+#define PROP_CAMERA_CLOCK_DEFAULT FALSE
+#define PROP_EVENTS_DEFAULT NULL
+#define PROP_PACKED_FORMATS_DEFAULT FALSE
+#define PROP_ROIS_DEFAULT NULL
 #define PROP_CAM_DEFAULT NULL
 #define PROP_STREAM_DEFAULT NULL
 #define PROP_CAPTURE_ERROR_DEFAULT ENUM_ABORT
@@ -152,6 +235,9 @@ enum {
 /* Enum for cature_error */
 #define GST_TYPE_CAPTURE_ERROR_ENUM (gst_pylon_capture_error_enum_get_type())
 
+/* Enum for hdr_lookup */
+#define GST_TYPE_HDR_LOOKUP_ENUM (gst_pylon_hdr_lookup_enum_get_type())
+
 /* Child proxy interface names */
 static const gchar *gst_pylon_src_child_proxy_names[] = {"cam", "stream"};
 
@@ -173,6 +259,25 @@ static GType gst_pylon_capture_error_enum_get_type(void) {
   return (GType)gtype;
 }
 
+static GType gst_pylon_hdr_lookup_enum_get_type(void) {
+  static gsize gtype = 0;
+  static const GEnumValue values[] = {
+      {ENUM_HDR_LOOKUP_EXPOSURE, "exposure",
+       "Identify HDR frames by their chunk exposure time. Duplicate "
+       "exposures are made unique by adjusting the sequences."},
+      {ENUM_HDR_LOOKUP_SEQUENCER_SET, "sequencer-set",
+       "Identify HDR frames by their ChunkSequencerSetActive chunk. "
+       "Sequences are used unmodified."},
+      {0, NULL, NULL}};
+
+  if (g_once_init_enter(&gtype)) {
+    GType tmp = g_enum_register_static("GstPylonHdrLookupEnum", values);
+    g_once_init_leave(&gtype, tmp);
+  }
+
+  return (GType)gtype;
+}
+
 #ifdef NVMM_ENABLED
 #  define GST_TYPE_NVSURFACE_LAYOUT_ENUM \
     (gst_pylon_nvsurface_layout_enum_get_type())
@@ -207,10 +312,15 @@ static GType gst_pylon_nvsurface_layout_enum_get_type(void) {
     GST_STATIC_PAD_TEMPLATE(
         "src", GST_PAD_SRC, GST_PAD_ALWAYS,
         GST_STATIC_CAPS(GST_VIDEO_CAPS_MAKE(
-            " {GRAY8, RGB, BGR, YUY2, UYVY} ") ";"
+            " {GRAY8, GRAY16_LE, RGB, BGR, BGRx, YUY2, UYVY, NV12, I420} ")
+                                               ";"
                                                "video/"
-                                               "x-bayer,format={rggb,bggr,gbgr,"
-                                               "grgb},"
+                                               "x-bayer,format={rggb,bggr,gbrg,"
+                                               "grbg,rggb10le,bggr10le,"
+                                               "gbrg10le,grbg10le,rggb12le,"
+                                               "bggr12le,gbrg12le,grbg12le,"
+                                               "rggb16le,bggr16le,gbrg16le,"
+                                               "grbg16le},"
                                                "width=" GST_VIDEO_SIZE_RANGE
                                                ",height=" GST_VIDEO_SIZE_RANGE
                                                ",framerate"
@@ -228,6 +338,7 @@ G_DEFINE_TYPE_WITH_CODE(GstPylonSrc, gst_pylon_src, GST_TYPE_PUSH_SRC,
 
 static void gst_pylon_src_class_init(GstPylonSrcClass *klass) {
   GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+  GstElementClass *element_class = GST_ELEMENT_CLASS(klass);
   GstBaseSrcClass *base_src_class = GST_BASE_SRC_CLASS(klass);
   GstPushSrcClass *push_src_class = GST_PUSH_SRC_CLASS(klass);
   gchar *cam_params = NULL;
@@ -237,8 +348,6 @@ static void gst_pylon_src_class_init(GstPylonSrcClass *klass) {
   const gchar *cam_prolog = NULL;
   const gchar *stream_prolog = NULL;
 
-  Pylon::PylonAutoInitTerm init_pylon;
-
   /* Setting up pads and setting metadata should be moved to
      base_class_init if you intend to subclass this class. */
   gst_element_class_add_static_pad_template(GST_ELEMENT_CLASS(klass),
@@ -357,15 +466,148 @@ static void gst_pylon_src_class_init(GstPylonSrcClass *klass) {
           static_cast<GParamFlags>(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
                                    GST_PARAM_MUTABLE_READY)));
 
+  g_object_class_install_property(
+      gobject_class, PROP_HDR_PROFILES,
+      g_param_spec_string(
+          "hdr-profiles", "HDR Exposure Profiles",
+          "Semicolon-separated list of HDR sequences, one per profile, each in the "
+          "hdr-sequence format. Example: '19,150;250:1.5,350,450;1000:6,4000:6' "
+          "programs day, dusk and night profiles. All profiles share the sequencer "
+          "sets of the camera and are switched within one frame via the hdr-profile "
+          "property. Overrides hdr-sequence and hdr-sequence2 when set.",
+          PROP_HDR_PROFILES_DEFAULT,
+          static_cast<GParamFlags>(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                                   GST_PARAM_MUTABLE_READY)));
+
   g_object_class_install_property(
       gobject_class, PROP_HDR_PROFILE,
       g_param_spec_int(
           "hdr-profile", "Active HDR Profile",
-          "HDR profile to switch to (0 or 1). Set to trigger a profile switch via software signal. "
+          "HDR profile to switch to. Set to trigger a profile switch via software signal. "
           "Get returns the currently active profile based on actual frames (-1 if not configured).",
-          -1, 1, PROP_HDR_PROFILE_DEFAULT,
+          -1, GST_PYLON_HDR_MAX_PROFILES - 1, PROP_HDR_PROFILE_DEFAULT,
           static_cast<GParamFlags>(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
+  g_object_class_install_property(
+      gobject_class, PROP_HDR_LOOKUP,
+      g_param_spec_enum(
+          "hdr-lookup", "HDR frame lookup",
+          "How the profile and exposure index of an HDR frame are identified. "
+          "The sequencer-set lookup reads the active sequencer set chunk and "
+          "supports identical exposures with different gains.",
+          GST_TYPE_HDR_LOOKUP_ENUM, PROP_HDR_LOOKUP_DEFAULT,
+          static_cast<GParamFlags>(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                                   GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property(
+      gobject_class, PROP_SEQUENCER_PROGRAM,
+      g_param_spec_string(
+          "sequencer-program", "Sequencer program",
+          "Key file defining per sequencer set camera features (e.g. Gain, "
+          "OffsetX, OffsetY, LUTEnable) and the transitions between the sets. "
+          "The camera cycles through the program without host interaction, "
+          "the active set of every frame is reported in the "
+          "ChunkSequencerSetActive field of the pylon meta chunks. Takes "
+          "precedence over the HDR sequence properties.",
+          PROP_SEQUENCER_PROGRAM_DEFAULT,
+          static_cast<GParamFlags>(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                                   GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property(
+      gobject_class, PROP_HDR_AUTO_EXPOSURE,
+      g_param_spec_boolean(
+          "hdr-auto-exposure", "HDR auto exposure",
+          "Adjust the exposure times of the HDR sequencer sets to the scene. "
+          "The shortest exposure of a window follows hdr-ae-highlight-target, "
+          "the longest one hdr-ae-shadow-target, the exposures in between "
+          "keep their relative spacing. Requires hdr-lookup=sequencer-set. "
+          "Adjustments are programmed the next time acquisition is stopped, "
+          "the exposure_generation field of the HDR meta counts them.",
+          PROP_HDR_AUTO_EXPOSURE_DEFAULT,
+          static_cast<GParamFlags>(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                                   GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property(
+      gobject_class, PROP_HDR_AE_HIGHLIGHT_TARGET,
+      g_param_spec_double(
+          "hdr-ae-highlight-target", "HDR auto exposure highlight target",
+          "Fraction of samples of the shortest exposure allowed to clip",
+          0.0, 1.0, PROP_HDR_AE_HIGHLIGHT_TARGET_DEFAULT,
+          static_cast<GParamFlags>(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                                   GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property(
+      gobject_class, PROP_HDR_AE_SHADOW_TARGET,
+      g_param_spec_double(
+          "hdr-ae-shadow-target", "HDR auto exposure shadow target",
+          "Fraction of samples of the longest exposure allowed in the darkest "
+          "histogram bin (code values below 16)",
+          0.0, 1.0, PROP_HDR_AE_SHADOW_TARGET_DEFAULT,
+          static_cast<GParamFlags>(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                                   GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property(
+      gobject_class, PROP_HDR_AE_INTERVAL,
+      g_param_spec_uint(
+          "hdr-ae-interval", "HDR auto exposure interval",
+          "Minimum number of HDR windows between two exposure adjustments",
+          1, PROP_HDR_AE_INTERVAL_MAX, PROP_HDR_AE_INTERVAL_DEFAULT,
+          static_cast<GParamFlags>(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                                   GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property(
+      gobject_class, PROP_CAMERA_CLOCK,
+      g_param_spec_boolean(
+          "camera-clock", "Provide camera clock",
+          "Offer a pipeline clock that follows the timestamp counter of the "
+          "camera. The counter is latched periodically and interpolated "
+          "between latches. When the pipeline selects this clock, buffer "
+          "timestamps are derived from the camera exposure timestamps.",
+          PROP_CAMERA_CLOCK_DEFAULT,
+          static_cast<GParamFlags>(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                                   GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property(
+      gobject_class, PROP_EVENTS,
+      g_param_spec_string(
+          "events", "Camera events",
+          "Comma separated camera events to post as \"pylon-camera-event\" "
+          "element messages, e.g. \"ExposureEnd,FrameStartOvertrigger\". "
+          "With ExposureEnd, frames carry the exposure end as a "
+          "timestamp/x-pylon-exposure-end reference timestamp.",
+          PROP_EVENTS_DEFAULT,
+          static_cast<GParamFlags>(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                                   GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property(
+      gobject_class, PROP_PACKED_FORMATS,
+      g_param_spec_boolean(
+          "packed-formats", "Prefer packed pixel formats",
+          "Transfer 10 and 12-bit formats packed, e.g. Mono12p instead of "
+          "Mono12, and unpack them to 16-bit samples on the host. Saves "
+          "25 to 37% of the link bandwidth at the cost of host CPU time. "
+          "Packed formats are used anyway when the camera offers no "
+          "unpacked equivalent.",
+          PROP_PACKED_FORMATS_DEFAULT,
+          static_cast<GParamFlags>(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                                   GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property(
+      gobject_class, PROP_ROIS,
+      g_param_spec_string(
+          "rois", "Multiple regions of interest",
+          "Sensor regions read out with the camera's multiple ROI feature, "
+          "as \"x,y,width,height\" separated by ';', e.g. "
+          "\"0,0,320,240;640,0,320,240\". The camera reads the column and "
+          "row ranges of the regions and stitches their intersections into "
+          "one frame, regions with a common range share it. Every buffer "
+          "carries a GstVideoRegionOfInterestMeta of type \"pylon-roi\" per "
+          "region with its position in the frame. An empty string switches "
+          "multiple ROI off.",
+          PROP_ROIS_DEFAULT,
+          static_cast<GParamFlags>(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                                   GST_PARAM_MUTABLE_READY)));
+
 #ifdef NVMM_ENABLED
   g_object_class_install_property(
       gobject_class, PROP_NVSURFACE_LAYOUT,
@@ -387,18 +629,33 @@ static void gst_pylon_src_class_init(GstPylonSrcClass *klass) {
                                    GST_PARAM_MUTABLE_READY)));
 #endif
 
+  /* Opening every connected camera here would make each element creation
+   * pay for the device enumeration, document what the caches describe */
   cam_params = gst_pylon_camera_get_string_properties();
   stream_params = gst_pylon_stream_grabber_get_string_properties();
 
   if (NULL == cam_params) {
-    cam_prolog = "No valid cameras where found connected to the system.";
-    stream_prolog = cam_prolog;
+    cam_prolog =
+        "No camera models were found in the feature cache. Run "
+        "\"gst-pylon-cache-tool generate\" or start a pipeline once to list "
+        "their properties here.";
     cam_params = g_strdup("");
+  } else {
+    cam_prolog =
+        "The following list details the properties for each cached camera "
+        "model.\n";
+  }
+
+  if (NULL == stream_params) {
+    stream_prolog =
+        "No stream grabbers were found in the feature cache. Run "
+        "\"gst-pylon-cache-tool generate\" or start a pipeline once to list "
+        "their properties here.";
     stream_params = g_strdup("");
   } else {
-    cam_prolog = "The following list details the properties for each camera.\n";
     stream_prolog =
-        "The following list details the properties for each stream grabber.\n";
+        "The following list details the properties for each cached stream "
+        "grabber.\n";
   }
 
   cam_blurb = g_strdup_printf(
@@ -432,6 +689,64 @@ static void gst_pylon_src_class_init(GstPylonSrcClass *klass) {
   g_free(cam_params);
   g_free(stream_params);
 
+  /**
+   * GstPylonSrc::apply-features:
+   * @pylonsrc: the pylonsrc element
+   * @features: camera feature=value pairs, named as the "cam" properties
+   *
+   * Writes all features in one register transaction, each feature after
+   * the features that change its limits or access. Starts the camera if
+   * needed.
+   *
+   * Returns: a structure with a boolean field per requested feature, TRUE
+   * if the feature was applied
+   */
+  g_signal_new_class_handler(
+      "apply-features", G_TYPE_FROM_CLASS(klass),
+      static_cast<GSignalFlags>(G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION),
+      G_CALLBACK(gst_pylon_src_apply_features), NULL, NULL, NULL,
+      GST_TYPE_STRUCTURE, 1, GST_TYPE_STRUCTURE | G_SIGNAL_TYPE_STATIC_SCOPE);
+
+  /**
+   * GstPylonSrc::schedule-features:
+   * @pylonsrc: the pylonsrc element
+   * @features: camera feature=value pairs, as for apply-features
+   * @frame_number: frame to apply the features on, G_MAXUINT64 for none
+   * @timestamp: camera timestamp in ticks to apply the features at,
+   * G_MAXUINT64 for none
+   *
+   * Queues a feature change for a frame number or camera timestamp. It is
+   * written from the camera control thread ahead of its target, frames
+   * report the last change in effect in the schedule_id field of their
+   * #GstPylonMeta. Of several changes taking effect on the same frame only
+   * the last one added is reported there, each change posts its own
+   * "pylon-schedule-applied" element message.
+   *
+   * Returns: the id of the scheduled change
+   */
+  g_signal_new_class_handler(
+      "schedule-features", G_TYPE_FROM_CLASS(klass),
+      static_cast<GSignalFlags>(G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION),
+      G_CALLBACK(gst_pylon_src_schedule_features), NULL, NULL, NULL,
+      G_TYPE_UINT, 3, GST_TYPE_STRUCTURE | G_SIGNAL_TYPE_STATIC_SCOPE,
+      G_TYPE_UINT64, G_TYPE_UINT64);
+
+  /**
+   * GstPylonSrc::cancel-schedule:
+   * @pylonsrc: the pylonsrc element
+   * @id: id returned by schedule-features
+   *
+   * Returns: TRUE if the change was cancelled before being written
+   */
+  g_signal_new_class_handler(
+      "cancel-schedule", G_TYPE_FROM_CLASS(klass),
+      static_cast<GSignalFlags>(G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION),
+      G_CALLBACK(gst_pylon_src_cancel_schedule), NULL, NULL, NULL,
+      G_TYPE_BOOLEAN, 1, G_TYPE_UINT);
+
+  element_class->provide_clock =
+      GST_DEBUG_FUNCPTR(gst_pylon_src_provide_clock);
+
   base_src_class->get_caps = GST_DEBUG_FUNCPTR(gst_pylon_src_get_caps);
   base_src_class->fixate = GST_DEBUG_FUNCPTR(gst_pylon_src_fixate);
   base_src_class->set_caps = GST_DEBUG_FUNCPTR(gst_pylon_src_set_caps);
@@ -458,9 +773,30 @@ static void gst_pylon_src_init(GstPylonSrc *self) {
   self->capture_error = PROP_CAPTURE_ERROR_DEFAULT;
   self->hdr_sequence = PROP_HDR_SEQUENCE_DEFAULT;
   self->hdr_sequence2 = PROP_HDR_SEQUENCE2_DEFAULT;
+  self->hdr_profiles = PROP_HDR_PROFILES_DEFAULT;
   self->hdr_profile = PROP_HDR_PROFILE_DEFAULT;
+  self->hdr_lookup = PROP_HDR_LOOKUP_DEFAULT;
+  self->sequencer_program = PROP_SEQUENCER_PROGRAM_DEFAULT;
+  self->hdr_auto_exposure = PROP_HDR_AUTO_EXPOSURE_DEFAULT;
+  self->hdr_ae_highlight_target = PROP_HDR_AE_HIGHLIGHT_TARGET_DEFAULT;
+  self->hdr_ae_shadow_target = PROP_HDR_AE_SHADOW_TARGET_DEFAULT;
+  self->hdr_ae_interval = PROP_HDR_AE_INTERVAL_DEFAULT;
   self->hdr_plugin = new HdrMetadataPlugin();
-  self->hdr_switcher = new HdrProfileSwitcher();
+  self->hdr_ae = NULL;
+  self->hdr_ae_exposures = new std::vector<std::vector<guint32>>();
+  self->hdr_ae_stale = FALSE;
+  self->hdr_ae_adjustments = 0;
+  self->hdr_ae_generation = 0;
+  self->control = NULL;
+  self->schedule = gst_pylon_schedule_new(GST_ELEMENT_CAST(self));
+  self->last_hdr_profile = -1;
+  self->last_frame_number = NO_FRAME_NUMBER;
+  self->switch_request_frame = NO_FRAME_NUMBER;
+  self->camera_clock = PROP_CAMERA_CLOCK_DEFAULT;
+  self->events = PROP_EVENTS_DEFAULT;
+  self->packed_formats = PROP_PACKED_FORMATS_DEFAULT;
+  self->rois = PROP_ROIS_DEFAULT;
+  self->clock = NULL;
   self->cam = PROP_CAM_DEFAULT;
   self->stream = PROP_STREAM_DEFAULT;
   gst_video_info_init(&self->video_info);
@@ -471,6 +807,9 @@ static void gst_pylon_src_init(GstPylonSrc *self) {
 
   gst_base_src_set_live(base, TRUE);
   gst_base_src_set_format(base, GST_FORMAT_TIME);
+
+  /* provide_clock only returns a clock if camera-clock is enabled */
+  GST_OBJECT_FLAG_SET(self, GST_ELEMENT_FLAG_PROVIDE_CLOCK);
 }
 
 static void gst_pylon_src_set_property(GObject *object, guint property_id,
@@ -511,29 +850,82 @@ static void gst_pylon_src_set_property(GObject *object, guint property_id,
     case PROP_HDR_SEQUENCE:
       g_free(self->hdr_sequence);
       self->hdr_sequence = g_value_dup_string(value);
+      gst_pylon_src_forget_auto_exposure(self);
       break;
     case PROP_HDR_SEQUENCE2:
       g_free(self->hdr_sequence2);
       self->hdr_sequence2 = g_value_dup_string(value);
+      gst_pylon_src_forget_auto_exposure(self);
+      break;
+    case PROP_HDR_PROFILES:
+      g_free(self->hdr_profiles);
+      self->hdr_profiles = g_value_dup_string(value);
+      gst_pylon_src_forget_auto_exposure(self);
       break;
     case PROP_HDR_PROFILE:
       {
         gint new_profile = g_value_get_int(value);
-        if (new_profile >= 0 && new_profile <= 1) {
-          if (self->hdr_plugin && self->hdr_plugin->IsConfigured()) {
-            // With software signals on all states, only need 1 retry
-            gint retry_count = 1;
-            self->hdr_switcher->RequestSwitch(new_profile, retry_count);
-            GST_INFO_OBJECT(self, "Profile switch requested to %d, will retry %d times",
-                           new_profile, retry_count);
+        gint n_profiles =
+            self->hdr_plugin ? self->hdr_plugin->GetProfileCount() : 0;
+        /* runs under the object lock, control is released and the HDR
+         * configuration replaced under it as well */
+        if (new_profile >= 0 && !self->control) {
+          GST_WARNING_OBJECT(self, "Cannot switch profile - camera stopped");
+        } else if (new_profile >= 0 && new_profile < n_profiles) {
+          if (self->hdr_plugin->IsConfigured()) {
+            // The software signal is sent from the control thread, the
+            // streaming thread only observes the switch in the frames
+            self->switch_request_frame = self->last_frame_number;
+            gst_pylon_control_request_hdr_profile(self->control, new_profile);
+            GST_INFO_OBJECT(self, "Profile switch requested to %d", new_profile);
           } else {
             GST_WARNING_OBJECT(self, "Cannot switch profile - HDR not configured");
           }
+        } else if (new_profile != -1 && n_profiles > 0) {
+          GST_WARNING_OBJECT(self, "Invalid profile value %d (must be 0 to %d)",
+                             new_profile, n_profiles - 1);
         } else if (new_profile != -1) {
-          GST_WARNING_OBJECT(self, "Invalid profile value %d (must be 0 or 1)", new_profile);
+          GST_WARNING_OBJECT(self, "Cannot switch profile - HDR not configured");
         }
       }
       break;
+    case PROP_HDR_LOOKUP:
+      self->hdr_lookup =
+          static_cast<GstPylonHdrLookupEnum>(g_value_get_enum(value));
+      break;
+    case PROP_SEQUENCER_PROGRAM:
+      g_free(self->sequencer_program);
+      self->sequencer_program = g_value_dup_string(value);
+      break;
+    case PROP_HDR_AUTO_EXPOSURE:
+      self->hdr_auto_exposure = g_value_get_boolean(value);
+      if (!self->hdr_auto_exposure) {
+        gst_pylon_src_forget_auto_exposure(self);
+      }
+      break;
+    case PROP_HDR_AE_HIGHLIGHT_TARGET:
+      self->hdr_ae_highlight_target = g_value_get_double(value);
+      break;
+    case PROP_HDR_AE_SHADOW_TARGET:
+      self->hdr_ae_shadow_target = g_value_get_double(value);
+      break;
+    case PROP_HDR_AE_INTERVAL:
+      self->hdr_ae_interval = g_value_get_uint(value);
+      break;
+    case PROP_CAMERA_CLOCK:
+      self->camera_clock = g_value_get_boolean(value);
+      break;
+    case PROP_EVENTS:
+      g_free(self->events);
+      self->events = g_value_dup_string(value);
+      break;
+    case PROP_PACKED_FORMATS:
+      self->packed_formats = g_value_get_boolean(value);
+      break;
+    case PROP_ROIS:
+      g_free(self->rois);
+      self->rois = g_value_dup_string(value);
+      break;
 #ifdef NVMM_ENABLED
     case PROP_NVSURFACE_LAYOUT:
       self->nvsurface_layout =
@@ -587,10 +979,43 @@ static void gst_pylon_src_get_property(GObject *object, guint property_id,
     case PROP_HDR_SEQUENCE2:
       g_value_set_string(value, self->hdr_sequence2);
       break;
+    case PROP_HDR_PROFILES:
+      g_value_set_string(value, self->hdr_profiles);
+      break;
     case PROP_HDR_PROFILE:
       g_value_set_int(value,
         self->hdr_plugin ? self->hdr_plugin->GetCurrentProfile() : -1);
       break;
+    case PROP_HDR_LOOKUP:
+      g_value_set_enum(value, self->hdr_lookup);
+      break;
+    case PROP_SEQUENCER_PROGRAM:
+      g_value_set_string(value, self->sequencer_program);
+      break;
+    case PROP_HDR_AUTO_EXPOSURE:
+      g_value_set_boolean(value, self->hdr_auto_exposure);
+      break;
+    case PROP_HDR_AE_HIGHLIGHT_TARGET:
+      g_value_set_double(value, self->hdr_ae_highlight_target);
+      break;
+    case PROP_HDR_AE_SHADOW_TARGET:
+      g_value_set_double(value, self->hdr_ae_shadow_target);
+      break;
+    case PROP_HDR_AE_INTERVAL:
+      g_value_set_uint(value, self->hdr_ae_interval);
+      break;
+    case PROP_CAMERA_CLOCK:
+      g_value_set_boolean(value, self->camera_clock);
+      break;
+    case PROP_EVENTS:
+      g_value_set_string(value, self->events);
+      break;
+    case PROP_PACKED_FORMATS:
+      g_value_set_boolean(value, self->packed_formats);
+      break;
+    case PROP_ROIS:
+      g_value_set_string(value, self->rois);
+      break;
 #ifdef NVMM_ENABLED
     case PROP_NVSURFACE_LAYOUT:
       g_value_set_enum(value, self->nvsurface_layout);
@@ -633,16 +1058,37 @@ static void gst_pylon_src_finalize(GObject *object) {
   g_free(self->hdr_sequence2);
   self->hdr_sequence2 = NULL;
 
+  g_free(self->hdr_profiles);
+  self->hdr_profiles = NULL;
+
+  g_free(self->sequencer_program);
+  self->sequencer_program = NULL;
+
+  g_free(self->events);
+  self->events = NULL;
+
+  g_free(self->rois);
+  self->rois = NULL;
+
   if (self->hdr_plugin) {
     delete self->hdr_plugin;
     self->hdr_plugin = NULL;
   }
 
-  if (self->hdr_switcher) {
-    delete self->hdr_switcher;
-    self->hdr_switcher = NULL;
+  gst_pylon_src_release_control(self);
+  /* nothing can select another clock for an element being destroyed */
+  gst_pylon_src_release_clock(self, FALSE);
+
+  if (self->schedule) {
+    gst_pylon_schedule_free(self->schedule);
+    self->schedule = NULL;
   }
 
+  delete self->hdr_ae;
+  self->hdr_ae = NULL;
+  delete self->hdr_ae_exposures;
+  self->hdr_ae_exposures = NULL;
+
   if (self->cam) {
     g_object_unref(self->cam);
     self->cam = NULL;
@@ -712,6 +1158,21 @@ static gboolean gst_pylon_src_is_bayer(GstStructure *st) {
   return is_bayer;
 }
 
+/* bytes per pixel of a fixed bayer format, only the formats in a 16-bit
+ * container carry an endianness suffix */
+static gint gst_pylon_src_get_bayer_pixel_size(GstStructure *st) {
+  const gchar *format = NULL;
+
+  g_return_val_if_fail(st, 1);
+
+  format = gst_structure_get_string(st, "format");
+  if (format && g_str_has_suffix(format, "le")) {
+    return 2;
+  }
+
+  return 1;
+}
+
 /* called if, in negotiation, caps need fixating */
 static GstCaps *gst_pylon_src_fixate(GstBaseSrc *src, GstCaps *caps) {
   GstPylonSrc *self = GST_PYLON_SRC(src);
@@ -719,6 +1180,7 @@ static GstCaps *gst_pylon_src_fixate(GstBaseSrc *src, GstCaps *caps) {
   GstStructure *st = NULL;
   GstCapsFeatures *features = NULL;
   const GValue *width_field = NULL;
+  const GValue *height_field = NULL;
   static const gint width_1080p = 1920;
   static const gint height_1080p = 1080;
   static const gint preferred_framerate_num = 30;
@@ -741,12 +1203,31 @@ static GstCaps *gst_pylon_src_fixate(GstBaseSrc *src, GstCaps *caps) {
   outcaps = gst_caps_new_empty();
   st = gst_structure_copy(gst_caps_get_structure(caps, 0));
   features = gst_caps_features_copy(gst_caps_get_features(caps, 0));
-  width_field = gst_structure_get_value(st, "width");
   gst_caps_unref(caps);
 
+  /* the bayer width alignment depends on the pixel size */
+  gst_structure_fixate_field(st, "format");
+  width_field = gst_structure_get_value(st, "width");
+  height_field = gst_structure_get_value(st, "height");
+
+  /* a binned or decimated full frame is preferred over cropping the
+   * configured size to what downstream accepts */
+  if (GST_VALUE_HOLDS_INT_RANGE(width_field) &&
+      GST_VALUE_HOLDS_INT_RANGE(height_field)) {
+    gint max_width = gst_value_get_int_range_max(width_field);
+    gint max_height = gst_value_get_int_range_max(height_field);
+
+    if (preferred_width > max_width || preferred_height > max_height) {
+      gst_pylon_get_scaled_size(self->pylon, max_width, max_height,
+                                &preferred_width, &preferred_height);
+    }
+  }
+
   if (gst_pylon_src_is_bayer(st) && GST_VALUE_HOLDS_INT_RANGE(width_field)) {
+    gint alignment = 4 / gst_pylon_src_get_bayer_pixel_size(st);
+
     preferred_width_adjusted =
-        GST_ROUND_DOWN_4(gst_value_get_int_range_max(width_field));
+        gst_value_get_int_range_max(width_field) / alignment * alignment;
   } else {
     preferred_width_adjusted = preferred_width;
   }
@@ -791,10 +1272,84 @@ static void gst_pylon_src_enable_hdr_chunks(GstPylonSrc *self) {
   gst_child_proxy_set_property(GST_CHILD_PROXY(self), "cam::ChunkEnable-Timestamp", &val);
   GST_INFO_OBJECT(self, "Set cam::ChunkEnable-Timestamp=TRUE");
 
+  // The sequencer set lookup identifies frames by their active set
+  if (ENUM_HDR_LOOKUP_SEQUENCER_SET == self->hdr_lookup) {
+    gst_child_proxy_set_property(GST_CHILD_PROXY(self),
+                                 "cam::ChunkEnable-SequencerSetActive", &val);
+    GST_INFO_OBJECT(self, "Set cam::ChunkEnable-SequencerSetActive=TRUE");
+  }
+
   g_value_unset(&val);
   GST_INFO_OBJECT(self, "Chunk configuration completed");
 }
 
+static void gst_pylon_src_enable_sequencer_chunks(GstPylonSrc *self) {
+  GValue val = G_VALUE_INIT;
+
+  g_return_if_fail(GST_IS_PYLON_SRC(self));
+
+  /* chunk settings become read-only once the sequencer runs */
+  g_value_init(&val, G_TYPE_BOOLEAN);
+  g_value_set_boolean(&val, TRUE);
+
+  gst_child_proxy_set_property(GST_CHILD_PROXY(self), "cam::ChunkModeActive",
+                               &val);
+  gst_child_proxy_set_property(GST_CHILD_PROXY(self),
+                               "cam::ChunkEnable-SequencerSetActive", &val);
+
+  g_value_unset(&val);
+  GST_INFO_OBJECT(self, "Enabled the SequencerSetActive chunk");
+}
+
+/* One sequence per profile, hdr-profiles takes precedence over the
+ * hdr-sequence/hdr-sequence2 pair. NULL if HDR is disabled. */
+static gchar **gst_pylon_src_get_hdr_sequences(GstPylonSrc *self) {
+  GPtrArray *sequences = g_ptr_array_new();
+
+  if (self->hdr_profiles && strlen(self->hdr_profiles) > 0) {
+    gchar **profiles = g_strsplit(self->hdr_profiles, ";", -1);
+    for (guint p = 0; profiles[p]; p++) {
+      g_strstrip(profiles[p]);
+      if (strlen(profiles[p]) > 0) {
+        g_ptr_array_add(sequences, g_strdup(profiles[p]));
+      }
+    }
+    g_strfreev(profiles);
+  } else if (self->hdr_sequence && strlen(self->hdr_sequence) > 0) {
+    g_ptr_array_add(sequences, g_strdup(self->hdr_sequence));
+    if (self->hdr_sequence2 && strlen(self->hdr_sequence2) > 0) {
+      g_ptr_array_add(sequences, g_strdup(self->hdr_sequence2));
+    }
+  }
+
+  if (0 == sequences->len) {
+    g_ptr_array_free(sequences, TRUE);
+    return NULL;
+  }
+
+  g_ptr_array_add(sequences, NULL);
+  return reinterpret_cast<gchar **>(g_ptr_array_free(sequences, FALSE));
+}
+
+/* Replace the exposures of an exposure[:gain] sequence, keeping the gains */
+static gchar *gst_pylon_src_adjust_hdr_sequence(
+    const gchar *sequence, const std::vector<guint32> &exposures) {
+  gchar **steps = g_strsplit(sequence, ",", -1);
+  GString *str = g_string_new(NULL);
+
+  for (guint i = 0; steps[i] && i < exposures.size(); i++) {
+    const gchar *gain = strchr(steps[i], ':');
+
+    if (i > 0) {
+      g_string_append_c(str, ',');
+    }
+    g_string_append_printf(str, "%u%s", exposures[i], gain ? gain : "");
+  }
+  g_strfreev(steps);
+
+  return g_string_free(str, FALSE);
+}
+
 /* notify the subclass of new caps */
 static gboolean gst_pylon_src_set_caps(GstBaseSrc *src, GstCaps *caps) {
   GstPylonSrc *self = GST_PYLON_SRC(src);
@@ -807,13 +1362,25 @@ static gboolean gst_pylon_src_set_caps(GstBaseSrc *src, GstCaps *caps) {
   GError *error = NULL;
   gboolean ret = FALSE;
   const gchar *action = NULL;
+  gchar **sequences = NULL;
+  gboolean auto_exposed = FALSE;
 
   GST_INFO_OBJECT(self, "Setting new caps: %" GST_PTR_FORMAT, caps);
 
+  /* pending runtime writes must not interleave with the reconfiguration */
+  if (self->control) {
+    gst_pylon_control_flush(self->control);
+  }
+
+  /* restarts from the exposures about to be programmed */
+  delete self->hdr_ae;
+  self->hdr_ae = NULL;
+
   st = gst_caps_get_structure(caps, 0);
   gst_structure_get_int(st, "width", &width);
 
-  if (gst_pylon_src_is_bayer(st) && 0 != width % byte_alignment) {
+  if (gst_pylon_src_is_bayer(st) &&
+      0 != width * gst_pylon_src_get_bayer_pixel_size(st) % byte_alignment) {
     action = "configure";
     error_msg = g_strdup(
         "Bayer formats require the width to be word aligned (4 bytes).");
@@ -838,83 +1405,133 @@ static gboolean gst_pylon_src_set_caps(GstBaseSrc *src, GstCaps *caps) {
     goto log_error;
   }
 
+  GST_OBJECT_LOCK(self);
+  gst_pylon_set_packed_formats(self->pylon, self->packed_formats);
+  GST_OBJECT_UNLOCK(self);
+
   ret = gst_pylon_set_configuration(self->pylon, caps, &error);
   if (FALSE == ret && error) {
     action = "configure";
     goto log_error;
   }
 
-  /* Configure HDR sequence if specified */
-  if (self->hdr_sequence && strlen(self->hdr_sequence) > 0) {
-    // Parse sequences
-    std::vector<guint32> profile0_exposures;
-    std::vector<guint32> profile1_exposures;
-    std::vector<guint32> adjusted0, adjusted1;
-
-    // Parse profile 0
-    if (self->hdr_sequence) {
-      gchar **exposures = g_strsplit(self->hdr_sequence, ",", -1);
-      for (int i = 0; exposures[i]; i++) {
-        profile0_exposures.push_back(g_ascii_strtoull(exposures[i], NULL, 10));
-      }
-      g_strfreev(exposures);
+configure_sequencer:
+  /* A sequencer program takes over the sequencer from the HDR sequences */
+  if (self->sequencer_program && strlen(self->sequencer_program) > 0) {
+    if (self->hdr_sequence || self->hdr_profiles) {
+      GST_WARNING_OBJECT(self, "Sequencer program %s set, ignoring the HDR "
+                         "sequences", self->sequencer_program);
     }
 
-    // Parse profile 1
-    if (self->hdr_sequence2) {
-      gchar **exposures = g_strsplit(self->hdr_sequence2, ",", -1);
-      for (int i = 0; exposures[i]; i++) {
-        profile1_exposures.push_back(g_ascii_strtoull(exposures[i], NULL, 10));
-      }
-      g_strfreev(exposures);
-    }
+    /* frames are not HDR windows, no HDR metadata */
+    GST_OBJECT_LOCK(self);
+    self->hdr_plugin->Reset();
+    GST_OBJECT_UNLOCK(self);
+    gst_pylon_src_enable_sequencer_chunks(self);
 
-    // Configure HDR plugin - it may adjust sequences for duplicates
-    if (self->hdr_plugin->Configure(profile0_exposures, profile1_exposures,
-                                    adjusted0, adjusted1)) {
+    ret = gst_pylon_configure_sequencer_program(self->pylon,
+                                                self->sequencer_program,
+                                                &error);
+    if (FALSE == ret && error) {
+      action = "configure sequencer program";
+      goto log_error;
+    }
+  } else if ((sequences = gst_pylon_src_get_hdr_sequences(self))) {
+    /* Configure HDR sequences if specified, with the exposures the auto
+     * exposure found while acquiring */
+    if (self->hdr_auto_exposure &&
+        ENUM_HDR_LOOKUP_SEQUENCER_SET == self->hdr_lookup) {
+      auto_exposed = gst_pylon_src_apply_auto_exposure(self, sequences);
+    }
 
-      // Update sequences if they were adjusted
-      if (!adjusted0.empty() && adjusted0 != profile0_exposures) {
-        GString *str = g_string_new(NULL);
-        for (size_t i = 0; i < adjusted0.size(); i++) {
-          if (i > 0) g_string_append_c(str, ',');
-          g_string_append_printf(str, "%u", adjusted0[i]);
+    std::vector<std::vector<guint32>> profile_exposures;
+    std::vector<std::vector<guint32>> adjusted;
+
+    for (guint p = 0; sequences[p]; p++) {
+      std::vector<guint32> exposures;
+      gchar **steps = g_strsplit(sequences[p], ",", -1);
+      for (guint i = 0; steps[i]; i++) {
+        gdouble exposure = 0.0;
+        gdouble gain = 0.0;
+
+        if (!gst_pylon_parse_hdr_step(steps[i], &exposure, &gain)) {
+          g_set_error(&error, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_SETTINGS,
+                      "Invalid step %u \"%s\" in HDR sequence \"%s\"", i,
+                      steps[i], sequences[p]);
+          g_strfreev(steps);
+          ret = FALSE;
+          action = "parse HDR sequence";
+          goto log_error;
         }
-        GST_INFO_OBJECT(self, "Profile 0 sequence adjusted: %s -> %s",
-                       self->hdr_sequence, str->str);
-        g_free(self->hdr_sequence);
-        self->hdr_sequence = g_string_free(str, FALSE);
+        /* the plugin works with whole microseconds */
+        exposures.push_back(static_cast<guint32>(exposure));
       }
+      g_strfreev(steps);
+      profile_exposures.push_back(exposures);
+    }
+
+    // Configure HDR plugin - the exposure lookup may adjust sequences for
+    // duplicates, the sequencer set lookup keeps them as they are
+    gboolean configured = FALSE;
+    GST_OBJECT_LOCK(self);
+    if (ENUM_HDR_LOOKUP_SEQUENCER_SET == self->hdr_lookup) {
+      configured = self->hdr_plugin->ConfigureSequencerSets(profile_exposures);
+    } else {
+      configured = self->hdr_plugin->Configure(profile_exposures, adjusted);
+    }
+    GST_OBJECT_UNLOCK(self);
 
-      if (!adjusted1.empty() && adjusted1 != profile1_exposures) {
-        GString *str = g_string_new(NULL);
-        for (size_t i = 0; i < adjusted1.size(); i++) {
-          if (i > 0) g_string_append_c(str, ',');
-          g_string_append_printf(str, "%u", adjusted1[i]);
+    if (configured) {
+
+      // Program the camera with the adjusted exposures, gains are kept
+      for (guint p = 0; p < adjusted.size(); p++) {
+        if (adjusted[p] != profile_exposures[p]) {
+          gchar *sequence =
+              gst_pylon_src_adjust_hdr_sequence(sequences[p], adjusted[p]);
+          GST_INFO_OBJECT(self, "Profile %u sequence adjusted: %s -> %s", p,
+                          sequences[p], sequence);
+          g_free(sequences[p]);
+          sequences[p] = sequence;
         }
-        GST_INFO_OBJECT(self, "Profile 1 sequence adjusted: %s -> %s",
-                       self->hdr_sequence2, str->str);
-        g_free(self->hdr_sequence2);
-        self->hdr_sequence2 = g_string_free(str, FALSE);
       }
 
       // Enable chunks for HDR metadata
       gst_pylon_src_enable_hdr_chunks(self);
 
-      // Configure camera with (possibly adjusted) sequences
-      if (self->hdr_sequence2) {
-        ret = gst_pylon_configure_dual_hdr_sequence(self->pylon,
-                                                    self->hdr_sequence,
-                                                    self->hdr_sequence2,
-                                                    &error);
-      } else {
-        ret = gst_pylon_configure_hdr_sequence(self->pylon,
-                                               self->hdr_sequence,
+      if (1 == profile_exposures.size()) {
+        ret = gst_pylon_configure_hdr_sequence(self->pylon, sequences[0],
                                                &error);
+      } else {
+        ret = gst_pylon_configure_hdr_profiles(self->pylon, sequences, &error);
       }
 
       if (ret) {
-        GST_INFO_OBJECT(self, "HDR sequences configured successfully");
+        GST_INFO_OBJECT(self, "%zu HDR sequences configured successfully",
+                        profile_exposures.size());
+        if (self->hdr_auto_exposure) {
+          gst_pylon_src_setup_auto_exposure(self, caps, profile_exposures);
+        }
+        GST_OBJECT_LOCK(self);
+        self->hdr_ae_stale = FALSE;
+        g_atomic_int_set(&self->hdr_ae_generation,
+                         auto_exposed ? self->hdr_ae_adjustments : 0);
+        GST_OBJECT_UNLOCK(self);
+      } else if (auto_exposed) {
+        /* retry once with the configured exposures, the stream is worth
+         * more than what the controller found */
+        GST_ELEMENT_WARNING(self, LIBRARY, SETTINGS,
+                            ("Failed to program the HDR auto exposure "
+                             "result."),
+                            ("%s, using the configured exposures",
+                             error ? error->message : "Unknown error"));
+        g_clear_error(&error);
+        GST_OBJECT_LOCK(self);
+        gst_pylon_src_forget_auto_exposure(self);
+        GST_OBJECT_UNLOCK(self);
+        g_strfreev(sequences);
+        sequences = NULL;
+        auto_exposed = FALSE;
+        goto configure_sequencer;
       } else {
         GST_ERROR_OBJECT(self, "Failed to configure camera: %s",
                         error ? error->message : "Unknown error");
@@ -949,6 +1566,7 @@ error:
   g_free(error_msg);
 
 out:
+  g_strfreev(sequences);
   return ret;
 }
 
@@ -982,7 +1600,9 @@ static gboolean gst_pylon_src_start(GstBaseSrc *src) {
   }
 
   if (self->pylon) {
+    gst_pylon_src_release_control(self);
     gst_pylon_stop(self->pylon, &error);
+    gst_pylon_src_release_clock(self, TRUE);
     gst_pylon_free(self->pylon);
     self->pylon = NULL;
 
@@ -1044,8 +1664,31 @@ static gboolean gst_pylon_src_start(GstBaseSrc *src) {
     goto log_gst_error;
   }
 
+  GST_OBJECT_LOCK(self);
+  if (self->events) {
+    ret = gst_pylon_configure_events(self->pylon, self->events, &error);
+  }
+  GST_OBJECT_UNLOCK(self);
+
+  if (ret == FALSE && error) {
+    goto log_gst_error;
+  }
+
+  /* after the user set and feature file, the regions override theirs */
+  GST_OBJECT_LOCK(self);
+  if (self->rois) {
+    ret = gst_pylon_configure_rois(self->pylon, self->rois, &error);
+  }
+  GST_OBJECT_UNLOCK(self);
+
+  if (ret == FALSE && error) {
+    goto log_gst_error;
+  }
+
   self->duration = GST_CLOCK_TIME_NONE;
 
+  self->control = gst_pylon_control_new(GST_ELEMENT_CAST(self), self->pylon);
+
   goto out;
 
 log_gst_error:
@@ -1067,6 +1710,10 @@ static gboolean gst_pylon_src_stop(GstBaseSrc *src) {
 
   GST_INFO_OBJECT(self, "Stopping camera device");
 
+  gst_pylon_src_release_control(self);
+  /* changes not yet in effect do not survive the camera */
+  gst_pylon_schedule_clear(self->schedule);
+
   ret = gst_pylon_stop(self->pylon, &error);
 
   if (ret == FALSE && error) {
@@ -1075,13 +1722,23 @@ static gboolean gst_pylon_src_stop(GstBaseSrc *src) {
     g_error_free(error);
   }
 
-  // Reset HDR metadata plugin and switcher
+  // Reset HDR metadata plugin and switch tracking
+  GST_OBJECT_LOCK(self);
   if (self->hdr_plugin) {
     self->hdr_plugin->Reset();
   }
-  if (self->hdr_switcher) {
-    self->hdr_switcher->Reset();
-  }
+  GST_OBJECT_UNLOCK(self);
+  /* the exposures found so far are programmed on the next start */
+  delete self->hdr_ae;
+  self->hdr_ae = NULL;
+  GST_OBJECT_LOCK(self);
+  self->last_hdr_profile = -1;
+  self->last_frame_number = NO_FRAME_NUMBER;
+  self->switch_request_frame = NO_FRAME_NUMBER;
+  GST_OBJECT_UNLOCK(self);
+
+  /* the clock may outlive the camera, let it free run */
+  gst_pylon_src_release_clock(self, TRUE);
 
   gst_pylon_free(self->pylon);
   self->pylon = NULL;
@@ -1139,6 +1796,335 @@ static gboolean gst_pylon_src_query(GstBaseSrc *src, GstQuery *query) {
   return res;
 }
 
+/* offer a clock following the camera timestamp counter */
+static GstClock *gst_pylon_src_provide_clock(GstElement *element) {
+  GstPylonSrc *self = GST_PYLON_SRC(element);
+  GstClock *clock = NULL;
+  GError *error = NULL;
+
+  GST_OBJECT_LOCK(self);
+  if (!self->camera_clock || !self->pylon) {
+    goto unlock;
+  }
+
+  if (!self->clock) {
+    gchar *name = g_strdup_printf("%s-clock", GST_OBJECT_NAME(self));
+    self->clock = gst_pylon_clock_new(name);
+    g_free(name);
+
+    if (!gst_pylon_clock_attach(GST_PYLON_CLOCK(self->clock), self->pylon,
+                                &error)) {
+      GST_WARNING_OBJECT(self, "Unable to provide camera clock: %s",
+                         error->message);
+      g_error_free(error);
+      gst_object_unref(self->clock);
+      self->clock = NULL;
+      goto unlock;
+    }
+  }
+
+  clock = GST_CLOCK(gst_object_ref(self->clock));
+
+unlock:
+  GST_OBJECT_UNLOCK(self);
+
+  return clock;
+}
+
+/* Detaches the camera clock. During a state change @post_lost posts
+ * clock-lost, which makes the pipeline select a new clock. */
+static void gst_pylon_src_release_clock(GstPylonSrc *self,
+                                        gboolean post_lost) {
+  GstClock *clock = NULL;
+
+  GST_OBJECT_LOCK(self);
+  clock = self->clock;
+  self->clock = NULL;
+  GST_OBJECT_UNLOCK(self);
+
+  if (clock) {
+    gst_pylon_clock_detach(GST_PYLON_CLOCK(clock));
+    if (post_lost) {
+      gst_element_post_message(
+          GST_ELEMENT_CAST(self),
+          gst_message_new_clock_lost(GST_OBJECT_CAST(self), clock));
+    }
+    gst_object_unref(clock);
+  }
+}
+
+static void gst_pylon_src_release_control(GstPylonSrc *self) {
+  GstPylonControl *control = NULL;
+
+  GST_OBJECT_LOCK(self);
+  control = self->control;
+  self->control = NULL;
+  GST_OBJECT_UNLOCK(self);
+
+  if (control) {
+    gst_pylon_control_free(control);
+  }
+}
+
+/* post hdr-profile-switched on the first frame captured in a new profile */
+static void gst_pylon_src_check_hdr_profile(GstPylonSrc *self,
+                                            guint64 frame_number) {
+  gint profile = self->hdr_plugin->GetCurrentProfile();
+  gint previous = -1;
+  guint64 request_frame = NO_FRAME_NUMBER;
+  GstStructure *st = NULL;
+
+  GST_OBJECT_LOCK(self);
+  previous = self->last_hdr_profile;
+  self->last_hdr_profile = profile;
+  self->last_frame_number = frame_number;
+  if (previous >= 0 && previous != profile) {
+    request_frame = self->switch_request_frame;
+    self->switch_request_frame = NO_FRAME_NUMBER;
+  }
+  GST_OBJECT_UNLOCK(self);
+
+  if (previous < 0 || previous == profile) {
+    return;
+  }
+
+  st = gst_structure_new("hdr-profile-switched", "profile", G_TYPE_INT,
+                         profile, "previous-profile", G_TYPE_INT, previous,
+                         "frame-number", G_TYPE_UINT64, frame_number, NULL);
+
+  /* the latency is only known for switches requested through hdr-profile */
+  if (NO_FRAME_NUMBER != request_frame && frame_number > request_frame) {
+    gst_structure_set(st, "request-frame-number", G_TYPE_UINT64,
+                      request_frame, "latency-frames", G_TYPE_UINT64,
+                      frame_number - request_frame, NULL);
+  }
+
+  GST_INFO_OBJECT(self, "HDR profile switched: %" GST_PTR_FORMAT, st);
+
+  gst_element_post_message(GST_ELEMENT_CAST(self),
+                           gst_message_new_element(GST_OBJECT_CAST(self), st));
+}
+
+/* Luminance samples of the 8-bit formats, packed formats contribute their
+ * luma or green channel */
+static gboolean gst_pylon_src_get_sample_layout(GstCaps *caps,
+                                                gint *pixel_stride,
+                                                gint *offset) {
+  GstVideoInfo info;
+
+  if (gst_pylon_src_is_bayer(gst_caps_get_structure(caps, 0))) {
+    if (1 != gst_pylon_src_get_bayer_pixel_size(
+                 gst_caps_get_structure(caps, 0))) {
+      return FALSE;
+    }
+    *pixel_stride = 1;
+    *offset = 0;
+    return TRUE;
+  }
+
+  if (!gst_video_info_from_caps(&info, caps)) {
+    return FALSE;
+  }
+
+  switch (GST_VIDEO_INFO_FORMAT(&info)) {
+    case GST_VIDEO_FORMAT_GRAY8:
+    case GST_VIDEO_FORMAT_NV12:
+    case GST_VIDEO_FORMAT_I420:
+      *pixel_stride = 1;
+      *offset = 0;
+      break;
+    case GST_VIDEO_FORMAT_RGB:
+    case GST_VIDEO_FORMAT_BGR:
+      *pixel_stride = 3;
+      *offset = 1;
+      break;
+    case GST_VIDEO_FORMAT_BGRx:
+      *pixel_stride = 4;
+      *offset = 1;
+      break;
+    case GST_VIDEO_FORMAT_YUY2:
+      *pixel_stride = 2;
+      *offset = 0;
+      break;
+    case GST_VIDEO_FORMAT_UYVY:
+      *pixel_stride = 2;
+      *offset = 1;
+      break;
+    default:
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+static void gst_pylon_src_setup_auto_exposure(
+    GstPylonSrc *self, GstCaps *caps,
+    const std::vector<std::vector<guint32>> &profile_exposures) {
+  GstPylonHdrAutoExposure *ae = NULL;
+  GError *error = NULL;
+  gdouble min_exposure = 0.0;
+  gdouble max_exposure = 0.0;
+  gint pixel_stride = 1;
+  gint offset = 0;
+
+  /* the exposure lookup identifies frames by the exposures it changes */
+  if (ENUM_HDR_LOOKUP_SEQUENCER_SET != self->hdr_lookup) {
+    GST_ELEMENT_WARNING(self, LIBRARY, SETTINGS,
+                        ("HDR auto exposure disabled."),
+                        ("hdr-auto-exposure requires hdr-lookup=sequencer-set"));
+    return;
+  }
+
+  if (!gst_pylon_src_get_sample_layout(caps, &pixel_stride, &offset)) {
+    GST_ELEMENT_WARNING(self, LIBRARY, SETTINGS,
+                        ("HDR auto exposure disabled."),
+                        ("No 8-bit luminance in %" GST_PTR_FORMAT, caps));
+    return;
+  }
+
+  if (!gst_pylon_get_exposure_limits(self->pylon, &min_exposure,
+                                     &max_exposure, &error)) {
+    GST_ELEMENT_WARNING(self, LIBRARY, SETTINGS,
+                        ("HDR auto exposure disabled."), ("%s",
+                                                          error->message));
+    g_error_free(error);
+    return;
+  }
+
+  ae = new GstPylonHdrAutoExposure();
+  if (!ae->Configure(profile_exposures, min_exposure, max_exposure)) {
+    GST_ELEMENT_WARNING(self, LIBRARY, SETTINGS,
+                        ("HDR auto exposure disabled."),
+                        ("Invalid HDR exposures"));
+    delete ae;
+    return;
+  }
+
+  GST_OBJECT_LOCK(self);
+  ae->SetTargets(self->hdr_ae_highlight_target, self->hdr_ae_shadow_target);
+  ae->SetInterval(self->hdr_ae_interval);
+  GST_OBJECT_UNLOCK(self);
+  ae->SetSampleLayout(pixel_stride, offset);
+
+  self->hdr_ae = ae;
+
+  GST_INFO_OBJECT(self,
+                  "HDR auto exposure enabled, %s histograms, exposures "
+                  "%.0f to %.0f us",
+                  gst_pylon_simd_level_name(ae->GetSimdLevel()), min_exposure,
+                  max_exposure);
+}
+
+/* Substitutes the exposures found by the auto exposure into the HDR
+ * sequences, returns TRUE if any of them was replaced */
+static gboolean gst_pylon_src_apply_auto_exposure(GstPylonSrc *self,
+                                                  gchar **sequences) {
+  gboolean applied = FALSE;
+
+  GST_OBJECT_LOCK(self);
+  for (guint p = 0; sequences[p] && p < self->hdr_ae_exposures->size(); p++) {
+    const std::vector<guint32> &exposures = (*self->hdr_ae_exposures)[p];
+    guint n_steps = 0;
+
+    gchar **steps = g_strsplit(sequences[p], ",", -1);
+    n_steps = g_strv_length(steps);
+    g_strfreev(steps);
+
+    /* profiles not adjusted yet, or found for other sequences */
+    if (exposures.empty() || exposures.size() != n_steps) {
+      continue;
+    }
+
+    gchar *sequence = gst_pylon_src_adjust_hdr_sequence(sequences[p],
+                                                        exposures);
+    GST_INFO_OBJECT(self, "Profile %u auto exposure: %s -> %s", p,
+                    sequences[p], sequence);
+    g_free(sequences[p]);
+    sequences[p] = sequence;
+    applied = TRUE;
+  }
+  GST_OBJECT_UNLOCK(self);
+
+  return applied;
+}
+
+/* drops the exposures found, the configured ones are programmed on the next
+ * negotiation. Must be called with the object lock held. */
+static void gst_pylon_src_forget_auto_exposure(GstPylonSrc *self) {
+  self->hdr_ae_exposures->clear();
+  self->hdr_ae_adjustments = 0;
+  /* the running controller still measures the previous sequences */
+  self->hdr_ae_stale = TRUE;
+}
+
+/* Measures an exposure with HDR meta and keeps the new exposures of its
+ * profile. Cameras reject sequencer configuration during acquisition, they
+ * are programmed the next time it is stopped for a negotiation. */
+static void gst_pylon_src_run_auto_exposure(GstPylonSrc *self,
+                                            GstBuffer *buf) {
+  GstHdrMeta *hdr_meta = gst_buffer_get_hdr_meta(buf);
+  GstPylonMeta *pylon_meta = gst_buffer_get_pylon_meta(buf);
+  std::vector<guint32> exposures;
+  GstMapInfo info;
+  gboolean adjust = FALSE;
+
+  if (!hdr_meta) {
+    return;
+  }
+
+  hdr_meta->exposure_generation = g_atomic_int_get(&self->hdr_ae_generation);
+
+  if (!self->hdr_ae || !pylon_meta) {
+    return;
+  }
+
+  if (!gst_buffer_map(buf, &info, GST_MAP_READ)) {
+    return;
+  }
+
+  adjust = self->hdr_ae->AddFrame(
+      hdr_meta->hdr_profile, hdr_meta->exposure_sequence_index, info.data,
+      pylon_meta->stride, GST_VIDEO_INFO_WIDTH(&self->video_info),
+      GST_VIDEO_INFO_HEIGHT(&self->video_info), exposures);
+
+  gst_buffer_unmap(buf, &info);
+
+  if (!adjust) {
+    return;
+  }
+
+  GST_DEBUG_OBJECT(self, "HDR profile %u exposures adjusted, %u to %u us",
+                   hdr_meta->hdr_profile,
+                   *std::min_element(exposures.begin(), exposures.end()),
+                   *std::max_element(exposures.begin(), exposures.end()));
+
+  GST_OBJECT_LOCK(self);
+  if (self->hdr_ae_stale) {
+    GST_OBJECT_UNLOCK(self);
+    return;
+  }
+  if (hdr_meta->hdr_profile >= self->hdr_ae_exposures->size()) {
+    self->hdr_ae_exposures->resize(hdr_meta->hdr_profile + 1);
+  }
+  (*self->hdr_ae_exposures)[hdr_meta->hdr_profile] = exposures;
+  self->hdr_ae_adjustments++;
+  GST_OBJECT_UNLOCK(self);
+}
+
+/* issue the scheduled changes due and mark the frame with the last one in
+ * effect */
+static void gst_pylon_src_run_schedule(GstPylonSrc *self, GstBuffer *buf) {
+  GstPylonMeta *pylon_meta = gst_buffer_get_pylon_meta(buf);
+
+  if (!pylon_meta) {
+    return;
+  }
+
+  pylon_meta->schedule_id = gst_pylon_schedule_process_frame(
+      self->schedule, self->control, pylon_meta->image_number,
+      pylon_meta->timestamp);
+}
+
 /* add time metadata to buffer */
 static void gst_plyon_src_add_metadata(GstPylonSrc *self, GstBuffer *buf) {
   GstClock *clock = NULL;
@@ -1153,6 +2139,7 @@ static void gst_plyon_src_add_metadata(GstPylonSrc *self, GstBuffer *buf) {
   guint height = 0;
   guint n_planes = 0;
   gint stride[GST_VIDEO_MAX_PLANES] = {0};
+  gboolean camera_clock = FALSE;
 
   g_return_if_fail(self);
   g_return_if_fail(buf);
@@ -1167,6 +2154,7 @@ static void gst_plyon_src_add_metadata(GstPylonSrc *self, GstBuffer *buf) {
   if ((clock = GST_ELEMENT_CLOCK(self))) {
     /* we have a clock, get base time and ref clock */
     base_time = GST_ELEMENT(self)->base_time;
+    camera_clock = (clock == self->clock);
     gst_object_ref(clock);
   } else {
     /* no clock, can't set timestamps */
@@ -1174,8 +2162,15 @@ static void gst_plyon_src_add_metadata(GstPylonSrc *self, GstBuffer *buf) {
   }
   GST_OBJECT_UNLOCK(self);
 
-  /* sample pipeline clock */
-  if (clock) {
+  /* the camera clock shares the time base of the exposure timestamps,
+   * otherwise sample the pipeline clock */
+  if (clock && camera_clock) {
+    abs_time = gst_pylon_clock_ticks_to_time(GST_PYLON_CLOCK(clock),
+                                             pylon_meta->timestamp);
+    /* frames exposed before the pipeline started running */
+    abs_time = MAX(abs_time, base_time);
+    gst_object_unref(clock);
+  } else if (clock) {
     abs_time = gst_clock_get_time(clock);
     gst_object_unref(clock);
   } else {
@@ -1201,9 +2196,13 @@ static void gst_plyon_src_add_metadata(GstPylonSrc *self, GstBuffer *buf) {
   height = GST_VIDEO_INFO_HEIGHT(&self->video_info);
   n_planes = GST_VIDEO_INFO_N_PLANES(&self->video_info);
 
-  /* assuming pylon formats come in a single plane */
+  /* pylon formats come in a single plane, the stride is in bytes and
+   * already accounts for 16-bit containers. Planar formats are converted
+   * into the default layout of the caps. */
   for (guint p = 0; p < n_planes; p++) {
-    stride[p] = pylon_meta->stride;
+    stride[p] = pylon_meta->stride && 1 == n_planes
+                    ? pylon_meta->stride
+                    : GST_VIDEO_INFO_PLANE_STRIDE(&self->video_info, p);
   }
 
   gst_buffer_add_video_meta_full(buf, GST_VIDEO_FRAME_FLAG_NONE, format, width,
@@ -1224,19 +2223,6 @@ static GstFlowReturn gst_pylon_src_create(GstPushSrc *src, GstBuffer **buf) {
   capture_error = self->capture_error;
   GST_OBJECT_UNLOCK(self);
 
-  // Check if we need to send profile switch signals
-  gint signal_profile;
-  if (self->hdr_switcher->GetPendingSignal(&signal_profile)) {
-    GError *switch_error = NULL;
-    if (gst_pylon_switch_hdr_profile(self->pylon, signal_profile, &switch_error)) {
-      GST_DEBUG_OBJECT(self, "Sent profile switch signal for profile %d", signal_profile);
-    } else {
-      GST_WARNING_OBJECT(self, "Failed to send profile switch signal: %s",
-                         switch_error ? switch_error->message : "Unknown error");
-      if (switch_error) g_error_free(switch_error);
-    }
-  }
-
   pylon_ret = gst_pylon_capture(
       self->pylon, buf, static_cast<GstPylonCaptureErrorEnum>(capture_error),
       &error);
@@ -1257,6 +2243,7 @@ static GstFlowReturn gst_pylon_src_create(GstPushSrc *src, GstBuffer **buf) {
   }
 
   gst_plyon_src_add_metadata(self, *buf);
+  gst_pylon_src_run_schedule(self, *buf);
 
   // Process and attach HDR metadata if configured
   if (self->hdr_plugin && self->hdr_plugin->IsConfigured()) {
@@ -1265,6 +2252,7 @@ static GstFlowReturn gst_pylon_src_create(GstPushSrc *src, GstBuffer **buf) {
     if (pylon_meta) {
       guint64 frame_number = pylon_meta->image_number;
       guint32 exposure_time = 0;
+      gint64 sequencer_set = -1;
 
       // Try to get exposure time from chunks
       if (pylon_meta->chunks) {
@@ -1277,10 +2265,26 @@ static GstFlowReturn gst_pylon_src_create(GstPushSrc *src, GstBuffer **buf) {
           exposure_time = (guint32)chunk_exposure;  // Convert to microseconds
           GST_LOG_OBJECT(self, "Got exposure time from ChunkExposureTimeAbs: %u μs", exposure_time);
         }
+
+        if (self->hdr_plugin->UsesSequencerSets()) {
+          gst_structure_get_int64(pylon_meta->chunks, "ChunkSequencerSetActive",
+                                  &sequencer_set);
+        }
       }
 
-      // Attach HDR metadata if we have exposure time
-      if (exposure_time > 0) {
+      if (self->hdr_plugin->UsesSequencerSets()) {
+        // Constant time lookup, the exposure is only informative here
+        if (sequencer_set < 0) {
+          GST_DEBUG_OBJECT(self, "No sequencer set available for frame %lu - HDR metadata not attached",
+                           frame_number);
+        } else if (!self->hdr_plugin->ProcessAndAttachMetadataBySet(
+                       *buf, frame_number, static_cast<guint32>(sequencer_set),
+                       exposure_time)) {
+          GST_WARNING_OBJECT(self, "Failed to attach HDR metadata for frame %lu (set %" G_GINT64_FORMAT ")",
+                             frame_number, sequencer_set);
+        }
+      } else if (exposure_time > 0) {
+        // Attach HDR metadata if we have exposure time
         if (!self->hdr_plugin->ProcessAndAttachMetadata(*buf,
                                                          frame_number,
                                                          exposure_time)) {
@@ -1293,6 +2297,9 @@ static GstFlowReturn gst_pylon_src_create(GstPushSrc *src, GstBuffer **buf) {
         GST_DEBUG_OBJECT(self, "No exposure time available for frame %lu - HDR metadata not attached",
                         frame_number);
       }
+
+      gst_pylon_src_check_hdr_profile(self, frame_number);
+      gst_pylon_src_run_auto_exposure(self, *buf);
     }
   }
 
@@ -1302,6 +2309,46 @@ done:
   return ret;
 }
 
+static GstStructure *gst_pylon_src_apply_features(
+    GstPylonSrc *self, const GstStructure *features) {
+  GstStructure *results = NULL;
+  GObject *cam = NULL;
+
+  g_return_val_if_fail(features, NULL);
+
+  cam = gst_pylon_src_child_proxy_get_child_by_name(GST_CHILD_PROXY(self),
+                                                     "cam");
+  if (!cam) {
+    /* nothing was applied */
+    results = gst_structure_new_empty(GST_PYLON_OBJECT_APPLY_RESULTS_NAME);
+    for (gint i = 0; i < gst_structure_n_fields(features); i++) {
+      gst_structure_set(results, gst_structure_nth_field_name(features, i),
+                        G_TYPE_BOOLEAN, FALSE, NULL);
+    }
+    return results;
+  }
+
+  results = gst_pylon_object_apply_properties(
+      reinterpret_cast<GstPylonObject *>(cam), features);
+  g_object_unref(cam);
+
+  return results;
+}
+
+static guint gst_pylon_src_schedule_features(GstPylonSrc *self,
+                                             const GstStructure *features,
+                                             guint64 frame_number,
+                                             guint64 timestamp) {
+  g_return_val_if_fail(features, 0);
+
+  return gst_pylon_schedule_add(self->schedule, features, frame_number,
+                                timestamp);
+}
+
+static gboolean gst_pylon_src_cancel_schedule(GstPylonSrc *self, guint id) {
+  return gst_pylon_schedule_cancel(self->schedule, id);
+}
+
 static guint gst_pylon_src_child_proxy_get_children_count(
     GstChildProxy *child_proxy) {
   return sizeof(gst_pylon_src_child_proxy_names) / sizeof(gchar *);
@@ -0,0 +1,568 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Unpacking of 10 and 12-bit packed pixel formats to 16-bit samples
+ */
+
+#include "gstpylonunpack.h"
+
+#include <algorithm>
+
+/* Byte pairs holding each 16-bit output lane of one SIMD block, low byte
+ * first. The packed bits of a sample are then in a single lane and only
+ * need a per lane shift and mask. */
+alignas(16) static const uint8_t SHUFFLE_10P[16] = {0, 1, 1, 2, 2, 3, 3, 4,
+                                                    5, 6, 6, 7, 7, 8, 8, 9};
+alignas(16) static const uint8_t SHUFFLE_12P[16] = {0, 1, 1,  2,  3, 4,
+                                                    4, 5, 6,  7,  7, 8,
+                                                    9, 10, 10, 11};
+/* even lanes get the high byte first, so the high nibble of the middle
+ * byte is the one shifted out */
+alignas(16) static const uint8_t SHUFFLE_12_PACKED[16] = {1,  0, 1, 2,  4, 3,
+                                                          4,  5, 7, 6,  7, 8,
+                                                          10, 9, 10, 11};
+
+/* 10p lanes hold their sample at bit 0, 2, 4 and 6, multiplying aligns all
+ * of them at bit 6 */
+alignas(16) static const uint16_t ALIGN_10P[8] = {64, 16, 4, 1,
+                                                  64, 16, 4, 1};
+
+static void unpack_row_lsb_scalar(const uint8_t *src, uint16_t *dst,
+                                  int width, int x, int bits, int shift) {
+  const size_t row_bytes = (static_cast<size_t>(width) * bits + 7) / 8;
+  const uint32_t mask = (1u << bits) - 1;
+
+  for (; x < width; x++) {
+    size_t bit = static_cast<size_t>(x) * bits;
+    size_t byte = bit >> 3;
+    uint32_t v = src[byte];
+
+    /* the last sample of a row may end in its first byte */
+    if (byte + 1 < row_bytes) {
+      v |= static_cast<uint32_t>(src[byte + 1]) << 8;
+    }
+
+    dst[x] = static_cast<uint16_t>(((v >> (bit & 7)) & mask) << shift);
+  }
+}
+
+static void unpack_row_12_packed_scalar(const uint8_t *src, uint16_t *dst,
+                                        int width, int x, int shift) {
+  for (; x < width; x++) {
+    const uint8_t *pair = src + static_cast<size_t>(x / 2) * 3;
+
+    if (x & 1) {
+      dst[x] = static_cast<uint16_t>(((pair[2] << 4) | (pair[1] >> 4))
+                                     << shift);
+    } else {
+      dst[x] = static_cast<uint16_t>(((pair[0] << 4) | (pair[1] & 0x0F))
+                                     << shift);
+    }
+  }
+}
+
+/* the source rows of pylon buffers are not necessarily 16-bit aligned */
+static void unpack_row_16_scalar(const uint8_t *src, uint16_t *dst,
+                                 int width, int x, int shift) {
+  for (; x < width; x++) {
+    dst[x] = static_cast<uint16_t>((src[2 * x] | (src[2 * x + 1] << 8))
+                                   << shift);
+  }
+}
+
+static void unpack_row_10p_c(const uint8_t *src, uint16_t *dst, int width,
+                             int shift) {
+  unpack_row_lsb_scalar(src, dst, width, 0, 10, shift);
+}
+
+static void unpack_row_12p_c(const uint8_t *src, uint16_t *dst, int width,
+                             int shift) {
+  unpack_row_lsb_scalar(src, dst, width, 0, 12, shift);
+}
+
+static void unpack_row_12_packed_c(const uint8_t *src, uint16_t *dst,
+                                   int width, int shift) {
+  unpack_row_12_packed_scalar(src, dst, width, 0, shift);
+}
+
+static void unpack_row_16_c(const uint8_t *src, uint16_t *dst, int width,
+                            int shift) {
+  unpack_row_16_scalar(src, dst, width, 0, shift);
+}
+
+/* The SIMD loops load 16 bytes per 8 samples although they consume 10 or
+ * 12, they stop while the over read still lies inside the row and leave
+ * the rest to the scalar code. */
+#if defined(GST_PYLON_ARCH_X86)
+GST_PYLON_TARGET_SSE41 static inline __m128i load_shuffled_sse41(
+    const uint8_t *src, const uint8_t *shuffle) {
+  return _mm_shuffle_epi8(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(src)),
+      _mm_load_si128(reinterpret_cast<const __m128i *>(shuffle)));
+}
+
+GST_PYLON_TARGET_SSE41 static void unpack_row_10p_sse41(const uint8_t *src,
+                                                        uint16_t *dst,
+                                                        int width,
+                                                        int shift) {
+  const size_t row_bytes = GstPylonUnpack::GetRowBytes(GST_PYLON_UNPACK_10P,
+                                                       width);
+  const __m128i align =
+      _mm_load_si128(reinterpret_cast<const __m128i *>(ALIGN_10P));
+  const __m128i count = _mm_cvtsi32_si128(shift);
+  int x = 0;
+
+  for (; x + 8 <= width && static_cast<size_t>(x) * 5 / 4 + 16 <= row_bytes;
+       x += 8) {
+    __m128i v = load_shuffled_sse41(src + static_cast<size_t>(x) * 5 / 4,
+                                    SHUFFLE_10P);
+
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i *>(dst + x),
+        _mm_sll_epi16(_mm_srli_epi16(_mm_mullo_epi16(v, align), 6), count));
+  }
+
+  unpack_row_lsb_scalar(src, dst, width, x, 10, shift);
+}
+
+GST_PYLON_TARGET_SSE41 static void unpack_row_12p_sse41(const uint8_t *src,
+                                                        uint16_t *dst,
+                                                        int width,
+                                                        int shift) {
+  const size_t row_bytes = GstPylonUnpack::GetRowBytes(GST_PYLON_UNPACK_12P,
+                                                       width);
+  const __m128i mask = _mm_set1_epi16(0x0FFF);
+  const __m128i count = _mm_cvtsi32_si128(shift);
+  int x = 0;
+
+  for (; x + 8 <= width && static_cast<size_t>(x) * 3 / 2 + 16 <= row_bytes;
+       x += 8) {
+    __m128i v = load_shuffled_sse41(src + static_cast<size_t>(x) * 3 / 2,
+                                    SHUFFLE_12P);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x),
+                     _mm_sll_epi16(_mm_blend_epi16(_mm_and_si128(v, mask),
+                                                   _mm_srli_epi16(v, 4), 0xAA),
+                                   count));
+  }
+
+  unpack_row_lsb_scalar(src, dst, width, x, 12, shift);
+}
+
+GST_PYLON_TARGET_SSE41 static void unpack_row_12_packed_sse41(
+    const uint8_t *src, uint16_t *dst, int width, int shift) {
+  const size_t row_bytes =
+      GstPylonUnpack::GetRowBytes(GST_PYLON_UNPACK_12_PACKED, width);
+  const __m128i high = _mm_set1_epi16(0x0FF0);
+  const __m128i low = _mm_set1_epi16(0x000F);
+  const __m128i count = _mm_cvtsi32_si128(shift);
+  int x = 0;
+
+  for (; x + 8 <= width && static_cast<size_t>(x) * 3 / 2 + 16 <= row_bytes;
+       x += 8) {
+    __m128i v = load_shuffled_sse41(src + static_cast<size_t>(x) * 3 / 2,
+                                    SHUFFLE_12_PACKED);
+    __m128i shifted = _mm_srli_epi16(v, 4);
+    __m128i even = _mm_or_si128(_mm_and_si128(shifted, high),
+                                _mm_and_si128(v, low));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x),
+                     _mm_sll_epi16(_mm_blend_epi16(even, shifted, 0xAA),
+                                   count));
+  }
+
+  unpack_row_12_packed_scalar(src, dst, width, x, shift);
+}
+
+GST_PYLON_TARGET_SSE41 static void unpack_row_16_sse41(const uint8_t *src,
+                                                       uint16_t *dst,
+                                                       int width, int shift) {
+  const __m128i count = _mm_cvtsi32_si128(shift);
+  int x = 0;
+
+  for (; x + 8 <= width; x += 8) {
+    __m128i v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(src + static_cast<size_t>(x) * 2));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x),
+                     _mm_sll_epi16(v, count));
+  }
+
+  unpack_row_16_scalar(src, dst, width, x, shift);
+}
+
+/* two 8 sample blocks, one per 128-bit lane since the byte shuffle does not
+ * cross lanes */
+GST_PYLON_TARGET_AVX2 static inline __m256i load_shuffled_avx2(
+    const uint8_t *src, size_t block_bytes, const uint8_t *shuffle) {
+  __m256i v = _mm256_inserti128_si256(
+      _mm256_castsi128_si256(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(src))),
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + block_bytes)),
+      1);
+
+  return _mm256_shuffle_epi8(
+      v, _mm256_broadcastsi128_si256(
+             _mm_load_si128(reinterpret_cast<const __m128i *>(shuffle))));
+}
+
+GST_PYLON_TARGET_AVX2 static void unpack_row_10p_avx2(const uint8_t *src,
+                                                      uint16_t *dst, int width,
+                                                      int shift) {
+  const size_t row_bytes = GstPylonUnpack::GetRowBytes(GST_PYLON_UNPACK_10P,
+                                                       width);
+  const __m256i align = _mm256_broadcastsi128_si256(
+      _mm_load_si128(reinterpret_cast<const __m128i *>(ALIGN_10P)));
+  const __m128i count = _mm_cvtsi32_si128(shift);
+  int x = 0;
+
+  for (; x + 16 <= width && static_cast<size_t>(x) * 5 / 4 + 26 <= row_bytes;
+       x += 16) {
+    __m256i v = load_shuffled_avx2(src + static_cast<size_t>(x) * 5 / 4, 10,
+                                   SHUFFLE_10P);
+
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i *>(dst + x),
+        _mm256_sll_epi16(
+            _mm256_srli_epi16(_mm256_mullo_epi16(v, align), 6), count));
+  }
+
+  unpack_row_lsb_scalar(src, dst, width, x, 10, shift);
+}
+
+GST_PYLON_TARGET_AVX2 static void unpack_row_12p_avx2(const uint8_t *src,
+                                                      uint16_t *dst, int width,
+                                                      int shift) {
+  const size_t row_bytes = GstPylonUnpack::GetRowBytes(GST_PYLON_UNPACK_12P,
+                                                       width);
+  const __m256i mask = _mm256_set1_epi16(0x0FFF);
+  const __m128i count = _mm_cvtsi32_si128(shift);
+  int x = 0;
+
+  for (; x + 16 <= width && static_cast<size_t>(x) * 3 / 2 + 28 <= row_bytes;
+       x += 16) {
+    __m256i v = load_shuffled_avx2(src + static_cast<size_t>(x) * 3 / 2, 12,
+                                   SHUFFLE_12P);
+
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i *>(dst + x),
+        _mm256_sll_epi16(_mm256_blend_epi16(_mm256_and_si256(v, mask),
+                                            _mm256_srli_epi16(v, 4), 0xAA),
+                         count));
+  }
+
+  unpack_row_lsb_scalar(src, dst, width, x, 12, shift);
+}
+
+GST_PYLON_TARGET_AVX2 static void unpack_row_12_packed_avx2(
+    const uint8_t *src, uint16_t *dst, int width, int shift) {
+  const size_t row_bytes =
+      GstPylonUnpack::GetRowBytes(GST_PYLON_UNPACK_12_PACKED, width);
+  const __m256i high = _mm256_set1_epi16(0x0FF0);
+  const __m256i low = _mm256_set1_epi16(0x000F);
+  const __m128i count = _mm_cvtsi32_si128(shift);
+  int x = 0;
+
+  for (; x + 16 <= width && static_cast<size_t>(x) * 3 / 2 + 28 <= row_bytes;
+       x += 16) {
+    __m256i v = load_shuffled_avx2(src + static_cast<size_t>(x) * 3 / 2, 12,
+                                   SHUFFLE_12_PACKED);
+    __m256i shifted = _mm256_srli_epi16(v, 4);
+    __m256i even = _mm256_or_si256(_mm256_and_si256(shifted, high),
+                                   _mm256_and_si256(v, low));
+
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i *>(dst + x),
+        _mm256_sll_epi16(_mm256_blend_epi16(even, shifted, 0xAA), count));
+  }
+
+  unpack_row_12_packed_scalar(src, dst, width, x, shift);
+}
+
+GST_PYLON_TARGET_AVX2 static void unpack_row_16_avx2(const uint8_t *src,
+                                                     uint16_t *dst, int width,
+                                                     int shift) {
+  const __m128i count = _mm_cvtsi32_si128(shift);
+  int x = 0;
+
+  for (; x + 16 <= width; x += 16) {
+    __m256i v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(src + static_cast<size_t>(x) * 2));
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + x),
+                        _mm256_sll_epi16(v, count));
+  }
+
+  unpack_row_16_scalar(src, dst, width, x, shift);
+}
+#endif
+
+#if defined(GST_PYLON_ARCH_ARM64)
+static inline uint16x8_t load_shuffled_neon(const uint8_t *src,
+                                            const uint8_t *shuffle) {
+  return vreinterpretq_u16_u8(vqtbl1q_u8(vld1q_u8(src), vld1q_u8(shuffle)));
+}
+
+static void unpack_row_10p_neon(const uint8_t *src, uint16_t *dst,
+                                int width, int shift) {
+  const size_t row_bytes = GstPylonUnpack::GetRowBytes(GST_PYLON_UNPACK_10P,
+                                                       width);
+  const int16_t shift_values[8] = {0, -2, -4, -6, 0, -2, -4, -6};
+  const int16x8_t shifts = vld1q_s16(shift_values);
+  const uint16x8_t mask = vdupq_n_u16(0x03FF);
+  const int16x8_t count = vdupq_n_s16(shift);
+  int x = 0;
+
+  for (; x + 8 <= width && static_cast<size_t>(x) * 5 / 4 + 16 <= row_bytes;
+       x += 8) {
+    uint16x8_t v = load_shuffled_neon(src + static_cast<size_t>(x) * 5 / 4,
+                                      SHUFFLE_10P);
+
+    vst1q_u16(dst + x,
+              vshlq_u16(vandq_u16(vshlq_u16(v, shifts), mask), count));
+  }
+
+  unpack_row_lsb_scalar(src, dst, width, x, 10, shift);
+}
+
+static void unpack_row_12p_neon(const uint8_t *src, uint16_t *dst,
+                                int width, int shift) {
+  const size_t row_bytes = GstPylonUnpack::GetRowBytes(GST_PYLON_UNPACK_12P,
+                                                       width);
+  const uint16_t odd_values[8] = {0, 0xFFFF, 0, 0xFFFF, 0, 0xFFFF, 0, 0xFFFF};
+  const uint16x8_t odd = vld1q_u16(odd_values);
+  const uint16x8_t mask = vdupq_n_u16(0x0FFF);
+  const int16x8_t count = vdupq_n_s16(shift);
+  int x = 0;
+
+  for (; x + 8 <= width && static_cast<size_t>(x) * 3 / 2 + 16 <= row_bytes;
+       x += 8) {
+    uint16x8_t v = load_shuffled_neon(src + static_cast<size_t>(x) * 3 / 2,
+                                      SHUFFLE_12P);
+
+    vst1q_u16(dst + x,
+              vshlq_u16(vbslq_u16(odd, vshrq_n_u16(v, 4), vandq_u16(v, mask)),
+                        count));
+  }
+
+  unpack_row_lsb_scalar(src, dst, width, x, 12, shift);
+}
+
+static void unpack_row_12_packed_neon(const uint8_t *src, uint16_t *dst,
+                                      int width, int shift) {
+  const size_t row_bytes =
+      GstPylonUnpack::GetRowBytes(GST_PYLON_UNPACK_12_PACKED, width);
+  const uint16_t odd_values[8] = {0, 0xFFFF, 0, 0xFFFF, 0, 0xFFFF, 0, 0xFFFF};
+  const uint16x8_t odd = vld1q_u16(odd_values);
+  const uint16x8_t high = vdupq_n_u16(0x0FF0);
+  const uint16x8_t low = vdupq_n_u16(0x000F);
+  const int16x8_t count = vdupq_n_s16(shift);
+  int x = 0;
+
+  for (; x + 8 <= width && static_cast<size_t>(x) * 3 / 2 + 16 <= row_bytes;
+       x += 8) {
+    uint16x8_t v = load_shuffled_neon(src + static_cast<size_t>(x) * 3 / 2,
+                                      SHUFFLE_12_PACKED);
+    uint16x8_t shifted = vshrq_n_u16(v, 4);
+    uint16x8_t even =
+        vorrq_u16(vandq_u16(shifted, high), vandq_u16(v, low));
+
+    vst1q_u16(dst + x, vshlq_u16(vbslq_u16(odd, shifted, even), count));
+  }
+
+  unpack_row_12_packed_scalar(src, dst, width, x, shift);
+}
+
+static void unpack_row_16_neon(const uint8_t *src, uint16_t *dst, int width,
+                               int shift) {
+  const int16x8_t count = vdupq_n_s16(shift);
+  int x = 0;
+
+  for (; x + 8 <= width; x += 8) {
+    uint16x8_t v =
+        vreinterpretq_u16_u8(vld1q_u8(src + static_cast<size_t>(x) * 2));
+
+    vst1q_u16(dst + x, vshlq_u16(v, count));
+  }
+
+  unpack_row_16_scalar(src, dst, width, x, shift);
+}
+#endif
+
+static GstPylonUnpackRowFunc select_unpack_row(GstPylonUnpackLayout layout,
+                                               GstPylonSimdLevel level) {
+  switch (layout) {
+    case GST_PYLON_UNPACK_10P:
+      switch (level) {
+#if defined(GST_PYLON_ARCH_X86)
+        case GST_PYLON_SIMD_AVX2:
+          return unpack_row_10p_avx2;
+        case GST_PYLON_SIMD_SSE41:
+          return unpack_row_10p_sse41;
+#endif
+#if defined(GST_PYLON_ARCH_ARM64)
+        case GST_PYLON_SIMD_NEON:
+          return unpack_row_10p_neon;
+#endif
+        default:
+          return unpack_row_10p_c;
+      }
+    case GST_PYLON_UNPACK_12P:
+      switch (level) {
+#if defined(GST_PYLON_ARCH_X86)
+        case GST_PYLON_SIMD_AVX2:
+          return unpack_row_12p_avx2;
+        case GST_PYLON_SIMD_SSE41:
+          return unpack_row_12p_sse41;
+#endif
+#if defined(GST_PYLON_ARCH_ARM64)
+        case GST_PYLON_SIMD_NEON:
+          return unpack_row_12p_neon;
+#endif
+        default:
+          return unpack_row_12p_c;
+      }
+    case GST_PYLON_UNPACK_12_PACKED:
+      switch (level) {
+#if defined(GST_PYLON_ARCH_X86)
+        case GST_PYLON_SIMD_AVX2:
+          return unpack_row_12_packed_avx2;
+        case GST_PYLON_SIMD_SSE41:
+          return unpack_row_12_packed_sse41;
+#endif
+#if defined(GST_PYLON_ARCH_ARM64)
+        case GST_PYLON_SIMD_NEON:
+          return unpack_row_12_packed_neon;
+#endif
+        default:
+          return unpack_row_12_packed_c;
+      }
+    case GST_PYLON_UNPACK_16:
+      switch (level) {
+#if defined(GST_PYLON_ARCH_X86)
+        case GST_PYLON_SIMD_AVX2:
+          return unpack_row_16_avx2;
+        case GST_PYLON_SIMD_SSE41:
+          return unpack_row_16_sse41;
+#endif
+#if defined(GST_PYLON_ARCH_ARM64)
+        case GST_PYLON_SIMD_NEON:
+          return unpack_row_16_neon;
+#endif
+        default:
+          return unpack_row_16_c;
+      }
+    default:
+      return nullptr;
+  }
+}
+
+static bool has_suffix(const std::string &str, const std::string &suffix) {
+  return str.size() >= suffix.size() &&
+         0 == str.compare(str.size() - suffix.size(), suffix.size(), suffix);
+}
+
+GstPylonUnpack::GstPylonUnpack()
+    : layout(GST_PYLON_UNPACK_NONE),
+      shift(0),
+      simd_level(gst_pylon_simd_detect()),
+      unpack_row(nullptr) {}
+
+GstPylonUnpackLayout GstPylonUnpack::GetLayout(const std::string &pfnc_name) {
+  if (has_suffix(pfnc_name, "10p")) {
+    return GST_PYLON_UNPACK_10P;
+  }
+  if (has_suffix(pfnc_name, "12p")) {
+    return GST_PYLON_UNPACK_12P;
+  }
+  if (has_suffix(pfnc_name, "12Packed")) {
+    return GST_PYLON_UNPACK_12_PACKED;
+  }
+
+  return GST_PYLON_UNPACK_NONE;
+}
+
+int GstPylonUnpack::GetSampleBits(const std::string &pfnc_name) {
+  if (std::string::npos != pfnc_name.find("10")) {
+    return 10;
+  }
+  if (std::string::npos != pfnc_name.find("12")) {
+    return 12;
+  }
+
+  return 16;
+}
+
+size_t GstPylonUnpack::GetRowBytes(GstPylonUnpackLayout layout, int width) {
+  switch (layout) {
+    case GST_PYLON_UNPACK_10P:
+      return (static_cast<size_t>(width) * 10 + 7) / 8;
+    case GST_PYLON_UNPACK_12P:
+    case GST_PYLON_UNPACK_12_PACKED:
+      return (static_cast<size_t>(width) * 12 + 7) / 8;
+    default:
+      return static_cast<size_t>(width) * 2;
+  }
+}
+
+bool GstPylonUnpack::Configure(GstPylonUnpackLayout layout, int shift) {
+  GstPylonUnpackRowFunc func = select_unpack_row(layout, this->simd_level);
+
+  if ((!func && GST_PYLON_UNPACK_NONE != layout) || shift < 0 || shift > 6) {
+    return false;
+  }
+
+  this->layout = layout;
+  this->shift = shift;
+  this->unpack_row = func;
+
+  return true;
+}
+
+GstPylonUnpackLayout GstPylonUnpack::GetLayout() const { return this->layout; }
+
+int GstPylonUnpack::GetShift() const { return this->shift; }
+
+GstPylonSimdLevel GstPylonUnpack::GetSimdLevel() const {
+  return this->simd_level;
+}
+
+void GstPylonUnpack::SetSimdLevel(GstPylonSimdLevel level) {
+  GstPylonSimdLevel cpu = gst_pylon_simd_detect_cpu();
+
+  if (GST_PYLON_SIMD_SCALAR == level || level == cpu ||
+      (GST_PYLON_SIMD_NEON != cpu && GST_PYLON_SIMD_NEON != level &&
+       level < cpu)) {
+    this->simd_level = level;
+    if (GST_PYLON_UNPACK_NONE != this->layout) {
+      this->unpack_row = select_unpack_row(this->layout, level);
+    }
+  }
+}
+
+void GstPylonUnpack::Process(const uint8_t *src, size_t src_stride,
+                             uint16_t *dst, size_t dst_stride, int width,
+                             int height, GstPylonWorkerPool *pool) const {
+  if (!this->unpack_row) {
+    return;
+  }
+
+  auto unpack_rows = [&](size_t begin, size_t end) {
+    for (size_t y = begin; y < end; y++) {
+      this->unpack_row(src + y * src_stride,
+                       reinterpret_cast<uint16_t *>(
+                           reinterpret_cast<uint8_t *>(dst) + y * dst_stride),
+                       width, this->shift);
+    }
+  };
+
+  if (pool && pool->GetThreadCount() > 1 &&
+      static_cast<size_t>(width) * height >=
+          GST_PYLON_UNPACK_MIN_THREADED_PIXELS) {
+    /* a few stripes per thread balance uneven scheduling */
+    pool->Run(height,
+              std::max<size_t>(1, height / (pool->GetThreadCount() * 4)),
+              unpack_rows);
+  } else {
+    unpack_rows(0, height);
+  }
+}
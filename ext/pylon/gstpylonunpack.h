@@ -0,0 +1,79 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Unpacking of 10 and 12-bit packed pixel formats to 16-bit samples
+ */
+
+#ifndef _GST_PYLON_UNPACK_H_
+#define _GST_PYLON_UNPACK_H_
+
+#include "gstpylonsimd.h"
+#include "gstpylonworkerpool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/* frames smaller than this are unpacked on the calling thread, the stripe
+ * hand off would cost more than it saves */
+#define GST_PYLON_UNPACK_MIN_THREADED_PIXELS (512 * 1024)
+
+typedef enum {
+  GST_PYLON_UNPACK_NONE = 0,
+  /* PFNC Mono10p/Bayer*10p: 4 pixels in 5 bytes, LSB first */
+  GST_PYLON_UNPACK_10P = 1,
+  /* PFNC Mono12p/Bayer*12p: 2 pixels in 3 bytes, LSB first */
+  GST_PYLON_UNPACK_12P = 2,
+  /* GigE Vision Mono12Packed/Bayer*12Packed: 2 pixels in 3 bytes, the
+   * middle byte holds the low nibbles of both */
+  GST_PYLON_UNPACK_12_PACKED = 3,
+  /* Mono10/Mono12: one right aligned sample per little endian 16-bit word,
+   * only copied to apply the shift */
+  GST_PYLON_UNPACK_16 = 4,
+} GstPylonUnpackLayout;
+
+typedef void (*GstPylonUnpackRowFunc)(const uint8_t *src, uint16_t *dst,
+                                      int width, int shift);
+
+/**
+ * GstPylonUnpack:
+ *
+ * Expands each sample of a packed pixel format into a little endian 16-bit
+ * word, right aligned like the unpacked Mono10/Mono12 formats and then
+ * shifted left by the configured amount. GRAY16_LE spans the full 16-bit
+ * range, so mono samples are shifted to the most significant bits, the
+ * 10 and 12-bit bayer caps keep them right aligned. Large frames are split
+ * into row stripes over a worker pool.
+ */
+class GstPylonUnpack {
+ public:
+  GstPylonUnpack();
+
+  /* GST_PYLON_UNPACK_NONE if the PFNC format is not packed */
+  static GstPylonUnpackLayout GetLayout(const std::string &pfnc_name);
+  /* significant bits of a 10, 12 or 16-bit PFNC format */
+  static int GetSampleBits(const std::string &pfnc_name);
+  /* bytes of a packed row without padding */
+  static size_t GetRowBytes(GstPylonUnpackLayout layout, int width);
+
+  /* GST_PYLON_UNPACK_NONE disables Process(), @shift moves the samples
+   * towards the most significant bit, at most by 6 for 10-bit samples */
+  bool Configure(GstPylonUnpackLayout layout, int shift);
+  GstPylonUnpackLayout GetLayout() const;
+  int GetShift() const;
+
+  GstPylonSimdLevel GetSimdLevel() const;
+  /* fall back to a lower code path, used by the benchmark */
+  void SetSimdLevel(GstPylonSimdLevel level);
+
+  void Process(const uint8_t *src, size_t src_stride, uint16_t *dst,
+               size_t dst_stride, int width, int height,
+               GstPylonWorkerPool *pool) const;
+
+ private:
+  GstPylonUnpackLayout layout;
+  int shift;
+  GstPylonSimdLevel simd_level;
+  GstPylonUnpackRowFunc unpack_row;
+};
+
+#endif
@@ -0,0 +1,110 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Worker pool splitting image processing into row stripes
+ */
+
+#include "gstpylonworkerpool.h"
+
+#include <algorithm>
+
+GstPylonWorkerPool::GstPylonWorkerPool(unsigned int n_threads)
+    : job(nullptr),
+      n_items(0),
+      stripe(1),
+      next_item(0),
+      pending_workers(0),
+      generation(0),
+      stopping(false) {
+  if (0 == n_threads) {
+    n_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  /* the calling thread is the first worker */
+  for (unsigned int i = 1; i < n_threads; i++) {
+    this->workers.emplace_back(&GstPylonWorkerPool::WorkerLoop, this);
+  }
+}
+
+GstPylonWorkerPool::~GstPylonWorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stopping = true;
+  }
+  this->work_cv.notify_all();
+
+  for (auto &worker : this->workers) {
+    worker.join();
+  }
+}
+
+unsigned int GstPylonWorkerPool::GetThreadCount() const {
+  return static_cast<unsigned int>(this->workers.size()) + 1;
+}
+
+void GstPylonWorkerPool::ProcessStripes() {
+  for (;;) {
+    size_t begin = this->next_item.fetch_add(this->stripe);
+    if (begin >= this->n_items) {
+      break;
+    }
+    (*this->job)(begin, std::min(begin + this->stripe, this->n_items));
+  }
+}
+
+void GstPylonWorkerPool::WorkerLoop() {
+  uint64_t seen_generation = 0;
+
+  std::unique_lock<std::mutex> lock(this->mutex);
+  for (;;) {
+    this->work_cv.wait(lock, [&] {
+      return this->stopping || this->generation != seen_generation;
+    });
+    if (this->stopping) {
+      return;
+    }
+    seen_generation = this->generation;
+
+    lock.unlock();
+    this->ProcessStripes();
+    lock.lock();
+
+    if (0 == --this->pending_workers) {
+      this->done_cv.notify_one();
+    }
+  }
+}
+
+void GstPylonWorkerPool::Run(
+    size_t n_items, size_t stripe,
+    const std::function<void(size_t begin, size_t end)> &func) {
+  stripe = std::max<size_t>(1, stripe);
+
+  if (0 == n_items) {
+    return;
+  }
+
+  /* not worth waking anybody up */
+  if (this->workers.empty() || n_items <= stripe) {
+    func(0, n_items);
+    return;
+  }
+
+  std::lock_guard<std::mutex> run_lock(this->run_mutex);
+
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->job = &func;
+    this->n_items = n_items;
+    this->stripe = stripe;
+    this->next_item = 0;
+    this->pending_workers = this->workers.size();
+    this->generation++;
+  }
+  this->work_cv.notify_all();
+
+  this->ProcessStripes();
+
+  std::unique_lock<std::mutex> lock(this->mutex);
+  this->done_cv.wait(lock, [this] { return 0 == this->pending_workers; });
+  this->job = nullptr;
+}
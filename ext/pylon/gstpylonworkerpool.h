@@ -0,0 +1,57 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Worker pool splitting image processing into row stripes
+ */
+
+#ifndef _GST_PYLON_WORKER_POOL_H_
+#define _GST_PYLON_WORKER_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * GstPylonWorkerPool:
+ *
+ * Persistent set of worker threads. Run() splits a range of items, usually
+ * image rows, into stripes that the workers and the calling thread pick up
+ * until the range is exhausted, and returns once all stripes are done.
+ */
+class GstPylonWorkerPool {
+ public:
+  /* n_threads counts the calling thread, 0 selects one per CPU core */
+  explicit GstPylonWorkerPool(unsigned int n_threads = 0);
+  ~GstPylonWorkerPool();
+
+  GstPylonWorkerPool(const GstPylonWorkerPool &) = delete;
+  GstPylonWorkerPool &operator=(const GstPylonWorkerPool &) = delete;
+
+  unsigned int GetThreadCount() const;
+  void Run(size_t n_items, size_t stripe,
+           const std::function<void(size_t begin, size_t end)> &func);
+
+ private:
+  void WorkerLoop();
+  void ProcessStripes();
+
+  std::vector<std::thread> workers;
+  std::mutex run_mutex;
+  std::mutex mutex;
+  std::condition_variable work_cv;
+  std::condition_variable done_cv;
+
+  const std::function<void(size_t, size_t)> *job;
+  size_t n_items;
+  size_t stripe;
+  std::atomic<size_t> next_item;
+  size_t pending_workers;
+  uint64_t generation;
+  bool stopping;
+};
+
+#endif
@@ -0,0 +1,482 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Conversion of YUV 4:2:2 and RGB frames to NV12 and I420
+ */
+
+#include "gstpylonyuvconvert.h"
+
+#include <algorithm>
+
+/* BT.601 limited range, 8 fractional bits. Chroma is computed from the
+ * mean of the 2x2 block, which keeps every intermediate value of the SIMD
+ * code paths in 16 bits. */
+static inline uint8_t luma(int r, int g, int b) {
+  return static_cast<uint8_t>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+}
+
+static inline uint8_t chroma_u(int r, int g, int b) {
+  return static_cast<uint8_t>(((-38 * r - 74 * g + 112 * b + 128) >> 8) +
+                              128);
+}
+
+static inline uint8_t chroma_v(int r, int g, int b) {
+  return static_cast<uint8_t>(((112 * r - 94 * g - 18 * b + 128) >> 8) +
+                              128);
+}
+
+static inline void store_chroma(uint8_t *u, uint8_t *v, int x, uint8_t cb,
+                                uint8_t cr, GstPylonYuvOutput output) {
+  if (GST_PYLON_YUV_OUTPUT_NV12 == output) {
+    u[x] = cb;
+    u[x + 1] = cr;
+  } else {
+    u[x / 2] = cb;
+    v[x / 2] = cr;
+  }
+}
+
+static void convert_rows_scalar(const uint8_t *src0, const uint8_t *src1,
+                                uint8_t *y0, uint8_t *y1, uint8_t *u,
+                                uint8_t *v, int width, GstPylonYuvInput input,
+                                GstPylonYuvOutput output, int x) {
+  if (GST_PYLON_YUV_INPUT_YUY2 == input ||
+      GST_PYLON_YUV_INPUT_UYVY == input) {
+    const int luma_offset = GST_PYLON_YUV_INPUT_YUY2 == input ? 0 : 1;
+    const int chroma_offset = 1 - luma_offset;
+
+    for (; x < width; x += 2) {
+      const uint8_t *pair0 = src0 + x * 2;
+      const uint8_t *pair1 = src1 + x * 2;
+
+      y0[x] = pair0[luma_offset];
+      y1[x] = pair1[luma_offset];
+      if (x + 1 < width) {
+        y0[x + 1] = pair0[luma_offset + 2];
+        y1[x + 1] = pair1[luma_offset + 2];
+      }
+      store_chroma(
+          u, v, x,
+          (pair0[chroma_offset] + pair1[chroma_offset] + 1) >> 1,
+          (pair0[chroma_offset + 2] + pair1[chroma_offset + 2] + 1) >> 1,
+          output);
+    }
+    return;
+  }
+
+  const int r = GST_PYLON_YUV_INPUT_RGB == input ? 0 : 2;
+  const int b = 2 - r;
+
+  for (; x < width; x += 2) {
+    const uint8_t *p00 = src0 + x * 3;
+    const uint8_t *p10 = src1 + x * 3;
+    const uint8_t *p01 = x + 1 < width ? p00 + 3 : p00;
+    const uint8_t *p11 = x + 1 < width ? p10 + 3 : p10;
+
+    y0[x] = luma(p00[r], p00[1], p00[b]);
+    y1[x] = luma(p10[r], p10[1], p10[b]);
+    if (x + 1 < width) {
+      y0[x + 1] = luma(p01[r], p01[1], p01[b]);
+      y1[x + 1] = luma(p11[r], p11[1], p11[b]);
+    }
+
+    int mean_r = (p00[r] + p01[r] + p10[r] + p11[r] + 2) >> 2;
+    int mean_g = (p00[1] + p01[1] + p10[1] + p11[1] + 2) >> 2;
+    int mean_b = (p00[b] + p01[b] + p10[b] + p11[b] + 2) >> 2;
+    store_chroma(u, v, x, chroma_u(mean_r, mean_g, mean_b),
+                 chroma_v(mean_r, mean_g, mean_b), output);
+  }
+}
+
+static void convert_rows_c(const uint8_t *src0, const uint8_t *src1,
+                           uint8_t *y0, uint8_t *y1, uint8_t *u, uint8_t *v,
+                           int width, GstPylonYuvInput input,
+                           GstPylonYuvOutput output) {
+  convert_rows_scalar(src0, src1, y0, y1, u, v, width, input, output, 0);
+}
+
+#if defined(GST_PYLON_ARCH_X86)
+/* bytes of one color out of 16 RGB pixels, by 16-byte block of the row */
+alignas(16) static const uint8_t RGB_DEINTERLEAVE[3][3][16] = {
+    {{0, 3, 6, 9, 12, 15, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+      0x80, 0x80},
+     {1, 4, 7, 10, 13, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+      0x80, 0x80},
+     {2, 5, 8, 11, 14, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+      0x80, 0x80}},
+    {{0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 2, 5, 8, 11, 14, 0x80, 0x80, 0x80,
+      0x80, 0x80},
+     {0x80, 0x80, 0x80, 0x80, 0x80, 0, 3, 6, 9, 12, 15, 0x80, 0x80, 0x80,
+      0x80, 0x80},
+     {0x80, 0x80, 0x80, 0x80, 0x80, 1, 4, 7, 10, 13, 0x80, 0x80, 0x80, 0x80,
+      0x80, 0x80}},
+    {{0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 1, 4,
+      7, 10, 13},
+     {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 2, 5,
+      8, 11, 14},
+     {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0, 3, 6, 9,
+      12, 15}}};
+
+/* even bytes, then odd bytes */
+alignas(16) static const uint8_t UV_DEINTERLEAVE[16] = {
+    0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15};
+
+GST_PYLON_TARGET_SSE41 static inline __m128i load_sse41(const uint8_t *src) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+}
+
+GST_PYLON_TARGET_SSE41 static inline __m128i deinterleave_sse41(
+    const __m128i blocks[3], int channel) {
+  const __m128i *masks = reinterpret_cast<const __m128i *>(RGB_DEINTERLEAVE);
+
+  return _mm_or_si128(
+      _mm_or_si128(_mm_shuffle_epi8(blocks[0], _mm_load_si128(&masks[channel])),
+                   _mm_shuffle_epi8(blocks[1],
+                                    _mm_load_si128(&masks[3 + channel]))),
+      _mm_shuffle_epi8(blocks[2], _mm_load_si128(&masks[6 + channel])));
+}
+
+GST_PYLON_TARGET_SSE41 static inline __m128i luma_sse41(__m128i r, __m128i g,
+                                                        __m128i b) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i half[2];
+
+  /* at most 56228, the wrapping 16-bit arithmetic is exact */
+  for (int h = 0; h < 2; h++) {
+    __m128i r16 = h ? _mm_unpackhi_epi8(r, zero) : _mm_unpacklo_epi8(r, zero);
+    __m128i g16 = h ? _mm_unpackhi_epi8(g, zero) : _mm_unpacklo_epi8(g, zero);
+    __m128i b16 = h ? _mm_unpackhi_epi8(b, zero) : _mm_unpacklo_epi8(b, zero);
+    __m128i sum = _mm_add_epi16(
+        _mm_add_epi16(_mm_mullo_epi16(r16, _mm_set1_epi16(66)),
+                      _mm_mullo_epi16(g16, _mm_set1_epi16(129))),
+        _mm_add_epi16(_mm_mullo_epi16(b16, _mm_set1_epi16(25)),
+                      _mm_set1_epi16(128)));
+    half[h] = _mm_add_epi16(_mm_srli_epi16(sum, 8), _mm_set1_epi16(16));
+  }
+
+  return _mm_packus_epi16(half[0], half[1]);
+}
+
+GST_PYLON_TARGET_SSE41 static inline __m128i chroma_sse41(
+    __m128i r, __m128i g, __m128i b, short cr, short cg, short cb) {
+  __m128i sum = _mm_add_epi16(
+      _mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(cr)),
+                    _mm_mullo_epi16(g, _mm_set1_epi16(cg))),
+      _mm_add_epi16(_mm_mullo_epi16(b, _mm_set1_epi16(cb)),
+                    _mm_set1_epi16(128)));
+
+  return _mm_add_epi16(_mm_srai_epi16(sum, 8), _mm_set1_epi16(128));
+}
+
+/* mean of each 2x2 block of one color */
+GST_PYLON_TARGET_SSE41 static inline __m128i block_mean_sse41(__m128i row0,
+                                                              __m128i row1) {
+  const __m128i one = _mm_set1_epi8(1);
+  __m128i sum = _mm_add_epi16(_mm_maddubs_epi16(row0, one),
+                              _mm_maddubs_epi16(row1, one));
+
+  return _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(2)), 2);
+}
+
+/* stores 8 interleaved chroma pairs */
+GST_PYLON_TARGET_SSE41 static inline void store_chroma_sse41(
+    uint8_t *u, uint8_t *v, int x, __m128i uv, GstPylonYuvOutput output) {
+  if (GST_PYLON_YUV_OUTPUT_NV12 == output) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(u + x), uv);
+  } else {
+    uv = _mm_shuffle_epi8(
+        uv, _mm_load_si128(reinterpret_cast<const __m128i *>(UV_DEINTERLEAVE)));
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(u + x / 2), uv);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(v + x / 2),
+                     _mm_srli_si128(uv, 8));
+  }
+}
+
+GST_PYLON_TARGET_SSE41 static void convert_rows_sse41(
+    const uint8_t *src0, const uint8_t *src1, uint8_t *y0, uint8_t *y1,
+    uint8_t *u, uint8_t *v, int width, GstPylonYuvInput input,
+    GstPylonYuvOutput output) {
+  int x = 0;
+
+  if (GST_PYLON_YUV_INPUT_YUY2 == input ||
+      GST_PYLON_YUV_INPUT_UYVY == input) {
+    const __m128i low = _mm_set1_epi16(0x00FF);
+    const bool yuy2 = GST_PYLON_YUV_INPUT_YUY2 == input;
+
+    for (; x + 16 <= width; x += 16) {
+      __m128i a0 = load_sse41(src0 + x * 2);
+      __m128i b0 = load_sse41(src0 + x * 2 + 16);
+      __m128i a1 = load_sse41(src1 + x * 2);
+      __m128i b1 = load_sse41(src1 + x * 2 + 16);
+      __m128i even0 = _mm_packus_epi16(_mm_and_si128(a0, low),
+                                       _mm_and_si128(b0, low));
+      __m128i odd0 = _mm_packus_epi16(_mm_srli_epi16(a0, 8),
+                                      _mm_srli_epi16(b0, 8));
+      __m128i even1 = _mm_packus_epi16(_mm_and_si128(a1, low),
+                                       _mm_and_si128(b1, low));
+      __m128i odd1 = _mm_packus_epi16(_mm_srli_epi16(a1, 8),
+                                      _mm_srli_epi16(b1, 8));
+
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(y0 + x),
+                       yuy2 ? even0 : odd0);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(y1 + x),
+                       yuy2 ? even1 : odd1);
+      store_chroma_sse41(u, v, x,
+                         yuy2 ? _mm_avg_epu8(odd0, odd1)
+                              : _mm_avg_epu8(even0, even1),
+                         output);
+    }
+  } else {
+    const bool rgb = GST_PYLON_YUV_INPUT_RGB == input;
+
+    for (; x + 16 <= width; x += 16) {
+      __m128i blocks0[3] = {load_sse41(src0 + x * 3),
+                            load_sse41(src0 + x * 3 + 16),
+                            load_sse41(src0 + x * 3 + 32)};
+      __m128i blocks1[3] = {load_sse41(src1 + x * 3),
+                            load_sse41(src1 + x * 3 + 16),
+                            load_sse41(src1 + x * 3 + 32)};
+      __m128i r0 = deinterleave_sse41(blocks0, rgb ? 0 : 2);
+      __m128i g0 = deinterleave_sse41(blocks0, 1);
+      __m128i b0 = deinterleave_sse41(blocks0, rgb ? 2 : 0);
+      __m128i r1 = deinterleave_sse41(blocks1, rgb ? 0 : 2);
+      __m128i g1 = deinterleave_sse41(blocks1, 1);
+      __m128i b1 = deinterleave_sse41(blocks1, rgb ? 2 : 0);
+
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(y0 + x),
+                       luma_sse41(r0, g0, b0));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(y1 + x),
+                       luma_sse41(r1, g1, b1));
+
+      __m128i mean_r = block_mean_sse41(r0, r1);
+      __m128i mean_g = block_mean_sse41(g0, g1);
+      __m128i mean_b = block_mean_sse41(b0, b1);
+      __m128i uv = _mm_packus_epi16(
+          chroma_sse41(mean_r, mean_g, mean_b, -38, -74, 112),
+          chroma_sse41(mean_r, mean_g, mean_b, 112, -94, -18));
+      store_chroma_sse41(u, v, x,
+                         _mm_unpacklo_epi8(uv, _mm_srli_si128(uv, 8)),
+                         output);
+    }
+  }
+
+  convert_rows_scalar(src0, src1, y0, y1, u, v, width, input, output, x);
+}
+#endif
+
+#if defined(GST_PYLON_ARCH_ARM64)
+static inline uint8x8_t chroma_neon(uint16x8_t r, uint16x8_t g, uint16x8_t b,
+                                    int16_t cr, int16_t cg, int16_t cb) {
+  int16x8_t sum = vmulq_n_s16(vreinterpretq_s16_u16(r), cr);
+  sum = vmlaq_n_s16(sum, vreinterpretq_s16_u16(g), cg);
+  sum = vmlaq_n_s16(sum, vreinterpretq_s16_u16(b), cb);
+  sum = vaddq_s16(vshrq_n_s16(vaddq_s16(sum, vdupq_n_s16(128)), 8),
+                  vdupq_n_s16(128));
+
+  return vqmovun_s16(sum);
+}
+
+static inline uint8x16_t luma_neon(uint8x16_t r, uint8x16_t g, uint8x16_t b) {
+  uint16x8_t lo = vmull_u8(vget_low_u8(r), vdup_n_u8(66));
+  uint16x8_t hi = vmull_u8(vget_high_u8(r), vdup_n_u8(66));
+
+  lo = vmlal_u8(lo, vget_low_u8(g), vdup_n_u8(129));
+  hi = vmlal_u8(hi, vget_high_u8(g), vdup_n_u8(129));
+  lo = vmlal_u8(lo, vget_low_u8(b), vdup_n_u8(25));
+  hi = vmlal_u8(hi, vget_high_u8(b), vdup_n_u8(25));
+
+  uint8x16_t y = vcombine_u8(vshrn_n_u16(vaddq_u16(lo, vdupq_n_u16(128)), 8),
+                             vshrn_n_u16(vaddq_u16(hi, vdupq_n_u16(128)), 8));
+  return vaddq_u8(y, vdupq_n_u8(16));
+}
+
+static void convert_rows_neon(const uint8_t *src0, const uint8_t *src1,
+                              uint8_t *y0, uint8_t *y1, uint8_t *u,
+                              uint8_t *v, int width, GstPylonYuvInput input,
+                              GstPylonYuvOutput output) {
+  int x = 0;
+
+  if (GST_PYLON_YUV_INPUT_YUY2 == input ||
+      GST_PYLON_YUV_INPUT_UYVY == input) {
+    const int luma_offset = GST_PYLON_YUV_INPUT_YUY2 == input ? 0 : 1;
+    const int chroma_offset = 1 - luma_offset;
+
+    for (; x + 32 <= width; x += 32) {
+      uint8x16x4_t row0 = vld4q_u8(src0 + x * 2);
+      uint8x16x4_t row1 = vld4q_u8(src1 + x * 2);
+      uint8x16x2_t luma0 = {
+          {row0.val[luma_offset], row0.val[luma_offset + 2]}};
+      uint8x16x2_t luma1 = {
+          {row1.val[luma_offset], row1.val[luma_offset + 2]}};
+      uint8x16_t cb =
+          vrhaddq_u8(row0.val[chroma_offset], row1.val[chroma_offset]);
+      uint8x16_t cr = vrhaddq_u8(row0.val[chroma_offset + 2],
+                                 row1.val[chroma_offset + 2]);
+
+      vst2q_u8(y0 + x, luma0);
+      vst2q_u8(y1 + x, luma1);
+      if (GST_PYLON_YUV_OUTPUT_NV12 == output) {
+        uint8x16x2_t uv = {{cb, cr}};
+        vst2q_u8(u + x, uv);
+      } else {
+        vst1q_u8(u + x / 2, cb);
+        vst1q_u8(v + x / 2, cr);
+      }
+    }
+  } else {
+    const int r = GST_PYLON_YUV_INPUT_RGB == input ? 0 : 2;
+    const int b = 2 - r;
+
+    for (; x + 16 <= width; x += 16) {
+      uint8x16x3_t row0 = vld3q_u8(src0 + x * 3);
+      uint8x16x3_t row1 = vld3q_u8(src1 + x * 3);
+
+      vst1q_u8(y0 + x, luma_neon(row0.val[r], row0.val[1], row0.val[b]));
+      vst1q_u8(y1 + x, luma_neon(row1.val[r], row1.val[1], row1.val[b]));
+
+      /* (sum + 2) >> 2 */
+      uint16x8_t mean_r = vrshrq_n_u16(
+          vaddq_u16(vpaddlq_u8(row0.val[r]), vpaddlq_u8(row1.val[r])), 2);
+      uint16x8_t mean_g = vrshrq_n_u16(
+          vaddq_u16(vpaddlq_u8(row0.val[1]), vpaddlq_u8(row1.val[1])), 2);
+      uint16x8_t mean_b = vrshrq_n_u16(
+          vaddq_u16(vpaddlq_u8(row0.val[b]), vpaddlq_u8(row1.val[b])), 2);
+      uint8x8_t cb = chroma_neon(mean_r, mean_g, mean_b, -38, -74, 112);
+      uint8x8_t cr = chroma_neon(mean_r, mean_g, mean_b, 112, -94, -18);
+
+      if (GST_PYLON_YUV_OUTPUT_NV12 == output) {
+        uint8x8x2_t uv = {{cb, cr}};
+        vst2_u8(u + x, uv);
+      } else {
+        vst1_u8(u + x / 2, cb);
+        vst1_u8(v + x / 2, cr);
+      }
+    }
+  }
+
+  convert_rows_scalar(src0, src1, y0, y1, u, v, width, input, output, x);
+}
+#endif
+
+/* the 16-bit products leave little for AVX2 to gain over the memory
+ * bandwidth, it shares the SSE4.1 code path */
+static GstPylonYuvRowFunc select_convert_rows(GstPylonSimdLevel level) {
+  switch (level) {
+#if defined(GST_PYLON_ARCH_X86)
+    case GST_PYLON_SIMD_AVX2:
+    case GST_PYLON_SIMD_SSE41:
+      return convert_rows_sse41;
+#endif
+#if defined(GST_PYLON_ARCH_ARM64)
+    case GST_PYLON_SIMD_NEON:
+      return convert_rows_neon;
+#endif
+    default:
+      return convert_rows_c;
+  }
+}
+
+GstPylonYuvConvert::GstPylonYuvConvert()
+    : input(GST_PYLON_YUV_INPUT_NONE),
+      output(GST_PYLON_YUV_OUTPUT_NONE),
+      simd_level(gst_pylon_simd_detect()),
+      convert_rows(select_convert_rows(simd_level)) {}
+
+GstPylonYuvInput GstPylonYuvConvert::GetInput(const std::string &pfnc_name) {
+  static const struct {
+    const char *pfnc_name;
+    GstPylonYuvInput input;
+  } inputs[] = {{"YCbCr422_8", GST_PYLON_YUV_INPUT_YUY2},
+                {"YUV422_8", GST_PYLON_YUV_INPUT_YUY2},
+                {"YUV422_YUYV_Packed", GST_PYLON_YUV_INPUT_YUY2},
+                {"YUV422_8_UYVY", GST_PYLON_YUV_INPUT_UYVY},
+                {"YUV422Packed", GST_PYLON_YUV_INPUT_UYVY},
+                {"RGB8", GST_PYLON_YUV_INPUT_RGB},
+                {"RGB8Packed", GST_PYLON_YUV_INPUT_RGB},
+                {"BGR8", GST_PYLON_YUV_INPUT_BGR},
+                {"BGR8Packed", GST_PYLON_YUV_INPUT_BGR}};
+
+  for (const auto &entry : inputs) {
+    if (pfnc_name == entry.pfnc_name) {
+      return entry.input;
+    }
+  }
+
+  return GST_PYLON_YUV_INPUT_NONE;
+}
+
+GstPylonYuvOutput GstPylonYuvConvert::GetOutput(
+    const std::string &gst_format) {
+  if ("NV12" == gst_format) {
+    return GST_PYLON_YUV_OUTPUT_NV12;
+  }
+  if ("I420" == gst_format) {
+    return GST_PYLON_YUV_OUTPUT_I420;
+  }
+
+  return GST_PYLON_YUV_OUTPUT_NONE;
+}
+
+void GstPylonYuvConvert::Configure(GstPylonYuvInput input,
+                                   GstPylonYuvOutput output) {
+  this->input = input;
+  this->output = GST_PYLON_YUV_INPUT_NONE == input ? GST_PYLON_YUV_OUTPUT_NONE
+                                                   : output;
+}
+
+GstPylonYuvOutput GstPylonYuvConvert::GetOutput() const {
+  return this->output;
+}
+
+GstPylonSimdLevel GstPylonYuvConvert::GetSimdLevel() const {
+  return this->simd_level;
+}
+
+void GstPylonYuvConvert::SetSimdLevel(GstPylonSimdLevel level) {
+  GstPylonSimdLevel cpu = gst_pylon_simd_detect_cpu();
+
+  if (GST_PYLON_SIMD_SCALAR == level || level == cpu ||
+      (GST_PYLON_SIMD_NEON != cpu && GST_PYLON_SIMD_NEON != level &&
+       level < cpu)) {
+    this->simd_level = level;
+    this->convert_rows = select_convert_rows(level);
+  }
+}
+
+void GstPylonYuvConvert::Process(const uint8_t *src, size_t src_stride,
+                                 uint8_t *const planes[3],
+                                 const size_t strides[3], int width,
+                                 int height, GstPylonWorkerPool *pool) const {
+  if (GST_PYLON_YUV_OUTPUT_NONE == this->output) {
+    return;
+  }
+
+  const size_t n_pairs = (height + 1) / 2;
+
+  auto convert_pairs = [&](size_t begin, size_t end) {
+    for (size_t pair = begin; pair < end; pair++) {
+      const size_t y = pair * 2;
+      const bool last = static_cast<int>(y) + 1 >= height;
+      const uint8_t *src0 = src + y * src_stride;
+      uint8_t *y0 = planes[0] + y * strides[0];
+
+      this->convert_rows(
+          src0, last ? src0 : src0 + src_stride, y0,
+          last ? y0 : y0 + strides[0], planes[1] + pair * strides[1],
+          GST_PYLON_YUV_OUTPUT_I420 == this->output
+              ? planes[2] + pair * strides[2]
+              : nullptr,
+          width, this->input, this->output);
+    }
+  };
+
+  if (pool && pool->GetThreadCount() > 1 &&
+      static_cast<size_t>(width) * height >=
+          GST_PYLON_YUV_CONVERT_MIN_THREADED_PIXELS) {
+    /* a few stripes per thread balance uneven scheduling */
+    pool->Run(n_pairs,
+              std::max<size_t>(1, n_pairs / (pool->GetThreadCount() * 4)),
+              convert_pairs);
+  } else {
+    convert_pairs(0, n_pairs);
+  }
+}
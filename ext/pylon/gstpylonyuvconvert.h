@@ -0,0 +1,81 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Conversion of YUV 4:2:2 and RGB frames to NV12 and I420
+ */
+
+#ifndef _GST_PYLON_YUV_CONVERT_H_
+#define _GST_PYLON_YUV_CONVERT_H_
+
+#include "gstpylonsimd.h"
+#include "gstpylonworkerpool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/* frames smaller than this are converted on the calling thread */
+#define GST_PYLON_YUV_CONVERT_MIN_THREADED_PIXELS (512 * 1024)
+
+typedef enum {
+  GST_PYLON_YUV_INPUT_NONE = 0,
+  GST_PYLON_YUV_INPUT_YUY2 = 1,
+  GST_PYLON_YUV_INPUT_UYVY = 2,
+  GST_PYLON_YUV_INPUT_RGB = 3,
+  GST_PYLON_YUV_INPUT_BGR = 4,
+} GstPylonYuvInput;
+
+typedef enum {
+  GST_PYLON_YUV_OUTPUT_NONE = 0,
+  /* Y plane, then one plane of interleaved U and V */
+  GST_PYLON_YUV_OUTPUT_NV12 = 1,
+  /* Y, U and V planes */
+  GST_PYLON_YUV_OUTPUT_I420 = 2,
+} GstPylonYuvOutput;
+
+/* converts the pixels from x on of a pair of rows, x is even */
+typedef void (*GstPylonYuvRowFunc)(const uint8_t *src0, const uint8_t *src1,
+                                   uint8_t *y0, uint8_t *y1, uint8_t *u,
+                                   uint8_t *v, int width,
+                                   GstPylonYuvInput input,
+                                   GstPylonYuvOutput output);
+
+/**
+ * GstPylonYuvConvert:
+ *
+ * Subsamples the chroma of every 2x2 block of pixels. 4:2:2 input keeps
+ * its samples, the chroma of two rows is averaged. RGB input is converted
+ * with the BT.601 limited range matrix. An odd last row or column is
+ * paired with itself; 4:2:2 rows are read in whole macropixels.
+ * Large frames are split into row stripes over a worker pool.
+ */
+class GstPylonYuvConvert {
+ public:
+  GstPylonYuvConvert();
+
+  /* GST_PYLON_YUV_INPUT_NONE if the PFNC format is not converted */
+  static GstPylonYuvInput GetInput(const std::string &pfnc_name);
+  /* GST_PYLON_YUV_OUTPUT_NONE if the GStreamer format is not produced */
+  static GstPylonYuvOutput GetOutput(const std::string &gst_format);
+
+  /* GST_PYLON_YUV_OUTPUT_NONE disables Process() */
+  void Configure(GstPylonYuvInput input, GstPylonYuvOutput output);
+  GstPylonYuvOutput GetOutput() const;
+
+  GstPylonSimdLevel GetSimdLevel() const;
+  /* fall back to a lower code path, used by the benchmark */
+  void SetSimdLevel(GstPylonSimdLevel level);
+
+  /* planes and strides in Y, U(V), V order, the V plane is unused for
+   * NV12 */
+  void Process(const uint8_t *src, size_t src_stride, uint8_t *const planes[3],
+               const size_t strides[3], int width, int height,
+               GstPylonWorkerPool *pool) const;
+
+ private:
+  GstPylonYuvInput input;
+  GstPylonYuvOutput output;
+  GstPylonSimdLevel simd_level;
+  GstPylonYuvRowFunc convert_rows;
+};
+
+#endif
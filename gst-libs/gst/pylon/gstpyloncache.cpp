@@ -32,15 +32,115 @@
 
 #include "gstpyloncache.h"
 
+#include "gstpylonfeaturewalker.h"
+#include "gstpylonparamspecs.h"
+
 #include <errno.h>
 #include <glib/gfileutils.h>
 #include <gst/pylon/gstpylonincludes.h>
 
+#include <algorithm>
+#include <cstring>
+
 #define DIRERR -1
 
+#define CACHE_MAGIC "GSTPYLON"
+#define CACHE_MAGIC_SIZE 8
+#define CACHE_BYTE_ORDER 0x01020304
+#define CACHE_NULL_STRING G_MAXUINT32
+
+/* stable identifiers of the stored GParamSpec types, GTypes of enums are
+ * only valid within one process */
+enum GstPylonCacheSpecType {
+  SPEC_TYPE_INT64 = 0,
+  SPEC_TYPE_BOOLEAN = 1,
+  SPEC_TYPE_DOUBLE = 2,
+  SPEC_TYPE_STRING = 3,
+  SPEC_TYPE_ENUM = 4,
+};
+
+/* Appends fixed size values and length prefixed strings in host byte order,
+ * the header records the byte order to reject foreign files */
+class GstPylonCacheWriter {
+ public:
+  template <class T>
+  void Write(T value) {
+    data.append(reinterpret_cast<const gchar *>(&value), sizeof(value));
+  }
+
+  void WriteString(const gchar *str) {
+    if (!str) {
+      Write<guint32>(CACHE_NULL_STRING);
+      return;
+    }
+    guint32 length = strlen(str);
+    Write<guint32>(length);
+    data.append(str, length);
+  }
+
+  std::string data;
+};
+
+/* Reads back what GstPylonCacheWriter wrote, every read is bounds checked */
+class GstPylonCacheReader {
+ public:
+  GstPylonCacheReader(const gchar *data, gsize size)
+      : data(data), size(size), pos(0) {}
+
+  template <class T>
+  bool Read(T &value) {
+    if (size - pos < sizeof(value)) {
+      return false;
+    }
+    memcpy(&value, data + pos, sizeof(value));
+    pos += sizeof(value);
+    return true;
+  }
+
+  bool ReadString(std::string &str, bool &is_null) {
+    guint32 length = 0;
+    if (!Read(length)) {
+      return false;
+    }
+    is_null = CACHE_NULL_STRING == length;
+    if (is_null) {
+      str.clear();
+      return true;
+    }
+    if (size - pos < length) {
+      return false;
+    }
+    str.assign(data + pos, length);
+    pos += length;
+    return true;
+  }
+
+  bool ReadString(std::string &str) {
+    bool is_null = false;
+    return ReadString(str, is_null) && !is_null;
+  }
+
+  bool ReadBytes(std::string &bytes, gsize length) {
+    if (size - pos < length) {
+      return false;
+    }
+    bytes.assign(data + pos, length);
+    pos += length;
+    return true;
+  }
+
+  bool AtEnd() { return pos == size; }
+
+ private:
+  const gchar *data;
+  gsize size;
+  gsize pos;
+};
+
 /* prototypes */
 static std::string gst_pylon_cache_create_filepath(
     const std::string &cache_filename);
+static GParamSpec *gst_pylon_cache_make_spec(const std::string &record);
 
 static std::string gst_pylon_cache_create_filepath(
     const std::string &cache_filename) {
@@ -50,12 +150,12 @@ static std::string gst_pylon_cache_create_filepath(
   std::string filename_hash_str = filename_hash;
   g_free(filename_hash);
 
-  std::string dirpath = std::string(g_get_user_cache_dir()) + "/" + "gstpylon";
+  std::string dirpath = GstPylonCache::GetCacheDir();
 
   /* Create gstpylon directory */
   gint dir_permissions = 0775;
   gint ret = g_mkdir_with_parents(dirpath.c_str(), dir_permissions);
-  std::string filepath = dirpath + "/" + filename_hash_str + ".config";
+  std::string filepath = dirpath + "/" + filename_hash_str + ".bin";
   if (DIRERR == ret) {
     std::string msg =
         "Failed to create " + dirpath + ": " + std::string(strerror(errno));
@@ -65,9 +165,155 @@ static std::string gst_pylon_cache_create_filepath(
   return filepath;
 }
 
+/* Enum types are registered once per process and their values must stay
+ * valid for its lifetime, so they are never freed */
+static GType gst_pylon_cache_make_enum_type(GstPylonCacheReader &reader) {
+  std::string type_name;
+  guint32 n_values = 0;
+
+  if (!reader.ReadString(type_name) || !reader.Read(n_values)) {
+    return G_TYPE_INVALID;
+  }
+
+  GEnumValue *values = g_new0(GEnumValue, n_values + 1);
+  for (guint32 i = 0; i < n_values; i++) {
+    gint32 value = 0;
+    std::string name;
+    std::string nick;
+    bool nick_is_null = false;
+    if (!reader.Read(value) || !reader.ReadString(name) ||
+        !reader.ReadString(nick, nick_is_null)) {
+      for (guint32 j = 0; j < i; j++) {
+        g_free(const_cast<gchar *>(values[j].value_name));
+        g_free(const_cast<gchar *>(values[j].value_nick));
+      }
+      g_free(values);
+      return G_TYPE_INVALID;
+    }
+    values[i].value = value;
+    values[i].value_name = g_strdup(name.c_str());
+    values[i].value_nick = nick_is_null ? NULL : g_strdup(nick.c_str());
+  }
+
+  GType type = g_type_from_name(type_name.c_str());
+  if (type) {
+    for (guint32 i = 0; i < n_values; i++) {
+      g_free(const_cast<gchar *>(values[i].value_name));
+      g_free(const_cast<gchar *>(values[i].value_nick));
+    }
+    g_free(values);
+    return G_TYPE_IS_ENUM(type) ? type : G_TYPE_INVALID;
+  }
+
+  return g_enum_register_static(type_name.c_str(), values);
+}
+
+static GParamSpec *gst_pylon_cache_make_spec(const std::string &record) {
+  GstPylonCacheReader reader(record.data(), record.size());
+  std::string name;
+  std::string nick;
+  std::string blurb;
+  guint32 flags = 0;
+  guint8 type = 0;
+
+  if (!reader.ReadString(name) || !reader.ReadString(nick) ||
+      !reader.ReadString(blurb) || !reader.Read(flags) || !reader.Read(type)) {
+    return NULL;
+  }
+
+  /* the strings are copied into the GParamSpec */
+  GParamFlags spec_flags =
+      static_cast<GParamFlags>(flags & ~G_PARAM_STATIC_STRINGS);
+  GParamSpec *spec = NULL;
+
+  switch (type) {
+    case SPEC_TYPE_INT64: {
+      gint64 min = 0, max = 0, def = 0;
+      if (reader.Read(min) && reader.Read(max) && reader.Read(def) &&
+          def >= min && def <= max) {
+        spec = g_param_spec_int64(name.c_str(), nick.c_str(), blurb.c_str(),
+                                  min, max, def, spec_flags);
+      }
+      break;
+    }
+    case SPEC_TYPE_BOOLEAN: {
+      guint8 def = 0;
+      if (reader.Read(def)) {
+        spec = g_param_spec_boolean(name.c_str(), nick.c_str(), blurb.c_str(),
+                                    def, spec_flags);
+      }
+      break;
+    }
+    case SPEC_TYPE_DOUBLE: {
+      gdouble min = 0, max = 0, def = 0;
+      if (reader.Read(min) && reader.Read(max) && reader.Read(def) &&
+          def >= min && def <= max) {
+        spec = g_param_spec_double(name.c_str(), nick.c_str(), blurb.c_str(),
+                                   min, max, def, spec_flags);
+      }
+      break;
+    }
+    case SPEC_TYPE_STRING: {
+      std::string def;
+      bool is_null = false;
+      if (reader.ReadString(def, is_null)) {
+        spec = g_param_spec_string(name.c_str(), nick.c_str(), blurb.c_str(),
+                                   is_null ? NULL : def.c_str(), spec_flags);
+      }
+      break;
+    }
+    case SPEC_TYPE_ENUM: {
+      gint32 def = 0;
+      GType enum_type = gst_pylon_cache_make_enum_type(reader);
+      if (enum_type && reader.Read(def)) {
+        GEnumClass *enum_class = G_ENUM_CLASS(g_type_class_ref(enum_type));
+        if (g_enum_get_value(enum_class, def)) {
+          spec = g_param_spec_enum(name.c_str(), nick.c_str(), blurb.c_str(),
+                                   enum_type, def, spec_flags);
+        }
+        g_type_class_unref(enum_class);
+      }
+      break;
+    }
+    default:
+      break;
+  }
+
+  if (!spec) {
+    return NULL;
+  }
+
+  guint8 has_selector = 0;
+  if (!reader.Read(has_selector)) {
+    g_param_spec_unref(g_param_spec_ref_sink(spec));
+    return NULL;
+  }
+
+  if (has_selector) {
+    std::string feature;
+    std::string selector;
+    gint64 selector_value = 0;
+    if (!reader.ReadString(feature) || !reader.ReadString(selector) ||
+        !reader.Read(selector_value)) {
+      g_param_spec_unref(g_param_spec_ref_sink(spec));
+      return NULL;
+    }
+    gst_pylon_param_spec_selector_set_data(spec, feature.c_str(),
+                                           selector.c_str(), selector_value);
+  }
+
+  if (!reader.AtEnd()) {
+    g_param_spec_unref(g_param_spec_ref_sink(spec));
+    return NULL;
+  }
+
+  return spec;
+}
+
 GstPylonCache::GstPylonCache(const std::string &name)
-    : filepath(gst_pylon_cache_create_filepath(name)),
-      feature_cache_dict(g_key_file_new()),
+    : name(name),
+      filepath(gst_pylon_cache_create_filepath(name)),
+      has_invalidator_groups(FALSE),
       is_modified(FALSE) {
   /* load initial cache file */
   if (!LoadCacheFile()) {
@@ -75,48 +321,262 @@ GstPylonCache::GstPylonCache(const std::string &name)
   }
 }
 
-GstPylonCache::~GstPylonCache() { g_key_file_free(this->feature_cache_dict); }
+GstPylonCache::GstPylonCache()
+    : has_invalidator_groups(FALSE), is_modified(FALSE) {}
+
+GstPylonCache::~GstPylonCache() {}
+
+std::unique_ptr<GstPylonCache> GstPylonCache::FromFile(
+    const std::string &filepath) {
+  std::unique_ptr<GstPylonCache> cache(new GstPylonCache());
+  GError *err = NULL;
+
+  GMappedFile *file = g_mapped_file_new(filepath.c_str(), FALSE, &err);
+  if (!file) {
+    std::string msg = err->message;
+    g_error_free(err);
+    throw Pylon::GenericException(msg.c_str(), __FILE__, __LINE__);
+  }
+
+  gboolean ret = cache->Parse(g_mapped_file_get_contents(file),
+                              g_mapped_file_get_length(file));
+  g_mapped_file_unref(file);
+
+  if (!ret) {
+    std::string msg = filepath + " is not a feature cache of version " +
+                      std::to_string(GST_PYLON_CACHE_VERSION);
+    throw Pylon::GenericException(msg.c_str(), __FILE__, __LINE__);
+  }
+
+  cache->filepath = filepath;
+
+  return cache;
+}
+
+std::string GstPylonCache::GetCacheDir() {
+  return std::string(g_get_user_cache_dir()) + "/" + "gstpylon";
+}
+
+std::vector<std::string> GstPylonCache::ListCacheFiles() {
+  std::vector<std::string> files;
+  std::string dirpath = GstPylonCache::GetCacheDir();
+
+  GDir *dir = g_dir_open(dirpath.c_str(), 0, NULL);
+  if (!dir) {
+    return files;
+  }
+
+  while (const gchar *filename = g_dir_read_name(dir)) {
+    if (g_str_has_suffix(filename, ".bin")) {
+      files.push_back(dirpath + "/" + filename);
+    }
+  }
+  g_dir_close(dir);
+
+  std::sort(files.begin(), files.end());
+
+  return files;
+}
+
+const std::string &GstPylonCache::GetName() { return this->name; }
+
+const std::string &GstPylonCache::GetFilePath() { return this->filepath; }
+
+void GstPylonCache::SetFilePath(const std::string &path) {
+  this->filepath = path;
+}
+
+gsize GstPylonCache::GetLimitsCount() { return this->limits.size(); }
+
+gsize GstPylonCache::GetParamSpecCount() { return this->spec_records.size(); }
+
+void GstPylonCache::Clear() {
+  this->limits.clear();
+  this->spec_records.clear();
+  this->spec_index.clear();
+  is_modified = TRUE;
+}
+
+gboolean GstPylonCache::HasInvalidatorGroups() {
+  return this->has_invalidator_groups;
+}
+
+void GstPylonCache::SetInvalidatorGroups(
+    const std::unordered_map<std::string, std::vector<std::string>> &groups) {
+  this->invalidator_groups = groups;
+  this->has_invalidator_groups = TRUE;
+}
+
+std::vector<std::string> GstPylonCache::GetInvalidatorGroupMembers(
+    const std::string &group) {
+  auto entry = this->invalidator_groups.find(group);
+  if (entry == this->invalidator_groups.end()) {
+    return {};
+  }
+
+  return entry->second;
+}
 
 gboolean GstPylonCache::LoadCacheFile() {
-  gboolean ret = TRUE;
+  GError *err = NULL;
 
   /* Check if file exists */
-  ret = g_file_test(this->filepath.c_str(), G_FILE_TEST_EXISTS);
-  if (!ret) {
+  if (!g_file_test(this->filepath.c_str(), G_FILE_TEST_EXISTS)) {
+    return FALSE;
+  }
+
+  GMappedFile *file = g_mapped_file_new(this->filepath.c_str(), FALSE, &err);
+  if (!file) {
+    GST_WARNING("Could not map feature cache %s: %s", this->filepath.c_str(),
+                err->message);
+    g_error_free(err);
     return FALSE;
   }
 
   /* Check if file contents are valid, this also sets the content of the
-   * GKeyFile object if valid */
-  ret = g_key_file_load_from_file(
-      this->feature_cache_dict, this->filepath.c_str(), G_KEY_FILE_NONE, NULL);
+   * cache if valid */
+  gboolean ret = Parse(g_mapped_file_get_contents(file),
+                       g_mapped_file_get_length(file));
+  g_mapped_file_unref(file);
+
   if (!ret) {
+    GST_WARNING("Ignoring invalid or outdated feature cache %s",
+                this->filepath.c_str());
+  }
+
+  return ret;
+}
+
+gboolean GstPylonCache::Parse(const gchar *data, gsize size) {
+  GstPylonCacheReader reader(data, size);
+  std::string magic;
+  guint32 version = 0;
+  guint32 byte_order = 0;
+  guint32 schema = 0;
+  guint32 n_limits = 0;
+  guint32 n_specs = 0;
+  std::string file_name;
+
+  std::unordered_map<std::string, Limits> new_limits;
+  std::vector<std::string> new_records;
+  std::unordered_map<std::string, gsize> new_index;
+
+  if (!reader.ReadBytes(magic, CACHE_MAGIC_SIZE) || magic != CACHE_MAGIC ||
+      !reader.Read(version) || version != GST_PYLON_CACHE_VERSION ||
+      !reader.Read(byte_order) || byte_order != CACHE_BYTE_ORDER ||
+      !reader.Read(schema) || schema != GST_PYLON_FEATURE_WALKER_SCHEMA ||
+      !reader.ReadString(file_name) || !reader.Read(n_limits) ||
+      !reader.Read(n_specs)) {
     return FALSE;
   }
+
+  /* files are found by the hash of their name, a different one means the
+   * file was copied by hand */
+  if (!this->name.empty() && this->name != file_name) {
+    GST_WARNING("Feature cache %s belongs to \"%s\"", this->filepath.c_str(),
+                file_name.c_str());
+    return FALSE;
+  }
+
+  for (guint32 i = 0; i < n_limits; i++) {
+    std::string name;
+    guint8 is_double = 0;
+    Limits entry = {};
+
+    if (!reader.ReadString(name) || !reader.Read(is_double)) {
+      return FALSE;
+    }
+    entry.is_double = is_double;
+    if (is_double) {
+      if (!reader.Read(entry.double_min) || !reader.Read(entry.double_max)) {
+        return FALSE;
+      }
+    } else {
+      if (!reader.Read(entry.int_min) || !reader.Read(entry.int_max)) {
+        return FALSE;
+      }
+    }
+    if (!reader.Read(entry.flags)) {
+      return FALSE;
+    }
+    new_limits[name] = entry;
+  }
+
+  for (guint32 i = 0; i < n_specs; i++) {
+    guint32 length = 0;
+    std::string record;
+    std::string name;
+
+    if (!reader.Read(length) || !reader.ReadBytes(record, length)) {
+      return FALSE;
+    }
+    /* every record starts with the property name */
+    GstPylonCacheReader record_reader(record.data(), record.size());
+    if (!record_reader.ReadString(name)) {
+      return FALSE;
+    }
+    new_index[name] = new_records.size();
+    new_records.push_back(std::move(record));
+  }
+
+  if (!reader.AtEnd()) {
+    return FALSE;
+  }
+
+  this->name = file_name;
+  this->limits = std::move(new_limits);
+  this->spec_records = std::move(new_records);
+  this->spec_index = std::move(new_index);
+
   return TRUE;
 }
 
+std::string GstPylonCache::Serialize() {
+  GstPylonCacheWriter writer;
+
+  writer.data.append(CACHE_MAGIC, CACHE_MAGIC_SIZE);
+  writer.Write<guint32>(GST_PYLON_CACHE_VERSION);
+  writer.Write<guint32>(CACHE_BYTE_ORDER);
+  writer.Write<guint32>(GST_PYLON_FEATURE_WALKER_SCHEMA);
+  writer.WriteString(this->name.c_str());
+  writer.Write<guint32>(this->limits.size());
+  writer.Write<guint32>(this->spec_records.size());
+
+  for (const auto &entry : this->limits) {
+    writer.WriteString(entry.first.c_str());
+    writer.Write<guint8>(entry.second.is_double);
+    if (entry.second.is_double) {
+      writer.Write<gdouble>(entry.second.double_min);
+      writer.Write<gdouble>(entry.second.double_max);
+    } else {
+      writer.Write<gint64>(entry.second.int_min);
+      writer.Write<gint64>(entry.second.int_max);
+    }
+    writer.Write<gint64>(entry.second.flags);
+  }
+
+  for (const auto &record : this->spec_records) {
+    writer.Write<guint32>(record.size());
+    writer.data.append(record);
+  }
+
+  return writer.data;
+}
+
 gboolean GstPylonCache::HasNewSettings() { return is_modified; }
 
 void GstPylonCache::CreateCacheFile() {
   GError *file_err = NULL;
+  std::string contents = Serialize();
 
 #if defined(GLIB_VERSION_2_66) && GLIB_VERSION_MIN_REQUIRED >= GLIB_VERSION_2_66
-  gchar *contents = NULL;
-  gsize length = 0;
-
-  contents = g_key_file_to_data(this->feature_cache_dict, &length, NULL);
-  g_assert(contents != NULL);
-
   gboolean ret = g_file_set_contents_full(
-      this->filepath.c_str(), contents, length,
+      this->filepath.c_str(), contents.data(), contents.size(),
       static_cast<GFileSetContentsFlags>(G_FILE_SET_CONTENTS_CONSISTENT), 0666,
       &file_err);
-
-  g_free(contents);
 #else
-  gboolean ret = g_key_file_save_to_file(this->feature_cache_dict,
-                                         this->filepath.c_str(), &file_err);
+  gboolean ret = g_file_set_contents(this->filepath.c_str(), contents.data(),
+                                     contents.size(), &file_err);
 #endif
 
   if (!ret) {
@@ -126,86 +586,142 @@ void GstPylonCache::CreateCacheFile() {
   }
 }
 
-void GstPylonCache::SetIntegerAttribute(const char *feature,
-                                        const char *attribute,
-                                        const gint64 val) {
-  g_key_file_set_int64(this->feature_cache_dict, feature, attribute, val);
-  is_modified = true;
-}
-
-void GstPylonCache::SetDoubleAttribute(const char *feature,
-                                       const char *attribute,
-                                       const gdouble val) {
-  g_key_file_set_double(this->feature_cache_dict, feature, attribute, val);
-  is_modified = true;
-}
-
-bool GstPylonCache::GetIntegerAttribute(const char *feature,
-                                        const char *attribute, gint64 &val) {
-  GError *err = NULL;
-
-  gint64 value =
-      g_key_file_get_int64(this->feature_cache_dict, feature, attribute, &err);
-  if (err) {
-    GST_WARNING("Could not read values for feature %s from file %s: %s",
-                feature, this->filepath.c_str(), err->message);
-    g_error_free(err);
-    return false;
-  }
-  val = value;
-  return true;
-}
-
-bool GstPylonCache::GetDoubleAttribute(const char *feature,
-                                       const char *attribute, gdouble &val) {
-  GError *err = NULL;
-
-  gdouble value =
-      g_key_file_get_double(this->feature_cache_dict, feature, attribute, &err);
-  if (err) {
-    GST_WARNING("Could not read values for feature %s from file %s: %s",
-                feature, this->filepath.c_str(), err->message);
-    g_error_free(err);
-    return false;
-  }
-  val = value;
-  return true;
-}
-
 void GstPylonCache::SetIntProps(const gchar *feature_name, const gint64 min,
                                 const gint64 max, const GParamFlags flags) {
-  SetIntegerAttribute(feature_name, "min", min);
-  SetIntegerAttribute(feature_name, "max", max);
-  SetIntegerAttribute(feature_name, "flags", static_cast<gint64>(flags));
+  Limits entry = {};
+  entry.is_double = FALSE;
+  entry.int_min = min;
+  entry.int_max = max;
+  entry.flags = static_cast<gint64>(flags);
+  this->limits[feature_name] = entry;
+  is_modified = TRUE;
 }
+
 void GstPylonCache::SetDoubleProps(const gchar *feature_name, const gdouble min,
                                    const gdouble max, const GParamFlags flags) {
-  SetDoubleAttribute(feature_name, "min", min);
-  SetDoubleAttribute(feature_name, "max", max);
-  SetIntegerAttribute(feature_name, "flags", static_cast<gint64>(flags));
+  Limits entry = {};
+  entry.is_double = TRUE;
+  entry.double_min = min;
+  entry.double_max = max;
+  entry.flags = static_cast<gint64>(flags);
+  this->limits[feature_name] = entry;
+  is_modified = TRUE;
 }
 
 bool GstPylonCache::GetIntProps(const gchar *feature_name, gint64 &min,
                                 gint64 &max, GParamFlags &flags) {
-  if (!GetIntegerAttribute(feature_name, "min", min)) return false;
-  if (!GetIntegerAttribute(feature_name, "max", max)) return false;
-  gint64 flag_val = 0;
-  if (!GetIntegerAttribute(feature_name, "flags", flag_val)) return false;
+  auto entry = this->limits.find(feature_name);
+  if (entry == this->limits.end() || entry->second.is_double) {
+    GST_LOG("No cached limits for feature %s", feature_name);
+    return false;
+  }
 
-  flags = static_cast<GParamFlags>(flag_val);
+  min = entry->second.int_min;
+  max = entry->second.int_max;
+  flags = static_cast<GParamFlags>(entry->second.flags);
 
   return true;
 }
 
 bool GstPylonCache::GetDoubleProps(const char *feature_name, gdouble &min,
                                    gdouble &max, GParamFlags &flags) {
-  if (!GetDoubleAttribute(feature_name, "min", min)) return false;
-  if (!GetDoubleAttribute(feature_name, "max", max)) return false;
-
-  gint64 flag_val = 0;
-  if (!GetIntegerAttribute(feature_name, "flags", flag_val)) return false;
+  auto entry = this->limits.find(feature_name);
+  if (entry == this->limits.end() || !entry->second.is_double) {
+    GST_LOG("No cached limits for feature %s", feature_name);
+    return false;
+  }
 
-  flags = static_cast<GParamFlags>(flag_val);
+  min = entry->second.double_min;
+  max = entry->second.double_max;
+  flags = static_cast<GParamFlags>(entry->second.flags);
 
   return true;
 }
+
+void GstPylonCache::SetParamSpec(GParamSpec *pspec) {
+  GstPylonCacheWriter writer;
+
+  g_return_if_fail(pspec);
+
+  writer.WriteString(g_param_spec_get_name(pspec));
+  writer.WriteString(g_param_spec_get_nick(pspec));
+  writer.WriteString(g_param_spec_get_blurb(pspec));
+  writer.Write<guint32>(pspec->flags & ~G_PARAM_STATIC_STRINGS);
+
+  if (G_IS_PARAM_SPEC_INT64(pspec)) {
+    GParamSpecInt64 *spec = G_PARAM_SPEC_INT64(pspec);
+    writer.Write<guint8>(SPEC_TYPE_INT64);
+    writer.Write<gint64>(spec->minimum);
+    writer.Write<gint64>(spec->maximum);
+    writer.Write<gint64>(spec->default_value);
+  } else if (G_IS_PARAM_SPEC_BOOLEAN(pspec)) {
+    writer.Write<guint8>(SPEC_TYPE_BOOLEAN);
+    writer.Write<guint8>(G_PARAM_SPEC_BOOLEAN(pspec)->default_value);
+  } else if (G_IS_PARAM_SPEC_DOUBLE(pspec)) {
+    GParamSpecDouble *spec = G_PARAM_SPEC_DOUBLE(pspec);
+    writer.Write<guint8>(SPEC_TYPE_DOUBLE);
+    writer.Write<gdouble>(spec->minimum);
+    writer.Write<gdouble>(spec->maximum);
+    writer.Write<gdouble>(spec->default_value);
+  } else if (G_IS_PARAM_SPEC_STRING(pspec)) {
+    writer.Write<guint8>(SPEC_TYPE_STRING);
+    writer.WriteString(G_PARAM_SPEC_STRING(pspec)->default_value);
+  } else if (G_IS_PARAM_SPEC_ENUM(pspec)) {
+    GParamSpecEnum *spec = G_PARAM_SPEC_ENUM(pspec);
+    writer.Write<guint8>(SPEC_TYPE_ENUM);
+    writer.WriteString(g_type_name(pspec->value_type));
+    writer.Write<guint32>(spec->enum_class->n_values);
+    for (guint i = 0; i < spec->enum_class->n_values; i++) {
+      writer.Write<gint32>(spec->enum_class->values[i].value);
+      writer.WriteString(spec->enum_class->values[i].value_name);
+      writer.WriteString(spec->enum_class->values[i].value_nick);
+    }
+    writer.Write<gint32>(spec->default_value);
+  } else {
+    GST_DEBUG("Not caching property %s of unsupported type %s", pspec->name,
+              g_type_name(pspec->value_type));
+    return;
+  }
+
+  GstPylonParamSpecSelectorData *selector_data = NULL;
+  if (GST_PYLON_PARAM_FLAG_IS_SET(pspec, GST_PYLON_PARAM_IS_SELECTOR)) {
+    selector_data = gst_pylon_param_spec_selector_get_data(pspec);
+  }
+  writer.Write<guint8>(selector_data != NULL);
+  if (selector_data) {
+    writer.WriteString(selector_data->feature);
+    writer.WriteString(selector_data->selector);
+    writer.Write<gint64>(selector_data->selector_value);
+  }
+
+  auto index = this->spec_index.find(pspec->name);
+  if (index != this->spec_index.end()) {
+    this->spec_records[index->second] = std::move(writer.data);
+  } else {
+    this->spec_index[pspec->name] = this->spec_records.size();
+    this->spec_records.push_back(std::move(writer.data));
+  }
+  is_modified = TRUE;
+}
+
+gboolean GstPylonCache::HasParamSpecs() { return !this->spec_records.empty(); }
+
+std::vector<GParamSpec *> GstPylonCache::GetParamSpecs() {
+  std::vector<GParamSpec *> specs;
+
+  for (const auto &record : this->spec_records) {
+    GParamSpec *spec = gst_pylon_cache_make_spec(record);
+    if (!spec) {
+      GST_WARNING("Corrupted property description in feature cache %s",
+                  this->filepath.c_str());
+      for (const auto &s : specs) {
+        g_param_spec_unref(g_param_spec_ref_sink(s));
+      }
+      specs.clear();
+      break;
+    }
+    specs.push_back(spec);
+  }
+
+  return specs;
+}
@@ -35,8 +35,25 @@
 
 #include <gst/gst.h>
 
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
+/* Bump whenever the binary layout of the cache file changes, files of other
+ * versions are ignored and regenerated. Changes to the properties the
+ * feature walker installs bump GST_PYLON_FEATURE_WALKER_SCHEMA instead. */
+#define GST_PYLON_CACHE_VERSION 3
+
+/**
+ * GstPylonCache:
+ *
+ * Feature cache of a camera model, stored in a versioned binary file in
+ * $XDG_CACHE_HOME/gstpylon. It holds the limits found for each feature and
+ * the complete description of every installed GParamSpec, so that a warm
+ * start installs the properties from the mapped file without walking the
+ * nodemap.
+ */
 class GST_PLUGIN_EXPORT GstPylonCache {
  public:
   GstPylonCache(const std::string &name);
@@ -53,24 +70,68 @@ class GST_PLUGIN_EXPORT GstPylonCache {
   bool GetDoubleProps(const gchar *feature_name, gdouble &min, gdouble &max,
                       GParamFlags &flags);
 
+  /* Record the description of an installed property, replaces an earlier
+   * record of the same name */
+  void SetParamSpec(GParamSpec *pspec);
+  gboolean HasParamSpecs();
+  /* New GParamSpecs for every recorded property, registers enum types that
+   * do not exist yet */
+  std::vector<GParamSpec *> GetParamSpecs();
+
   /* Load from file system */
   gboolean LoadCacheFile();
   /* Persist cache to filesystem */
   void CreateCacheFile();
 
+  /* Open a cache file outside of the cache directory, throws if it is
+   * missing or invalid */
+  static std::unique_ptr<GstPylonCache> FromFile(const std::string &filepath);
+  /* Directory holding the cache files of all models */
+  static std::string GetCacheDir();
+  /* Paths of the cache files in the cache directory, sorted */
+  static std::vector<std::string> ListCacheFiles();
+
+  /* Key the cache was created for, stored in the file */
+  const std::string &GetName();
+  const std::string &GetFilePath();
+  /* Where CreateCacheFile() writes to, defaults to the cache directory */
+  void SetFilePath(const std::string &path);
+  gsize GetLimitsCount();
+  gsize GetParamSpecCount();
+  /* Drop all entries, the next walk describes every property again */
+  void Clear();
+
+  /* Scratch data of the limits search, kept in memory only. Features whose
+   * limits depend on the same invalidators form a group, keyed by the
+   * invalidator names, one search finds the limits of all members. */
+  gboolean HasInvalidatorGroups();
+  void SetInvalidatorGroups(
+      const std::unordered_map<std::string, std::vector<std::string>> &groups);
+  std::vector<std::string> GetInvalidatorGroupMembers(const std::string &group);
+
  private:
-  void SetIntegerAttribute(const char *feature, const char *attribute,
-                           const gint64 val);
-  void SetDoubleAttribute(const char *feature, const char *attribute,
-                          gdouble val);
+  GstPylonCache();
+
+  struct Limits {
+    gboolean is_double;
+    gint64 int_min;
+    gint64 int_max;
+    gdouble double_min;
+    gdouble double_max;
+    gint64 flags;
+  };
 
-  bool GetIntegerAttribute(const char *feature, const char *attribute,
-                           gint64 &val);
-  bool GetDoubleAttribute(const char *feature, const char *attribute,
-                          gdouble &val);
+  gboolean Parse(const gchar *data, gsize size);
+  std::string Serialize();
 
+  std::string name;
   std::string filepath;
-  GKeyFile *feature_cache_dict;
+  std::unordered_map<std::string, Limits> limits;
+  /* serialized GParamSpec records, in installation order */
+  std::vector<std::string> spec_records;
+  std::unordered_map<std::string, gsize> spec_index;
+  std::unordered_map<std::string, std::vector<std::string>> invalidator_groups;
+  gboolean has_invalidator_groups;
   gboolean is_modified;
 };
 
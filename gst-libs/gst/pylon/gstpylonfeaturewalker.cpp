@@ -40,6 +40,7 @@
 
 #include <string.h>
 
+#include <algorithm>
 #include <queue>
 #include <unordered_set>
 
@@ -79,12 +80,8 @@ static const std::unordered_set<std::string> propfilter_set = {
 static const std::unordered_set<std::string> categoryfilter_set = {
     "ChunkData",
     "FileAccessControl", /* has to be implemented in access library */
-    "EventControl",      /* disable full event section until mapped to gst
-                            events/msgs */
     "SequenceControl",   /* sequencer control relies on cmd feature */
     "SequencerControl",  /* sequencer control relies on cmd feature */
-    "MultipleROI",       /* workaround skip to avoid issues with ace2/dart2
-                           FIXME: this has to be fixed in feature walker */
 };
 
 /* filter for selector nodes */
@@ -103,7 +100,8 @@ bool is_unsupported_category(const std::string& category_name) {
   bool res = categoryfilter_set.find(category_name) != categoryfilter_set.end();
 
   if (!res) {
-    /* check on end pattern to cover events */
+    /* event data is only valid inside an event callback, see the events
+     * property of pylonsrc */
     std::string event_suffix = "EventData";
     if (category_name.length() >= event_suffix.length()) {
       res |= 0 == category_name.compare(
@@ -120,6 +118,54 @@ bool is_unsupported_selector(const std::string& feature_name) {
   return selectorfilter_set.find(feature_name) != selectorfilter_set.end();
 }
 
+/* Restores the value an enumeration or integer selector had when it was
+ * created. Selectors that are not readable and writable are left alone. */
+class GstPylonSelectorRestore {
+ public:
+  explicit GstPylonSelectorRestore(GenApi::INode* selector)
+      : selector(selector) {
+    if (!selector || !GenApi::IsReadable(selector) ||
+        !GenApi::IsWritable(selector)) {
+      this->selector = NULL;
+      return;
+    }
+
+    try {
+      if (GenApi::intfIEnumeration == selector->GetPrincipalInterfaceType()) {
+        value = Pylon::CEnumParameter(selector).GetIntValue();
+      } else {
+        value = Pylon::CIntegerParameter(selector).GetValue();
+      }
+    } catch (const Pylon::GenericException&) {
+      this->selector = NULL;
+    }
+  }
+
+  ~GstPylonSelectorRestore() {
+    if (!selector) {
+      return;
+    }
+
+    try {
+      if (GenApi::intfIEnumeration == selector->GetPrincipalInterfaceType()) {
+        Pylon::CEnumParameter(selector).SetIntValue(value);
+      } else {
+        Pylon::CIntegerParameter(selector).TrySetValue(value);
+      }
+    } catch (const Pylon::GenericException& e) {
+      GST_DEBUG("Unable to restore selector %s: %s",
+                selector->GetName().c_str(), e.GetDescription());
+    }
+  }
+
+  GstPylonSelectorRestore(const GstPylonSelectorRestore&) = delete;
+  GstPylonSelectorRestore& operator=(const GstPylonSelectorRestore&) = delete;
+
+ private:
+  GenApi::INode* selector;
+  gint64 value = 0;
+};
+
 std::vector<std::string> gst_pylon_get_enum_entries(
     GenApi::IEnumeration* enum_node) {
   GenApi::NodeList_t enum_entries;
@@ -153,12 +199,15 @@ std::vector<std::string> gst_pylon_get_int_entries(GenApi::IInteger* int_node) {
 
   g_return_val_if_fail(int_node, entry_names);
 
-  for (gint i = int_node->GetMin(); i <= int_node->GetMax();
-       i += int_node->GetInc()) {
-    /* Limit integer based selectors to MAX_INT_SELECTOR_ENTRIES */
-    if (i > MAX_INT_SELECTOR_ENTRIES) {
-      break;
-    }
+  /* The range may depend on other features, read it once. Index selectors
+   * like ROIRowIndex do not necessarily start at 0. */
+  const gint64 min = int_node->GetMin();
+  const gint64 max = int_node->GetMax();
+  const gint64 inc = std::max<gint64>(1, int_node->GetInc());
+
+  /* Limit integer based selectors to MAX_INT_SELECTOR_ENTRIES */
+  for (gint64 i = min;
+       i <= max && entry_names.size() < MAX_INT_SELECTOR_ENTRIES; i += inc) {
     entry_names.push_back(std::to_string(i));
   }
 
@@ -253,17 +302,29 @@ std::vector<GParamSpec*> gst_pylon_camera_handle_node(
     selector_node = NULL;
   }
 
+  /* Building the specs moves the selector through all of its values, put it
+   * back where it was so later writes go to the entry the user expects */
+  GstPylonSelectorRestore restore(selector_node);
+
   for (auto& enum_value : enum_values) {
     try {
       if (NULL != selector_node) {
         switch (selector_node->GetPrincipalInterfaceType()) {
-          case GenApi::intfIEnumeration:
+          case GenApi::intfIEnumeration: {
             param.Attach(selector_node);
-            selector_value =
-                param.GetEntryByName(enum_value.c_str())->GetValue();
+            /* implemented entries may still be unavailable, e.g. the ROI
+             * columns beyond what the sensor mode supports */
+            GenApi::IEnumEntry* entry =
+                param.GetEntryByName(enum_value.c_str());
+            if (!entry || !GenApi::IsAvailable(entry)) {
+              throw Pylon::GenericException("Selector entry is not available",
+                                            __FILE__, __LINE__);
+            }
+            selector_value = entry->GetValue();
             break;
+          }
           case GenApi::intfIInteger:
-            selector_value = std::stoi(enum_value);
+            selector_value = std::stoll(enum_value);
             break;
           default:; /* do nothing */
         }
@@ -313,6 +374,19 @@ void GstPylonFeatureWalker::install_properties(
     single_feature = env_p;
   }
 
+  /* A complete description from an earlier walk installs without touching
+   * the nodemap */
+  if (!single_feature && feature_cache.HasParamSpecs()) {
+    std::vector<GParamSpec*> specs_list = feature_cache.GetParamSpecs();
+    if (!specs_list.empty()) {
+      gint nprop = 1;
+      GST_DEBUG("Install %zu properties of device %s from the feature cache",
+                specs_list.size(), device_fullname.c_str());
+      gst_pylon_camera_install_specs(specs_list, oclass, nprop);
+      return;
+    }
+  }
+
   auto param_factory =
       GstPylonParamFactory(nodemap, device_fullname, feature_cache);
 
@@ -349,6 +423,15 @@ void GstPylonFeatureWalker::install_properties(
           std::vector<GParamSpec*> specs_list =
               gst_pylon_camera_handle_node(node, param_factory);
 
+          /* a partial walk must not pass for a complete description */
+          if (!single_feature) {
+            for (const auto& pspec : specs_list) {
+              if (!g_object_class_find_property(oclass, pspec->name)) {
+                feature_cache.SetParamSpec(pspec);
+              }
+            }
+          }
+
           gst_pylon_camera_install_specs(specs_list, oclass, nprop);
         }
       } catch (const Pylon::GenericException& e) {
@@ -37,6 +37,10 @@
 #include <gst/pylon/gstpyloncache.h>
 #include <gst/pylon/gstpylonincludes.h>
 
+/* Bump whenever the walk installs different properties for the same
+ * nodemap, feature caches written by another schema are regenerated */
+#define GST_PYLON_FEATURE_WALKER_SCHEMA 1
+
 class GstPylonFeatureWalker {
  public:
   static void install_properties(GObjectClass* oclass,
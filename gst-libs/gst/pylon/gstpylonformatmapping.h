@@ -49,13 +49,64 @@ const std::vector<PixelFormatMappingType> pixel_format_mapping_raw = {
     {"BGR8Packed", "BGR"},     {"RGB8", "RGB"},
     {"BGR8", "BGR"},           {"YCbCr422_8", "YUY2"},
     {"YUV422_8_UYVY", "UYVY"}, {"YUV422_8", "YUY2"},
-    {"YUV422Packed", "UYVY"},  {"YUV422_YUYV_Packed", "YUY2"}};
+    {"YUV422Packed", "UYVY"},  {"YUV422_YUYV_Packed", "YUY2"},
+    /* unpacked formats in a little endian 16-bit container, the deepest one
+     * the camera supports is chosen */
+    {"Mono16", "GRAY16_LE"},   {"Mono12", "GRAY16_LE"},
+    {"Mono10", "GRAY16_LE"},
+    /* packed formats, unpacked to 16-bit on the host */
+    {"Mono12p", "GRAY16_LE"},  {"Mono12Packed", "GRAY16_LE"},
+    {"Mono10p", "GRAY16_LE"}};
 
 const std::vector<PixelFormatMappingType> pixel_format_mapping_bayer = {
     {"BayerBG8", "bggr"},
     {"BayerGR8", "grbg"},
     {"BayerRG8", "rggb"},
-    {"BayerGB8", "gbrg"}};
+    {"BayerGB8", "gbrg"},
+    {"BayerBG10", "bggr10le"},
+    {"BayerGR10", "grbg10le"},
+    {"BayerRG10", "rggb10le"},
+    {"BayerGB10", "gbrg10le"},
+    {"BayerBG12", "bggr12le"},
+    {"BayerGR12", "grbg12le"},
+    {"BayerRG12", "rggb12le"},
+    {"BayerGB12", "gbrg12le"},
+    {"BayerBG16", "bggr16le"},
+    {"BayerGR16", "grbg16le"},
+    {"BayerRG16", "rggb16le"},
+    {"BayerGB16", "gbrg16le"},
+    {"BayerBG10p", "bggr10le"},
+    {"BayerGR10p", "grbg10le"},
+    {"BayerRG10p", "rggb10le"},
+    {"BayerGB10p", "gbrg10le"},
+    {"BayerBG12p", "bggr12le"},
+    {"BayerGR12p", "grbg12le"},
+    {"BayerRG12p", "rggb12le"},
+    {"BayerGB12p", "gbrg12le"},
+    {"BayerBG12Packed", "bggr12le"},
+    {"BayerGR12Packed", "grbg12le"},
+    {"BayerRG12Packed", "rggb12le"},
+    {"BayerGB12Packed", "gbrg12le"}};
+
+/* 8-bit Bayer formats demosaiced on the host */
+const std::vector<PixelFormatMappingType> pixel_format_mapping_debayer = {
+    {"BayerBG8", "RGB"},   {"BayerGR8", "RGB"},   {"BayerRG8", "RGB"},
+    {"BayerGB8", "RGB"},   {"BayerBG8", "BGRx"},  {"BayerGR8", "BGRx"},
+    {"BayerRG8", "BGRx"},  {"BayerGB8", "BGRx"},  {"BayerBG8", "GRAY8"},
+    {"BayerGR8", "GRAY8"}, {"BayerRG8", "GRAY8"}, {"BayerGB8", "GRAY8"}};
+
+/* 4:2:2 and RGB formats converted to 4:2:0 on the host, the camera's own
+ * chroma is preferred */
+const std::vector<PixelFormatMappingType> pixel_format_mapping_yuv = {
+    {"YCbCr422_8", "NV12"},         {"YUV422_8", "NV12"},
+    {"YUV422_8_UYVY", "NV12"},      {"YUV422Packed", "NV12"},
+    {"YUV422_YUYV_Packed", "NV12"}, {"RGB8", "NV12"},
+    {"RGB8Packed", "NV12"},         {"BGR8", "NV12"},
+    {"BGR8Packed", "NV12"},         {"YCbCr422_8", "I420"},
+    {"YUV422_8", "I420"},           {"YUV422_8_UYVY", "I420"},
+    {"YUV422Packed", "I420"},       {"YUV422_YUYV_Packed", "I420"},
+    {"RGB8", "I420"},               {"RGB8Packed", "I420"},
+    {"BGR8", "I420"},               {"BGR8Packed", "I420"}};
 
 bool isSupportedPylonFormat(const std::string &format) {
   bool res = false;
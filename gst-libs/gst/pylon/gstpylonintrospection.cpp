@@ -45,7 +45,9 @@
 
 #include <algorithm>
 #include <chrono>
-#include <numeric>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
 #include <set>
 #include <unordered_map>
 #include <vector>
@@ -80,23 +82,19 @@ void gst_pylon_add_all_property_values(
     std::unordered_map<std::string, GenApi::INode *> &invalidators);
 std::vector<GenApi::INode *> gst_pylon_get_available_features(
     const std::set<GenApi::INode *> &feature_list);
-template <class Type>
-std::vector<std::vector<Type>> gst_pylon_cartesian_product(
-    std::vector<std::vector<Type>> &v);
-template <class P, class T>
-T gst_pylon_check_for_feature_invalidators(
-    GenApi::INode *feature_node, GenApi::INode *limit_node, std::string limit,
-    std::unordered_map<std::string, GenApi::INode *> &invalidators);
 template <class P, class T>
 T gst_pylon_query_feature_limits(GenApi::INode *feature_node,
                                  const std::string &limit);
-std::vector<std::vector<GstPylonActions *>> gst_pylon_create_set_value_actions(
-    const std::vector<GenApi::INode *> &node_list);
+std::vector<GstPylonActions *> gst_pylon_create_set_value_actions(
+    GenApi::INode *node);
 template <class P, class T>
-void gst_pylon_find_limits(GenApi::INode *node,
-                           double &minimum_under_all_settings,
-                           double &maximum_under_all_settings,
-                           std::vector<GenApi::INode *> &invalidators_result);
+void gst_pylon_find_limits(GenApi::INode *node, GstPylonCache &feature_cache,
+                           T &minimum_under_all_settings,
+                           T &maximum_under_all_settings);
+template <class T>
+static void gst_pylon_find_static_limits(GenApi::INode *node,
+                                         T &minimum_under_all_settings,
+                                         T &maximum_under_all_settings);
 template <class T>
 std::string gst_pylon_build_cache_value_string(GParamFlags flags,
                                                T minimum_under_all_settings,
@@ -124,8 +122,54 @@ gboolean gst_pylon_can_feature_later_be_writable(GenApi::INode *node) {
   }
 }
 
-GParamFlags gst_pylon_query_access(GenApi::INodeMap &nodemap,
-                                   GenApi::INode *node) {
+static GstPylonLimitsMode gst_pylon_read_limits_mode() {
+  const char *env_p = std::getenv("PYLONSRC_FEATURE_LIMITS");
+
+  if (!env_p || std::string(env_p) == "precise") {
+    return GST_PYLON_LIMITS_PRECISE;
+  } else if (std::string(env_p) == "lazy") {
+    return GST_PYLON_LIMITS_LAZY;
+  } else if (std::string(env_p) == "background") {
+    return GST_PYLON_LIMITS_BACKGROUND;
+  }
+
+  GST_WARNING("Unknown feature limits mode \"%s\", using precise limits",
+              env_p);
+  return GST_PYLON_LIMITS_PRECISE;
+}
+
+GstPylonLimitsMode gst_pylon_query_limits_mode() {
+  static const GstPylonLimitsMode mode = gst_pylon_read_limits_mode();
+
+  return mode;
+}
+
+/* Access flags from the node description only. Writable features are
+ * assumed to be mutable in READY only, instead of probing which of them the
+ * camera keeps writable with TLParamsLocked. */
+static GParamFlags gst_pylon_query_static_access(GenApi::INode *node) {
+  gint flags = 0;
+
+  g_return_val_if_fail(node, static_cast<GParamFlags>(flags));
+
+  Pylon::CParameter param(node);
+  gboolean is_later_writable = gst_pylon_can_feature_later_be_writable(node);
+
+  if (param.IsReadable()) {
+    flags |= G_PARAM_READABLE;
+  }
+  if (param.IsWritable() || is_later_writable) {
+    flags |= G_PARAM_WRITABLE;
+  }
+  if (param.IsWritable()) {
+    flags |= GST_PARAM_MUTABLE_READY;
+  }
+
+  return static_cast<GParamFlags>(flags);
+}
+
+static GParamFlags gst_pylon_query_runtime_access(GenApi::INodeMap &nodemap,
+                                                  GenApi::INode *node) {
   gint flags = 0;
 
   g_return_val_if_fail(node, static_cast<GParamFlags>(flags));
@@ -169,6 +213,15 @@ GParamFlags gst_pylon_query_access(GenApi::INodeMap &nodemap,
   return static_cast<GParamFlags>(flags);
 }
 
+GParamFlags gst_pylon_query_access(GenApi::INodeMap &nodemap,
+                                   GenApi::INode *node) {
+  if (gst_pylon_query_limits_mode() != GST_PYLON_LIMITS_PRECISE) {
+    return gst_pylon_query_static_access(node);
+  }
+
+  return gst_pylon_query_runtime_access(nodemap, node);
+}
+
 GenApi::INode *gst_pylon_find_limit_node(GenApi::INode *node,
                                          const GenICam::gcstring &limit) {
   GenApi::INode *limit_node = NULL;
@@ -305,24 +358,6 @@ static std::vector<GenApi::INode *> gst_pylon_filter_gev_ctrl(
   return valid_features;
 }
 
-template <class Type>
-std::vector<std::vector<Type>> gst_pylon_cartesian_product(
-    std::vector<std::vector<Type>> &values) {
-  std::vector<std::vector<Type>> result;
-  auto product = [](long long a, std::vector<Type> &b) { return a * b.size(); };
-  const long long N = accumulate(values.begin(), values.end(), 1LL, product);
-  std::vector<Type> result_combination(values.size());
-  for (long long n = 0; n < N; ++n) {
-    lldiv_t div_result{n, 0};
-    for (long long i = values.size() - 1; 0 <= i; --i) {
-      div_result = div(div_result.quot, values[i].size());
-      result_combination[i] = values[i][div_result.rem];
-    }
-    result.push_back(result_combination);
-  }
-  return result;
-}
-
 template <class P, class T>
 T gst_pylon_query_feature_limits(GenApi::INode *node,
                                  const std::string &limit) {
@@ -337,95 +372,70 @@ T gst_pylon_query_feature_limits(GenApi::INode *node,
   }
 }
 
-template <class P, class T>
-T gst_pylon_check_for_feature_invalidators(
-    GenApi::INode *node, GenApi::INode *limit_node, std::string limit,
-    std::unordered_map<std::string, GenApi::INode *> &invalidators) {
-  T limit_under_all_settings = 0;
-  GenICam::gcstring value;
-  GenICam::gcstring attribute;
-
-  g_return_val_if_fail(node, 0);
-
-  if (!limit_node ||
-      !limit_node->GetProperty("pInvalidator", value, attribute)) {
-    limit_under_all_settings =
-        gst_pylon_query_feature_limits<P, T>(node, limit);
-  } else {
-    limit_node->GetProperty("pInvalidator", value, attribute);
-    gst_pylon_add_all_property_values(node, std::string(value), invalidators);
-  }
-
-  return limit_under_all_settings;
-}
-
-std::vector<std::vector<GstPylonActions *>> gst_pylon_create_set_value_actions(
-    const std::vector<GenApi::INode *> &node_list) {
-  std::vector<std::vector<GstPylonActions *>> actions_list;
-
-  for (const auto &node : node_list) {
-    std::vector<GstPylonActions *> values;
-    switch (node->GetPrincipalInterfaceType()) {
-      case GenApi::intfIBoolean: {
-        Pylon::CBooleanParameter param(node);
-        values.push_back(
-            new GstPylonTypeAction<Pylon::CBooleanParameter, gboolean>(param,
-                                                                       TRUE));
-        values.push_back(
-            new GstPylonTypeAction<Pylon::CBooleanParameter, gboolean>(param,
-                                                                       FALSE));
-        break;
-      }
-      case GenApi::intfIFloat: {
-        Pylon::CFloatParameter param(node);
-        values.push_back(
-            new GstPylonTypeAction<Pylon::CFloatParameter, gdouble>(
-                param, param.GetMin()));
-        values.push_back(
-            new GstPylonTypeAction<Pylon::CFloatParameter, gdouble>(
-                param, param.GetMax()));
-        break;
-      }
-      case GenApi::intfIInteger: {
-        Pylon::CIntegerParameter param(node);
-        values.push_back(
-            new GstPylonTypeAction<Pylon::CIntegerParameter, gint64>(
-                param, param.GetMin()));
-        values.push_back(
-            new GstPylonTypeAction<Pylon::CIntegerParameter, gint64>(
-                param, param.GetMax()));
-        break;
-      }
-      case GenApi::intfIEnumeration: {
-        Pylon::CEnumParameter param(node);
-        GenApi::StringList_t settable_values;
-        param.GetSettableValues(settable_values);
-        for (const auto &value : settable_values) {
-          /* Skip only check plugin supported formats */
-          if (node->GetName() == "PixelFormat" &&
-              !isSupportedPylonFormat(value.c_str())) {
-            continue;
-          }
-          values.push_back(
-              new GstPylonTypeAction<Pylon::CEnumParameter, Pylon::String_t>(
-                  param, value));
+/* Values an invalidator is set to by the limits search, taken in the current
+ * state of the nodemap. Numeric features only take their extremes, values in
+ * between are assumed not to widen the limits of the features they control. */
+std::vector<GstPylonActions *> gst_pylon_create_set_value_actions(
+    GenApi::INode *node) {
+  std::vector<GstPylonActions *> values;
+
+  switch (node->GetPrincipalInterfaceType()) {
+    case GenApi::intfIBoolean: {
+      Pylon::CBooleanParameter param(node);
+      values.push_back(
+          new GstPylonTypeAction<Pylon::CBooleanParameter, gboolean>(param,
+                                                                     TRUE));
+      values.push_back(
+          new GstPylonTypeAction<Pylon::CBooleanParameter, gboolean>(param,
+                                                                     FALSE));
+      break;
+    }
+    case GenApi::intfIFloat: {
+      Pylon::CFloatParameter param(node);
+      values.push_back(new GstPylonTypeAction<Pylon::CFloatParameter, gdouble>(
+          param, param.GetMin()));
+      values.push_back(new GstPylonTypeAction<Pylon::CFloatParameter, gdouble>(
+          param, param.GetMax()));
+      break;
+    }
+    case GenApi::intfIInteger: {
+      Pylon::CIntegerParameter param(node);
+      values.push_back(
+          new GstPylonTypeAction<Pylon::CIntegerParameter, gint64>(
+              param, param.GetMin()));
+      values.push_back(
+          new GstPylonTypeAction<Pylon::CIntegerParameter, gint64>(
+              param, param.GetMax()));
+      break;
+    }
+    case GenApi::intfIEnumeration: {
+      Pylon::CEnumParameter param(node);
+      GenApi::StringList_t settable_values;
+      param.GetSettableValues(settable_values);
+      for (const auto &value : settable_values) {
+        /* Skip only check plugin supported formats */
+        if (node->GetName() == "PixelFormat" &&
+            !isSupportedPylonFormat(value.c_str())) {
+          continue;
         }
-        break;
-      }
-      case GenApi::intfICommand: {
-        /* command node feature modification is ignored */
-        continue;
+        values.push_back(
+            new GstPylonTypeAction<Pylon::CEnumParameter, Pylon::String_t>(
+                param, value));
       }
-      default:
-        std::string msg =
-            "No test for node " + std::string(node->GetName().c_str());
-        GST_DEBUG("%s", msg.c_str());
-        continue;
+      break;
+    }
+    case GenApi::intfICommand: {
+      /* command node feature modification is ignored */
+      break;
     }
-    actions_list.push_back(values);
+    default:
+      std::string msg =
+          "No test for node " + std::string(node->GetName().c_str());
+      GST_DEBUG("%s", msg.c_str());
+      break;
   }
 
-  return actions_list;
+  return values;
 }
 
 std::vector<GstPylonActions *> gst_pylon_create_reset_value_actions(
@@ -501,37 +511,159 @@ class TimeLogger {
   std::vector<std::string> info_list;
 };
 
-template <class P, class T>
-void gst_pylon_find_limits(GenApi::INode *node, T &minimum_under_all_settings,
-                           T &maximum_under_all_settings) {
-  std::unordered_map<std::string, GenApi::INode *> invalidators;
-  maximum_under_all_settings = 0;
+static void gst_pylon_reset_values(
+    const std::vector<GstPylonActions *> &reset_list) {
+  for (const auto &action : reset_list) {
+    try {
+      action->set_value();
+    } catch (const Pylon::GenericException &) {
+      GST_DEBUG("failed to reset value");
+    }
+    delete action;
+  }
+}
+
+/* Time a single limits search may take, in milliseconds */
+static constexpr gint64 DEFAULT_LIMITS_BUDGET_MS = 1000;
+
+static gint64 gst_pylon_read_limits_budget() {
+  const char *env_p = std::getenv("PYLONSRC_LIMITS_BUDGET_MS");
+
+  if (!env_p) {
+    return DEFAULT_LIMITS_BUDGET_MS;
+  }
+
+  gchar *end = NULL;
+  gint64 budget = g_ascii_strtoll(env_p, &end, 10);
+  if (end == env_p || *end != '\0' || budget < 0) {
+    GST_WARNING("Invalid feature limits budget \"%s\", using %" G_GINT64_FORMAT
+                " ms",
+                env_p, DEFAULT_LIMITS_BUDGET_MS);
+    return DEFAULT_LIMITS_BUDGET_MS;
+  }
+
+  return budget;
+}
+
+/* 0 lets every search run to completion */
+static gint64 gst_pylon_query_limits_budget() {
+  static const gint64 budget = gst_pylon_read_limits_budget();
+
+  return budget;
+}
+
+/* Limits used when the search of these features runs out of its budget,
+ * their invalidators span too many settings on some camera families */
+struct GstPylonKnownLimits {
+  const gchar *feature;
+  gdouble minimum;
+  gdouble maximum;
+};
+
+static const GstPylonKnownLimits known_limits[] = {
+    {"ExposureTime", 1.0, 1e+07},
+    {"BlackLevel", 0, 4095},
+    {"AcquisitionBurstFrameCount", 1, 1023},
+    {"BslColorAdjustmentHue", -1, 1},
+    {"BslColorAdjustmentSaturation", 0, 2},
+    {"GevSCBWR", 0, 100},
+    {"GevSCBWRA", 1, 512},
+    {"GevSCPD", 0, 50000000},
+    {"GevSCFTD", 0, 50000000},
+};
+
+template <class T>
+static gboolean gst_pylon_find_known_limits(GenApi::INode *node,
+                                            T &minimum_under_all_settings,
+                                            T &maximum_under_all_settings) {
+  for (const auto &known : known_limits) {
+    if (node->GetName() == known.feature) {
+      GST_DEBUG("Apply %s feature workaround", known.feature);
+      minimum_under_all_settings = static_cast<T>(known.minimum);
+      maximum_under_all_settings = static_cast<T>(known.maximum);
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+/* Limits of the geometry features follow from the sensor size, which is
+ * cheaper and as precise as searching them */
+template <class T>
+static gboolean gst_pylon_find_derived_limits(GenApi::INode *node,
+                                              T &minimum_under_all_settings,
+                                              T &maximum_under_all_settings) {
+  GenApi::INodeMap *nodemap = node->GetNodeMap();
+  const GenICam::gcstring &name = node->GetName();
+  const gchar *sensor_size = NULL;
+  const gchar *size = NULL;
+
+  if (name == "OffsetX" || name == "AutoFunctionROIOffsetX" ||
+      name == "AutoFunctionAOIOffsetX") {
+    sensor_size = "SensorWidth";
+    size = "Width";
+  } else if (name == "OffsetY" || name == "AutoFunctionROIOffsetY" ||
+             name == "AutoFunctionAOIOffsetY") {
+    sensor_size = "SensorHeight";
+    size = "Height";
+  } else if (name == "AutoFunctionROIWidth" ||
+             name == "AutoFunctionAOIWidth") {
+    sensor_size = "SensorWidth";
+  } else if (name == "AutoFunctionROIHeight" ||
+             name == "AutoFunctionAOIHeight") {
+    sensor_size = "SensorHeight";
+  } else {
+    return FALSE;
+  }
+
+  Pylon::CIntegerParameter sensor(nodemap->GetNode(sensor_size));
+  if (!sensor.IsValid()) {
+    return FALSE;
+  }
+
   minimum_under_all_settings = 0;
-  g_return_if_fail(node);
+  if (!size) {
+    GST_DEBUG("Apply %s feature workaround", name.c_str());
+    maximum_under_all_settings = sensor.GetValue();
+    return TRUE;
+  }
 
-  auto tl = TimeLogger(node->GetName().c_str());
+  /* the offset is largest at the smallest size */
+  Pylon::CIntegerParameter roi_size(nodemap->GetNode(size));
+  if (!roi_size.IsValid()) {
+    return FALSE;
+  }
 
-  /* Find the maximum value of a feature under the influence of other elements
-   * of the nodemap */
-  GenApi::INode *pmax_node = gst_pylon_find_limit_node(node, "pMax");
-  maximum_under_all_settings = gst_pylon_check_for_feature_invalidators<P, T>(
-      node, pmax_node, "max", invalidators);
+  GST_DEBUG("Apply %s feature workaround", name.c_str());
+  maximum_under_all_settings = sensor.GetValue() - roi_size.GetInc();
+  return TRUE;
+}
 
-  /* Find the minimum value of a feature under the influence of other elements
-   * of the nodemap */
-  GenApi::INode *pmin_node = gst_pylon_find_limit_node(node, "pMin");
-  minimum_under_all_settings = gst_pylon_check_for_feature_invalidators<P, T>(
-      node, pmin_node, "min", invalidators);
+/* Features whose settings change the limits of a node, sorted by name so
+ * every search visits them in the same order */
+static std::vector<GenApi::INode *> gst_pylon_find_invalidator_features(
+    GenApi::INode *node) {
+  std::unordered_map<std::string, GenApi::INode *> invalidators;
+  GenICam::gcstring value;
+  GenICam::gcstring attribute;
 
-  /* Return if no invalidator nodes found */
-  if (invalidators.empty()) {
-    return;
+  for (const auto &limit : {"pMax", "pMin"}) {
+    GenApi::INode *limit_node = gst_pylon_find_limit_node(node, limit);
+    if (limit_node &&
+        limit_node->GetProperty("pInvalidator", value, attribute)) {
+      gst_pylon_add_all_property_values(node, std::string(value),
+                                        invalidators);
+    }
   }
 
   /* Find all features that control the node and
    * store results in a set to remove duplicates*/
   std::set<GenApi::INode *> parent_invalidators;
   for (const auto &inv : invalidators) {
+    if (!inv.second) {
+      continue;
+    }
     std::vector<GenApi::INode *> parent_features =
         gst_pylon_find_parent_features(inv.second);
     for (const auto &p_feat : parent_features) {
@@ -540,200 +672,465 @@ void gst_pylon_find_limits(GenApi::INode *node, T &minimum_under_all_settings,
   }
 
   /* Filter parent invalidators to only available ones */
-  std::vector<GenApi::INode *> available_parent_inv =
+  std::vector<GenApi::INode *> features =
       gst_pylon_get_available_features(parent_invalidators);
 
-  /* workarounds for ace2/dart2/boost features high
-   * dependency count
-   * FIXME: refactor this into a filter class
-   */
-  if (node->GetName() == "ExposureTime") {
-    GST_DEBUG("Apply ExposureTime feature workaround");
-    minimum_under_all_settings = 1.0;
-    maximum_under_all_settings = 1e+07;
-    return;
-  } else if (node->GetName() == "BlackLevel") {
-    GST_DEBUG("Apply BlackLevel 12bit feature workaround");
-    minimum_under_all_settings = 0;
-    maximum_under_all_settings = 4095;
-    return;
-  } else if (node->GetName() == "OffsetX") {
-    GST_DEBUG("Apply OffsetX feature workaround");
-    Pylon::CIntegerParameter sensor_width(
-        node->GetNodeMap()->GetNode("SensorWidth"));
-    Pylon::CIntegerParameter width(node->GetNodeMap()->GetNode("Width"));
-    /* try to shortcut if sensor width is available */
-    if (sensor_width.IsValid() && width.IsValid()) {
-      minimum_under_all_settings = 0;
-      maximum_under_all_settings = sensor_width.GetValue() - width.GetInc();
-      return;
+  /* remove any feature from the list that belongs to an unsupported
+   * category */
+  features = gst_pylon_get_valid_categories(features);
+
+  /* workaround for camera features that have an irrelevant dependency on
+   * the gige setup parameters */
+  features = gst_pylon_filter_gev_ctrl(features);
+
+  std::sort(features.begin(), features.end(),
+            [](GenApi::INode *a, GenApi::INode *b) {
+              return a->GetName() < b->GetName();
+            });
+
+  return features;
+}
+
+static std::string gst_pylon_build_invalidator_group(
+    const std::vector<GenApi::INode *> &invalidators) {
+  std::string group;
+
+  for (const auto &invalidator : invalidators) {
+    group += std::string(invalidator->GetName().c_str()) + "\t";
+  }
+
+  return group;
+}
+
+/* Only features cached under their plain name can take limits found for
+ * another feature, selected ones are cached per selector value */
+static gboolean gst_pylon_is_limits_group_candidate(GenApi::INode *node) {
+  if (!node->IsFeature() || !GenApi::IsImplemented(node)) {
+    return FALSE;
+  }
+
+  GenApi::EInterfaceType type = node->GetPrincipalInterfaceType();
+  if (type != GenApi::intfIInteger && type != GenApi::intfIFloat) {
+    return FALSE;
+  }
+
+  GenApi::FeatureList_t selectors;
+  auto selected = dynamic_cast<GenApi::ISelector *>(node);
+  if (selected) {
+    selected->GetSelectingFeatures(selectors);
+  }
+
+  return selectors.empty();
+}
+
+/* Other features without cached limits whose limits depend on the same
+ * invalidators as the node. The groups of a nodemap are built once per
+ * feature cache. */
+static std::vector<GenApi::INode *> gst_pylon_find_limits_group(
+    GenApi::INode *node, const std::string &group,
+    GstPylonCache &feature_cache) {
+  std::vector<GenApi::INode *> members;
+  GenApi::INodeMap *nodemap = node->GetNodeMap();
+
+  if (!feature_cache.HasInvalidatorGroups()) {
+    std::unordered_map<std::string, std::vector<std::string>> groups;
+    GenApi::NodeList_t nodes;
+
+    nodemap->GetNodes(nodes);
+    for (const auto &candidate : nodes) {
+      try {
+        if (!gst_pylon_is_limits_group_candidate(candidate)) {
+          continue;
+        }
+        std::vector<GenApi::INode *> invalidators =
+            gst_pylon_find_invalidator_features(candidate);
+        if (!invalidators.empty()) {
+          groups[gst_pylon_build_invalidator_group(invalidators)].push_back(
+              candidate->GetName().c_str());
+        }
+      } catch (const GenICam::GenericException &) {
+        continue;
+      }
     }
-  } else if (node->GetName() == "OffsetY") {
-    GST_DEBUG("Apply OffsetY feature workaround");
-    Pylon::CIntegerParameter sensor_height(
-        node->GetNodeMap()->GetNode("SensorHeight"));
-    Pylon::CIntegerParameter height(node->GetNodeMap()->GetNode("Height"));
-    /* try to shortcut if sensor height is available */
-    if (sensor_height.IsValid() && height.IsValid()) {
-      minimum_under_all_settings = 0;
-      maximum_under_all_settings = sensor_height.GetValue() - height.GetInc();
-      return;
+
+    feature_cache.SetInvalidatorGroups(groups);
+  }
+
+  for (const auto &name : feature_cache.GetInvalidatorGroupMembers(group)) {
+    gint64 int_limit = 0;
+    gdouble double_limit = 0;
+    GParamFlags flags = static_cast<GParamFlags>(0);
+
+    if (name == node->GetName().c_str() ||
+        feature_cache.GetIntProps(name.c_str(), int_limit, int_limit, flags) ||
+        feature_cache.GetDoubleProps(name.c_str(), double_limit, double_limit,
+                                     flags)) {
+      continue;
     }
-  } else if (node->GetName() == "AutoFunctionROIOffsetX" ||
-             node->GetName() == "AutoFunctionAOIOffsetX") {
-    GST_DEBUG("Apply AutoFunctionROIOffsetX feature workaround");
-    Pylon::CIntegerParameter sensor_width(
-        node->GetNodeMap()->GetNode("SensorWidth"));
-    Pylon::CIntegerParameter width(node->GetNodeMap()->GetNode("Width"));
-    /* try to shortcut if sensor width is available */
-    if (sensor_width.IsValid() && width.IsValid()) {
-      minimum_under_all_settings = 0;
-      maximum_under_all_settings = sensor_width.GetValue() - width.GetInc();
-      return;
+
+    GenApi::INode *member = nodemap->GetNode(name.c_str());
+    if (member) {
+      members.push_back(member);
     }
-  } else if (node->GetName() == "AutoFunctionROIOffsetY" ||
-             node->GetName() == "AutoFunctionAOIOffsetY") {
-    GST_DEBUG("Apply AutoFunctionROIOffsetY feature workaround");
-    Pylon::CIntegerParameter sensor_height(
-        node->GetNodeMap()->GetNode("SensorHeight"));
-    Pylon::CIntegerParameter height(node->GetNodeMap()->GetNode("Height"));
-    /* try to shortcut if sensor height is available */
-    if (sensor_height.IsValid() && height.IsValid()) {
-      minimum_under_all_settings = 0;
-      maximum_under_all_settings = sensor_height.GetValue() - height.GetInc();
-      return;
+  }
+
+  return members;
+}
+
+/* Limits of a feature sharing the invalidators of the searched one */
+struct GstPylonGroupLimits {
+  GenApi::INode *node;
+  gboolean is_double;
+  gboolean is_valid;
+  gboolean has_limits;
+  gint64 int_min;
+  gint64 int_max;
+  gdouble double_min;
+  gdouble double_max;
+};
+
+/* Depth first search over the settings of the invalidators of a feature.
+ * Each invalidator only takes the values it accepts in the state left by the
+ * ones before it, so unreachable combinations are never tried. Branches
+ * leading to an already visited state are pruned and the search gives up
+ * once its time budget is spent. The limits of the features in the same
+ * invalidator group are collected on the way. */
+template <class P, class T>
+class GstPylonLimitsSearch {
+ public:
+  GstPylonLimitsSearch(GenApi::INode *node,
+                       const std::vector<GenApi::INode *> &invalidators,
+                       const std::vector<GenApi::INode *> &group,
+                       gint64 budget_ms)
+      : node(node),
+        invalidators(invalidators),
+        visited(invalidators.size()),
+        budget_ms(budget_ms) {
+    for (const auto &member : group) {
+      GstPylonGroupLimits limits = {};
+      limits.node = member;
+      limits.is_double =
+          member->GetPrincipalInterfaceType() == GenApi::intfIFloat;
+      limits.is_valid = TRUE;
+      this->group.push_back(limits);
     }
-  } else if (node->GetName() == "AutoFunctionROIWidth" ||
-             node->GetName() == "AutoFunctionAOIWidth") {
-    GST_DEBUG("Apply AutoFunctionROIWidth feature workaround");
-    Pylon::CIntegerParameter sensor_width(
-        node->GetNodeMap()->GetNode("SensorWidth"));
-    /* try to shortcut if sensor width is available */
-    if (sensor_width.IsValid()) {
-      minimum_under_all_settings = 0;
-      maximum_under_all_settings = sensor_width.GetValue();
+  }
+
+  /* FALSE if the budget ran out before all states were visited */
+  gboolean Run() {
+    this->deadline = g_get_monotonic_time() + this->budget_ms * 1000;
+    this->exhausted = FALSE;
+    this->n_states = 0;
+
+    Visit(0);
+
+    return !this->exhausted;
+  }
+
+  gboolean HasLimits() { return this->has_limits; }
+  T GetMin() { return this->minimum; }
+  T GetMax() { return this->maximum; }
+  guint GetStateCount() { return this->n_states; }
+  const std::vector<GstPylonGroupLimits> &GetGroupLimits() {
+    return this->group;
+  }
+
+ private:
+  void Visit(gsize level) {
+    if (this->budget_ms > 0 && g_get_monotonic_time() > this->deadline) {
+      this->exhausted = TRUE;
       return;
     }
-  } else if (node->GetName() == "AutoFunctionROIHeight" ||
-             node->GetName() == "AutoFunctionAOIHeight") {
-    GST_DEBUG("Apply AutoFunctionROIHeight feature workaround");
-    Pylon::CIntegerParameter sensor_height(
-        node->GetNodeMap()->GetNode("SensorHeight"));
-    /* try to shortcut if sensor height is available */
-    if (sensor_height.IsValid()) {
-      minimum_under_all_settings = 0;
-      maximum_under_all_settings = sensor_height.GetValue();
+
+    if (level == this->invalidators.size()) {
+      Evaluate();
       return;
     }
-  } else if (node->GetName() == "AcquisitionBurstFrameCount") {
-    minimum_under_all_settings = 1;
-    maximum_under_all_settings = 1023;
-    GST_DEBUG("Apply AcquisitionBurstFrameCount feature workaround");
-    return;
-  } else if (node->GetName() == "BslColorAdjustmentHue") {
-    minimum_under_all_settings = -1;
-    maximum_under_all_settings = 1;
-    GST_DEBUG("Apply BslColorAdjustmentHue feature workaround");
-    return;
-  } else if (node->GetName() == "BslColorAdjustmentSaturation") {
-    minimum_under_all_settings = 0;
-    maximum_under_all_settings = 2;
-    GST_DEBUG("Apply BslColorAdjustmentSaturation feature workaround");
-    return;
-  } else if (node->GetName() == "GevSCBWR") {
-    minimum_under_all_settings = 0;
-    maximum_under_all_settings = 100;
-    GST_DEBUG("Apply GevSCBWR feature workaround");
-    return;
-  } else if (node->GetName() == "GevSCBWRA") {
-    minimum_under_all_settings = 1;
-    maximum_under_all_settings = 512;
-    GST_DEBUG("Apply GevSCBWRA feature workaround");
-    return;
-  } else if (node->GetName() == "GevSCPD") {
-    minimum_under_all_settings = 0;
-    maximum_under_all_settings = 50000000;
-    GST_DEBUG("Apply GevSCPD feature workaround");
-    return;
-  } else if (node->GetName() == "GevSCFTD") {
-    minimum_under_all_settings = 0;
-    maximum_under_all_settings = 50000000;
-    GST_DEBUG("Apply GevSCFTD feature workaround");
-    return;
-  };
-
-  /* remove any feature from the list that belongs to an unsupported
-   * category */
-  available_parent_inv = gst_pylon_get_valid_categories(available_parent_inv);
 
-  /* workaround for camera features that have an irrelevant dependency on
-   * the gige setup parameters */
-  available_parent_inv = gst_pylon_filter_gev_ctrl(available_parent_inv);
-
-  for (auto &node : available_parent_inv) {
-    tl.add_info(node->GetName().c_str());
-  }
+    std::vector<GstPylonActions *> actions;
+    try {
+      actions = gst_pylon_create_set_value_actions(this->invalidators[level]);
+    } catch (const GenICam::GenericException &) {
+      GST_DEBUG("No values to try for %s",
+                this->invalidators[level]->GetName().c_str());
+    }
 
-  /* Save current set of values */
-  std::vector<GstPylonActions *> reset_list =
-      gst_pylon_create_reset_value_actions(available_parent_inv);
-
-  /* Create list of extreme value settings per invalidator */
-  std::vector<std::vector<GstPylonActions *>> actions_list =
-      gst_pylon_create_set_value_actions(available_parent_inv);
-
-  /* try to get support for optimized bulk feature settings */
-  auto reg_streaming_start = Pylon::CCommandParameter(
-      node->GetNodeMap()->GetNode("DeviceRegistersStreamingStart"));
-  auto reg_streaming_end = Pylon::CCommandParameter(
-      node->GetNodeMap()->GetNode("DeviceRegistersStreamingEnd"));
-
-  /* Create list of all possible setting permutations and execute them all */
-  auto action_list_permutations = gst_pylon_cartesian_product(actions_list);
-  std::vector<T> min_values;
-  std::vector<T> max_values;
-  for (const auto &actions : action_list_permutations) {
-    reg_streaming_start.TryExecute();
+    gboolean descended = FALSE;
     for (const auto &action : actions) {
+      if (this->exhausted) {
+        break;
+      }
+
       /* Some states might not be valid, so just skip them */
       try {
         action->set_value();
-      } catch (const GenICam::GenericException &e) {
+      } catch (const GenICam::GenericException &) {
         GST_DEBUG("failed to set action");
         continue;
       }
+
+      descended = TRUE;
+      if (this->visited[level].insert(GetState(level)).second) {
+        Visit(level + 1);
+      }
     }
 
-    reg_streaming_end.TryExecute();
+    for (const auto &action : actions) {
+      delete action;
+    }
+
+    /* a read-only or locked invalidator keeps its current value */
+    if (!descended && !this->exhausted &&
+        this->visited[level].insert(GetState(level)).second) {
+      Visit(level + 1);
+    }
+  }
+
+  /* Values of the invalidators up to level, as the device took them */
+  std::string GetState(gsize level) {
+    std::string state;
+
+    for (gsize i = 0; i <= level; i++) {
+      Pylon::CParameter param(this->invalidators[i]);
+      state += std::string(param.ToStringOrDefault("").c_str()) + "\t";
+    }
+
+    return state;
+  }
+
+  void Evaluate() {
+    this->n_states++;
 
     /* Capture min and max values after all setting are applied*/
-    min_values.push_back(gst_pylon_query_feature_limits<P, T>(node, "min"));
-    max_values.push_back(gst_pylon_query_feature_limits<P, T>(node, "max"));
+    try {
+      T state_min = gst_pylon_query_feature_limits<P, T>(this->node, "min");
+      T state_max = gst_pylon_query_feature_limits<P, T>(this->node, "max");
+
+      this->minimum =
+          this->has_limits ? std::min(this->minimum, state_min) : state_min;
+      this->maximum =
+          this->has_limits ? std::max(this->maximum, state_max) : state_max;
+      this->has_limits = TRUE;
+    } catch (const GenICam::GenericException &) {
+      GST_DEBUG("Limits of %s not readable in this state",
+                this->node->GetName().c_str());
+    }
+
+    for (auto &member : this->group) {
+      if (!member.is_valid) {
+        continue;
+      }
+
+      /* a member missing one state has no limits under all settings */
+      try {
+        if (member.is_double) {
+          Pylon::CFloatParameter param(member.node);
+          gdouble state_min = param.GetMin();
+          gdouble state_max = param.GetMax();
+          member.double_min = member.has_limits
+                                  ? std::min(member.double_min, state_min)
+                                  : state_min;
+          member.double_max = member.has_limits
+                                  ? std::max(member.double_max, state_max)
+                                  : state_max;
+        } else {
+          Pylon::CIntegerParameter param(member.node);
+          gint64 state_min = param.GetMin();
+          gint64 state_max = param.GetMax();
+          member.int_min =
+              member.has_limits ? std::min(member.int_min, state_min)
+                                : state_min;
+          member.int_max =
+              member.has_limits ? std::max(member.int_max, state_max)
+                                : state_max;
+        }
+        member.has_limits = TRUE;
+      } catch (const GenICam::GenericException &) {
+        member.is_valid = FALSE;
+      }
+    }
   }
 
-  /* Get the max and min values under all settings executed*/
-  minimum_under_all_settings =
-      *std::min_element(min_values.begin(), min_values.end());
-  maximum_under_all_settings =
-      *std::max_element(max_values.begin(), max_values.end());
+  GenApi::INode *node;
+  std::vector<GenApi::INode *> invalidators;
+  std::vector<GstPylonGroupLimits> group;
+  /* states reached per level, a prefix of the invalidator values */
+  std::vector<std::set<std::string>> visited;
+  gint64 budget_ms;
+  gint64 deadline = 0;
+  gboolean exhausted = FALSE;
+  guint n_states = 0;
+  gboolean has_limits = FALSE;
+  T minimum = 0;
+  T maximum = 0;
+};
 
-  /* Reset to old values */
-  for (const auto &action : reset_list) {
+/* Store the limits the search found for the other members of the group */
+static void gst_pylon_save_group_limits(
+    GenApi::INodeMap &nodemap, const std::vector<GstPylonGroupLimits> &group,
+    GstPylonCache &feature_cache) {
+  for (const auto &member : group) {
+    if (!member.is_valid || !member.has_limits) {
+      continue;
+    }
+
+    std::string name = member.node->GetName().c_str();
+    GParamFlags flags = static_cast<GParamFlags>(0);
     try {
-      action->set_value();
-    } catch (const Pylon::GenericException &) {
+      flags = gst_pylon_query_runtime_access(nodemap, member.node);
+    } catch (const GenICam::GenericException &) {
       continue;
     }
+
+    GST_DEBUG("Limits of %s found by the same search", name.c_str());
+    if (member.is_double) {
+      feature_cache.SetDoubleProps(name.c_str(), member.double_min,
+                                   member.double_max, flags);
+    } else {
+      feature_cache.SetIntProps(name.c_str(), member.int_min, member.int_max,
+                                flags);
+    }
   }
+}
 
-  /* Clean up */
-  for (const auto &actions : actions_list) {
-    for (const auto &action : actions) {
-      delete action;
+template <class P, class T>
+void gst_pylon_find_limits(GenApi::INode *node, GstPylonCache &feature_cache,
+                           T &minimum_under_all_settings,
+                           T &maximum_under_all_settings) {
+  maximum_under_all_settings = 0;
+  minimum_under_all_settings = 0;
+  g_return_if_fail(node);
+
+  auto tl = TimeLogger(node->GetName().c_str());
+
+  std::vector<GenApi::INode *> invalidators =
+      gst_pylon_find_invalidator_features(node);
+
+  /* Return if no invalidator nodes found */
+  if (invalidators.empty()) {
+    minimum_under_all_settings =
+        gst_pylon_query_feature_limits<P, T>(node, "min");
+    maximum_under_all_settings =
+        gst_pylon_query_feature_limits<P, T>(node, "max");
+    return;
+  }
+
+  if (gst_pylon_find_derived_limits<T>(node, minimum_under_all_settings,
+                                       maximum_under_all_settings)) {
+    return;
+  }
+
+  for (auto &invalidator : invalidators) {
+    tl.add_info(invalidator->GetName().c_str());
+  }
+
+  std::string group = gst_pylon_build_invalidator_group(invalidators);
+  GstPylonLimitsSearch<P, T> search(
+      node, invalidators,
+      gst_pylon_find_limits_group(node, group, feature_cache),
+      gst_pylon_query_limits_budget());
+
+  /* Save current set of values */
+  std::vector<GstPylonActions *> reset_list =
+      gst_pylon_create_reset_value_actions(invalidators);
+
+  gboolean completed = FALSE;
+  try {
+    completed = search.Run();
+  } catch (const GenICam::GenericException &) {
+    gst_pylon_reset_values(reset_list);
+    throw;
+  }
+
+  /* Reset to old values */
+  gst_pylon_reset_values(reset_list);
+
+  tl.add_info(std::to_string(search.GetStateCount()) + " states");
+
+  if (completed && search.HasLimits()) {
+    minimum_under_all_settings = search.GetMin();
+    maximum_under_all_settings = search.GetMax();
+    gst_pylon_save_group_limits(*node->GetNodeMap(), search.GetGroupLimits(),
+                                feature_cache);
+    return;
+  }
+
+  GST_DEBUG("Limits search of %s stopped after %u states",
+            node->GetName().c_str(), search.GetStateCount());
+
+  if (gst_pylon_find_known_limits<T>(node, minimum_under_all_settings,
+                                     maximum_under_all_settings)) {
+    return;
+  }
+
+  /* never narrower than what the partial search has seen */
+  gst_pylon_find_static_limits<T>(node, minimum_under_all_settings,
+                                  maximum_under_all_settings);
+  if (search.HasLimits()) {
+    minimum_under_all_settings =
+        std::min(minimum_under_all_settings, search.GetMin());
+    maximum_under_all_settings =
+        std::max(maximum_under_all_settings, search.GetMax());
+  }
+}
+
+static void gst_pylon_parse_static_limit(const GenICam::gcstring &str,
+                                         gint64 &value) {
+  gchar *end = NULL;
+  gint64 parsed = g_ascii_strtoll(str.c_str(), &end, 0);
+
+  if (end != str.c_str()) {
+    value = parsed;
+  }
+}
+
+static void gst_pylon_parse_static_limit(const GenICam::gcstring &str,
+                                         gdouble &value) {
+  gchar *end = NULL;
+  gdouble parsed = g_ascii_strtod(str.c_str(), &end);
+
+  if (end != str.c_str() && std::isfinite(parsed)) {
+    value = parsed;
+  }
+}
+
+/* Read a constant Min or Max element of the node description, following
+ * pValue to the node holding the value. Limits computed by other nodes are
+ * left untouched. */
+template <class T>
+static void gst_pylon_find_static_limit(GenApi::INode *node,
+                                        const GenICam::gcstring &limit,
+                                        T &value) {
+  GenICam::gcstring property;
+  GenICam::gcstring attribute;
+
+  g_return_if_fail(node);
+
+  if (node->GetProperty(limit, property, attribute)) {
+    gst_pylon_parse_static_limit(property, value);
+  } else if (node->GetProperty("pValue", property, attribute)) {
+    GenApi::INode *value_node = node->GetNodeMap()->GetNode(property);
+    if (value_node) {
+      gst_pylon_find_static_limit<T>(value_node, limit, value);
     }
   }
-  for (const auto &action : reset_list) {
-    delete action;
+}
+
+/* Widest limits known without touching the device: the constants of the node
+ * description or the range of the type */
+template <class T>
+static void gst_pylon_find_static_limits(GenApi::INode *node,
+                                         T &minimum_under_all_settings,
+                                         T &maximum_under_all_settings) {
+  minimum_under_all_settings = std::numeric_limits<T>::lowest();
+  maximum_under_all_settings = std::numeric_limits<T>::max();
+
+  gst_pylon_find_static_limit<T>(node, "Min", minimum_under_all_settings);
+  gst_pylon_find_static_limit<T>(node, "Max", maximum_under_all_settings);
+
+  if (minimum_under_all_settings > maximum_under_all_settings) {
+    minimum_under_all_settings = std::numeric_limits<T>::lowest();
+    maximum_under_all_settings = std::numeric_limits<T>::max();
   }
 }
 
@@ -761,9 +1158,19 @@ void gst_pylon_query_feature_properties_double(
   if (!feature_cache.GetDoubleProps(feature_cache_name,
                                     minimum_under_all_settings,
                                     maximum_under_all_settings, flags)) {
+    if (gst_pylon_query_limits_mode() != GST_PYLON_LIMITS_PRECISE) {
+      gst_pylon_find_static_limits<gdouble>(node, minimum_under_all_settings,
+                                            maximum_under_all_settings);
+      flags = static_cast<GParamFlags>(gst_pylon_query_access(nodemap, node) |
+                                       GST_PYLON_PARAM_LIMITS_PENDING);
+      g_free(feature_cache_name);
+      return;
+    }
+
     flags = gst_pylon_query_access(nodemap, node);
     gst_pylon_find_limits<Pylon::CFloatParameter, gdouble>(
-        node, minimum_under_all_settings, maximum_under_all_settings);
+        node, feature_cache, minimum_under_all_settings,
+        maximum_under_all_settings);
 
     feature_cache.SetDoubleProps(feature_cache_name, minimum_under_all_settings,
                                  maximum_under_all_settings, flags);
@@ -797,9 +1204,19 @@ void gst_pylon_query_feature_properties_integer(
   if (!feature_cache.GetIntProps(node->GetName().c_str(),
                                  minimum_under_all_settings,
                                  maximum_under_all_settings, flags)) {
+    if (gst_pylon_query_limits_mode() != GST_PYLON_LIMITS_PRECISE) {
+      gst_pylon_find_static_limits<gint64>(node, minimum_under_all_settings,
+                                           maximum_under_all_settings);
+      flags = static_cast<GParamFlags>(gst_pylon_query_access(nodemap, node) |
+                                       GST_PYLON_PARAM_LIMITS_PENDING);
+      g_free(feature_cache_name);
+      return;
+    }
+
     flags = gst_pylon_query_access(nodemap, node);
     gst_pylon_find_limits<Pylon::CIntegerParameter, gint64>(
-        node, minimum_under_all_settings, maximum_under_all_settings);
+        node, feature_cache, minimum_under_all_settings,
+        maximum_under_all_settings);
 
     feature_cache.SetIntProps(node->GetName().c_str(),
                               minimum_under_all_settings,
@@ -808,3 +1225,203 @@ void gst_pylon_query_feature_properties_integer(
 
   g_free(feature_cache_name);
 }
+
+/* Only the mutability may differ from the static guess, readability and
+ * writability are fixed once the property is installed */
+static GParamFlags gst_pylon_refined_flags(GParamSpec *pspec,
+                                           GParamFlags flags) {
+  gint mutable_flags = GST_PARAM_MUTABLE_READY | GST_PARAM_MUTABLE_PLAYING;
+
+  return static_cast<GParamFlags>(
+      (pspec->flags & ~(mutable_flags | GST_PYLON_PARAM_LIMITS_PENDING |
+                        G_PARAM_STATIC_STRINGS)) |
+      (flags & mutable_flags));
+}
+
+static void gst_pylon_refine_limits(GenApi::INodeMap &nodemap,
+                                    GenApi::INode *node, GParamSpec *pspec,
+                                    GstPylonParamSpecSelectorData *selector_data,
+                                    GstPylonCache &feature_cache) {
+  GParamFlags flags = static_cast<GParamFlags>(0);
+  gchar *feature_cache_name = NULL;
+
+  if (selector_data) {
+    gst_pylon_object_set_pylon_selector(nodemap, selector_data->selector,
+                                        selector_data->selector_value);
+    feature_cache_name = gst_pylon_create_selected_name(
+        nodemap, selector_data->feature, selector_data->selector,
+        selector_data->selector_value);
+  } else {
+    feature_cache_name = g_strdup(node->GetName().c_str());
+  }
+
+  /* Use the same cache keys as gst_pylon_query_feature_properties_*() */
+  GParamSpec *refined = NULL;
+  if (G_IS_PARAM_SPEC_INT64(pspec)) {
+    GParamSpecInt64 *spec = G_PARAM_SPEC_INT64(pspec);
+    gint64 minimum_under_all_settings = 0;
+    gint64 maximum_under_all_settings = 0;
+
+    if (!feature_cache.GetIntProps(node->GetName().c_str(),
+                                   minimum_under_all_settings,
+                                   maximum_under_all_settings, flags)) {
+      flags = gst_pylon_query_runtime_access(nodemap, node);
+      gst_pylon_find_limits<Pylon::CIntegerParameter, gint64>(
+          node, feature_cache, minimum_under_all_settings,
+          maximum_under_all_settings);
+      feature_cache.SetIntProps(node->GetName().c_str(),
+                                minimum_under_all_settings,
+                                maximum_under_all_settings, flags);
+    }
+
+    refined = g_param_spec_int64(
+        pspec->name, g_param_spec_get_nick(pspec),
+        g_param_spec_get_blurb(pspec), minimum_under_all_settings,
+        maximum_under_all_settings,
+        CLAMP(spec->default_value, minimum_under_all_settings,
+              maximum_under_all_settings),
+        gst_pylon_refined_flags(pspec, flags));
+  } else if (G_IS_PARAM_SPEC_DOUBLE(pspec)) {
+    GParamSpecDouble *spec = G_PARAM_SPEC_DOUBLE(pspec);
+    gdouble minimum_under_all_settings = 0;
+    gdouble maximum_under_all_settings = 0;
+
+    if (!feature_cache.GetDoubleProps(feature_cache_name,
+                                      minimum_under_all_settings,
+                                      maximum_under_all_settings, flags)) {
+      flags = gst_pylon_query_runtime_access(nodemap, node);
+      gst_pylon_find_limits<Pylon::CFloatParameter, gdouble>(
+          node, feature_cache, minimum_under_all_settings,
+          maximum_under_all_settings);
+      feature_cache.SetDoubleProps(feature_cache_name,
+                                   minimum_under_all_settings,
+                                   maximum_under_all_settings, flags);
+    }
+
+    refined = g_param_spec_double(
+        pspec->name, g_param_spec_get_nick(pspec),
+        g_param_spec_get_blurb(pspec), minimum_under_all_settings,
+        maximum_under_all_settings,
+        CLAMP(spec->default_value, minimum_under_all_settings,
+              maximum_under_all_settings),
+        gst_pylon_refined_flags(pspec, flags));
+  }
+
+  g_free(feature_cache_name);
+
+  if (!refined) {
+    return;
+  }
+
+  /* The installed GParamSpec is shared by every object of the class and read
+   * by any thread without a lock. The refined description only goes to the
+   * feature cache and is installed by the next class registration. */
+  if (selector_data) {
+    gst_pylon_param_spec_selector_set_data(refined, selector_data->feature,
+                                           selector_data->selector,
+                                           selector_data->selector_value);
+  }
+  feature_cache.SetParamSpec(refined);
+  g_param_spec_unref(g_param_spec_ref_sink(refined));
+}
+
+void gst_pylon_refine_feature_limits(GenApi::INodeMap &nodemap,
+                                     GParamSpec *pspec,
+                                     GstPylonCache &feature_cache) {
+  g_return_if_fail(pspec);
+
+  if (!GST_PYLON_PARAM_FLAG_IS_SET(pspec, GST_PYLON_PARAM_LIMITS_PENDING)) {
+    return;
+  }
+
+  GstPylonParamSpecSelectorData *selector_data = NULL;
+  gchar *feature_name = NULL;
+  if (GST_PYLON_PARAM_FLAG_IS_SET(pspec, GST_PYLON_PARAM_IS_SELECTOR)) {
+    selector_data = gst_pylon_param_spec_selector_get_data(pspec);
+    feature_name = g_strdup(selector_data->feature);
+  } else {
+    /* Decanonicalize gst to pylon name */
+    feature_name = g_strdelimit(g_strdup(pspec->name), "-", '_');
+  }
+
+  GenApi::INode *node = nodemap.GetNode(feature_name);
+  g_free(feature_name);
+  if (!node) {
+    std::string msg = "No feature found for property " +
+                      std::string(pspec->name);
+    throw Pylon::GenericException(msg.c_str(), __FILE__, __LINE__);
+  }
+
+  /* Leave the selector where the application put it */
+  std::vector<GstPylonActions *> reset_list;
+  if (selector_data) {
+    reset_list = gst_pylon_create_reset_value_actions(
+        {nodemap.GetNode(selector_data->selector)});
+  }
+
+  try {
+    gst_pylon_refine_limits(nodemap, node, pspec, selector_data,
+                            feature_cache);
+  } catch (const Pylon::GenericException &) {
+    gst_pylon_reset_values(reset_list);
+    throw;
+  }
+
+  gst_pylon_reset_values(reset_list);
+}
+
+std::vector<gsize> gst_pylon_sort_by_dependencies(
+    const std::vector<GenApi::INode *> &nodes) {
+  gsize n_nodes = nodes.size();
+  std::vector<std::vector<gsize>> successors(n_nodes);
+  std::vector<gsize> n_predecessors(n_nodes, 0);
+  std::vector<gboolean> is_sorted(n_nodes, FALSE);
+  std::vector<gsize> order;
+
+  /* a node invalidates every node depending on it, directly or through
+   * the nodes computing its limits and access mode */
+  for (gsize i = 0; i < n_nodes; i++) {
+    GenApi::NodeList_t depending;
+    nodes[i]->GetChildren(depending, GenApi::ctDependingNodes);
+    std::set<GenApi::INode *> depending_set(depending.begin(),
+                                            depending.end());
+
+    for (gsize j = 0; j < n_nodes; j++) {
+      if (nodes[j] != nodes[i] && depending_set.count(nodes[j])) {
+        successors[i].push_back(j);
+        n_predecessors[j]++;
+      }
+    }
+  }
+
+  while (order.size() < n_nodes) {
+    gsize next = n_nodes;
+
+    for (gsize i = 0; i < n_nodes; i++) {
+      if (!is_sorted[i] && 0 == n_predecessors[i]) {
+        next = i;
+        break;
+      }
+    }
+
+    /* cycle, continue with the first remaining node */
+    if (next == n_nodes) {
+      for (gsize i = 0; i < n_nodes; i++) {
+        if (!is_sorted[i]) {
+          next = i;
+          break;
+        }
+      }
+    }
+
+    is_sorted[next] = TRUE;
+    order.push_back(next);
+    for (const auto &successor : successors[next]) {
+      if (n_predecessors[successor] > 0) {
+        n_predecessors[successor]--;
+      }
+    }
+  }
+
+  return order;
+}
@@ -37,6 +37,28 @@
 #include <gst/pylon/gstpyloncache.h>
 #include <gst/pylon/gstpylonincludes.h>
 
+#include <vector>
+
+/**
+ * GstPylonLimitsMode:
+ * @GST_PYLON_LIMITS_PRECISE: search the limits of every feature under all
+ * settings while registering the properties
+ * @GST_PYLON_LIMITS_LAZY: register the static limits of the node description
+ * and search the precise ones when a feature is first set
+ * @GST_PYLON_LIMITS_BACKGROUND: as lazy, and search the remaining limits in a
+ * background thread while the camera is idle
+ *
+ * Selected by the PYLONSRC_FEATURE_LIMITS environment variable. Limits found
+ * by a search are kept in the feature cache in every mode.
+ */
+typedef enum {
+  GST_PYLON_LIMITS_PRECISE = 0,
+  GST_PYLON_LIMITS_LAZY = 1,
+  GST_PYLON_LIMITS_BACKGROUND = 2,
+} GstPylonLimitsMode;
+
+GstPylonLimitsMode gst_pylon_query_limits_mode();
+
 GParamFlags gst_pylon_query_access(GenApi::INodeMap &nodemap,
                                    GenApi::INode *node);
 
@@ -52,4 +74,18 @@ void gst_pylon_query_feature_properties_integer(
     gint64 &minimum_under_all_settings, gint64 &maximum_under_all_settings,
     GenApi::INode *selector = NULL, gint64 selector_value = 0);
 
+/* Record a property registered with GST_PYLON_PARAM_LIMITS_PENDING in the
+ * feature cache with its limits under all settings, searching them if the
+ * cache has none. @pspec itself keeps its static limits. Throws on
+ * failure. */
+void gst_pylon_refine_feature_limits(GenApi::INodeMap &nodemap,
+                                     GParamSpec *pspec,
+                                     GstPylonCache &feature_cache);
+
+/* Indices of the nodes in the order they can be written, each feature after
+ * the features it depends on. Nodes in a dependency cycle keep their
+ * relative order. */
+std::vector<gsize> gst_pylon_sort_by_dependencies(
+    const std::vector<GenApi::INode *> &nodes);
+
 #endif
@@ -214,6 +214,7 @@ static gboolean gst_pylon_meta_init(GstMeta *meta, gpointer params,
   GstPylonMeta *pylon_meta = (GstPylonMeta *)meta;
 
   pylon_meta->chunks = gst_structure_new_empty("meta/x-pylon");
+  pylon_meta->schedule_id = 0;
 
   return TRUE;
 }
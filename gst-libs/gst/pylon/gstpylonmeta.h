@@ -58,6 +58,9 @@ struct _GstPylonMeta {
   GstPylonOffset offset;
   GstClockTime timestamp;
   gsize stride;
+  /* last scheduled feature change in effect on this frame, 0 if none.
+   * Changes taking effect together report only the last one added. */
+  guint schedule_id;
 };
 
 EXT_PYLONSRC_API GType gst_pylon_meta_api_get_type(void);
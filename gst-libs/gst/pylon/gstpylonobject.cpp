@@ -36,10 +36,12 @@
 
 #include "gstpylondebug.h"
 #include "gstpylonfeaturewalker.h"
+#include "gstpylonintrospection.h"
 #include "gstpylonobject.h"
 #include "gstpylonparamspecs.h"
 
 #include <utility>
+#include <vector>
 
 /************************************************************
  * Start of GObject definition
@@ -111,7 +113,7 @@ static void gst_pylon_object_install_properties(GstPylonObjectClass* klass,
 template <typename F, typename P>
 static void gst_pylon_object_set_pylon_feature(GstPylonObjectPrivate* priv,
                                                F get_value, const GValue* value,
-                                               const gchar* name);
+                                               GenApi::INode* node);
 
 template <typename F, typename P>
 static void gst_pylon_object_set_pylon_selected_feature(
@@ -134,6 +136,9 @@ static void gst_pylon_object_feature_get_value(
     GstPylonParamSpecSelectorData* selector_data, F get_value,
     const GValue* value);
 
+static void gst_pylon_object_attach_property_data(GObjectClass* oclass);
+static void gst_pylon_object_resolve_nodes(GstPylonObject* self);
+
 static void gst_pylon_object_set_property(GObject* object, guint property_id,
                                           const GValue* value,
                                           GParamSpec* pspec);
@@ -180,27 +185,162 @@ static void gst_pylon_object_class_init(
   gst_pylon_object_install_properties(klass, device_members->nodemap,
                                       device_members->device_name,
                                       device_members->feature_cache);
+  gst_pylon_object_attach_property_data(oclass);
 
   delete (device_members);
 }
 
 static void gst_pylon_object_init(GstPylonObject* self) {}
 
+/* ROI properties are cached while the camera is stopped, the values are
+ * checked during caps fixation */
+typedef enum {
+  GST_PYLON_OBJECT_DIMENSION_NONE = 0,
+  GST_PYLON_OBJECT_DIMENSION_OFFSETX,
+  GST_PYLON_OBJECT_DIMENSION_OFFSETY,
+  GST_PYLON_OBJECT_DIMENSION_WIDTH,
+  GST_PYLON_OBJECT_DIMENSION_HEIGHT,
+} GstPylonObjectDimension;
+
+/* Everything derived from the property name, computed once per class
+ * instead of on every get and set */
+typedef struct {
+  gchar* feature;
+  gchar* selector;
+  GstPylonObjectDimension dimension;
+} GstPylonObjectPropertyData;
+
+#define GST_PYLON_OBJECT_PROPERTY_QSTRING "GstPylonObjectPropertyData"
+
+static void gst_pylon_object_property_data_free(
+    GstPylonObjectPropertyData* data) {
+  g_free(data->feature);
+  g_free(data->selector);
+  g_slice_free(GstPylonObjectPropertyData, data);
+}
+
+static GstPylonObjectPropertyData* gst_pylon_object_get_property_data(
+    GParamSpec* pspec) {
+  static GQuark quark =
+      g_quark_from_static_string(GST_PYLON_OBJECT_PROPERTY_QSTRING);
+
+  return static_cast<GstPylonObjectPropertyData*>(
+      g_param_spec_get_qdata(pspec, quark));
+}
+
+static void gst_pylon_object_attach_property_data(GObjectClass* oclass) {
+  static GQuark quark =
+      g_quark_from_static_string(GST_PYLON_OBJECT_PROPERTY_QSTRING);
+  const std::pair<const gchar*, GstPylonObjectDimension> dimensions[] = {
+      {"OffsetX", GST_PYLON_OBJECT_DIMENSION_OFFSETX},
+      {"OffsetY", GST_PYLON_OBJECT_DIMENSION_OFFSETY},
+      {"Width", GST_PYLON_OBJECT_DIMENSION_WIDTH},
+      {"Height", GST_PYLON_OBJECT_DIMENSION_HEIGHT},
+  };
+  guint n_specs = 0;
+
+  GParamSpec** specs = g_object_class_list_properties(oclass, &n_specs);
+
+  for (guint i = 0; i < n_specs; i++) {
+    GParamSpec* pspec = specs[i];
+    GstPylonObjectPropertyData* data =
+        g_slice_new0(GstPylonObjectPropertyData);
+
+    if (GST_PYLON_PARAM_FLAG_IS_SET(pspec, GST_PYLON_PARAM_IS_SELECTOR)) {
+      GstPylonParamSpecSelectorData* selector_data =
+          gst_pylon_param_spec_selector_get_data(pspec);
+      data->feature = g_strdup(selector_data->feature);
+      data->selector = g_strdup(selector_data->selector);
+    } else {
+      /* Decanonicalize gst to pylon name */
+      data->feature = g_strdelimit(g_strdup(pspec->name), "-", '_');
+    }
+
+    for (const auto& dimension : dimensions) {
+      if (g_str_equal(pspec->name, dimension.first)) {
+        data->dimension = dimension.second;
+      }
+    }
+
+    g_param_spec_set_qdata_full(
+        pspec, quark, data,
+        (GDestroyNotify)gst_pylon_object_property_data_free);
+  }
+
+  g_free(specs);
+}
+
+/* Nodes differ between nodemaps of the same model, so they are looked up per
+ * object, once */
+static void gst_pylon_object_resolve_nodes(GstPylonObject* self) {
+  GstPylonObjectPrivate* priv =
+      (GstPylonObjectPrivate*)gst_pylon_object_get_instance_private(self);
+  guint n_specs = 0;
+
+  GParamSpec** specs =
+      g_object_class_list_properties(G_OBJECT_GET_CLASS(self), &n_specs);
+
+  priv->nodes = new std::vector<GstPylonObjectNodes>();
+  priv->value_cache = new GstPylonValueCache();
+  for (guint i = 0; i < n_specs; i++) {
+    GstPylonObjectPropertyData* data =
+        gst_pylon_object_get_property_data(specs[i]);
+    guint index = specs[i]->param_id - 1;
+
+    if (!data) {
+      continue;
+    }
+
+    if (index >= priv->nodes->size()) {
+      priv->nodes->resize(index + 1, {NULL, NULL});
+    }
+
+    GstPylonObjectNodes& nodes = (*priv->nodes)[index];
+    nodes.feature = priv->nodemap->GetNode(data->feature);
+    nodes.selector =
+        data->selector ? priv->nodemap->GetNode(data->selector) : NULL;
+
+    if (!nodes.feature) {
+      GST_WARNING("No feature %s for property \"%s\"", data->feature,
+                  specs[i]->name);
+    } else if (specs[i]->flags & G_PARAM_READABLE) {
+      priv->value_cache->Watch(index, nodes.feature);
+    }
+  }
+
+  g_free(specs);
+}
+
+static const GstPylonObjectNodes& gst_pylon_object_get_nodes(
+    GstPylonObjectPrivate* priv, GParamSpec* pspec) {
+  guint index = pspec->param_id - 1;
+
+  if (!priv->nodes || index >= priv->nodes->size() ||
+      !(*priv->nodes)[index].feature) {
+    std::string msg =
+        "No feature found for property " + std::string(pspec->name);
+    throw Pylon::GenericException(msg.c_str(), __FILE__, __LINE__);
+  }
+
+  return (*priv->nodes)[index];
+}
+
 /* Set pylon feature from gst property */
 template <class F, typename P>
 static void gst_pylon_object_set_pylon_feature(GstPylonObjectPrivate* priv,
                                                F get_value, const GValue* value,
-                                               const gchar* name) {
-  P param(*priv->nodemap, name);
+                                               GenApi::INode* node) {
+  P param(node);
   param.SetValue(get_value(value));
-  GST_INFO("Set Feature %s: %s", name, param.ToString().c_str());
+  GST_INFO("Set Feature %s: %s", node->GetName().c_str(),
+           param.ToString().c_str());
 }
 
 template <>
 void gst_pylon_object_set_pylon_feature<GGetInt64, Pylon::CIntegerParameter>(
     GstPylonObjectPrivate* priv, GGetInt64 get_value, const GValue* value,
-    const gchar* name) {
-  Pylon::CIntegerParameter param(*priv->nodemap, name);
+    GenApi::INode* node) {
+  Pylon::CIntegerParameter param(node);
   int64_t gst_val = get_value(value);
   bool value_corrected = false;
 
@@ -219,15 +359,15 @@ void gst_pylon_object_set_pylon_feature<GGetInt64, Pylon::CIntegerParameter>(
   } else {
     param.SetValue(get_value(value));
   }
-  GST_INFO("Set Feature %s: %s%s", name, param.ToString().c_str(),
-           value_corrected ? " [corrected]" : "");
+  GST_INFO("Set Feature %s: %s%s", node->GetName().c_str(),
+           param.ToString().c_str(), value_corrected ? " [corrected]" : "");
 }
 
 template <>
 void gst_pylon_object_set_pylon_feature<GGetDouble, Pylon::CFloatParameter>(
     GstPylonObjectPrivate* priv, GGetDouble get_value, const GValue* value,
-    const gchar* name) {
-  Pylon::CFloatParameter param(*priv->nodemap, name);
+    GenApi::INode* node) {
+  Pylon::CFloatParameter param(node);
   double gst_val = get_value(value);
   bool value_corrected = false;
   if (priv->enable_correction &&
@@ -240,67 +380,69 @@ void gst_pylon_object_set_pylon_feature<GGetDouble, Pylon::CFloatParameter>(
     param.SetValue(gst_val);
   }
 
-  GST_INFO("Set Feature %s: %s%s", name, param.ToString().c_str(),
-           value_corrected ? " [corrected]" : "");
+  GST_INFO("Set Feature %s: %s%s", node->GetName().c_str(),
+           param.ToString().c_str(), value_corrected ? " [corrected]" : "");
 }
 
 template <>
 void gst_pylon_object_set_pylon_feature<GGetEnum, Pylon::CEnumParameter>(
     GstPylonObjectPrivate* priv, GGetEnum get_value, const GValue* value,
-    const gchar* name) {
-  Pylon::CEnumParameter param(*priv->nodemap, name);
+    GenApi::INode* node) {
+  Pylon::CEnumParameter param(node);
   param.SetIntValue(get_value(value));
-  GST_INFO("Set Feature %s: %s", name, param.ToString().c_str());
+  GST_INFO("Set Feature %s: %s", node->GetName().c_str(),
+           param.ToString().c_str());
 }
 
 /* Get gst property from pylon feature */
 template <class F, typename P>
-static void gst_pylon_object_get_pylon_feature(GenApi::INodeMap& nodemap,
-                                               F set_value, GValue* value,
-                                               const gchar* name) {
-  P param(nodemap, name);
+static void gst_pylon_object_get_pylon_feature(F set_value, GValue* value,
+                                               GenApi::INode* node) {
+  P param(node);
   set_value(value, param.GetValue());
-  GST_DEBUG("Get Feature %s: %s", name, param.ToString().c_str());
+  GST_DEBUG("Get Feature %s: %s", node->GetName().c_str(),
+            param.ToString().c_str());
 }
 
 template <>
 void gst_pylon_object_get_pylon_feature<GSetEnum, Pylon::CEnumParameter>(
-    GenApi::INodeMap& nodemap, GSetEnum set_value, GValue* value,
-    const gchar* name) {
-  Pylon::CEnumParameter param(nodemap, name);
+    GSetEnum set_value, GValue* value, GenApi::INode* node) {
+  Pylon::CEnumParameter param(node);
   set_value(value, param.GetIntValue());
-  GST_DEBUG("Get Feature %s: %s", name, param.ToString().c_str());
+  GST_DEBUG("Get Feature %s: %s", node->GetName().c_str(),
+            param.ToString().c_str());
 }
 
 template <>
 void gst_pylon_object_get_pylon_feature<GSetString, Pylon::CStringParameter>(
-    GenApi::INodeMap& nodemap, GSetString set_value, GValue* value,
-    const gchar* name) {
-  Pylon::CStringParameter param(nodemap, name);
+    GSetString set_value, GValue* value, GenApi::INode* node) {
+  Pylon::CStringParameter param(node);
   set_value(value, param.GetValue().c_str());
-  GST_DEBUG("Get Feature %s: %s", name, param.ToString().c_str());
+  GST_DEBUG("Get Feature %s: %s", node->GetName().c_str(),
+            param.ToString().c_str());
 }
 
-void gst_pylon_object_set_pylon_selector(GenApi::INodeMap& nodemap,
-                                         const gchar* selector_name,
-                                         gint64& selector_value) {
-  gint selector_type =
-      nodemap.GetNode(selector_name)->GetPrincipalInterfaceType();
+static void gst_pylon_object_set_pylon_selector_node(GenApi::INode* selector,
+                                                     gint64 selector_value) {
+  gint selector_type = selector->GetPrincipalInterfaceType();
   switch (selector_type) {
-    case GenApi::intfIEnumeration:
-      Pylon::CEnumParameter(nodemap, selector_name).SetIntValue(selector_value);
-      GST_INFO(
-          "Set Selector-Feature %s: %s", selector_name,
-          Pylon::CEnumParameter(nodemap, selector_name).ToString().c_str());
+    case GenApi::intfIEnumeration: {
+      Pylon::CEnumParameter param(selector);
+      param.SetIntValue(selector_value);
+      GST_INFO("Set Selector-Feature %s: %s", selector->GetName().c_str(),
+               param.ToString().c_str());
       break;
-    case GenApi::intfIInteger:
-      Pylon::CIntegerParameter(nodemap, selector_name).SetValue(selector_value);
-      GST_INFO(
-          "Set Selector-Feature %s: %s", selector_name,
-          Pylon::CIntegerParameter(nodemap, selector_name).ToString().c_str());
+    }
+    case GenApi::intfIInteger: {
+      Pylon::CIntegerParameter param(selector);
+      param.SetValue(selector_value);
+      GST_INFO("Set Selector-Feature %s: %s", selector->GetName().c_str(),
+               param.ToString().c_str());
       break;
+    }
     default:
-      std::string error_msg = "Selector \"" + std::string(selector_name) +
+      std::string error_msg = "Selector \"" +
+                              std::string(selector->GetName().c_str()) +
                               "\"" + " is of invalid type " +
                               std::to_string(selector_type);
       g_warning("%s", error_msg.c_str());
@@ -308,6 +450,19 @@ void gst_pylon_object_set_pylon_selector(GenApi::INodeMap& nodemap,
   }
 }
 
+void gst_pylon_object_set_pylon_selector(GenApi::INodeMap& nodemap,
+                                         const gchar* selector_name,
+                                         gint64& selector_value) {
+  GenApi::INode* selector = nodemap.GetNode(selector_name);
+  if (!selector) {
+    std::string error_msg =
+        "Selector \"" + std::string(selector_name) + "\" not found";
+    throw Pylon::GenericException(error_msg.c_str(), __FILE__, __LINE__);
+  }
+
+  gst_pylon_object_set_pylon_selector_node(selector, selector_value);
+}
+
 template <typename T, typename P>
 static T gst_pylon_object_get_pylon_property(GenApi::INodeMap& nodemap,
                                              const gchar* name) {
@@ -322,53 +477,168 @@ static void gst_pylon_object_feature_set_value(
     GParamSpec* pspec, GstPylonObjectPrivate* priv,
     GstPylonParamSpecSelectorData* selector_data, F get_value,
     const GValue* value) {
+  const GstPylonObjectNodes& nodes = gst_pylon_object_get_nodes(priv, pspec);
+
   /* The value accepted by the pspec can be a direct feature or a feature that
    * has a selector. */
-
-  if (GST_PYLON_PARAM_FLAG_IS_SET(pspec, GST_PYLON_PARAM_IS_SELECTOR)) {
-    gst_pylon_object_set_pylon_selector(*priv->nodemap, selector_data->selector,
-                                        selector_data->selector_value);
-    gst_pylon_object_set_pylon_feature<F, P>(priv, get_value, value,
-                                             selector_data->feature);
-  } else {
-    /* Decanonicalize gst to pylon name */
-    gchar** split = g_strsplit(pspec->name, "-", -1);
-    gchar* name_pylon = g_strjoinv("_", split);
-    g_strfreev(split);
-    gst_pylon_object_set_pylon_feature<F, P>(priv, get_value, value,
-                                             name_pylon);
-    g_free(name_pylon);
+  if (selector_data) {
+    if (!nodes.selector) {
+      std::string msg = "Selector " + std::string(selector_data->selector) +
+                        " not found";
+      throw Pylon::GenericException(msg.c_str(), __FILE__, __LINE__);
+    }
+    gst_pylon_object_set_pylon_selector_node(nodes.selector,
+                                             selector_data->selector_value);
   }
+
+  gst_pylon_object_set_pylon_feature<F, P>(priv, get_value, value,
+                                           nodes.feature);
 }
 
 template <typename F, typename P>
 static void gst_pylon_object_feature_get_value(
     GParamSpec* pspec, GstPylonObjectPrivate* priv,
     GstPylonParamSpecSelectorData* selector_data, F set_value, GValue* value) {
+  const GstPylonObjectNodes& nodes = gst_pylon_object_get_nodes(priv, pspec);
+
   /* The value accepted by the pspec can be a direct feature or a feature that
    * has a selector. */
-  if (GST_PYLON_PARAM_FLAG_IS_SET(pspec, GST_PYLON_PARAM_IS_SELECTOR)) {
-    gst_pylon_object_set_pylon_selector(*priv->nodemap, selector_data->selector,
-                                        selector_data->selector_value);
-    gst_pylon_object_get_pylon_feature<F, P>(*priv->nodemap, set_value, value,
-                                             selector_data->feature);
-  } else {
-    /* Decanonicalize gst to pylon name */
-    gchar** split = g_strsplit(pspec->name, "-", -1);
-    gchar* name_pylon = g_strjoinv("_", split);
-    g_strfreev(split);
-    gst_pylon_object_get_pylon_feature<F, P>(*priv->nodemap, set_value, value,
-                                             name_pylon);
-    g_free(name_pylon);
+  if (selector_data) {
+    if (!nodes.selector) {
+      std::string msg = "Selector " + std::string(selector_data->selector) +
+                        " not found";
+      throw Pylon::GenericException(msg.c_str(), __FILE__, __LINE__);
+    }
+    gst_pylon_object_set_pylon_selector_node(nodes.selector,
+                                             selector_data->selector_value);
   }
+
+  gst_pylon_object_get_pylon_feature<F, P>(set_value, value, nodes.feature);
 }
 
-static void gst_pylon_object_set_property(GObject* object, guint property_id,
-                                          const GValue* value,
-                                          GParamSpec* pspec) {
-  GstPylonObject* self = (GstPylonObject*)object;
+/* Search the precise limits of a lazily registered property for the feature
+ * cache. Features are locked while grabbing, a search then would report the
+ * limits of the current configuration only. */
+static gboolean gst_pylon_object_refine_limits(GstPylonObjectPrivate* priv,
+                                               GParamSpec* pspec) {
+  /* Keeps other threads from seeing the intermediate values of the search */
+  GenApi::AutoLock lock(priv->nodemap->GetLock());
+
+  if (!GST_PYLON_PARAM_FLAG_IS_SET(pspec, GST_PYLON_PARAM_LIMITS_PENDING) ||
+      priv->refined_specs->count(pspec)) {
+    return TRUE;
+  }
+
+  if (priv->camera->IsGrabbing()) {
+    return FALSE;
+  }
+
+  try {
+    gst_pylon_refine_feature_limits(*priv->nodemap, pspec,
+                                    *priv->feature_cache);
+    priv->refined_specs->insert(pspec);
+    GST_DEBUG("Refined limits of \"%s\"", pspec->name);
+  } catch (const Pylon::GenericException& e) {
+    GST_DEBUG("Unable to refine limits of \"%s\": %s", pspec->name,
+              e.GetDescription());
+  }
+
+  return TRUE;
+}
+
+static void gst_pylon_object_save_limits(GstPylonObjectPrivate* priv) {
+  GenApi::AutoLock lock(priv->nodemap->GetLock());
+
+  if (priv->feature_cache->HasNewSettings()) {
+    try {
+      priv->feature_cache->CreateCacheFile();
+    } catch (const Pylon::GenericException& e) {
+      GST_WARNING("Feature cache could not be updated. %s",
+                  e.GetDescription());
+    }
+  }
+}
+
+static gpointer gst_pylon_object_search_limits(gpointer data) {
+  GstPylonObject* self = (GstPylonObject*)data;
+  GstPylonObjectPrivate* priv =
+      (GstPylonObjectPrivate*)gst_pylon_object_get_instance_private(self);
+  guint n_specs = 0;
+
+  GParamSpec** specs =
+      g_object_class_list_properties(G_OBJECT_GET_CLASS(self), &n_specs);
+
+  for (guint i = 0; i < n_specs; i++) {
+    if (g_atomic_int_get(&priv->limits_cancelled)) {
+      break;
+    }
+
+    /* Remaining features are searched the next time the camera is idle */
+    if (!gst_pylon_object_refine_limits(priv, specs[i])) {
+      break;
+    }
+  }
+
+  g_free(specs);
+
+  gst_pylon_object_save_limits(priv);
+
+  return NULL;
+}
+
+void gst_pylon_object_stop_limits_search(GstPylonObject* self) {
+  g_return_if_fail(self);
+
+  GstPylonObjectPrivate* priv =
+      (GstPylonObjectPrivate*)gst_pylon_object_get_instance_private(self);
+
+  if (priv->limits_thread) {
+    g_atomic_int_set(&priv->limits_cancelled, TRUE);
+    g_thread_join(priv->limits_thread);
+    priv->limits_thread = NULL;
+  }
+}
+
+void gst_pylon_object_release_nodes(GstPylonObject* self) {
+  g_return_if_fail(self);
+
+  GstPylonObjectPrivate* priv =
+      (GstPylonObjectPrivate*)gst_pylon_object_get_instance_private(self);
+
+  if (!priv->nodemap) {
+    return;
+  }
+
+  gst_pylon_object_stop_limits_search(self);
+
+  priv->value_cache->Release();
+  delete priv->nodes;
+  priv->nodes = NULL;
+
+  priv->nodemap = NULL;
+  priv->camera = NULL;
+}
+
+/* TRUE once the camera the object was created for is gone */
+static gboolean gst_pylon_object_is_released(GstPylonObject* self,
+                                             GParamSpec* pspec) {
   GstPylonObjectPrivate* priv =
       (GstPylonObjectPrivate*)gst_pylon_object_get_instance_private(self);
+
+  if (priv->nodemap) {
+    return FALSE;
+  }
+
+  GST_WARNING_OBJECT(self, "Property \"%s\" is no longer accessible, the "
+                     "camera was closed", pspec ? pspec->name : "");
+  return TRUE;
+}
+
+/* Write a property value to the camera, or to the dimension cache before
+ * streaming. Throws on failure. */
+static void gst_pylon_object_write_property(GstPylonObjectPrivate* priv,
+                                            GParamSpec* pspec,
+                                            const GValue* value) {
   GType value_type = g_type_fundamental(G_VALUE_TYPE(value));
   GstPylonParamSpecSelectorData* selector_data = NULL;
 
@@ -379,62 +649,84 @@ static void gst_pylon_object_set_property(GObject* object, guint property_id,
   /* check if property is from dimension list
    * and set before streaming
    */
-  if (!priv->camera->IsGrabbing()) {
-    bool is_cached = false;
-    if (std::string(pspec->name) == "OffsetX") {
-      priv->dimension_cache.offsetx = g_value_get_int64(value);
-      is_cached = true;
-    } else if (std::string(pspec->name) == "OffsetY") {
-      priv->dimension_cache.offsety = g_value_get_int64(value);
-      is_cached = true;
-    } else if (std::string(pspec->name) == "Width") {
-      priv->dimension_cache.width = g_value_get_int64(value);
-      is_cached = true;
-    } else if (std::string(pspec->name) == "Height") {
-      priv->dimension_cache.height = g_value_get_int64(value);
-      is_cached = true;
-    }
-    if (is_cached) {
-      GST_INFO("Caching property \"%s\". Value is checked during caps fixation",
-               pspec->name);
-
-      /* skip to set the camera property value
-       * any value in the gst property range of this feature is accepted in this
-       * phase
-       */
-      return;
-    }
-  }
-
-  try {
-    switch (value_type) {
-      case G_TYPE_INT64:
-        gst_pylon_object_feature_set_value<GGetInt64, Pylon::CIntegerParameter>(
-            pspec, priv, selector_data, g_value_get_int64, value);
+  GstPylonObjectPropertyData* data = gst_pylon_object_get_property_data(pspec);
+  if (data && data->dimension != GST_PYLON_OBJECT_DIMENSION_NONE &&
+      !priv->camera->IsGrabbing()) {
+    switch (data->dimension) {
+      case GST_PYLON_OBJECT_DIMENSION_OFFSETX:
+        priv->dimension_cache.offsetx = g_value_get_int64(value);
         break;
-      case G_TYPE_BOOLEAN:
-        gst_pylon_object_feature_set_value<GGetBool, Pylon::CBooleanParameter>(
-            pspec, priv, selector_data, g_value_get_boolean, value);
+      case GST_PYLON_OBJECT_DIMENSION_OFFSETY:
+        priv->dimension_cache.offsety = g_value_get_int64(value);
         break;
-      case G_TYPE_DOUBLE:
-        gst_pylon_object_feature_set_value<GGetDouble, Pylon::CFloatParameter>(
-            pspec, priv, selector_data, g_value_get_double, value);
+      case GST_PYLON_OBJECT_DIMENSION_WIDTH:
+        priv->dimension_cache.width = g_value_get_int64(value);
         break;
-      case G_TYPE_STRING:
-        gst_pylon_object_feature_set_value<GGetString, Pylon::CStringParameter>(
-            pspec, priv, selector_data, g_value_get_string, value);
+      case GST_PYLON_OBJECT_DIMENSION_HEIGHT:
+        priv->dimension_cache.height = g_value_get_int64(value);
         break;
-      case G_TYPE_ENUM:
-        gst_pylon_object_feature_set_value<GGetEnum, Pylon::CEnumParameter>(
-            pspec, priv, selector_data, g_value_get_enum, value);
-        break;
-
       default:
-        g_warning("Unsupported GType: %s", g_type_name(pspec->value_type));
-        std::string msg =
-            "Unsupported GType: " + std::string(g_type_name(pspec->value_type));
-        throw Pylon::GenericException(msg.c_str(), __FILE__, __LINE__);
+        break;
     }
+
+    GST_INFO("Caching property \"%s\". Value is checked during caps fixation",
+             pspec->name);
+
+    /* skip to set the camera property value
+     * any value in the gst property range of this feature is accepted in this
+     * phase
+     */
+    return;
+  }
+
+  switch (value_type) {
+    case G_TYPE_INT64:
+      gst_pylon_object_feature_set_value<GGetInt64, Pylon::CIntegerParameter>(
+          pspec, priv, selector_data, g_value_get_int64, value);
+      break;
+    case G_TYPE_BOOLEAN:
+      gst_pylon_object_feature_set_value<GGetBool, Pylon::CBooleanParameter>(
+          pspec, priv, selector_data, g_value_get_boolean, value);
+      break;
+    case G_TYPE_DOUBLE:
+      gst_pylon_object_feature_set_value<GGetDouble, Pylon::CFloatParameter>(
+          pspec, priv, selector_data, g_value_get_double, value);
+      break;
+    case G_TYPE_STRING:
+      gst_pylon_object_feature_set_value<GGetString, Pylon::CStringParameter>(
+          pspec, priv, selector_data, g_value_get_string, value);
+      break;
+    case G_TYPE_ENUM:
+      gst_pylon_object_feature_set_value<GGetEnum, Pylon::CEnumParameter>(
+          pspec, priv, selector_data, g_value_get_enum, value);
+      break;
+
+    default:
+      g_warning("Unsupported GType: %s", g_type_name(pspec->value_type));
+      std::string msg =
+          "Unsupported GType: " + std::string(g_type_name(pspec->value_type));
+      throw Pylon::GenericException(msg.c_str(), __FILE__, __LINE__);
+  }
+}
+
+static void gst_pylon_object_set_property(GObject* object, guint property_id,
+                                          const GValue* value,
+                                          GParamSpec* pspec) {
+  GstPylonObject* self = (GstPylonObject*)object;
+  GstPylonObjectPrivate* priv =
+      (GstPylonObjectPrivate*)gst_pylon_object_get_instance_private(self);
+
+  if (gst_pylon_object_is_released(self, pspec)) {
+    return;
+  }
+
+  if (GST_PYLON_PARAM_FLAG_IS_SET(pspec, GST_PYLON_PARAM_LIMITS_PENDING) &&
+      gst_pylon_object_refine_limits(priv, pspec)) {
+    gst_pylon_object_save_limits(priv);
+  }
+
+  try {
+    gst_pylon_object_write_property(priv, pspec, value);
   } catch (const Pylon::GenericException& e) {
     GST_ERROR("Unable to set pylon property \"%s\" on \"%s\": %s", pspec->name,
               priv->camera->GetDeviceInfo().GetFriendlyName().c_str(),
@@ -442,6 +734,149 @@ static void gst_pylon_object_set_property(GObject* object, guint property_id,
   }
 }
 
+/* Convert a value of a features structure to the type of its property,
+ * strings are parsed the way gst-launch parses property values */
+static gboolean gst_pylon_object_convert_value(const GValue* src,
+                                               GValue* dest) {
+  if (G_VALUE_TYPE(src) == G_VALUE_TYPE(dest)) {
+    g_value_copy(src, dest);
+    return TRUE;
+  }
+
+  if (G_VALUE_HOLDS_STRING(src)) {
+    const gchar* str = g_value_get_string(src);
+    return str && gst_value_deserialize(dest, str);
+  }
+
+  if (g_value_type_transformable(G_VALUE_TYPE(src), G_VALUE_TYPE(dest))) {
+    return g_value_transform(src, dest);
+  }
+
+  return FALSE;
+}
+
+typedef struct {
+  GParamSpec* pspec;
+  GValue value;
+  gboolean applied;
+} GstPylonObjectWrite;
+
+GstStructure* gst_pylon_object_apply_properties(
+    GstPylonObject* self, const GstStructure* properties) {
+  g_return_val_if_fail(self, NULL);
+  g_return_val_if_fail(properties, NULL);
+
+  GstPylonObjectPrivate* priv =
+      (GstPylonObjectPrivate*)gst_pylon_object_get_instance_private(self);
+  GstStructure* results =
+      gst_structure_new_empty(GST_PYLON_OBJECT_APPLY_RESULTS_NAME);
+  std::vector<GstPylonObjectWrite> writes;
+  std::vector<GenApi::INode*> nodes;
+  gboolean refined = FALSE;
+
+  if (gst_pylon_object_is_released(self, NULL)) {
+    return results;
+  }
+
+  gint n_fields = gst_structure_n_fields(properties);
+  for (gint i = 0; i < n_fields; i++) {
+    const gchar* name = gst_structure_nth_field_name(properties, i);
+    GParamSpec* pspec =
+        g_object_class_find_property(G_OBJECT_GET_CLASS(self), name);
+
+    /* results keep the order of the request */
+    gst_structure_set(results, name, G_TYPE_BOOLEAN, FALSE, NULL);
+
+    if (!pspec || !(pspec->flags & G_PARAM_WRITABLE) ||
+        !gst_pylon_object_get_property_data(pspec)) {
+      GST_WARNING("No writable property \"%s\" on \"%s\"", name,
+                  GST_OBJECT_NAME(self));
+      continue;
+    }
+
+    GstPylonObjectWrite write = {pspec, G_VALUE_INIT, FALSE};
+    g_value_init(&write.value, pspec->value_type);
+    if (!gst_pylon_object_convert_value(
+            gst_structure_get_value(properties, name), &write.value)) {
+      GST_WARNING("Invalid value for property \"%s\"", name);
+      g_value_unset(&write.value);
+      continue;
+    }
+
+    if (GST_PYLON_PARAM_FLAG_IS_SET(pspec, GST_PYLON_PARAM_LIMITS_PENDING)) {
+      refined |= gst_pylon_object_refine_limits(priv, pspec);
+    }
+
+    if (g_param_value_validate(pspec, &write.value)) {
+      GST_WARNING("Value for property \"%s\" out of range", name);
+      g_value_unset(&write.value);
+      continue;
+    }
+
+    try {
+      nodes.push_back(gst_pylon_object_get_nodes(priv, pspec).feature);
+      writes.push_back(write);
+    } catch (const Pylon::GenericException& e) {
+      GST_WARNING("%s", e.GetDescription());
+      g_value_unset(&write.value);
+    }
+  }
+
+  if (refined) {
+    gst_pylon_object_save_limits(priv);
+  }
+
+  {
+    /* no other thread sees the features half written */
+    GenApi::AutoLock lock(priv->nodemap->GetLock());
+    Pylon::CCommandParameter streaming_start(*priv->nodemap,
+                                             "DeviceRegistersStreamingStart");
+    Pylon::CCommandParameter streaming_end(*priv->nodemap,
+                                           "DeviceRegistersStreamingEnd");
+
+    /* writes to the device are collected and sent in one transfer */
+    gboolean batched = streaming_start.TryExecute();
+
+    for (const auto& index : gst_pylon_sort_by_dependencies(nodes)) {
+      GstPylonObjectWrite& write = writes[index];
+      try {
+        gst_pylon_object_write_property(priv, write.pspec, &write.value);
+        write.applied = TRUE;
+      } catch (const Pylon::GenericException& e) {
+        GST_WARNING("Unable to set pylon property \"%s\" on \"%s\": %s",
+                    write.pspec->name,
+                    priv->camera->GetDeviceInfo().GetFriendlyName().c_str(),
+                    e.GetDescription());
+      }
+    }
+
+    if (batched) {
+      try {
+        streaming_end.Execute();
+      } catch (const Pylon::GenericException& e) {
+        /* the device rejected the batch, none of it is known to be applied */
+        GST_WARNING("Unable to apply the features to \"%s\": %s",
+                    priv->camera->GetDeviceInfo().GetFriendlyName().c_str(),
+                    e.GetDescription());
+        for (auto& write : writes) {
+          write.applied = FALSE;
+        }
+      }
+    }
+  }
+
+  for (auto& write : writes) {
+    gst_structure_set(results, write.pspec->name, G_TYPE_BOOLEAN, write.applied,
+                      NULL);
+    if (write.applied) {
+      g_object_notify_by_pspec(G_OBJECT(self), write.pspec);
+    }
+    g_value_unset(&write.value);
+  }
+
+  return results;
+}
+
 static void gst_pylon_object_get_property(GObject* object, guint property_id,
                                           GValue* value, GParamSpec* pspec) {
   GstPylonObject* self = (GstPylonObject*)object;
@@ -449,6 +884,10 @@ static void gst_pylon_object_get_property(GObject* object, guint property_id,
       (GstPylonObjectPrivate*)gst_pylon_object_get_instance_private(self);
   GstPylonParamSpecSelectorData* selector_data = NULL;
 
+  if (gst_pylon_object_is_released(self, pspec)) {
+    return;
+  }
+
   if (GST_PYLON_PARAM_FLAG_IS_SET(pspec, GST_PYLON_PARAM_IS_SELECTOR)) {
     selector_data = gst_pylon_param_spec_selector_get_data(pspec);
   }
@@ -456,27 +895,29 @@ static void gst_pylon_object_get_property(GObject* object, guint property_id,
   /* check if property is from dimension list
    * and get from cache if not streaming
    */
-  if (!priv->camera->IsGrabbing()) {
-    bool is_cached = false;
-    if (std::string(pspec->name) == "OffsetX" &&
-        priv->dimension_cache.offsetx >= 0) {
-      is_cached = true;
-      g_value_set_int64(value, priv->dimension_cache.offsetx);
-    } else if (std::string(pspec->name) == "OffsetY" &&
-               priv->dimension_cache.offsety >= 0) {
-      is_cached = true;
-      g_value_set_int64(value, priv->dimension_cache.offsety);
-    } else if (std::string(pspec->name) == "Width" &&
-               priv->dimension_cache.width >= 0) {
-      is_cached = true;
-      g_value_set_int64(value, priv->dimension_cache.width);
-    } else if (std::string(pspec->name) == "Height" &&
-               priv->dimension_cache.height >= 0) {
-      is_cached = true;
-      g_value_set_int64(value, priv->dimension_cache.height);
+  GstPylonObjectPropertyData* data = gst_pylon_object_get_property_data(pspec);
+  if (data && data->dimension != GST_PYLON_OBJECT_DIMENSION_NONE &&
+      !priv->camera->IsGrabbing()) {
+    gint cached = -1;
+    switch (data->dimension) {
+      case GST_PYLON_OBJECT_DIMENSION_OFFSETX:
+        cached = priv->dimension_cache.offsetx;
+        break;
+      case GST_PYLON_OBJECT_DIMENSION_OFFSETY:
+        cached = priv->dimension_cache.offsety;
+        break;
+      case GST_PYLON_OBJECT_DIMENSION_WIDTH:
+        cached = priv->dimension_cache.width;
+        break;
+      case GST_PYLON_OBJECT_DIMENSION_HEIGHT:
+        cached = priv->dimension_cache.height;
+        break;
+      default:
+        break;
     }
 
-    if (is_cached) {
+    if (cached >= 0) {
+      g_value_set_int64(value, cached);
       GST_INFO(
           "Read cached property \"%s\". Value might be adjusted during caps "
           "fixation",
@@ -486,6 +927,15 @@ static void gst_pylon_object_get_property(GObject* object, guint property_id,
     }
   }
 
+  /* repeated reads are served from memory until the node changes */
+  if (priv->value_cache->Lookup(property_id - 1, value)) {
+    return;
+  }
+
+  /* a write by another thread between the read and the store would leave a
+   * stale value behind */
+  GenApi::AutoLock lock(priv->nodemap->GetLock());
+
   try {
     switch (g_type_fundamental(pspec->value_type)) {
       case G_TYPE_INT64:
@@ -514,6 +964,8 @@ static void gst_pylon_object_get_property(GObject* object, guint property_id,
             "Unsupported GType: " + std::string(g_type_name(pspec->value_type));
         throw Pylon::GenericException(msg.c_str(), __FILE__, __LINE__);
     }
+
+    priv->value_cache->Store(property_id - 1, value);
   } catch (const Pylon::GenericException& e) {
     GST_ERROR("Unable to get pylon property \"%s\" on \"%s\": %s", pspec->name,
               priv->camera->GetDeviceInfo().GetFriendlyName().c_str(),
@@ -521,10 +973,24 @@ static void gst_pylon_object_get_property(GObject* object, guint property_id,
   }
 }
 
+std::string gst_pylon_object_get_camera_cache_name(
+    Pylon::CBaslerUniversalInstantCamera& camera) {
+  return std::string(camera.GetDeviceInfo().GetModelName() + "_" +
+                     camera.DeviceFirmwareVersion.GetValueOrDefault("") +
+                     GST_PYLON_OBJECT_CACHE_NAME_SUFFIX);
+}
+
+std::string gst_pylon_object_get_sgrabber_cache_name(
+    Pylon::CBaslerUniversalInstantCamera& camera) {
+  return std::string(camera.GetDeviceInfo().GetModelName() + "_" +
+                     Pylon::GetPylonVersionString() +
+                     GST_PYLON_OBJECT_SGRABBER_CACHE_NAME_SUFFIX);
+}
+
 GObject* gst_pylon_object_new(
     std::shared_ptr<Pylon::CBaslerUniversalInstantCamera> camera,
-    const std::string& device_name, GenApi::INodeMap* nodemap,
-    gboolean enable_correction) {
+    const std::string& device_name, const std::string& cache_name,
+    GenApi::INodeMap* nodemap, gboolean enable_correction) {
   std::string type_name =
       gst_pylon_param_spec_sanitize_name(device_name.c_str());
 
@@ -533,10 +999,7 @@ GObject* gst_pylon_object_new(
   std::unique_ptr<GstPylonCache> feature_cache;
 
   if (!type) {
-    std::string cache_filename =
-        std::string(camera->GetDeviceInfo().GetModelName() + "_" +
-                    Pylon::GetPylonVersionString() + "_" + VERSION);
-    feature_cache = std::make_unique<GstPylonCache>(cache_filename);
+    feature_cache = std::make_unique<GstPylonCache>(cache_name);
     type = gst_pylon_object_register(device_name, *feature_cache, *nodemap);
   }
 
@@ -554,6 +1017,17 @@ GObject* gst_pylon_object_new(
    */
   priv->dimension_cache = {-1, -1, -1, -1};
 
+  gst_pylon_object_resolve_nodes(self);
+
+  /* Lazily registered limits are searched later and added to the cache, the
+   * properties may come from a cache written in another mode */
+  priv->feature_cache = new GstPylonCache(cache_name);
+  priv->refined_specs = new std::unordered_set<GParamSpec*>();
+  if (gst_pylon_query_limits_mode() == GST_PYLON_LIMITS_BACKGROUND) {
+    priv->limits_thread =
+        g_thread_new("pylon-limits", gst_pylon_object_search_limits, self);
+  }
+
   return obj;
 }
 
@@ -562,6 +1036,17 @@ static void gst_pylon_object_finalize(GObject* object) {
   GstPylonObjectPrivate* priv =
       (GstPylonObjectPrivate*)gst_pylon_object_get_instance_private(self);
 
+  /* normally released with the camera, still needed if it never was */
+  gst_pylon_object_release_nodes(self);
+  delete priv->feature_cache;
+  priv->feature_cache = NULL;
+  delete priv->refined_specs;
+  priv->refined_specs = NULL;
+  delete priv->value_cache;
+  priv->value_cache = NULL;
+  delete priv->nodes;
+  priv->nodes = NULL;
+
   priv->camera = NULL;
 
   G_OBJECT_CLASS(gst_pylon_object_parent_class)->finalize(object);
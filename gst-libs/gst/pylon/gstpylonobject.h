@@ -36,6 +36,9 @@
 #include <gst/gst.h>
 #include <gst/pylon/gstpyloncache.h>
 #include <gst/pylon/gstpylonincludes.h>
+#include <gst/pylon/gstpylonvaluecache.h>
+
+#include <unordered_set>
 
 G_DECLARE_DERIVABLE_TYPE(GstPylonObject, gst_pylon_object, GST, PYLON_OBJECT,
                          GstObject)
@@ -51,11 +54,26 @@ typedef struct {
   gint offsety;
 } dimension_t;
 
+/* Nodes behind a property, resolved once when the object is created */
+typedef struct {
+  GenApi::INode* feature;
+  GenApi::INode* selector;
+} GstPylonObjectNodes;
+
 typedef struct {
   std::shared_ptr<Pylon::CBaslerUniversalInstantCamera> camera;
   GenApi::INodeMap* nodemap;
   gboolean enable_correction;
   dimension_t dimension_cache;
+  GstPylonCache* feature_cache;
+  GThread* limits_thread;
+  gint limits_cancelled;
+  /* lazily registered properties whose limits were searched, the installed
+   * GParamSpecs are shared by the class and never change */
+  std::unordered_set<GParamSpec*>* refined_specs;
+  /* indexed by property id - 1 */
+  std::vector<GstPylonObjectNodes>* nodes;
+  GstPylonValueCache* value_cache;
 } GstPylonObjectPrivate;
 
 typedef struct {
@@ -69,13 +87,38 @@ EXT_PYLONSRC_API GType gst_pylon_object_register(const std::string& device_name,
                                                  GenApi::INodeMap& nodemap);
 EXT_PYLONSRC_API GObject* gst_pylon_object_new(
     std::shared_ptr<Pylon::CBaslerUniversalInstantCamera> camera,
-    const std::string& device_name, GenApi::INodeMap* nodemap,
-    gboolean enable_correction);
+    const std::string& device_name, const std::string& cache_name,
+    GenApi::INodeMap* nodemap, gboolean enable_correction);
+
+/* Feature cache keys, shared by all cameras of a model running the same
+ * firmware. Stream grabber features depend on the pylon version instead. */
+#define GST_PYLON_OBJECT_CACHE_NAME_SUFFIX "_" VERSION
+#define GST_PYLON_OBJECT_SGRABBER_CACHE_NAME_SUFFIX \
+  GST_PYLON_OBJECT_CACHE_NAME_SUFFIX "_StreamGrabber"
+EXT_PYLONSRC_API std::string gst_pylon_object_get_camera_cache_name(
+    Pylon::CBaslerUniversalInstantCamera& camera);
+EXT_PYLONSRC_API std::string gst_pylon_object_get_sgrabber_cache_name(
+    Pylon::CBaslerUniversalInstantCamera& camera);
 
 EXT_PYLONSRC_API void gst_pylon_object_set_pylon_selector(
     GenApi::INodeMap& nodemap, const gchar* selector_name,
     gint64& selector_value);
 
+/* Write the feature=value fields of @properties in one transaction, each
+ * feature after the ones it depends on. Returns a structure with a boolean
+ * field per requested feature telling whether it was applied. */
+#define GST_PYLON_OBJECT_APPLY_RESULTS_NAME "pylon-features-applied"
+EXT_PYLONSRC_API GstStructure* gst_pylon_object_apply_properties(
+    GstPylonObject* self, const GstStructure* properties);
+
+EXT_PYLONSRC_API void gst_pylon_object_stop_limits_search(
+    GstPylonObject* self);
+
+/* Detach the object from the nodemap before the camera is closed. The
+ * object may outlive the camera, e.g. as a child handed out through
+ * GstChildProxy, its properties are then no longer accessible. */
+EXT_PYLONSRC_API void gst_pylon_object_release_nodes(GstPylonObject* self);
+
 EXT_PYLONSRC_API gpointer
 gst_pylon_object_get_instance_private(GstPylonObject* self);
 
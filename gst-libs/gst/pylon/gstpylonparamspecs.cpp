@@ -108,10 +108,10 @@ static void gst_pylon_param_spec_data_free(
   g_slice_free(GstPylonParamSpecSelectorData, self);
 }
 
-static void gst_pylon_param_spec_selector_epilog(GParamSpec *spec,
-                                                 const gchar *feature_name,
-                                                 const gchar *selector_name,
-                                                 guint64 selector_value) {
+void gst_pylon_param_spec_selector_set_data(GParamSpec *spec,
+                                            const gchar *feature_name,
+                                            const gchar *selector_name,
+                                            guint64 selector_value) {
   static GQuark quark = g_quark_from_static_string(QSTRING);
 
   g_return_if_fail(feature_name);
@@ -140,8 +140,8 @@ GParamSpec *gst_pylon_param_spec_selector_int64(
       g_param_spec_int64(name, nick, blurb, min, max, def, flags);
   g_free(name);
 
-  gst_pylon_param_spec_selector_epilog(spec, feature_name, selector_name,
-                                       selector_value);
+  gst_pylon_param_spec_selector_set_data(spec, feature_name, selector_name,
+                                         selector_value);
 
   return spec;
 }
@@ -156,8 +156,8 @@ GParamSpec *gst_pylon_param_spec_selector_boolean(
   GParamSpec *spec = g_param_spec_boolean(name, nick, blurb, def, flags);
   g_free(name);
 
-  gst_pylon_param_spec_selector_epilog(spec, feature_name, selector_name,
-                                       selector_value);
+  gst_pylon_param_spec_selector_set_data(spec, feature_name, selector_name,
+                                         selector_value);
 
   return spec;
 }
@@ -176,8 +176,8 @@ GParamSpec *gst_pylon_param_spec_selector_double(
       g_param_spec_double(name, nick, blurb, min, max, def, flags);
   g_free(name);
 
-  gst_pylon_param_spec_selector_epilog(spec, feature_name, selector_name,
-                                       selector_value);
+  gst_pylon_param_spec_selector_set_data(spec, feature_name, selector_name,
+                                         selector_value);
 
   return spec;
 }
@@ -192,8 +192,8 @@ GParamSpec *gst_pylon_param_spec_selector_string(
   GParamSpec *spec = g_param_spec_string(name, nick, blurb, def, flags);
   g_free(name);
 
-  gst_pylon_param_spec_selector_epilog(spec, feature_name, selector_name,
-                                       selector_value);
+  gst_pylon_param_spec_selector_set_data(spec, feature_name, selector_name,
+                                         selector_value);
 
   return spec;
 }
@@ -208,8 +208,8 @@ GParamSpec *gst_pylon_param_spec_selector_enum(
   GParamSpec *spec = g_param_spec_enum(name, nick, blurb, type, def, flags);
   g_free(name);
 
-  gst_pylon_param_spec_selector_epilog(spec, feature_name, selector_name,
-                                       selector_value);
+  gst_pylon_param_spec_selector_set_data(spec, feature_name, selector_name,
+                                         selector_value);
 
   return spec;
 }
@@ -39,6 +39,9 @@
 
 /* Set flag for features with selectors */
 #define GST_PYLON_PARAM_IS_SELECTOR (1 << (G_PARAM_USER_SHIFT + 1))
+/* Set flag for features registered with the static limits of the node
+ * description, see gst_pylon_refine_feature_limits() */
+#define GST_PYLON_PARAM_LIMITS_PENDING (GST_PARAM_USER_SHIFT << 1)
 #define GST_PYLON_PARAM_FLAG_IS_SET(pspec, flag) ((pspec)->flags & (flag))
 
 /* --- typedefs & structures --- */
@@ -90,6 +93,10 @@ GParamSpec* gst_pylon_param_spec_selector_enum(
 std::string gst_pylon_param_spec_sanitize_name(const gchar* name);
 GstPylonParamSpecSelectorData* gst_pylon_param_spec_selector_get_data(
     GParamSpec* spec);
+void gst_pylon_param_spec_selector_set_data(GParamSpec* spec,
+                                            const gchar* feature_name,
+                                            const gchar* selector_name,
+                                            guint64 selector_value);
 gchar* gst_pylon_create_selected_name(GenApi::INodeMap& nodemap,
                                       const gchar* feature_name,
                                       const gchar* selector_name,
@@ -0,0 +1,188 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Property values of a camera kept in memory between reads
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "gstpylondebug.h"
+#include "gstpylonvaluecache.h"
+
+#include <cstdlib>
+#include <string>
+
+#define DEFAULT_VALUE_CACHE_TTL_MS 100
+
+/* Time to live of values GenApi does not cache, and overrides per feature
+ * for any node */
+struct GstPylonValueCacheTtl {
+  gint64 default_ms;
+  std::unordered_map<std::string, gint64> feature_ms;
+};
+
+/* PYLONSRC_VALUE_CACHE_TTL_MS=<ms>[,<feature>=<ms>...] */
+static GstPylonValueCacheTtl gst_pylon_value_cache_read_ttl() {
+  GstPylonValueCacheTtl ttl = {DEFAULT_VALUE_CACHE_TTL_MS, {}};
+  const char *env_p = std::getenv("PYLONSRC_VALUE_CACHE_TTL_MS");
+
+  if (!env_p) {
+    return ttl;
+  }
+
+  gchar **items = g_strsplit(env_p, ",", -1);
+  for (gchar **item = items; *item; item++) {
+    gchar **pair = g_strsplit(g_strstrip(*item), "=", 2);
+    const gchar *ms_str = pair[1] ? pair[1] : pair[0];
+    gchar *end = NULL;
+    gint64 ms = g_ascii_strtoll(ms_str, &end, 10);
+
+    if (end == ms_str || *end != '\0' || ms < 0) {
+      GST_WARNING("Invalid value cache time to live \"%s\"", *item);
+    } else if (pair[1]) {
+      ttl.feature_ms[pair[0]] = ms;
+    } else {
+      ttl.default_ms = ms;
+    }
+
+    g_strfreev(pair);
+  }
+  g_strfreev(items);
+
+  return ttl;
+}
+
+static const GstPylonValueCacheTtl &gst_pylon_value_cache_query_ttl() {
+  static const GstPylonValueCacheTtl ttl = gst_pylon_value_cache_read_ttl();
+
+  return ttl;
+}
+
+GstPylonValueCache::GstPylonValueCache() { g_mutex_init(&this->lock); }
+
+GstPylonValueCache::~GstPylonValueCache() {
+  if (!this->callbacks.empty()) {
+    GST_WARNING("Value cache destroyed with %zu node callbacks registered",
+                this->callbacks.size());
+  }
+
+  for (auto &entry : this->entries) {
+    if (G_IS_VALUE(&entry.value)) {
+      g_value_unset(&entry.value);
+    }
+  }
+
+  g_mutex_clear(&this->lock);
+}
+
+void GstPylonValueCache::Release() {
+  /* deregistering takes the nodemap lock, GenApi may be running
+   * OnNodeChanged() under it, which takes ours */
+  for (const auto &callback : this->callbacks) {
+    callback.first->DeregisterCallback(callback.second);
+  }
+  this->callbacks.clear();
+
+  g_mutex_lock(&this->lock);
+
+  this->node_entries.clear();
+  for (auto &entry : this->entries) {
+    entry.is_valid = FALSE;
+    entry.is_watched = FALSE;
+  }
+
+  g_mutex_unlock(&this->lock);
+}
+
+void GstPylonValueCache::Watch(guint index, GenApi::INode *node) {
+  const GstPylonValueCacheTtl &ttl = gst_pylon_value_cache_query_ttl();
+  gint64 ttl_ms = -1;
+
+  g_return_if_fail(node);
+
+  auto feature_ttl = ttl.feature_ms.find(node->GetName().c_str());
+  if (feature_ttl != ttl.feature_ms.end()) {
+    ttl_ms = feature_ttl->second;
+  } else if (GenApi::NoCache == node->GetCachingMode()) {
+    ttl_ms = ttl.default_ms;
+  }
+
+  g_mutex_lock(&this->lock);
+
+  if (index >= this->entries.size()) {
+    this->entries.resize(index + 1, {G_VALUE_INIT, FALSE, FALSE, 0, 0});
+  }
+
+  Entry &entry = this->entries[index];
+  entry.is_watched = TRUE;
+  entry.ttl_us = ttl_ms < 0 ? -1 : ttl_ms * G_TIME_SPAN_MILLISECOND;
+
+  this->node_entries[node].push_back(index);
+  gboolean is_registered = this->callbacks.count(node) > 0;
+
+  g_mutex_unlock(&this->lock);
+
+  if (!is_registered) {
+    this->callbacks[node] =
+        GenApi::Register(node, *this, &GstPylonValueCache::OnNodeChanged);
+  }
+}
+
+gboolean GstPylonValueCache::Lookup(guint index, GValue *value) {
+  gboolean ret = FALSE;
+
+  g_mutex_lock(&this->lock);
+
+  if (index < this->entries.size()) {
+    Entry &entry = this->entries[index];
+
+    if (entry.is_valid && entry.ttl_us >= 0 &&
+        g_get_monotonic_time() >= entry.expiry_us) {
+      entry.is_valid = FALSE;
+    }
+
+    if (entry.is_valid) {
+      g_value_copy(&entry.value, value);
+      ret = TRUE;
+    }
+  }
+
+  g_mutex_unlock(&this->lock);
+
+  return ret;
+}
+
+void GstPylonValueCache::Store(guint index, const GValue *value) {
+  g_mutex_lock(&this->lock);
+
+  if (index < this->entries.size()) {
+    Entry &entry = this->entries[index];
+
+    if (entry.is_watched && entry.ttl_us != 0) {
+      if (G_IS_VALUE(&entry.value)) {
+        g_value_unset(&entry.value);
+      }
+      g_value_init(&entry.value, G_VALUE_TYPE(value));
+      g_value_copy(value, &entry.value);
+      entry.is_valid = TRUE;
+      entry.expiry_us = g_get_monotonic_time() + MAX(entry.ttl_us, 0);
+    }
+  }
+
+  g_mutex_unlock(&this->lock);
+}
+
+/* called by GenApi with the nodemap locked, on writes and invalidations */
+void GstPylonValueCache::OnNodeChanged(GenApi::INode *node) {
+  g_mutex_lock(&this->lock);
+
+  auto node_entries = this->node_entries.find(node);
+  if (node_entries != this->node_entries.end()) {
+    for (const auto &index : node_entries->second) {
+      this->entries[index].is_valid = FALSE;
+    }
+  }
+
+  g_mutex_unlock(&this->lock);
+}
@@ -0,0 +1,66 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Property values of a camera kept in memory between reads
+ */
+
+#ifndef _GST_PYLON_VALUE_CACHE_H_
+#define _GST_PYLON_VALUE_CACHE_H_
+
+#include <gst/gst.h>
+#include <gst/pylon/gstpylonincludes.h>
+
+#include <unordered_map>
+#include <vector>
+
+/**
+ * GstPylonValueCache:
+ *
+ * Last value read of each property of a #GstPylonObject, indexed by
+ * property id - 1. A GenApi callback on the feature node drops the values
+ * of all properties backed by it whenever the node is written or
+ * invalidated. Nodes GenApi does not cache, like DeviceTemperature, change
+ * without a callback, their values expire after a time to live set by
+ * PYLONSRC_VALUE_CACHE_TTL_MS.
+ *
+ * Safe to use from any thread.
+ */
+class GstPylonValueCache {
+ public:
+  GstPylonValueCache();
+  /* frees the values only, Release() has to run while the nodes exist */
+  ~GstPylonValueCache();
+
+  /* Deregister the callbacks and forget the nodes, before the nodemap is
+   * destroyed. Nothing is cached afterwards. */
+  void Release();
+
+  /* Cache the property at @index, read from @node. All properties are
+   * watched before the cache is shared between threads. */
+  void Watch(guint index, GenApi::INode *node);
+
+  /* Copy a valid cached value into @value, an initialized GValue of the
+   * property type */
+  gboolean Lookup(guint index, GValue *value);
+  /* Read the value with the nodemap locked and store it before unlocking,
+   * GenApi runs the callbacks of other writers inside that lock */
+  void Store(guint index, const GValue *value);
+
+ private:
+  struct Entry {
+    GValue value;
+    gboolean is_valid;
+    gboolean is_watched;
+    /* -1 keeps the value until invalidated, 0 disables caching */
+    gint64 ttl_us;
+    gint64 expiry_us;
+  };
+
+  void OnNodeChanged(GenApi::INode *node);
+
+  GMutex lock;
+  std::vector<Entry> entries;
+  std::unordered_map<GenApi::INode *, std::vector<guint>> node_entries;
+  std::unordered_map<GenApi::INode *, GenApi::CallbackHandleType> callbacks;
+};
+
+#endif
@@ -0,0 +1,253 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * pylonhdrbundle windows: complete, with gaps, dropped, flagged and too long
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
+
+/* only the layout of the meta, the plugin registers it */
+#include "ext/pylon/gsthdrmeta.h"
+
+#define FRAME_CAPS \
+  "video/x-raw,format=GRAY8,width=4,height=2,framerate=30/1"
+#define FRAME_SIZE 8
+
+static GstHarness *bundle_harness(const gchar *output,
+                                  const gchar *incomplete) {
+  GstHarness *h = gst_harness_new("pylonhdrbundle");
+
+  gst_util_set_object_arg(G_OBJECT(h->element), "output", output);
+  gst_util_set_object_arg(G_OBJECT(h->element), "incomplete", incomplete);
+  gst_harness_set_src_caps_str(h, FRAME_CAPS);
+
+  return h;
+}
+
+/* an exposure filled with its index, as pylonsrc delivers it */
+static GstFlowReturn push_exposure(GstHarness *h, guint64 master_sequence,
+                                   guint index, guint count) {
+  GstBuffer *buf = gst_harness_create_buffer(h, FRAME_SIZE);
+  const GstMetaInfo *info = gst_meta_get_info("GstHdrMeta");
+  GstHdrMeta *meta = NULL;
+
+  fail_unless(info != NULL);
+  gst_buffer_memset(buf, 0, index, FRAME_SIZE);
+
+  meta = reinterpret_cast<GstHdrMeta *>(gst_buffer_add_meta(buf, info, NULL));
+  meta->master_sequence = master_sequence;
+  meta->exposure_sequence_index = index;
+  meta->exposure_count = count;
+  meta->exposure_value = 100 * (index + 1);
+
+  return gst_harness_push(h, buf);
+}
+
+static guint64 get_windows(GstHarness *h, const gchar *property) {
+  guint64 windows = 0;
+
+  g_object_get(h->element, property, &windows, NULL);
+
+  return windows;
+}
+
+static guint count_hdr_metas(GstBuffer *buf) {
+  GType api = g_type_from_name("GstHdrMetaAPI");
+  gpointer state = NULL;
+  guint n = 0;
+
+  while (gst_buffer_iterate_meta_filtered(buf, &state, api)) {
+    n++;
+  }
+
+  return n;
+}
+
+GST_START_TEST(test_complete_memories) {
+  GstHarness *h = bundle_harness("memories", "drop");
+  GstBuffer *out = NULL;
+  GstCaps *caps = NULL;
+  gint exposures = 0;
+
+  for (guint i = 0; i < 3; i++) {
+    fail_unless_equals_int(push_exposure(h, 7, i, 3), GST_FLOW_OK);
+  }
+
+  fail_unless_equals_int(gst_harness_buffers_received(h), 1);
+  out = gst_harness_pull(h);
+  fail_unless_equals_int(gst_buffer_n_memory(out), 3);
+  fail_unless_equals_int(count_hdr_metas(out), 3);
+  fail_unless_equals_int(GST_BUFFER_OFFSET(out), 7);
+  fail_if(GST_BUFFER_FLAG_IS_SET(out, GST_BUFFER_FLAG_CORRUPTED));
+
+  /* every exposure stays in its own memory, in index order */
+  for (guint i = 0; i < 3; i++) {
+    GstMapInfo map;
+    GstMemory *mem = gst_buffer_peek_memory(out, i);
+
+    fail_unless(gst_memory_map(mem, &map, GST_MAP_READ));
+    fail_unless_equals_int(map.data[0], i);
+    gst_memory_unmap(mem, &map);
+  }
+  gst_buffer_unref(out);
+
+  /* the caps announce the bundle */
+  caps = gst_pad_get_current_caps(h->sinkpad);
+  fail_unless(caps != NULL);
+  fail_unless(gst_structure_get_int(gst_caps_get_structure(caps, 0),
+                                    "exposure-count", &exposures));
+  fail_unless_equals_int(exposures, 3);
+  gst_caps_unref(caps);
+
+  fail_unless_equals_uint64(get_windows(h, "complete-windows"), 1);
+  fail_unless_equals_uint64(get_windows(h, "incomplete-windows"), 0);
+
+  gst_harness_teardown(h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST(test_complete_list) {
+  GstHarness *h = bundle_harness("list", "drop");
+  GstCaps *caps = NULL;
+
+  for (guint i = 0; i < 2; i++) {
+    fail_unless_equals_int(push_exposure(h, 1, i, 2), GST_FLOW_OK);
+  }
+
+  /* the list arrives as the original exposures */
+  fail_unless_equals_int(gst_harness_buffers_received(h), 2);
+  for (guint i = 0; i < 2; i++) {
+    GstBuffer *out = gst_harness_pull(h);
+
+    fail_unless_equals_int(gst_buffer_n_memory(out), 1);
+    fail_unless_equals_int(count_hdr_metas(out), 1);
+    gst_buffer_unref(out);
+  }
+
+  caps = gst_pad_get_current_caps(h->sinkpad);
+  fail_unless(caps != NULL);
+  fail_if(gst_structure_has_field(gst_caps_get_structure(caps, 0),
+                                  "exposure-count"));
+  gst_caps_unref(caps);
+
+  gst_harness_teardown(h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST(test_gap_dropped) {
+  GstHarness *h = bundle_harness("memories", "drop");
+  GstBuffer *out = NULL;
+
+  /* window 0 misses its last exposure */
+  fail_unless_equals_int(push_exposure(h, 0, 0, 3), GST_FLOW_OK);
+  fail_unless_equals_int(push_exposure(h, 0, 1, 3), GST_FLOW_OK);
+  for (guint i = 0; i < 3; i++) {
+    fail_unless_equals_int(push_exposure(h, 1, i, 3), GST_FLOW_OK);
+  }
+
+  fail_unless_equals_int(gst_harness_buffers_received(h), 1);
+  out = gst_harness_pull(h);
+  fail_unless_equals_int(GST_BUFFER_OFFSET(out), 1);
+  fail_unless_equals_int(gst_buffer_n_memory(out), 3);
+  gst_buffer_unref(out);
+
+  fail_unless_equals_uint64(get_windows(h, "complete-windows"), 1);
+  fail_unless_equals_uint64(get_windows(h, "incomplete-windows"), 1);
+
+  gst_harness_teardown(h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST(test_gap_flagged) {
+  GstHarness *h = bundle_harness("memories", "flag");
+  GstBuffer *out = NULL;
+
+  /* a repeated index ends the window as well */
+  fail_unless_equals_int(push_exposure(h, 0, 0, 2), GST_FLOW_OK);
+  fail_unless_equals_int(push_exposure(h, 1, 0, 2), GST_FLOW_OK);
+  fail_unless_equals_int(push_exposure(h, 1, 1, 2), GST_FLOW_OK);
+
+  fail_unless_equals_int(gst_harness_buffers_received(h), 2);
+  out = gst_harness_pull(h);
+  fail_unless(GST_BUFFER_FLAG_IS_SET(out, GST_BUFFER_FLAG_CORRUPTED));
+  fail_unless_equals_int(gst_buffer_n_memory(out), 1);
+  gst_buffer_unref(out);
+
+  out = gst_harness_pull(h);
+  fail_if(GST_BUFFER_FLAG_IS_SET(out, GST_BUFFER_FLAG_CORRUPTED));
+  fail_unless_equals_int(gst_buffer_n_memory(out), 2);
+  gst_buffer_unref(out);
+
+  fail_unless_equals_uint64(get_windows(h, "complete-windows"), 1);
+  fail_unless_equals_uint64(get_windows(h, "incomplete-windows"), 1);
+
+  gst_harness_teardown(h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST(test_eos_flushes_window) {
+  GstHarness *h = bundle_harness("list", "flag");
+  GstBuffer *out = NULL;
+
+  fail_unless_equals_int(push_exposure(h, 4, 0, 3), GST_FLOW_OK);
+  fail_unless_equals_int(gst_harness_buffers_received(h), 0);
+
+  fail_unless(gst_harness_push_event(h, gst_event_new_eos()));
+
+  fail_unless_equals_int(gst_harness_buffers_received(h), 1);
+  out = gst_harness_pull(h);
+  fail_unless(GST_BUFFER_FLAG_IS_SET(out, GST_BUFFER_FLAG_CORRUPTED));
+  gst_buffer_unref(out);
+
+  fail_unless_equals_uint64(get_windows(h, "incomplete-windows"), 1);
+
+  gst_harness_teardown(h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST(test_too_many_memories) {
+  GstHarness *h = bundle_harness("memories", "drop");
+  guint count = gst_buffer_get_max_memory() + 1;
+
+  fail_unless_equals_int(push_exposure(h, 0, 0, count), GST_FLOW_ERROR);
+  fail_unless_equals_int(gst_harness_buffers_received(h), 0);
+
+  gst_harness_teardown(h);
+
+  /* lists are not limited */
+  h = bundle_harness("list", "drop");
+  for (guint i = 0; i < count; i++) {
+    fail_unless_equals_int(push_exposure(h, 0, i, count), GST_FLOW_OK);
+  }
+  fail_unless_equals_int(gst_harness_buffers_received(h), count);
+
+  gst_harness_teardown(h);
+}
+
+GST_END_TEST;
+
+static Suite *pylonhdrbundle_suite(void) {
+  Suite *s = suite_create("pylonhdrbundle");
+  TCase *tc_chain = tcase_create("general");
+
+  suite_add_tcase(s, tc_chain);
+  tcase_add_test(tc_chain, test_complete_memories);
+  tcase_add_test(tc_chain, test_complete_list);
+  tcase_add_test(tc_chain, test_gap_dropped);
+  tcase_add_test(tc_chain, test_gap_flagged);
+  tcase_add_test(tc_chain, test_eos_flushes_window);
+  tcase_add_test(tc_chain, test_too_many_memories);
+
+  return s;
+}
+
+GST_CHECK_MAIN(pylonhdrbundle);
@@ -0,0 +1,296 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Binary feature cache file round trip and rejection of invalid files
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <glib/gstdio.h>
+#include <gst/check/gstcheck.h>
+#include <gst/pylon/gstpyloncache.h>
+#include <gst/pylon/gstpylondebug.h>
+#include <gst/pylon/gstpylonincludes.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+
+/* header offsets of the version 3 layout: magic, version, byte order and
+ * walker schema */
+#define CACHE_VERSION_OFFSET 8
+#define CACHE_BYTE_ORDER_OFFSET 12
+#define CACHE_SCHEMA_OFFSET 16
+
+static gchar *cache_dir = NULL;
+
+typedef enum {
+  TEST_MODE_OFF,
+  TEST_MODE_ONCE,
+  TEST_MODE_CONTINUOUS,
+} TestMode;
+
+static GType test_mode_get_type(void) {
+  static GType type = 0;
+  static const GEnumValue values[] = {
+      {TEST_MODE_OFF, "Off", "off"},
+      {TEST_MODE_ONCE, "Once", "once"},
+      {TEST_MODE_CONTINUOUS, "Continuous", "continuous"},
+      {0, NULL, NULL}};
+
+  if (!type) {
+    type = g_enum_register_static("GstPylonCacheTestMode", values);
+  }
+
+  return type;
+}
+
+static std::string cache_path(const gchar *name) {
+  gchar *path = g_build_filename(cache_dir, name, NULL);
+  std::string ret = path;
+  g_free(path);
+  return ret;
+}
+
+/* Writes a cache with limits and one property of every stored type */
+static std::string write_cache(const std::string &name) {
+  GstPylonCache cache(name);
+
+  cache.SetIntProps("Width", 16, 4096, G_PARAM_READWRITE);
+  cache.SetDoubleProps("ExposureTime", 10.0, 1000000.0, G_PARAM_READABLE);
+
+  GParamSpec *specs[] = {
+      g_param_spec_int64("Width", "Width", "Width of the image", 16, 4096,
+                         640, G_PARAM_READWRITE),
+      g_param_spec_double("ExposureTime", "ExposureTime", "Exposure in us",
+                          10.0, 1000000.0, 5000.0, G_PARAM_READWRITE),
+      g_param_spec_boolean("ReverseX", "ReverseX", "Flip horizontally", TRUE,
+                           G_PARAM_READWRITE),
+      g_param_spec_string("DeviceUserID", "DeviceUserID", "User name", NULL,
+                          G_PARAM_READABLE),
+      g_param_spec_enum("ExposureAuto", "ExposureAuto", "Auto exposure",
+                        test_mode_get_type(), TEST_MODE_ONCE,
+                        G_PARAM_READWRITE),
+  };
+  for (const auto &spec : specs) {
+    cache.SetParamSpec(spec);
+    g_param_spec_unref(g_param_spec_ref_sink(spec));
+  }
+
+  std::string path = cache_path((name + ".bin").c_str());
+  cache.SetFilePath(path);
+  cache.CreateCacheFile();
+
+  return path;
+}
+
+static std::string read_file(const std::string &path) {
+  gchar *contents = NULL;
+  gsize length = 0;
+
+  fail_unless(g_file_get_contents(path.c_str(), &contents, &length, NULL));
+  std::string ret(contents, length);
+  g_free(contents);
+
+  return ret;
+}
+
+/* Whether a file holding @contents opens as a feature cache */
+static gboolean cache_is_valid(const std::string &contents) {
+  std::string path = cache_path("modified.bin");
+
+  fail_unless(g_file_set_contents(path.c_str(), contents.data(),
+                                  contents.size(), NULL));
+
+  try {
+    GstPylonCache::FromFile(path);
+  } catch (const Pylon::GenericException &) {
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+static std::string set_header_field(std::string contents, gsize offset,
+                                    guint32 value) {
+  fail_unless(contents.size() >= offset + sizeof(value));
+  memcpy(&contents[offset], &value, sizeof(value));
+  return contents;
+}
+
+static guint32 get_header_field(const std::string &contents, gsize offset) {
+  guint32 value = 0;
+  fail_unless(contents.size() >= offset + sizeof(value));
+  memcpy(&value, &contents[offset], sizeof(value));
+  return value;
+}
+
+GST_START_TEST(test_round_trip) {
+  std::string path = write_cache("round-trip");
+  std::unique_ptr<GstPylonCache> cache = GstPylonCache::FromFile(path);
+  gint64 int_min = 0, int_max = 0;
+  gdouble double_min = 0, double_max = 0;
+  GParamFlags flags;
+
+  fail_unless_equals_string(cache->GetName().c_str(), "round-trip");
+  fail_unless_equals_int(cache->GetLimitsCount(), 2);
+
+  fail_unless(cache->GetIntProps("Width", int_min, int_max, flags));
+  fail_unless_equals_int64(int_min, 16);
+  fail_unless_equals_int64(int_max, 4096);
+  fail_unless_equals_int(flags, G_PARAM_READWRITE);
+  fail_if(cache->GetDoubleProps("Width", double_min, double_max, flags));
+
+  fail_unless(cache->GetDoubleProps("ExposureTime", double_min, double_max,
+                                    flags));
+  fail_unless_equals_float(double_min, 10.0);
+  fail_unless_equals_float(double_max, 1000000.0);
+  fail_unless_equals_int(flags, G_PARAM_READABLE);
+
+  std::vector<GParamSpec *> specs = cache->GetParamSpecs();
+  fail_unless_equals_int(specs.size(), 5);
+
+  GParamSpecInt64 *width = G_PARAM_SPEC_INT64(specs[0]);
+  fail_unless_equals_string(specs[0]->name, "Width");
+  fail_unless_equals_string(g_param_spec_get_blurb(specs[0]),
+                            "Width of the image");
+  fail_unless_equals_int64(width->minimum, 16);
+  fail_unless_equals_int64(width->maximum, 4096);
+  fail_unless_equals_int64(width->default_value, 640);
+
+  GParamSpecDouble *exposure = G_PARAM_SPEC_DOUBLE(specs[1]);
+  fail_unless_equals_float(exposure->default_value, 5000.0);
+
+  fail_unless(G_PARAM_SPEC_BOOLEAN(specs[2])->default_value);
+  fail_unless(NULL == G_PARAM_SPEC_STRING(specs[3])->default_value);
+  fail_if(specs[3]->flags & G_PARAM_WRITABLE);
+
+  fail_unless_equals_int(specs[4]->value_type, test_mode_get_type());
+  fail_unless_equals_int(G_PARAM_SPEC_ENUM(specs[4])->default_value,
+                         TEST_MODE_ONCE);
+
+  for (const auto &spec : specs) {
+    g_param_spec_unref(g_param_spec_ref_sink(spec));
+  }
+
+  /* what was read is written back completely */
+  std::string copy = cache_path("copy.bin");
+  cache->SetFilePath(copy);
+  cache->CreateCacheFile();
+  fail_unless_equals_int(read_file(copy).size(), read_file(path).size());
+  std::unique_ptr<GstPylonCache> copied = GstPylonCache::FromFile(copy);
+  fail_unless_equals_int(copied->GetLimitsCount(), 2);
+  fail_unless_equals_int(copied->GetParamSpecCount(), 5);
+}
+
+GST_END_TEST;
+
+GST_START_TEST(test_truncated) {
+  std::string contents = read_file(write_cache("truncated"));
+
+  fail_unless(cache_is_valid(contents));
+  for (gsize size = 0; size < contents.size(); size++) {
+    fail_if(cache_is_valid(contents.substr(0, size)),
+            "Cache truncated to %" G_GSIZE_FORMAT " of %" G_GSIZE_FORMAT
+            " bytes was accepted",
+            size, contents.size());
+  }
+  fail_if(cache_is_valid(contents + '\0'));
+}
+
+GST_END_TEST;
+
+GST_START_TEST(test_bad_magic) {
+  std::string contents = read_file(write_cache("bad-magic"));
+
+  contents[0] ^= 0xff;
+  fail_if(cache_is_valid(contents));
+}
+
+GST_END_TEST;
+
+GST_START_TEST(test_wrong_version) {
+  std::string contents = read_file(write_cache("wrong-version"));
+
+  fail_unless_equals_int(get_header_field(contents, CACHE_VERSION_OFFSET),
+                         GST_PYLON_CACHE_VERSION);
+  fail_if(cache_is_valid(set_header_field(contents, CACHE_VERSION_OFFSET,
+                                          GST_PYLON_CACHE_VERSION - 1)));
+  fail_if(cache_is_valid(set_header_field(contents, CACHE_VERSION_OFFSET,
+                                          GST_PYLON_CACHE_VERSION + 1)));
+}
+
+GST_END_TEST;
+
+GST_START_TEST(test_wrong_byte_order) {
+  std::string contents = read_file(write_cache("wrong-byte-order"));
+  guint32 byte_order = get_header_field(contents, CACHE_BYTE_ORDER_OFFSET);
+
+  fail_if(cache_is_valid(set_header_field(contents, CACHE_BYTE_ORDER_OFFSET,
+                                          GUINT32_SWAP_LE_BE(byte_order))));
+}
+
+GST_END_TEST;
+
+GST_START_TEST(test_wrong_schema) {
+  std::string contents = read_file(write_cache("wrong-schema"));
+  guint32 schema = get_header_field(contents, CACHE_SCHEMA_OFFSET);
+
+  fail_if(cache_is_valid(
+      set_header_field(contents, CACHE_SCHEMA_OFFSET, schema + 1)));
+}
+
+GST_END_TEST;
+
+/* The files of the tests and the directory the cache creates in it */
+static void remove_dir(const gchar *path) {
+  GDir *dir = g_dir_open(path, 0, NULL);
+
+  if (dir) {
+    while (const gchar *name = g_dir_read_name(dir)) {
+      gchar *child = g_build_filename(path, name, NULL);
+      if (g_file_test(child, G_FILE_TEST_IS_DIR)) {
+        remove_dir(child);
+      } else {
+        g_remove(child);
+      }
+      g_free(child);
+    }
+    g_dir_close(dir);
+  }
+
+  g_rmdir(path);
+}
+
+static Suite *cache_suite(void) {
+  Suite *s = suite_create("cache");
+  TCase *tc_chain = tcase_create("general");
+
+  suite_add_tcase(s, tc_chain);
+  tcase_add_test(tc_chain, test_round_trip);
+  tcase_add_test(tc_chain, test_truncated);
+  tcase_add_test(tc_chain, test_bad_magic);
+  tcase_add_test(tc_chain, test_wrong_version);
+  tcase_add_test(tc_chain, test_wrong_byte_order);
+  tcase_add_test(tc_chain, test_wrong_schema);
+
+  return s;
+}
+
+int main(int argc, char **argv) {
+  /* the caches must not touch the user's cache directory, which GLib reads
+   * only once */
+  cache_dir = g_dir_make_tmp("gstpylon-cache-XXXXXX", NULL);
+  g_setenv("XDG_CACHE_HOME", cache_dir, TRUE);
+
+  gst_check_init(&argc, &argv);
+  gst_pylon_debug_init();
+
+  int n_failed = gst_check_run_suite(cache_suite(), "cache", __FILE__);
+
+  remove_dir(cache_dir);
+  g_free(cache_dir);
+
+  return n_failed;
+}
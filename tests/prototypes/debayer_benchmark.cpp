@@ -0,0 +1,173 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Correctness and throughput of the in-source demosaicing on random Bayer
+ * frames, plus known results on uniform ones
+ *
+ * Usage: debayer_benchmark [width height threads iterations]
+ */
+
+#include "ext/pylon/gstpylondebayer.h"
+#include "kernel_check.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+/* 0 red, 1 green, 2 blue at (@x, @y), written down apart from the kernel */
+static int GetSiteColor(GstPylonBayerPattern pattern, int x, int y) {
+  static const int sites[4][2][2] = {
+      {{0, 1}, {1, 2}},   /* RGGB */
+      {{2, 1}, {1, 0}},   /* BGGR */
+      {{1, 0}, {2, 1}},   /* GRBG */
+      {{1, 2}, {0, 1}}};  /* GBRG */
+  int index = 0;
+
+  switch (pattern) {
+    case GST_PYLON_BAYER_RGGB:
+      index = 0;
+      break;
+    case GST_PYLON_BAYER_BGGR:
+      index = 1;
+      break;
+    case GST_PYLON_BAYER_GRBG:
+      index = 2;
+      break;
+    case GST_PYLON_BAYER_GBRG:
+      index = 3;
+      break;
+  }
+
+  return sites[index][y & 1][x & 1];
+}
+
+/* the pixel of a uniform mosaic, interpolation leaves it unchanged */
+static std::vector<uint8_t> GetUniformPixel(GstPylonDebayerOutput output,
+                                            const uint8_t rgb[3]) {
+  if (output == GST_PYLON_DEBAYER_RGB) {
+    return {rgb[0], rgb[1], rgb[2]};
+  }
+  if (output == GST_PYLON_DEBAYER_BGRX) {
+    return {rgb[2], rgb[1], rgb[0], 0xff};
+  }
+
+  /* the rounded average of red and blue, averaged with green */
+  int rb = (rgb[0] + rgb[2] + 1) >> 1;
+  return {static_cast<uint8_t>((rb + rgb[1] + 1) >> 1)};
+}
+
+int main(int argc, char **argv) {
+  KernelCheck check(argc, argv, 4000, 3000, 50);
+  const int width = check.GetWidth();
+  const int height = check.GetHeight();
+
+  /* camera rows are padded, keep the stride apart from the row size */
+  size_t src_stride = width + 8;
+  std::vector<uint8_t> bayer(src_stride * height);
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> dist(0, 255);
+
+  for (auto &sample : bayer) {
+    sample = dist(rng);
+  }
+
+  const struct {
+    GstPylonDebayerOutput output;
+    const char *name;
+  } outputs[] = {{GST_PYLON_DEBAYER_RGB, "RGB"},
+                 {GST_PYLON_DEBAYER_BGRX, "BGRx"},
+                 {GST_PYLON_DEBAYER_GRAY8, "GRAY8"}};
+  const struct {
+    GstPylonBayerPattern pattern;
+    const char *name;
+  } patterns[] = {{GST_PYLON_BAYER_RGGB, "rggb"},
+                  {GST_PYLON_BAYER_BGGR, "bggr"},
+                  {GST_PYLON_BAYER_GRBG, "grbg"},
+                  {GST_PYLON_BAYER_GBRG, "gbrg"}};
+
+  for (const auto &format : outputs) {
+    size_t dst_stride = static_cast<size_t>(width) *
+                        GstPylonDebayer::GetPixelSize(format.output);
+    std::vector<uint8_t> reference(dst_stride * height);
+    std::vector<uint8_t> rgb(reference.size());
+    std::vector<uint8_t> expected(reference.size());
+
+    for (const auto &pattern : patterns) {
+      GstPylonDebayer debayer;
+      std::string name = std::string(pattern.name) + " > " + format.name;
+
+      /* the scalar path is the reference of the SIMD ones */
+      debayer.Configure(pattern.pattern, format.output);
+      debayer.SetSimdLevel(GST_PYLON_SIMD_SCALAR);
+      debayer.Process(bayer.data(), src_stride, reference.data(), dst_stride,
+                      width, height, nullptr);
+
+      check.ForEachSimdLevel(debayer, [&](GstPylonSimdLevel level) {
+        /* a sample differing from the reference in every byte, so unwritten
+         * output never passes */
+        check.Run(
+            name, level,
+            [&]() {
+              for (size_t i = 0; i < rgb.size(); i++) {
+                rgb[i] = reference[i] ^ 0x80;
+              }
+            },
+            [&](GstPylonWorkerPool *pool) {
+              debayer.Process(bayer.data(), src_stride, rgb.data(),
+                              dst_stride, width, height, pool);
+            },
+            [&]() {
+              size_t mismatches = 0;
+              for (size_t i = 0; i < rgb.size(); i++) {
+                mismatches += rgb[i] != reference[i];
+              }
+              return mismatches;
+            });
+      });
+
+      /* uniform channels survive any interpolation, which checks the site
+       * order of the pattern and the output layout on their own */
+      static const uint8_t colors[][3] = {
+          {255, 0, 0}, {0, 255, 0}, {0, 0, 255}, {200, 100, 30}};
+
+      for (const auto &color : colors) {
+        std::vector<uint8_t> mosaic(bayer.size());
+        std::vector<uint8_t> pixel = GetUniformPixel(format.output, color);
+        std::string uniform_name = name + " uniform";
+
+        for (int y = 0; y < height; y++) {
+          for (int x = 0; x < width; x++) {
+            mosaic[y * src_stride + x] =
+                color[GetSiteColor(pattern.pattern, x, y)];
+          }
+        }
+        for (size_t i = 0; i < expected.size(); i++) {
+          expected[i] = pixel[i % pixel.size()];
+        }
+
+        check.ForEachSimdLevel(debayer, [&](GstPylonSimdLevel level) {
+          check.Verify(
+              uniform_name, level,
+              [&]() {
+                for (size_t i = 0; i < rgb.size(); i++) {
+                  rgb[i] = expected[i] ^ 0x80;
+                }
+              },
+              [&](GstPylonWorkerPool *pool) {
+                debayer.Process(mosaic.data(), src_stride, rgb.data(),
+                                dst_stride, width, height, pool);
+              },
+              [&]() {
+                size_t mismatches = 0;
+                for (size_t i = 0; i < rgb.size(); i++) {
+                  mismatches += rgb[i] != expected[i];
+                }
+                return mismatches;
+              });
+        });
+      }
+    }
+  }
+
+  return check.Finish();
+}
@@ -0,0 +1,131 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Correctness and throughput of the HDR exposure merge on synthetic windows
+ *
+ * Usage: hdr_fusion_benchmark [width height threads iterations exposures]
+ */
+
+#include "ext/pylon/gstpylonhdrmerge.h"
+#include "kernel_check.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+/* a horizontal radiance ramp spanning several decades plus sensor noise,
+ * exposed once per exposure time and clipped to 8 bits */
+static std::vector<std::vector<uint8_t>> make_window(
+    int width, int height, const std::vector<double> &exposure_times) {
+  std::vector<std::vector<uint8_t>> window;
+  std::mt19937 rng(42);
+  std::normal_distribution<double> noise(0.0, 1.5);
+
+  for (double time : exposure_times) {
+    std::vector<uint8_t> image(static_cast<size_t>(width) * height);
+    for (int y = 0; y < height; y++) {
+      for (int x = 0; x < width; x++) {
+        double radiance = std::pow(10.0, 4.0 * x / width) / 40.0;
+        double value = radiance * time / exposure_times[0] + noise(rng);
+        image[static_cast<size_t>(y) * width + x] =
+            static_cast<uint8_t>(std::min(255.0, std::max(0.0, value)));
+      }
+    }
+    window.push_back(std::move(image));
+  }
+
+  return window;
+}
+
+/* the SIMD paths round their float weights differently, by one step of
+ * the fractional radiance bits at most */
+static const int MAX_RADIANCE_ERROR = 1;
+
+int main(int argc, char **argv) {
+  KernelCheck check(argc, argv, 1920, 1200, 50);
+  const int width = check.GetWidth();
+  const int height = check.GetHeight();
+  int n_exposures = argc > 5 ? std::atoi(argv[5]) : 3;
+
+  std::vector<double> exposure_times;
+  for (int k = 0; k < n_exposures; k++) {
+    exposure_times.push_back(std::pow(8.0, k));
+  }
+
+  auto window = make_window(width, height, exposure_times);
+  std::vector<const uint8_t *> src;
+  std::vector<int> src_stride(n_exposures, width);
+  for (auto &image : window) {
+    src.push_back(image.data());
+  }
+
+  GstPylonHdrMerge merge;
+  if (!merge.Configure(exposure_times)) {
+    std::fprintf(stderr, "invalid exposure times\n");
+    return 1;
+  }
+
+  std::printf("%d exposures\n", n_exposures);
+
+  size_t size = static_cast<size_t>(width) * height;
+  std::vector<uint16_t> reference(size);
+  std::vector<uint16_t> radiance(size);
+  std::vector<uint8_t> tone_mapped(size);
+  std::vector<uint8_t> tone_expected(size);
+
+  /* the scalar path is the reference of the SIMD ones */
+  merge.SetSimdLevel(GST_PYLON_SIMD_SCALAR);
+  merge.Process(src.data(), src_stride.data(), reference.data(), width * 2,
+                width, height, nullptr);
+
+  check.ForEachSimdLevel(merge, [&](GstPylonSimdLevel level) {
+    /* radiance stays below 255 << 8 */
+    check.Run(
+        "radiance", level,
+        [&]() { std::fill(radiance.begin(), radiance.end(), 0xffff); },
+        [&](GstPylonWorkerPool *pool) {
+          merge.Process(src.data(), src_stride.data(), radiance.data(),
+                        width * 2, width, height, pool);
+        },
+        [&]() {
+          size_t mismatches = 0;
+          for (size_t i = 0; i < size; i++) {
+            mismatches += std::abs(static_cast<int>(radiance[i]) -
+                                   reference[i]) > MAX_RADIANCE_ERROR;
+          }
+          return mismatches;
+        });
+
+    /* the tone curve is steep at low radiance, one step of rounding can
+     * move a tone mapped sample by more than one. The samples are checked
+     * against the curve of this path's radiance instead. */
+    merge.Process(src.data(), src_stride.data(), radiance.data(), width * 2,
+                  width, height, nullptr);
+    for (size_t i = 0; i < size; i++) {
+      tone_expected[i] = merge.MapTone(radiance[i]);
+    }
+
+    check.Run(
+        "tonemapped", level,
+        [&]() {
+          for (size_t i = 0; i < size; i++) {
+            tone_mapped[i] = tone_expected[i] ^ 0x80;
+          }
+        },
+        [&](GstPylonWorkerPool *pool) {
+          merge.ProcessToneMapped(src.data(), src_stride.data(),
+                                  tone_mapped.data(), width, width, height,
+                                  pool);
+        },
+        [&]() {
+          size_t mismatches = 0;
+          for (size_t i = 0; i < size; i++) {
+            mismatches += tone_mapped[i] != tone_expected[i];
+          }
+          return mismatches;
+        });
+  });
+
+  return check.Finish();
+}
@@ -0,0 +1,149 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Verification and timing shared by the conversion kernel benchmarks
+ */
+
+#ifndef _KERNEL_CHECK_H_
+#define _KERNEL_CHECK_H_
+
+#include "ext/pylon/gstpylonsimd.h"
+#include "ext/pylon/gstpylonworkerpool.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+
+/**
+ * KernelCheck:
+ *
+ * Parses [width height threads iterations] and runs a kernel on every code
+ * path the CPU supports, threaded and on a single thread. Both outputs are
+ * compared with a reference or with known values, the throughput is only
+ * measured with a positive iteration count. main() returns Finish(), which fails on any
+ * mismatch so the benchmarks double as tests.
+ */
+class KernelCheck {
+ public:
+  /* the pool is nullptr for a single thread */
+  typedef std::function<void(GstPylonWorkerPool *pool)> ProcessFunc;
+  typedef std::function<void()> ClearFunc;
+  typedef std::function<size_t()> CompareFunc;
+
+  KernelCheck(int argc, char **argv, int default_width, int default_height,
+              int default_iterations)
+      : width(argc > 1 ? std::atoi(argv[1]) : default_width),
+        height(argc > 2 ? std::atoi(argv[2]) : default_height),
+        iterations(argc > 4 ? std::atoi(argv[4]) : default_iterations),
+        pool(argc > 3 ? std::atoi(argv[3]) : 0),
+        failures(0) {
+    std::printf("%dx%d, %u threads, %d iterations\n", width, height,
+                pool.GetThreadCount(), iterations);
+  }
+
+  int GetWidth() const { return width; }
+  int GetHeight() const { return height; }
+
+  /* calls @func with every SIMD level @kernel can be set to */
+  template <typename Kernel, typename Func>
+  void ForEachSimdLevel(Kernel &kernel, Func func) const {
+    const GstPylonSimdLevel levels[] = {
+        GST_PYLON_SIMD_SCALAR, GST_PYLON_SIMD_SSE41, GST_PYLON_SIMD_AVX2,
+        GST_PYLON_SIMD_NEON};
+
+    for (GstPylonSimdLevel level : levels) {
+      kernel.SetSimdLevel(level);
+      if (kernel.GetSimdLevel() == level) {
+        func(level);
+      }
+    }
+  }
+
+  /* Checks the output threaded and on a single thread, without timing.
+   * @clear fills the output with values the kernel never writes, @compare
+   * counts the output elements differing from the expected ones. Only
+   * mismatches are reported. */
+  size_t Verify(const std::string &name, GstPylonSimdLevel level,
+                const ClearFunc &clear, const ProcessFunc &process,
+                const CompareFunc &compare) {
+    size_t mismatches = Compare(clear, process, compare);
+
+    if (mismatches > 0) {
+      std::printf("%-16s %-7s mismatches %zu\n", name.c_str(),
+                  gst_pylon_simd_level_name(level), mismatches);
+    }
+
+    return mismatches;
+  }
+
+  /* as Verify(), but always reports and measures the throughput with a
+   * positive iteration count */
+  void Run(const std::string &name, GstPylonSimdLevel level,
+           const ClearFunc &clear, const ProcessFunc &process,
+           const CompareFunc &compare) {
+    size_t mismatches = Compare(clear, process, compare);
+
+    if (iterations <= 0) {
+      std::printf("%-16s %-7s mismatches %zu\n", name.c_str(),
+                  gst_pylon_simd_level_name(level), mismatches);
+      return;
+    }
+
+    double threaded_rate = Measure(process, &pool);
+    double single_rate = Measure(process, nullptr);
+    std::printf(
+        "%-16s %-7s %8.1f MPix/s (%7.1f per core)  single thread %8.1f "
+        "MPix/s  mismatches %zu\n",
+        name.c_str(), gst_pylon_simd_level_name(level), threaded_rate,
+        threaded_rate / pool.GetThreadCount(), single_rate, mismatches);
+  }
+
+  int Finish() const {
+    if (failures > 0) {
+      std::fprintf(stderr, "%zu mismatching samples\n", failures);
+      return 1;
+    }
+
+    return 0;
+  }
+
+ private:
+  size_t Compare(const ClearFunc &clear, const ProcessFunc &process,
+                 const CompareFunc &compare) {
+    size_t mismatches = 0;
+
+    clear();
+    process(&pool);
+    mismatches += compare();
+    clear();
+    process(nullptr);
+    mismatches += compare();
+    failures += mismatches;
+
+    return mismatches;
+  }
+
+  /* MPix/s over the configured iterations */
+  double Measure(const ProcessFunc &process, GstPylonWorkerPool *on) const {
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < iterations; i++) {
+      process(on);
+    }
+
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+
+    return static_cast<double>(width) * height / 1e6 * iterations / seconds;
+  }
+
+  int width;
+  int height;
+  int iterations;
+  GstPylonWorkerPool pool;
+  size_t failures;
+};
+
+#endif
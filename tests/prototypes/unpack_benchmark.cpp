@@ -0,0 +1,110 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Correctness and throughput of the packed pixel format unpacking on
+ * random frames
+ *
+ * Usage: unpack_benchmark [width height threads iterations]
+ */
+
+#include "ext/pylon/gstpylonunpack.h"
+#include "kernel_check.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+/* packs like the camera does, independent of the unpacking code */
+static void pack_row(GstPylonUnpackLayout layout, const uint16_t *samples,
+                     uint8_t *row, int width) {
+  if (GST_PYLON_UNPACK_16 == layout) {
+    for (int x = 0; x < width; x++) {
+      row[2 * x] = samples[x] & 0xFF;
+      row[2 * x + 1] = samples[x] >> 8;
+    }
+    return;
+  }
+
+  if (GST_PYLON_UNPACK_12_PACKED == layout) {
+    for (int x = 0; x < width; x++) {
+      uint8_t *pair = row + (x / 2) * 3;
+      if (x & 1) {
+        pair[2] = samples[x] >> 4;
+        pair[1] |= (samples[x] & 0x0F) << 4;
+      } else {
+        pair[0] = samples[x] >> 4;
+        pair[1] |= samples[x] & 0x0F;
+      }
+    }
+    return;
+  }
+
+  int bits = GST_PYLON_UNPACK_10P == layout ? 10 : 12;
+  for (int x = 0; x < width; x++) {
+    for (int b = 0; b < bits; b++) {
+      size_t bit = static_cast<size_t>(x) * bits + b;
+      if (samples[x] & (1 << b)) {
+        row[bit / 8] |= 1 << (bit % 8);
+      }
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  KernelCheck check(argc, argv, 1920, 1200, 200);
+  const int width = check.GetWidth();
+  const int height = check.GetHeight();
+
+  const struct {
+    GstPylonUnpackLayout layout;
+    const char *name;
+    int bits;
+    /* mono samples are moved to the most significant bits */
+    int shift;
+  } formats[] = {{GST_PYLON_UNPACK_10P, "Mono10p", 10, 6},
+                 {GST_PYLON_UNPACK_12P, "Mono12p", 12, 4},
+                 {GST_PYLON_UNPACK_12_PACKED, "Mono12Packed", 12, 4},
+                 {GST_PYLON_UNPACK_16, "Mono10", 10, 6},
+                 {GST_PYLON_UNPACK_12P, "BayerRG12p", 12, 0}};
+
+  for (const auto &format : formats) {
+    /* camera rows are padded, keep the stride apart from the row size */
+    size_t row_bytes = GstPylonUnpack::GetRowBytes(format.layout, width);
+    size_t src_stride = row_bytes + 8;
+    std::vector<uint16_t> samples(static_cast<size_t>(width) * height);
+    std::vector<uint8_t> packed(src_stride * height, 0);
+    std::vector<uint16_t> unpacked(samples.size());
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(0, (1 << format.bits) - 1);
+
+    for (auto &sample : samples) {
+      sample = dist(rng);
+    }
+    for (int y = 0; y < height; y++) {
+      pack_row(format.layout, samples.data() + static_cast<size_t>(y) * width,
+               packed.data() + y * src_stride, width);
+    }
+
+    GstPylonUnpack unpack;
+    unpack.Configure(format.layout, format.shift);
+
+    check.ForEachSimdLevel(unpack, [&](GstPylonSimdLevel level) {
+      check.Run(
+          format.name, level,
+          [&]() { std::fill(unpacked.begin(), unpacked.end(), 0xFFFF); },
+          [&](GstPylonWorkerPool *pool) {
+            unpack.Process(packed.data(), src_stride, unpacked.data(),
+                           width * 2, width, height, pool);
+          },
+          [&]() {
+            size_t mismatches = 0;
+            for (size_t i = 0; i < samples.size(); i++) {
+              mismatches += unpacked[i] !=
+                            static_cast<uint16_t>(samples[i] << format.shift);
+            }
+            return mismatches;
+          });
+    });
+  }
+
+  return check.Finish();
+}
@@ -0,0 +1,252 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Correctness and throughput of the NV12/I420 conversion on random frames,
+ * plus known results of uniform RGB frames and of 4:2:2 samples
+ *
+ * Usage: yuv_convert_benchmark [width height threads iterations]
+ */
+
+#include "ext/pylon/gstpylonyuvconvert.h"
+#include "kernel_check.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+/* a source frame and the Y, U and V samples it converts to, chroma per 2x2
+ * block */
+struct KnownFrame {
+  std::string name;
+  std::vector<uint8_t> src;
+  std::vector<uint8_t> planes[3];
+};
+
+/* uniform frames, BT.601 limited range values of white and pure red */
+static std::vector<KnownFrame> GetRgbFrames(GstPylonYuvInput input,
+                                            size_t src_stride, int width,
+                                            int height) {
+  static const struct {
+    const char *name;
+    uint8_t rgb[3];
+    uint8_t yuv[3];
+  } colors[] = {{"white", {255, 255, 255}, {235, 128, 128}},
+                {"red", {255, 0, 0}, {82, 90, 240}},
+                {"black", {0, 0, 0}, {16, 128, 128}}};
+  const bool bgr = GST_PYLON_YUV_INPUT_BGR == input;
+  const size_t n_chroma =
+      static_cast<size_t>((width + 1) / 2) * ((height + 1) / 2);
+  std::vector<KnownFrame> frames;
+
+  for (const auto &color : colors) {
+    KnownFrame frame;
+
+    frame.name = color.name;
+    frame.src.resize(src_stride * height);
+    for (int y = 0; y < height; y++) {
+      for (int x = 0; x < width; x++) {
+        uint8_t *pixel = &frame.src[y * src_stride + x * 3];
+        pixel[0] = color.rgb[bgr ? 2 : 0];
+        pixel[1] = color.rgb[1];
+        pixel[2] = color.rgb[bgr ? 0 : 2];
+      }
+    }
+    frame.planes[0].assign(static_cast<size_t>(width) * height, color.yuv[0]);
+    frame.planes[1].assign(n_chroma, color.yuv[1]);
+    frame.planes[2].assign(n_chroma, color.yuv[2]);
+    frames.push_back(frame);
+  }
+
+  return frames;
+}
+
+/* distinct luma per pixel and chroma per macropixel, equal in both rows of
+ * a pair so the vertical subsampling passes every sample through */
+static std::vector<KnownFrame> Get422Frames(GstPylonYuvInput input,
+                                            size_t src_stride, int width,
+                                            int height) {
+  const int luma_offset = GST_PYLON_YUV_INPUT_YUY2 == input ? 0 : 1;
+  const int chroma_offset = 1 - luma_offset;
+  const int chroma_width = (width + 1) / 2;
+  KnownFrame frame;
+
+  frame.name = "samples";
+  frame.src.resize(src_stride * height);
+  frame.planes[0].resize(static_cast<size_t>(width) * height);
+  frame.planes[1].resize(static_cast<size_t>(chroma_width) *
+                         ((height + 1) / 2));
+  frame.planes[2].resize(frame.planes[1].size());
+
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < chroma_width * 2; x++) {
+      uint8_t *pair = &frame.src[y * src_stride + (x & ~1) * 2];
+      uint8_t luma = static_cast<uint8_t>(x * 7 + y * 13);
+
+      pair[luma_offset + (x & 1) * 2] = luma;
+      if (x < width) {
+        frame.planes[0][y * width + x] = luma;
+      }
+    }
+    for (int cx = 0; cx < chroma_width; cx++) {
+      uint8_t *pair = &frame.src[y * src_stride + cx * 4];
+      size_t block = static_cast<size_t>(y / 2) * chroma_width + cx;
+      uint8_t cb = static_cast<uint8_t>(cx * 5 + y / 2 * 3);
+      uint8_t cr = static_cast<uint8_t>(cx * 11 + y / 2);
+
+      pair[chroma_offset] = cb;
+      pair[chroma_offset + 2] = cr;
+      frame.planes[1][block] = cb;
+      frame.planes[2][block] = cr;
+    }
+  }
+
+  return {frame};
+}
+
+int main(int argc, char **argv) {
+  KernelCheck check(argc, argv, 1920, 1080, 200);
+  const int width = check.GetWidth();
+  const int height = check.GetHeight();
+
+  const struct {
+    GstPylonYuvInput input;
+    const char *name;
+    int pixel_size;
+  } inputs[] = {{GST_PYLON_YUV_INPUT_YUY2, "YUY2", 2},
+                {GST_PYLON_YUV_INPUT_UYVY, "UYVY", 2},
+                {GST_PYLON_YUV_INPUT_RGB, "RGB", 3},
+                {GST_PYLON_YUV_INPUT_BGR, "BGR", 3}};
+  const struct {
+    GstPylonYuvOutput output;
+    const char *name;
+  } outputs[] = {{GST_PYLON_YUV_OUTPUT_NV12, "NV12"},
+                 {GST_PYLON_YUV_OUTPUT_I420, "I420"}};
+
+  /* the default GStreamer layout of both formats */
+  const size_t luma_stride = (width + 3) & ~3;
+  const int chroma_height = (height + 1) / 2;
+  const size_t chroma_stride[] = {
+      luma_stride, static_cast<size_t>(((width + 1) / 2 + 3) & ~3)};
+
+  for (const auto &in : inputs) {
+    /* camera rows are padded, 4:2:2 rows hold whole macropixels */
+    size_t src_stride =
+        static_cast<size_t>((width + 1) & ~1) * in.pixel_size + 8;
+    std::vector<uint8_t> src(src_stride * height);
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(0, 255);
+
+    for (auto &sample : src) {
+      sample = dist(rng);
+    }
+
+    for (const auto &out : outputs) {
+      size_t uv_stride =
+          chroma_stride[GST_PYLON_YUV_OUTPUT_I420 == out.output];
+      size_t luma_size = luma_stride * height;
+      size_t chroma_size = uv_stride * chroma_height;
+      std::vector<uint8_t> frame(luma_size + 2 * chroma_size);
+      std::vector<uint8_t> reference;
+      uint8_t *const planes[] = {frame.data(), frame.data() + luma_size,
+                                 frame.data() + luma_size + chroma_size};
+      const size_t strides[] = {luma_stride, uv_stride, uv_stride};
+      std::string name = std::string(in.name) + " > " + out.name;
+
+      /* padding is never written, only the samples are compared */
+      auto count_mismatches = [&](const std::vector<uint8_t> &expected) {
+        size_t mismatches = 0;
+        size_t chroma_row = GST_PYLON_YUV_OUTPUT_NV12 == out.output
+                                ? static_cast<size_t>((width + 1) & ~1)
+                                : static_cast<size_t>((width + 1) / 2);
+
+        for (int y = 0; y < height; y++) {
+          for (int x = 0; x < width; x++) {
+            size_t i = y * luma_stride + x;
+            mismatches += frame[i] != expected[i];
+          }
+        }
+        for (int y = 0; y < chroma_height; y++) {
+          for (size_t x = 0; x < chroma_row; x++) {
+            size_t i = luma_size + y * uv_stride + x;
+            mismatches += frame[i] != expected[i];
+            if (GST_PYLON_YUV_OUTPUT_I420 == out.output) {
+              i += chroma_size;
+              mismatches += frame[i] != expected[i];
+            }
+          }
+        }
+        return mismatches;
+      };
+      /* every byte differs from the expected one, so unwritten samples
+       * never pass */
+      auto clear = [&](const std::vector<uint8_t> &expected) {
+        for (size_t i = 0; i < frame.size(); i++) {
+          frame[i] = expected[i] ^ 0x80;
+        }
+      };
+
+      GstPylonYuvConvert convert;
+      convert.Configure(in.input, out.output);
+
+      /* the scalar path is the reference of the SIMD ones */
+      convert.SetSimdLevel(GST_PYLON_SIMD_SCALAR);
+      convert.Process(src.data(), src_stride, planes, strides, width, height,
+                      nullptr);
+      reference = frame;
+
+      check.ForEachSimdLevel(convert, [&](GstPylonSimdLevel level) {
+        check.Run(
+            name, level, [&]() { clear(reference); },
+            [&](GstPylonWorkerPool *pool) {
+              convert.Process(src.data(), src_stride, planes, strides, width,
+                              height, pool);
+            },
+            [&]() { return count_mismatches(reference); });
+      });
+
+      /* the known frames check the matrix and the sample order on their
+       * own */
+      std::vector<KnownFrame> known =
+          in.pixel_size == 3
+              ? GetRgbFrames(in.input, src_stride, width, height)
+              : Get422Frames(in.input, src_stride, width, height);
+
+      for (const auto &known_frame : known) {
+        std::vector<uint8_t> expected(frame.size());
+        const int chroma_width = (width + 1) / 2;
+
+        for (int y = 0; y < height; y++) {
+          std::copy_n(&known_frame.planes[0][y * width], width,
+                      &expected[y * luma_stride]);
+        }
+        for (int y = 0; y < chroma_height; y++) {
+          for (int x = 0; x < chroma_width; x++) {
+            size_t block = static_cast<size_t>(y) * chroma_width + x;
+            uint8_t *row = &expected[luma_size + y * uv_stride];
+
+            if (GST_PYLON_YUV_OUTPUT_NV12 == out.output) {
+              row[x * 2] = known_frame.planes[1][block];
+              row[x * 2 + 1] = known_frame.planes[2][block];
+            } else {
+              row[x] = known_frame.planes[1][block];
+              row[x + chroma_size] = known_frame.planes[2][block];
+            }
+          }
+        }
+
+        check.ForEachSimdLevel(convert, [&](GstPylonSimdLevel level) {
+          check.Verify(
+              name + " " + known_frame.name, level,
+              [&]() { clear(expected); },
+              [&](GstPylonWorkerPool *pool) {
+                convert.Process(known_frame.src.data(), src_stride, planes,
+                                strides, width, height, pool);
+              },
+              [&]() { return count_mismatches(expected); });
+        });
+      }
+    }
+  }
+
+  return check.Finish();
+}
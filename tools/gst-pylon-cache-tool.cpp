@@ -0,0 +1,308 @@
+/* SPDX-License-Identifier: BSD-2-Clause
+ *
+ * Generate, validate, export and import pylonsrc feature caches
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <gst/gst.h>
+#include <gst/pylon/gstpyloncache.h>
+#include <gst/pylon/gstpylondebug.h>
+#include <gst/pylon/gstpylonincludes.h>
+#include <gst/pylon/gstpylonobject.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define EXPORT_SUFFIX ".gstpyloncache"
+#define VALID_CHARS G_CSET_a_2_z G_CSET_A_2_Z G_CSET_DIGITS "._-"
+
+static gboolean force = FALSE;
+static gchar *serial = NULL;
+
+static GOptionEntry entries[] = {
+    {"force", 'f', 0, G_OPTION_ARG_NONE, &force,
+     "Regenerate caches that already describe all properties", NULL},
+    {"serial", 's', 0, G_OPTION_ARG_STRING, &serial,
+     "Only generate the caches of the camera with this serial number",
+     "SERIAL"},
+    {NULL}};
+
+static const gchar *description =
+    "Commands:\n"
+    "  generate             Write the caches of all connected cameras, set\n"
+    "                       PYLON_CAMEMU=<n> to include emulated cameras\n"
+    "  list                 Show the caches in the cache directory\n"
+    "  validate [FILE..]    Check cache files, all cached ones by default\n"
+    "  export DIR [NAME..]  Copy caches to DIR, all cached ones by default\n"
+    "  import FILE..        Install exported caches into the cache dir\n";
+
+/* Walks the nodemap into the cache of a camera or stream grabber, the same
+ * way the first pylonsrc on a machine does it */
+static gboolean gst_pylon_cache_tool_generate_device(
+    GenApi::INodeMap &nodemap, const std::string &device_name,
+    const std::string &cache_name) {
+  {
+    GstPylonCache feature_cache(cache_name);
+    if (feature_cache.HasParamSpecs() && !force) {
+      g_print("  %s: up to date\n", cache_name.c_str());
+      return TRUE;
+    }
+
+    feature_cache.Clear();
+    GType type =
+        gst_pylon_object_register(device_name, feature_cache, nodemap);
+    /* installs the properties and writes the cache */
+    g_type_class_unref(g_type_class_ref(type));
+  }
+
+  GstPylonCache written(cache_name);
+  if (!written.HasParamSpecs()) {
+    g_printerr("  %s: failed to write %s\n", cache_name.c_str(),
+               written.GetFilePath().c_str());
+    return FALSE;
+  }
+
+  g_print("  %s: %" G_GSIZE_FORMAT " properties, %" G_GSIZE_FORMAT
+          " limits -> %s\n",
+          cache_name.c_str(), written.GetParamSpecCount(),
+          written.GetLimitsCount(), written.GetFilePath().c_str());
+
+  return TRUE;
+}
+
+static gboolean gst_pylon_cache_tool_generate() {
+  gboolean ret = TRUE;
+  guint n_cameras = 0;
+
+  /* the limits under all settings are what makes a cache worth baking */
+  g_setenv("PYLONSRC_FEATURE_LIMITS", "precise", TRUE);
+
+  Pylon::CTlFactory &factory = Pylon::CTlFactory::GetInstance();
+  Pylon::DeviceInfoList_t device_list;
+  factory.EnumerateDevices(device_list);
+
+  for (const auto &device : device_list) {
+    if (serial && device.GetSerialNumber() != serial) {
+      continue;
+    }
+
+    n_cameras++;
+    g_print("%s (%s)\n", device.GetFriendlyName().c_str(),
+            device.GetSerialNumber().c_str());
+
+    try {
+      Pylon::CBaslerUniversalInstantCamera camera(factory.CreateDevice(device),
+                                                  Pylon::Cleanup_Delete);
+      camera.Open();
+
+      /* Set the camera to a valid state
+       * close left open transactions on the device
+       */
+      camera.DeviceFeaturePersistenceEnd.TryExecute();
+      camera.DeviceRegistersStreamingEnd.TryExecute();
+
+      /* Set the camera to a valid state
+       * load the factory default set
+       */
+      if (camera.UserSetSelector.IsWritable()) {
+        camera.UserSetSelector.SetValue("Default");
+        camera.UserSetLoad.Execute();
+      }
+
+      std::string device_name = std::string(device.GetFullName());
+      ret &= gst_pylon_cache_tool_generate_device(
+          camera.GetNodeMap(), device_name,
+          gst_pylon_object_get_camera_cache_name(camera));
+      ret &= gst_pylon_cache_tool_generate_device(
+          camera.GetStreamGrabberNodeMap(), device_name + " StreamGrabber",
+          gst_pylon_object_get_sgrabber_cache_name(camera));
+
+      camera.Close();
+    } catch (const Pylon::GenericException &e) {
+      g_printerr("  failed: %s\n", e.GetDescription());
+      ret = FALSE;
+    }
+  }
+
+  if (0 == n_cameras) {
+    g_printerr("No camera found%s%s\n", serial ? " with serial " : "",
+               serial ? serial : "");
+    ret = FALSE;
+  }
+
+  return ret;
+}
+
+static gboolean gst_pylon_cache_tool_validate_file(const std::string &path,
+                                                   gboolean verbose) {
+  try {
+    std::unique_ptr<GstPylonCache> cache = GstPylonCache::FromFile(path);
+
+    /* builds every property the way pylonsrc installs them */
+    std::vector<GParamSpec *> specs = cache->GetParamSpecs();
+    if (specs.empty()) {
+      g_printerr("%s: no property descriptions\n", path.c_str());
+      return FALSE;
+    }
+    for (const auto &spec : specs) {
+      g_param_spec_unref(g_param_spec_ref_sink(spec));
+    }
+
+    if (verbose) {
+      g_print("%s: %s, %" G_GSIZE_FORMAT " properties, %" G_GSIZE_FORMAT
+              " limits\n",
+              path.c_str(), cache->GetName().c_str(), specs.size(),
+              cache->GetLimitsCount());
+    }
+  } catch (const Pylon::GenericException &e) {
+    g_printerr("%s: %s\n", path.c_str(), e.GetDescription());
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+static gboolean gst_pylon_cache_tool_validate(
+    const std::vector<std::string> &paths) {
+  gboolean ret = TRUE;
+
+  for (const auto &path : paths) {
+    ret &= gst_pylon_cache_tool_validate_file(path, TRUE);
+  }
+
+  return ret;
+}
+
+static gboolean gst_pylon_cache_tool_export(
+    const gchar *dirpath, const std::vector<std::string> &names) {
+  gboolean ret = TRUE;
+
+  if (g_mkdir_with_parents(dirpath, 0775) != 0) {
+    g_printerr("Failed to create %s\n", dirpath);
+    return FALSE;
+  }
+
+  for (const auto &path : GstPylonCache::ListCacheFiles()) {
+    try {
+      std::unique_ptr<GstPylonCache> cache = GstPylonCache::FromFile(path);
+      const std::string &name = cache->GetName();
+
+      if (!names.empty() &&
+          std::find(names.begin(), names.end(), name) == names.end()) {
+        continue;
+      }
+
+      gchar *filename =
+          g_strcanon(g_strdup(name.c_str()), VALID_CHARS, '_');
+      std::string target =
+          std::string(dirpath) + "/" + filename + EXPORT_SUFFIX;
+      g_free(filename);
+
+      cache->SetFilePath(target);
+      cache->CreateCacheFile();
+      g_print("%s -> %s\n", name.c_str(), target.c_str());
+    } catch (const Pylon::GenericException &e) {
+      g_printerr("%s: %s\n", path.c_str(), e.GetDescription());
+      ret = FALSE;
+    }
+  }
+
+  return ret;
+}
+
+static gboolean gst_pylon_cache_tool_import(
+    const std::vector<std::string> &paths) {
+  gboolean ret = TRUE;
+
+  for (const auto &path : paths) {
+    if (!gst_pylon_cache_tool_validate_file(path, FALSE)) {
+      ret = FALSE;
+      continue;
+    }
+
+    try {
+      std::unique_ptr<GstPylonCache> cache = GstPylonCache::FromFile(path);
+      /* files in the cache directory are found by the hash of their name */
+      GstPylonCache installed(cache->GetName());
+
+      cache->SetFilePath(installed.GetFilePath());
+      cache->CreateCacheFile();
+      g_print("%s -> %s\n", cache->GetName().c_str(),
+              cache->GetFilePath().c_str());
+    } catch (const Pylon::GenericException &e) {
+      g_printerr("%s: %s\n", path.c_str(), e.GetDescription());
+      ret = FALSE;
+    }
+  }
+
+  return ret;
+}
+
+int main(int argc, char *argv[]) {
+  GError *err = NULL;
+  gboolean ret = FALSE;
+
+  GOptionContext *ctx = g_option_context_new("COMMAND [ARGUMENT...]");
+  g_option_context_set_summary(
+      ctx, "Manage the pylonsrc feature caches in $XDG_CACHE_HOME/gstpylon");
+  g_option_context_set_description(ctx, description);
+  g_option_context_add_main_entries(ctx, entries, NULL);
+  g_option_context_add_group(ctx, gst_init_get_option_group());
+
+  if (!g_option_context_parse(ctx, &argc, &argv, &err)) {
+    g_printerr("%s\n", err->message);
+    g_error_free(err);
+    g_option_context_free(ctx);
+    return 1;
+  }
+
+  if (argc < 2) {
+    gchar *help = g_option_context_get_help(ctx, TRUE, NULL);
+    g_printerr("%s", help);
+    g_free(help);
+    g_option_context_free(ctx);
+    return 1;
+  }
+  g_option_context_free(ctx);
+
+  gst_pylon_debug_init();
+
+  std::string command = argv[1];
+  std::vector<std::string> arguments(argv + 2, argv + argc);
+
+  if (command == "generate") {
+    Pylon::PylonInitialize();
+    try {
+      ret = gst_pylon_cache_tool_generate();
+    } catch (const Pylon::GenericException &e) {
+      g_printerr("%s\n", e.GetDescription());
+    }
+    Pylon::PylonTerminate();
+  } else if (command == "list") {
+    ret = TRUE;
+    for (const auto &path : GstPylonCache::ListCacheFiles()) {
+      gst_pylon_cache_tool_validate_file(path, TRUE);
+    }
+  } else if (command == "validate") {
+    ret = gst_pylon_cache_tool_validate(
+        arguments.empty() ? GstPylonCache::ListCacheFiles() : arguments);
+  } else if (command == "export" && !arguments.empty()) {
+    ret = gst_pylon_cache_tool_export(
+        arguments[0].c_str(),
+        std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+  } else if (command == "import" && !arguments.empty()) {
+    ret = gst_pylon_cache_tool_import(arguments);
+  } else {
+    g_printerr("Unknown command or missing argument: %s\n%s", command.c_str(),
+               description);
+  }
+
+  g_free(serial);
+
+  return ret ? 0 : 1;
+}